@@ -409,8 +409,7 @@ void AMFImporter::ParseFile(const std::string& pFile, IOSystem* pIOHandler)
 	if(file.get() == NULL) throw DeadlyImportError("Failed to open AMF file " + pFile + ".");
 
 	// generate a XML reader for it
-	std::unique_ptr<CIrrXML_IOStreamReader> mIOWrapper(new CIrrXML_IOStreamReader(file.get()));
-	mReader = irr::io::createIrrXMLReader(mIOWrapper.get());
+	mReader = new FastXmlReader(file.get());
 	if(!mReader) throw DeadlyImportError("Failed to create XML reader for file" + pFile + ".");
 	//
 	// start reading
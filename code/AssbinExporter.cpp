@@ -47,7 +47,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
 #include "ProcessHelper.h"
+#include "StringUtils.h"
 #include "Exceptional.h"
+#include "ParallelFor.h"
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #   include <zlib.h>
@@ -57,6 +59,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <time.h>
 
+#include <vector>
+
 
 #ifndef ASSIMP_BUILD_NO_EXPORT
 #ifndef ASSIMP_BUILD_NO_ASSBIN_EXPORTER
@@ -329,6 +333,8 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
     private:
         bool shortened;
         bool compressed;
+        bool indexed;
+        unsigned int numThreads;
 
     protected:
 
@@ -678,7 +684,9 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
         }
 
         // -----------------------------------------------------------------------------------
-        void WriteBinaryScene( IOStream * container, const aiScene* scene)
+        // With embedBlocks set to false, meshes, animations and textures are left
+        // out, the indexed layout stores them in blocks of their own.
+        void WriteBinaryScene( IOStream * container, const aiScene* scene, bool embedBlocks = true)
         {
             AssbinChunkWriter chunk( container, ASSBIN_CHUNK_AISCENE );
 
@@ -695,7 +703,7 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             WriteBinaryNode( &chunk, scene->mRootNode );
 
             // write all meshes
-            for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
+            for (unsigned int i = 0; embedBlocks && i < scene->mNumMeshes;++i) {
                 const aiMesh* mesh = scene->mMeshes[i];
                 WriteBinaryMesh( &chunk,mesh);
             }
@@ -707,14 +715,14 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             }
 
             // write all animations
-            for (unsigned int i = 0; i < scene->mNumAnimations;++i) {
+            for (unsigned int i = 0; embedBlocks && i < scene->mNumAnimations;++i) {
                 const aiAnimation* anim = scene->mAnimations[i];
                 WriteBinaryAnim(&chunk,anim);
             }
 
 
             // write all textures
-            for (unsigned int i = 0; i < scene->mNumTextures;++i) {
+            for (unsigned int i = 0; embedBlocks && i < scene->mNumTextures;++i) {
                 const aiTexture* mesh = scene->mTextures[i];
                 WriteBinaryTexture(&chunk,mesh);
             }
@@ -733,9 +741,88 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
         }
 
+        // -----------------------------------------------------------------------------------
+        /** A block of the indexed layout, see assbin_chunks.h */
+        struct IndexedBlock
+        {
+            uint32_t magic;
+            uint32_t flags;
+            uint32_t size;
+            std::vector<uint8_t> data;
+        };
+
+        // -----------------------------------------------------------------------------------
+        // Serialize block i of the indexed layout and deflate it if requested.
+        // Only reads the scene, so several blocks can be built at the same time.
+        void WriteIndexedBlock( const aiScene* scene, size_t i, IndexedBlock& block)
+        {
+            AssbinChunkWriter uncompressedStream( NULL, 0 );
+            if (0 == i) {
+                block.magic = ASSBIN_CHUNK_AISCENE;
+                WriteBinaryScene( &uncompressedStream, scene, false );
+            }
+            else if (--i < scene->mNumMeshes) {
+                block.magic = ASSBIN_CHUNK_AIMESH;
+                WriteBinaryMesh( &uncompressedStream, scene->mMeshes[i] );
+            }
+            else if ((i -= scene->mNumMeshes) < scene->mNumAnimations) {
+                block.magic = ASSBIN_CHUNK_AIANIMATION;
+                WriteBinaryAnim( &uncompressedStream, scene->mAnimations[i] );
+            }
+            else {
+                block.magic = ASSBIN_CHUNK_AITEXTURE;
+                WriteBinaryTexture( &uncompressedStream, scene->mTextures[i - scene->mNumAnimations] );
+            }
+
+            const uint8_t* uncompressedData = static_cast<const uint8_t*>(uncompressedStream.GetBufferPointer());
+            block.size = static_cast<uint32_t>(uncompressedStream.Tell());
+            block.flags = 0;
+            if (compressed) {
+                uLongf compressedSize = compressBound( block.size );
+                block.data.resize( compressedSize );
+                if (Z_OK == compress2( &block.data[0], &compressedSize, uncompressedData, block.size, 9 ) && compressedSize < block.size) {
+                    block.data.resize( compressedSize );
+                    block.flags = ASSBIN_BLOCK_DEFLATE;
+                    return;
+                }
+            }
+            // not compressed, or deflate did not make it any smaller
+            block.data.assign( uncompressedData, uncompressedData + block.size );
+        }
+
+        // -----------------------------------------------------------------------------------
+        // Write the scene in the indexed layout: the blocks are built in parallel,
+        // then the index table and the block data are written in order.
+        void WriteIndexedScene( IOStream * out, const aiScene* scene)
+        {
+            const size_t numBlocks = 1u + scene->mNumMeshes + scene->mNumAnimations + scene->mNumTextures;
+            std::vector<IndexedBlock> blocks( numBlocks );
+
+            ParallelFor( numBlocks, numThreads, [&]( size_t i ) {
+                WriteIndexedBlock( scene, i, blocks[i] );
+            } );
+
+            Write<unsigned int>( out, ASSBIN_CHUNK_INDEX );
+            Write<unsigned int>( out, static_cast<unsigned int>(numBlocks) );
+
+            uint64_t offset = out->Tell() + numBlocks * ASSBIN_INDEX_ENTRY_LENGTH;
+            for (const IndexedBlock& block : blocks) {
+                Write<unsigned int>( out, block.magic );
+                Write<unsigned int>( out, block.flags );
+                Write<uint64_t>( out, offset );
+                Write<unsigned int>( out, static_cast<unsigned int>(block.data.size()) );
+                Write<unsigned int>( out, block.size );
+                offset += block.data.size();
+            }
+
+            for (const IndexedBlock& block : blocks) {
+                out->Write( block.data.data(), 1, block.data.size() );
+            }
+        }
+
     public:
-        AssbinExport()
-            : shortened(false), compressed(false) // temporary settings until properties are introduced for exporters
+        AssbinExport( bool compressed = false, bool indexed = false, unsigned int numThreads = 0 )
+            : shortened(false), compressed(compressed), indexed(indexed), numThreads(numThreads)
         {
         }
 
@@ -747,15 +834,17 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             if (!out) return;
 
             time_t tt = time(NULL);
-            tm* p     = gmtime(&tt);
+            tm t = tm();
+            ai_gmtime(&tt, &t);
+            char curtime[26];
 
             // header
             char s[64];
             memset( s, 0, 64 );
 #if _MSC_VER >= 1400
-            sprintf_s(s,"ASSIMP.binary-dump.%s",asctime(p));
+            sprintf_s(s,"ASSIMP.binary-dump.%s",ai_asctime(&t, curtime));
 #else
-            ai_snprintf(s,64,"ASSIMP.binary-dump.%s",asctime(p));
+            ai_snprintf(s,64,"ASSIMP.binary-dump.%s",ai_asctime(&t, curtime));
 #endif
             out->Write( s, 44, 1 );
             // == 44 bytes
@@ -765,7 +854,7 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             Write<unsigned int>( out, aiGetVersionRevision() );
             Write<unsigned int>( out, aiGetCompileFlags() );
             Write<uint16_t>( out, shortened );
-            Write<uint16_t>( out, compressed );
+            Write<uint16_t>( out, indexed ? ASSBIN_LAYOUT_INDEXED : compressed ? ASSBIN_LAYOUT_DEFLATE : ASSBIN_LAYOUT_PLAIN );
             // ==  20 bytes
 
             char buff[256];
@@ -786,7 +875,11 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
             // Up to here the data is uncompressed. For compressed files, the rest
             // is compressed using standard DEFLATE from zlib.
-            if (compressed)
+            if (indexed)
+            {
+                WriteIndexedScene( out, pScene );
+            }
+            else if (compressed)
             {
                 AssbinChunkWriter uncompressedStream( NULL, 0 );
                 WriteBinaryScene( &uncompressedStream, pScene );
@@ -811,9 +904,13 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
         }
     };
 
-void ExportSceneAssbin(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
+void ExportSceneAssbin(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-    AssbinExport exporter;
+    const bool compressed = pProperties && pProperties->GetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_COMPRESSED );
+    const bool indexed = pProperties && pProperties->GetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_INDEXED );
+    const unsigned int numThreads = pProperties ? static_cast<unsigned int>(
+        std::max( 0, pProperties->GetPropertyInteger( AI_CONFIG_EXPORT_NUM_THREADS, 0 ) ) ) : 0u;
+    AssbinExport exporter( compressed, indexed, numThreads );
     exporter.WriteBinaryDump( pFile, pIOSystem, pScene );
 }
 } // end of namespace Assimp
@@ -52,10 +52,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssbinLoader.h"
 #include "assbin_chunks.h"
 #include "MemoryIOWrapper.h"
+#include "ParallelFor.h"
 #include <assimp/mesh.h>
 #include <assimp/anim.h>
 #include <assimp/scene.h>
 #include <assimp/importerdesc.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #   include <zlib.h>
@@ -78,6 +81,11 @@ static const aiImporterDesc desc = {
     "assbin"
 };
 
+AssbinImporter::AssbinImporter()
+    : shortened(false), compressed(false), lazy(false), numThreads(0), numDeferred(0), sceneFlags(0)
+{
+}
+
 const aiImporterDesc* AssbinImporter::GetInfo() const
 {
     return &desc;
@@ -297,7 +305,9 @@ void AssbinImporter::ReadBinaryBone( IOStream * stream, aiBone* b )
 }
 
 
-void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
+// -----------------------------------------------------------------------------------
+// Read the chunk header and the counts of a mesh, ASSBIN_MESH_HEADER_LENGTH bytes.
+void AssbinImporter::ReadBinaryMeshHeader( IOStream * stream, aiMesh* mesh )
 {
     uint32_t chunkID = Read<uint32_t>(stream);
     (void)(chunkID);
@@ -309,6 +319,12 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
     mesh->mNumFaces = Read<unsigned int>(stream);
     mesh->mNumBones = Read<unsigned int>(stream);
     mesh->mMaterialIndex = Read<unsigned int>(stream);
+}
+
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
+{
+    ReadBinaryMeshHeader( stream, mesh );
 
     // first of all, write bits for all existent vertex components
     unsigned int c = Read<unsigned int>(stream);
@@ -464,12 +480,15 @@ void AssbinImporter::ReadBinaryMaterial(IOStream * stream, aiMaterial* mat)
 }
 
 // -----------------------------------------------------------------------------------
-void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
+// With readKeys set to false only the name, the key counts and the states are
+// read, the stream is positioned after the chunk.
+void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd, bool readKeys)
 {
     uint32_t chunkID = Read<uint32_t>(stream);
     (void)(chunkID);
     ai_assert(chunkID == ASSBIN_CHUNK_AINODEANIM);
-    /*uint32_t size =*/ Read<uint32_t>(stream);
+    const uint32_t size = Read<uint32_t>(stream);
+    const size_t end = stream->Tell() + size;
 
     nd->mNodeName = Read<aiString>(stream);
     nd->mNumPositionKeys = Read<unsigned int>(stream);
@@ -478,6 +497,11 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
     nd->mPreState = (aiAnimBehaviour)Read<unsigned int>(stream);
     nd->mPostState = (aiAnimBehaviour)Read<unsigned int>(stream);
 
+    if (!readKeys) {
+        stream->Seek( end, aiOrigin_SET );
+        return;
+    }
+
     if (nd->mNumPositionKeys) {
         if (shortened) {
             ReadBounds(stream,nd->mPositionKeys,nd->mNumPositionKeys);
@@ -514,7 +538,9 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
 
 
 // -----------------------------------------------------------------------------------
-void AssbinImporter::ReadBinaryAnim( IOStream * stream, aiAnimation* anim )
+// The channels are reused if they exist already, i.e. if only their keys were
+// deferred before.
+void AssbinImporter::ReadBinaryAnim( IOStream * stream, aiAnimation* anim, bool readKeys )
 {
     uint32_t chunkID = Read<uint32_t>(stream);
     (void)(chunkID);
@@ -528,10 +554,14 @@ void AssbinImporter::ReadBinaryAnim( IOStream * stream, aiAnimation* anim )
 
     if (anim->mNumChannels)
     {
-        anim->mChannels = new aiNodeAnim*[ anim->mNumChannels ];
+        if (!anim->mChannels) {
+            anim->mChannels = new aiNodeAnim*[ anim->mNumChannels ];
+            for (unsigned int a = 0; a < anim->mNumChannels;++a) {
+                anim->mChannels[a] = new aiNodeAnim();
+            }
+        }
         for (unsigned int a = 0; a < anim->mNumChannels;++a) {
-            anim->mChannels[a] = new aiNodeAnim();
-            ReadBinaryNodeAnim(stream,anim->mChannels[a]);
+            ReadBinaryNodeAnim(stream,anim->mChannels[a],readKeys);
         }
     }
 }
@@ -606,7 +636,10 @@ void AssbinImporter::ReadBinaryCamera( IOStream * stream, aiCamera* cam )
     cam->mAspect = Read<float>(stream);
 }
 
-void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
+// -----------------------------------------------------------------------------------
+// With numBlocks given the meshes, animations and textures are only allocated, the
+// indexed layout stores their data in numBlocks - 1 blocks of their own.
+void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene, size_t numBlocks )
 {
     uint32_t chunkID = Read<uint32_t>(stream);
     (void)(chunkID);
@@ -621,6 +654,19 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
     scene->mNumLights     = Read<unsigned int>(stream);
     scene->mNumCameras    = Read<unsigned int>(stream);
 
+    // Check the counts before anything is allocated for them. Every object stored in
+    // the stream takes at least its chunk header.
+    const bool embeddedBlocks = 0 == numBlocks;
+    const uint64_t numStoredBlocks = static_cast<uint64_t>(scene->mNumMeshes) + scene->mNumAnimations + scene->mNumTextures;
+    const uint64_t numChunks = static_cast<uint64_t>(scene->mNumMaterials) + scene->mNumLights + scene->mNumCameras
+        + (embeddedBlocks ? numStoredBlocks : 0u);
+    if (numChunks > stream->FileSize() / 8) {
+        throw DeadlyImportError( "ASSBIN: invalid number of scene elements" );
+    }
+    if (!embeddedBlocks && numBlocks != 1u + numStoredBlocks) {
+        throw DeadlyImportError( "ASSBIN: number of blocks does not match the scene" );
+    }
+
     // Read node graph
     scene->mRootNode = new aiNode[1];
     ReadBinaryNode( stream, &scene->mRootNode, (aiNode*)NULL );
@@ -631,7 +677,14 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
         scene->mMeshes = new aiMesh*[scene->mNumMeshes];
         for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
             scene->mMeshes[i] = new aiMesh();
-            ReadBinaryMesh( stream,scene->mMeshes[i]);
+            if (embeddedBlocks && lazy) {
+                deferredMeshes.push_back( LocateChunk( stream ) );
+                ReadBinaryMeshHeader( stream, scene->mMeshes[i] );
+                stream->Seek( static_cast<size_t>(deferredMeshes.back().offset + deferredMeshes.back().size), aiOrigin_SET );
+            }
+            else if (embeddedBlocks) {
+                ReadBinaryMesh( stream,scene->mMeshes[i]);
+            }
         }
     }
 
@@ -651,7 +704,14 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
         scene->mAnimations = new aiAnimation*[scene->mNumAnimations];
         for (unsigned int i = 0; i < scene->mNumAnimations;++i) {
             scene->mAnimations[i] = new aiAnimation();
-            ReadBinaryAnim(stream,scene->mAnimations[i]);
+            if (embeddedBlocks && lazy) {
+                deferredAnimations.push_back( LocateChunk( stream ) );
+                ReadBinaryAnim( stream, scene->mAnimations[i], false );
+                stream->Seek( static_cast<size_t>(deferredAnimations.back().offset + deferredAnimations.back().size), aiOrigin_SET );
+            }
+            else if (embeddedBlocks) {
+                ReadBinaryAnim(stream,scene->mAnimations[i]);
+            }
         }
     }
 
@@ -661,7 +721,9 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
         scene->mTextures = new aiTexture*[scene->mNumTextures];
         for (unsigned int i = 0; i < scene->mNumTextures;++i) {
             scene->mTextures[i] = new aiTexture();
-            ReadBinaryTexture(stream,scene->mTextures[i]);
+            if (embeddedBlocks) {
+                ReadBinaryTexture(stream,scene->mTextures[i]);
+            }
         }
     }
 
@@ -687,8 +749,191 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 
 }
 
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadIndex( IOStream * stream, std::vector<IndexEntry>& index )
+{
+    if (Read<uint32_t>(stream) != ASSBIN_CHUNK_INDEX) {
+        throw DeadlyImportError( "ASSBIN: index table expected" );
+    }
+
+    const size_t fileSize = stream->FileSize();
+    const size_t numEntries = Read<uint32_t>(stream);
+    if (0 == numEntries || numEntries > fileSize / ASSBIN_INDEX_ENTRY_LENGTH) {
+        throw DeadlyImportError( "ASSBIN: invalid index table size" );
+    }
+    index.resize( numEntries );
+
+    for (IndexEntry& entry : index) {
+        entry.chunkID = Read<uint32_t>(stream);
+        entry.flags = Read<uint32_t>(stream);
+        entry.offset = Read<uint64_t>(stream);
+        entry.storedSize = Read<uint32_t>(stream);
+        entry.size = Read<uint32_t>(stream);
+
+        if (entry.offset > fileSize || entry.storedSize > fileSize - entry.offset) {
+            throw DeadlyImportError( "ASSBIN: block exceeds the file size" );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------------
+// Read the stored data of a block, still compressed if the block is. With maxSize
+// given only the beginning of the block is read.
+void AssbinImporter::ReadBlock( IOStream * stream, const IndexEntry& entry, std::vector<uint8_t>& data, size_t maxSize )
+{
+    data.resize( std::min<size_t>( entry.storedSize, maxSize ) );
+    if (aiReturn_SUCCESS != stream->Seek( static_cast<size_t>(entry.offset), aiOrigin_SET ) ||
+            (!data.empty() && stream->Read( &data[0], 1, data.size() ) != data.size())) {
+        throw DeadlyImportError( "ASSBIN: failed to read block data" );
+    }
+}
+
+// -----------------------------------------------------------------------------------
+// Inflate the first maxSize bytes (the whole block by default) of a compressed
+// block in place. Returns false if data holds only the beginning of the stored
+// block and that was not enough. Does not touch the importer state, so several
+// blocks may be decoded at the same time.
+bool AssbinImporter::DecodeBlock( const IndexEntry& entry, std::vector<uint8_t>& data, size_t maxSize )
+{
+    const size_t size = std::min<size_t>( entry.size, maxSize );
+    if (!(entry.flags & ASSBIN_BLOCK_DEFLATE)) {
+        if (entry.storedSize != entry.size || data.size() < size) {
+            throw DeadlyImportError( "ASSBIN: block size mismatch" );
+        }
+        data.resize( size );
+        return true;
+    }
+
+    std::vector<uint8_t> uncompressed( size );
+    z_stream zstream;
+    memset( &zstream, 0, sizeof(zstream) );
+    if (Z_OK != inflateInit( &zstream )) {
+        throw DeadlyImportError( "ASSBIN: failed to initialize zlib" );
+    }
+    zstream.next_in = data.data();
+    zstream.avail_in = static_cast<uInt>(data.size());
+    zstream.next_out = uncompressed.data();
+    zstream.avail_out = static_cast<uInt>(size);
+    const int ret = inflate( &zstream, Z_SYNC_FLUSH );
+    const size_t decoded = zstream.total_out;
+    inflateEnd( &zstream );
+
+    if (decoded != size || (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)) {
+        if (data.size() < entry.storedSize && ret != Z_DATA_ERROR) {
+            return false;
+        }
+        throw DeadlyImportError( "ASSBIN: failed to inflate block" );
+    }
+    data.swap( uncompressed );
+    return true;
+}
+
+// -----------------------------------------------------------------------------------
+// Read and inflate the first size bytes of a block. Only a part of the stored
+// data is read, unless it does not suffice.
+void AssbinImporter::ReadBlockHead( IOStream * stream, const IndexEntry& entry, size_t size, std::vector<uint8_t>& data )
+{
+    ReadBlock( stream, entry, data, (entry.flags & ASSBIN_BLOCK_DEFLATE) ? size + 4096 : size );
+    if (!DecodeBlock( entry, data, size )) {
+        ReadBlock( stream, entry, data );
+        DecodeBlock( entry, data, size );
+    }
+}
+
+// -----------------------------------------------------------------------------------
+// Record the location of the chunk at the current stream position. The plain
+// layout describes deferred chunks the same way as the blocks of the indexed layout.
+AssbinImporter::IndexEntry AssbinImporter::LocateChunk( IOStream * stream )
+{
+    IndexEntry entry;
+    entry.offset = stream->Tell();
+    entry.chunkID = Read<uint32_t>(stream);
+    entry.flags = 0;
+    entry.size = entry.storedSize = 8 + Read<uint32_t>(stream);
+    if (entry.offset + entry.size > stream->FileSize()) {
+        throw DeadlyImportError( "ASSBIN: chunk exceeds the file size" );
+    }
+    stream->Seek( static_cast<size_t>(entry.offset), aiOrigin_SET );
+    return entry;
+}
+
+// -----------------------------------------------------------------------------------
+// Read a scene in the indexed layout. Block 0 gives the scene structure, the
+// mesh, animation and texture blocks are then inflated and parsed in parallel.
+void AssbinImporter::ReadIndexedScene( IOStream * stream, aiScene* scene )
+{
+    std::vector<IndexEntry> index;
+    ReadIndex( stream, index );
+    if (index[0].chunkID != ASSBIN_CHUNK_AISCENE) {
+        throw DeadlyImportError( "ASSBIN: the first block must hold the scene" );
+    }
+
+    std::vector<std::vector<uint8_t> > blocks( index.size() );
+    ReadBlock( stream, index[0], blocks[0] );
+    DecodeBlock( index[0], blocks[0] );
+    {
+        MemoryIOStream io( blocks[0].data(), blocks[0].size() );
+        ReadBinaryScene( &io, scene, index.size() );
+    }
+    std::vector<uint8_t>().swap( blocks[0] );
+
+    for (size_t i = 1; i < index.size(); ++i) {
+        const uint32_t expected = i <= scene->mNumMeshes ? ASSBIN_CHUNK_AIMESH :
+            i <= scene->mNumMeshes + scene->mNumAnimations ? ASSBIN_CHUNK_AIANIMATION : ASSBIN_CHUNK_AITEXTURE;
+        if (index[i].chunkID != expected) {
+            throw DeadlyImportError( "ASSBIN: unexpected block type" );
+        }
+
+        if (lazy && expected == ASSBIN_CHUNK_AIMESH) {
+            // only the counts, the rest of the block is read by LoadDeferredMesh()
+            ReadBlockHead( stream, index[i], ASSBIN_MESH_HEADER_LENGTH, blocks[i] );
+            MemoryIOStream io( blocks[i].data(), blocks[i].size() );
+            ReadBinaryMeshHeader( &io, scene->mMeshes[i - 1] );
+            deferredMeshes.push_back( index[i] );
+            std::vector<uint8_t>().swap( blocks[i] );
+            continue;
+        }
+        if (lazy && expected == ASSBIN_CHUNK_AIANIMATION) {
+            // the channels are read now, their keys by LoadDeferredAnimation()
+            deferredAnimations.push_back( index[i] );
+        }
+        ReadBlock( stream, index[i], blocks[i] );
+    }
+    const size_t firstBlock = lazy ? 1u + scene->mNumMeshes : 1u;
+
+    ParallelFor( index.size() - firstBlock, numThreads, [&]( size_t item ) {
+        const size_t i = firstBlock + item;
+        DecodeBlock( index[i], blocks[i] );
+        MemoryIOStream io( blocks[i].data(), blocks[i].size() );
+        size_t n = i - 1;
+        if (n < scene->mNumMeshes) {
+            ReadBinaryMesh( &io, scene->mMeshes[n] );
+        }
+        else if ((n -= scene->mNumMeshes) < scene->mNumAnimations) {
+            ReadBinaryAnim( &io, scene->mAnimations[n], !lazy );
+        }
+        else {
+            ReadBinaryTexture( &io, scene->mTextures[n - scene->mNumAnimations] );
+        }
+        std::vector<uint8_t>().swap( blocks[i] );
+    } );
+}
+
+// -----------------------------------------------------------------------------------
+void AssbinImporter::SetupProperties( const Importer* pImp )
+{
+    lazy = pImp->GetPropertyBool( AI_CONFIG_IMPORT_ASSBIN_LAZY_LOADING, false );
+    numThreads = static_cast<unsigned int>( std::max( 0, pImp->GetPropertyInteger( AI_CONFIG_IMPORT_NUM_THREADS, 0 ) ) );
+}
+
+// -----------------------------------------------------------------------------------
 void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler )
 {
+    deferredFile = pFile;
+    deferredMeshes.clear();
+    deferredAnimations.clear();
+    numDeferred = 0;
+
     IOStream * stream = pIOHandler->Open(pFile,"rb");
     if (!stream)
         return;
@@ -701,7 +946,8 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
     /*unsigned int compileFlags =*/ Read<unsigned int>(stream);
 
     shortened = Read<uint16_t>(stream) > 0;
-    compressed = Read<uint16_t>(stream) > 0;
+    const uint16_t layout = Read<uint16_t>(stream);
+    compressed = layout != ASSBIN_LAYOUT_PLAIN;
 
     if (shortened)
         throw DeadlyImportError( "Shortened binaries are not supported!" );
@@ -710,31 +956,127 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
     stream->Seek( 128, aiOrigin_CUR ); // options
     stream->Seek( 64, aiOrigin_CUR ); // padding
 
-    if (compressed)
-    {
-        uLongf uncompressedSize = Read<uint32_t>(stream);
-        uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
+    if (lazy && layout == ASSBIN_LAYOUT_DEFLATE) {
+        DefaultLogger::get()->warn( "ASSBIN: lazy loading needs an uncompressed or an indexed file, loading everything" );
+        lazy = false;
+    }
 
-        unsigned char * compressedData = new unsigned char[ compressedSize ];
-        stream->Read( compressedData, 1, compressedSize );
+    try {
+        if (layout == ASSBIN_LAYOUT_INDEXED) {
+            ReadIndexedScene(stream,pScene);
+        }
+        else if (compressed)
+        {
+            uLongf uncompressedSize = Read<uint32_t>(stream);
+            uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
 
-        unsigned char * uncompressedData = new unsigned char[ uncompressedSize ];
+            std::vector<unsigned char> compressedData( compressedSize );
+            stream->Read( compressedData.data(), 1, compressedSize );
 
-        uncompress( uncompressedData, &uncompressedSize, compressedData, compressedSize );
+            std::vector<unsigned char> uncompressedData( uncompressedSize );
 
-        MemoryIOStream io( uncompressedData, uncompressedSize );
+            uncompress( uncompressedData.data(), &uncompressedSize, compressedData.data(), compressedSize );
 
-        ReadBinaryScene(&io,pScene);
+            MemoryIOStream io( uncompressedData.data(), uncompressedSize );
 
-        delete[] uncompressedData;
-        delete[] compressedData;
+            ReadBinaryScene(&io,pScene);
+        }
+        else
+        {
+            ReadBinaryScene(stream,pScene);
+        }
     }
-    else
-    {
-        ReadBinaryScene(stream,pScene);
+    catch (...) {
+        pIOHandler->Close(stream);
+        throw;
     }
 
     pIOHandler->Close(stream);
+
+    numDeferred = deferredMeshes.size() + deferredAnimations.size();
+    if (numDeferred) {
+        sceneFlags = pScene->mFlags;
+        pScene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
+    }
+}
+
+// -----------------------------------------------------------------------------------
+// Read a deferred chunk from the file again and inflate it
+void AssbinImporter::ReadDeferredChunk( IOSystem* pIOHandler, const IndexEntry& entry, std::vector<uint8_t>& data )
+{
+    IOStream * stream = pIOHandler->Open( deferredFile, "rb" );
+    if (!stream) {
+        throw DeadlyImportError( "ASSBIN: failed to reopen " + deferredFile );
+    }
+    try {
+        ReadBlock( stream, entry, data );
+    }
+    catch (...) {
+        pIOHandler->Close( stream );
+        throw;
+    }
+    pIOHandler->Close( stream );
+    DecodeBlock( entry, data );
+}
+
+// -----------------------------------------------------------------------------------
+// Count a loaded chunk, the scene is complete again once nothing is deferred
+void AssbinImporter::OnDeferredLoaded( aiScene* pScene, IndexEntry& entry )
+{
+    entry.chunkID = 0;
+    if (0 == --numDeferred) {
+        pScene->mFlags = sceneFlags;
+    }
+}
+
+// -----------------------------------------------------------------------------------
+bool AssbinImporter::LoadDeferredMesh( aiScene* pScene, IOSystem* pIOHandler, unsigned int index )
+{
+    if (index >= deferredMeshes.size() || !deferredMeshes[index].chunkID) {
+        return true;
+    }
+
+    std::vector<uint8_t> data;
+    ReadDeferredChunk( pIOHandler, deferredMeshes[index], data );
+    MemoryIOStream io( data.data(), data.size() );
+    ReadBinaryMesh( &io, pScene->mMeshes[index] );
+
+    OnDeferredLoaded( pScene, deferredMeshes[index] );
+    return true;
+}
+
+// -----------------------------------------------------------------------------------
+bool AssbinImporter::LoadDeferredAnimation( aiScene* pScene, IOSystem* pIOHandler, unsigned int index )
+{
+    if (index >= deferredAnimations.size() || !deferredAnimations[index].chunkID) {
+        return true;
+    }
+
+    std::vector<uint8_t> data;
+    ReadDeferredChunk( pIOHandler, deferredAnimations[index], data );
+    MemoryIOStream io( data.data(), data.size() );
+    ReadBinaryAnim( &io, pScene->mAnimations[index] );
+
+    OnDeferredLoaded( pScene, deferredAnimations[index] );
+    return true;
+}
+
+// -----------------------------------------------------------------------------------
+bool AssbinImporter::HasDeferredData() const
+{
+    return numDeferred != 0;
+}
+
+// -----------------------------------------------------------------------------------
+bool AssbinImporter::IsMeshDeferred( unsigned int index ) const
+{
+    return index < deferredMeshes.size() && deferredMeshes[index].chunkID;
+}
+
+// -----------------------------------------------------------------------------------
+bool AssbinImporter::IsAnimationDeferred( unsigned int index ) const
+{
+    return index < deferredAnimations.size() && deferredAnimations[index].chunkID;
 }
 
 #endif // !! ASSIMP_BUILD_NO_ASSBIN_IMPORTER
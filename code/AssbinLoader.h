@@ -48,6 +48,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseImporter.h"
 
+#include <string>
+#include <vector>
+
 struct aiMesh;
 struct aiNode;
 struct aiBone;
@@ -71,27 +74,63 @@ class AssbinImporter : public BaseImporter
 private:
   bool shortened;
   bool compressed;
+  bool lazy;
+  unsigned int numThreads;
+
+  /** Entry of the index table of the indexed layout, see assbin_chunks.h */
+  struct IndexEntry {
+    uint32_t chunkID;
+    uint32_t flags;
+    uint64_t offset;
+    uint32_t storedSize;
+    uint32_t size;
+  };
+
+  /** State of a scene read with AI_CONFIG_IMPORT_ASSBIN_LAZY_LOADING: location
+   *  of the deferred meshes and animations, chunkID is 0 once loaded. */
+  std::string deferredFile;
+  std::vector<IndexEntry> deferredMeshes;
+  std::vector<IndexEntry> deferredAnimations;
+  size_t numDeferred;
+  unsigned int sceneFlags;
 
 public:
+  AssbinImporter();
+
   virtual bool CanRead(
     const std::string& pFile,
     IOSystem* pIOHandler,
     bool checkSig
     ) const;
   virtual const aiImporterDesc* GetInfo() const;
+  virtual void SetupProperties( const Importer* pImp );
+  virtual bool LoadDeferredMesh( aiScene* pScene, IOSystem* pIOHandler, unsigned int index );
+  virtual bool LoadDeferredAnimation( aiScene* pScene, IOSystem* pIOHandler, unsigned int index );
+  virtual bool HasDeferredData() const;
+  virtual bool IsMeshDeferred( unsigned int index ) const;
+  virtual bool IsAnimationDeferred( unsigned int index ) const;
   virtual void InternReadFile(
     const std::string& pFile,
     aiScene* pScene,
     IOSystem* pIOHandler
     );
-  void ReadBinaryScene( IOStream * stream, aiScene* pScene );
+  void ReadBinaryScene( IOStream * stream, aiScene* pScene, size_t numBlocks = 0 );
+  void ReadIndexedScene( IOStream * stream, aiScene* pScene );
+  void ReadIndex( IOStream * stream, std::vector<IndexEntry>& index );
+  void ReadBlock( IOStream * stream, const IndexEntry& entry, std::vector<uint8_t>& data, size_t maxSize = ~size_t(0) );
+  bool DecodeBlock( const IndexEntry& entry, std::vector<uint8_t>& data, size_t maxSize = ~size_t(0) );
+  void ReadBlockHead( IOStream * stream, const IndexEntry& entry, size_t size, std::vector<uint8_t>& data );
+  IndexEntry LocateChunk( IOStream * stream );
+  void ReadDeferredChunk( IOSystem* pIOHandler, const IndexEntry& entry, std::vector<uint8_t>& data );
+  void OnDeferredLoaded( aiScene* pScene, IndexEntry& entry );
   void ReadBinaryNode( IOStream * stream, aiNode** mRootNode, aiNode* parent );
+  void ReadBinaryMeshHeader( IOStream * stream, aiMesh* mesh );
   void ReadBinaryMesh( IOStream * stream, aiMesh* mesh );
   void ReadBinaryBone( IOStream * stream, aiBone* bone );
   void ReadBinaryMaterial(IOStream * stream, aiMaterial* mat);
   void ReadBinaryMaterialProperty(IOStream * stream, aiMaterialProperty* prop);
-  void ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd);
-  void ReadBinaryAnim( IOStream * stream, aiAnimation* anim );
+  void ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd, bool readKeys = true);
+  void ReadBinaryAnim( IOStream * stream, aiAnimation* anim, bool readKeys = true );
   void ReadBinaryTexture(IOStream * stream, aiTexture* tex);
   void ReadBinaryLight( IOStream * stream, aiLight* l );
   void ReadBinaryCamera( IOStream * stream, aiCamera* cam );
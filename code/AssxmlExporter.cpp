@@ -44,6 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdarg.h>
 #include <assimp/version.h>
 #include "ProcessHelper.h"
+#include "fast_ftoa.h"
+#include "StringUtils.h"
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
@@ -87,6 +89,40 @@ static int ioprintf( IOStream * io, const char *format, ... ) {
     return nSize;
 }
 
+// -----------------------------------------------------------------------------------
+// Writes vertex data, one vertex per line, formatted like ioprintf() with "\t\t%0 8f %0 8f ..."
+// would do: six decimal places and a space in place of the plus sign. Called for the bulk
+// of a dump, so the lines are formatted with fast_ftoa_fixed() and written in blocks.
+static void WriteFixedLines( IOStream * io, const ai_real *values, unsigned int numLines,
+        unsigned int numComponents, unsigned int stride ) {
+    static const size_t Size = 4096;
+    const size_t maxLineSize = 3 + numComponents * ( AI_FTOA_MAX_CHARS + 2 );
+    ai_assert( maxLineSize <= Size );
+
+    char sz[ Size ];
+    char *out = sz;
+    for ( unsigned int n = 0; n < numLines; ++n, values += stride ) {
+        if ( static_cast<size_t>( out - sz ) + maxLineSize > Size ) {
+            io->Write( sz, sizeof(char), out - sz );
+            out = sz;
+        }
+
+        *out++ = '\t';
+        *out++ = '\t';
+        for ( unsigned int i = 0; i < numComponents; ++i ) {
+            if ( i > 0 ) {
+                *out++ = ' ';
+            }
+            if ( !std::signbit( values[ i ] ) ) {
+                *out++ = ' ';
+            }
+            out = fast_ftoa_fixed( values[ i ], 6, out );
+        }
+        *out++ = '\n';
+    }
+    io->Write( sz, sizeof(char), out - sz );
+}
+
 // -----------------------------------------------------------------------------------
 // Convert a name to standard XML format
 static void ConvertName(aiString& out, const aiString& in) {
@@ -182,8 +218,10 @@ static std::string encodeXML(const std::string& data) {
 static
 void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
     time_t tt = ::time( NULL );
-    tm* p     = ::gmtime( &tt );
-    ai_assert( nullptr != p );
+    tm t = tm();
+    const bool ok( ai_gmtime( &tt, &t ) );
+    ai_assert( ok );
+    (void)(ok);
 
     // write header
     std::string header(
@@ -200,7 +238,8 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
     const unsigned int majorVersion( aiGetVersionMajor() );
     const unsigned int minorVersion( aiGetVersionMinor() );
     const unsigned int rev( aiGetVersionRevision() );
-    const char *curtime( asctime( p ) );
+    char buffer[ 26 ];
+    const char *curtime( ai_asctime( &t, buffer ) );
     ioprintf( io, header.c_str(), majorVersion, minorVersion, rev, curtime, scene->mFlags, 0 );
 
     // write the node graph
@@ -527,12 +566,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
             if (mesh->HasPositions()) {
                 ioprintf(io,"\t\t<Positions num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
-                    for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mVertices[n].x,
-                            mesh->mVertices[n].y,
-                            mesh->mVertices[n].z);
-                    }
+                    WriteFixedLines(io,&mesh->mVertices->x,mesh->mNumVertices,3,3);
                 }
                 ioprintf(io,"\t\t</Positions>\n");
             }
@@ -541,12 +575,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
             if (mesh->HasNormals()) {
                 ioprintf(io,"\t\t<Normals num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
-                    for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mNormals[n].x,
-                            mesh->mNormals[n].y,
-                            mesh->mNormals[n].z);
-                    }
+                    WriteFixedLines(io,&mesh->mNormals->x,mesh->mNumVertices,3,3);
                 }
                 else {
                 }
@@ -557,23 +586,13 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
             if (mesh->HasTangentsAndBitangents()) {
                 ioprintf(io,"\t\t<Tangents num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
-                    for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mTangents[n].x,
-                            mesh->mTangents[n].y,
-                            mesh->mTangents[n].z);
-                    }
+                    WriteFixedLines(io,&mesh->mTangents->x,mesh->mNumVertices,3,3);
                 }
                 ioprintf(io,"\t\t</Tangents>\n");
 
                 ioprintf(io,"\t\t<Bitangents num=\"%i\" set=\"0\" num_components=\"3\"> \n",mesh->mNumVertices);
                 if (!shortened) {
-                    for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                            mesh->mBitangents[n].x,
-                            mesh->mBitangents[n].y,
-                            mesh->mBitangents[n].z);
-                    }
+                    WriteFixedLines(io,&mesh->mBitangents->x,mesh->mNumVertices,3,3);
                 }
                 ioprintf(io,"\t\t</Bitangents>\n");
             }
@@ -587,21 +606,8 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                     a,mesh->mNumUVComponents[a]);
 
                 if (!shortened) {
-                    if (mesh->mNumUVComponents[a] == 3) {
-                        for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                            ioprintf(io,"\t\t%0 8f %0 8f %0 8f\n",
-                                mesh->mTextureCoords[a][n].x,
-                                mesh->mTextureCoords[a][n].y,
-                                mesh->mTextureCoords[a][n].z);
-                        }
-                    }
-                    else {
-                        for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                            ioprintf(io,"\t\t%0 8f %0 8f\n",
-                                mesh->mTextureCoords[a][n].x,
-                                mesh->mTextureCoords[a][n].y);
-                        }
-                    }
+                    WriteFixedLines(io,&mesh->mTextureCoords[a]->x,mesh->mNumVertices,
+                        mesh->mNumUVComponents[a] == 3 ? 3 : 2,3);
                 }
                 ioprintf(io,"\t\t</TextureCoords>\n");
             }
@@ -612,13 +618,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened) {
                     break;
                 ioprintf(io,"\t\t<Colors num=\"%i\" set=\"%i\" num_components=\"4\"> \n",mesh->mNumVertices,a);
                 if (!shortened) {
-                    for (unsigned int n = 0; n < mesh->mNumVertices; ++n) {
-                        ioprintf(io,"\t\t%0 8f %0 8f %0 8f %0 8f\n",
-                            mesh->mColors[a][n].r,
-                            mesh->mColors[a][n].g,
-                            mesh->mColors[a][n].b,
-                            mesh->mColors[a][n].a);
-                    }
+                    WriteFixedLines(io,&mesh->mColors[a]->r,mesh->mNumVertices,4,4);
                 }
                 ioprintf(io,"\t\t</Colors>\n");
             }
@@ -0,0 +1,304 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Base64.h
+ *  @brief Fast base64 decoding, used for data URIs in glTF files.
+ *
+ *  The decoder processes four characters per step with a single table lookup
+ *  each. On x86 and x64, blocks of 16 or 32 characters are decoded with SSSE3
+ *  or AVX2 instructions instead if the CPU supports them. The SIMD paths are
+ *  compiled with function target attributes and selected at runtime through
+ *  cpuid, so no -m or /arch flags are needed. All variants produce the same
+ *  output.
+ */
+#ifndef AI_BASE64_H_INC
+#define AI_BASE64_H_INC
+
+#include <assimp/ai_assert.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   define AI_BASE64_USE_SIMD
+#   define AI_BASE64_TARGET(isa)
+#   include <intrin.h>
+#   include <immintrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define AI_BASE64_USE_SIMD
+#   define AI_BASE64_TARGET(isa) __attribute__((target(isa)))
+#   include <immintrin.h>
+#endif
+
+namespace Assimp {
+namespace Base64 {
+
+// ---------------------------------------------------------------------------
+/** Returns the lookup table mapping a character to its 6 bit value.
+ *  '=' maps to 64, all other invalid characters map to 0. */
+inline const uint8_t* DecodeTable() {
+    static const uint8_t table[256] = {
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 62,  0,  0,  0, 63,
+        52, 53, 54, 55, 56, 57, 58, 59, 60, 61,  0,  0,  0, 64,  0,  0,
+         0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,  0,  0,  0,  0,  0,
+         0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0
+    };
+    return table;
+}
+
+// ---------------------------------------------------------------------------
+/** Returns the number of bytes encoded by a base64 string.
+ *  @param in        The base64 characters.
+ *  @param inLength  Number of characters, should be a multiple of 4. */
+inline size_t DecodedLength(const char* in, size_t inLength) {
+    inLength -= inLength % 4;
+    if (inLength < 4) {
+        return 0;
+    }
+
+    const size_t nEquals = size_t(in[inLength - 1] == '=') + size_t(in[inLength - 2] == '=');
+    return (inLength / 4) * 3 - nEquals;
+}
+
+#ifdef AI_BASE64_USE_SIMD
+enum SimdLevel {
+    SimdLevel_None,
+    SimdLevel_SSSE3,
+    SimdLevel_AVX2
+};
+
+// ---------------------------------------------------------------------------
+// Queries the instruction sets supported by the CPU (and, for AVX2, the OS).
+inline SimdLevel DetectSimdLevel() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool ssse3 = (info[2] & (1 << 9)) != 0;
+    const bool osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osAvx) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool ssse3 = __builtin_cpu_supports("ssse3") != 0;
+    const bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+    return avx2 ? SimdLevel_AVX2 : (ssse3 ? SimdLevel_SSSE3 : SimdLevel_None);
+}
+
+// ---------------------------------------------------------------------------
+// Returns the detected instruction set, the query runs only once.
+inline SimdLevel GetSimdLevel() {
+    static const SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+// ---------------------------------------------------------------------------
+// Decodes 16 characters into 12 bytes, but writes 16 bytes. Returns false
+// and writes nothing if the block contains padding or invalid characters.
+// See W. Mula, D. Lemire: "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions" for a description of the lookups.
+AI_BASE64_TARGET("ssse3")
+inline bool DecodeBlockSSSE3(const char* in, uint8_t* out) {
+    const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+    const __m128i loNibbles = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+
+    // validate, each valid character has no bit in common in both lookups
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+    const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128()))) {
+        return false;
+    }
+
+    // translate to 6 bit values, '/' is the only character needing special care
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i eq2F = _mm_cmpeq_epi8(input, _mm_set1_epi8(0x2f));
+    const __m128i values = _mm_add_epi8(input, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles)));
+
+    // pack four 6 bit values into 24 bits and bring the bytes into order
+    const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)),
+                                          _mm_set1_epi32(0x00011000));
+    const __m128i packed = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Same as DecodeBlockSSSE3, but for 32 characters into 24 bytes (writes 32 bytes).
+AI_BASE64_TARGET("avx2")
+inline bool DecodeBlockAVX2(const char* in, uint8_t* out) {
+    const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), _mm256_set1_epi8(0x0f));
+    const __m256i loNibbles = _mm256_and_si256(input, _mm256_set1_epi8(0x0f));
+
+    const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                           0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                           0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+    const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+    if (!_mm256_testz_si256(lo, hi)) {
+        return false;
+    }
+
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i eq2F = _mm256_cmpeq_epi8(input, _mm256_set1_epi8(0x2f));
+    const __m256i values = _mm256_add_epi8(input, _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles)));
+
+    const __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+                                             _mm256_set1_epi32(0x00011000));
+    __m256i packed = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                                  2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    // close the gap between the two 128 bit lanes
+    packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Decodes as many 32 character blocks with AVX2 as possible, the loop has to
+// live in a function compiled for AVX2 so the block decoder can be inlined.
+AI_BASE64_TARGET("avx2")
+inline void DecodeBlocksAVX2(const char* in, size_t bodyLength, uint8_t* out, size_t outLength, size_t& i, size_t& j) {
+    while (i + 32 <= bodyLength && j + 32 <= outLength && DecodeBlockAVX2(in + i, out + j)) {
+        i += 32;
+        j += 24;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Same as DecodeBlocksAVX2 for 16 character blocks with SSSE3.
+AI_BASE64_TARGET("ssse3")
+inline void DecodeBlocksSSSE3(const char* in, size_t bodyLength, uint8_t* out, size_t outLength, size_t& i, size_t& j) {
+    while (i + 16 <= bodyLength && j + 16 <= outLength && DecodeBlockSSSE3(in + i, out + j)) {
+        i += 16;
+        j += 12;
+    }
+}
+#endif // AI_BASE64_USE_SIMD
+
+// ---------------------------------------------------------------------------
+/** Decodes a base64 string.
+ *  @param in        The base64 characters.
+ *  @param inLength  Number of characters, should be a multiple of 4.
+ *  @param out       Receives the data, must hold DecodedLength(in, inLength) bytes.
+ *  @return The number of bytes written. */
+inline size_t Decode(const char* in, size_t inLength, uint8_t* out) {
+    ai_assert(inLength % 4 == 0);
+
+    const size_t outLength = DecodedLength(in, inLength);
+    if (!outLength) {
+        return 0;
+    }
+    inLength -= inLength % 4;
+
+    // the last four characters may contain padding, they are handled separately
+    const size_t bodyLength = inLength - 4;
+    size_t i = 0, j = 0;
+
+#ifdef AI_BASE64_USE_SIMD
+    const SimdLevel simd = GetSimdLevel();
+    if (simd >= SimdLevel_AVX2) {
+        DecodeBlocksAVX2(in, bodyLength, out, outLength, i, j);
+    }
+    if (simd >= SimdLevel_SSSE3) {
+        DecodeBlocksSSSE3(in, bodyLength, out, outLength, i, j);
+    }
+#endif
+
+    const uint8_t* table = DecodeTable();
+    for (; i < bodyLength; i += 4) {
+        const uint32_t v = (uint32_t(table[uint8_t(in[i    ])]) << 18) |
+                           (uint32_t(table[uint8_t(in[i + 1])]) << 12) |
+                           (uint32_t(table[uint8_t(in[i + 2])]) <<  6) |
+                            uint32_t(table[uint8_t(in[i + 3])]);
+        out[j    ] = uint8_t(v >> 16);
+        out[j + 1] = uint8_t(v >> 8);
+        out[j + 2] = uint8_t(v);
+        j += 3;
+    }
+
+    const uint8_t b0 = table[uint8_t(in[i    ])];
+    const uint8_t b1 = table[uint8_t(in[i + 1])];
+    const uint8_t b2 = table[uint8_t(in[i + 2])];
+    const uint8_t b3 = table[uint8_t(in[i + 3])];
+
+    out[j++] = uint8_t((b0 << 2) | (b1 >> 4));
+    if (b2 < 64 && j < outLength) out[j++] = uint8_t((b1 << 4) | (b2 >> 2));
+    if (b3 < 64 && j < outLength) out[j++] = uint8_t((b2 << 6) | b3);
+
+    // misplaced padding characters leave bytes undefined otherwise
+    while (j < outLength) {
+        out[j++] = 0;
+    }
+
+    return outLength;
+}
+
+} // Namespace Base64
+} // Namespace Assimp
+
+#endif // AI_BASE64_H_INC
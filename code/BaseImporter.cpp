@@ -113,6 +113,39 @@ void BaseImporter::SetupProperties(const Importer* /*pImp*/)
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseImporter::LoadDeferredMesh(aiScene* /*pScene*/, IOSystem* /*pIOHandler*/, unsigned int /*index*/)
+{
+    // the default implementation defers nothing
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseImporter::LoadDeferredAnimation(aiScene* /*pScene*/, IOSystem* /*pIOHandler*/, unsigned int /*index*/)
+{
+    // the default implementation defers nothing
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseImporter::HasDeferredData() const
+{
+    // the default implementation defers nothing
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseImporter::IsMeshDeferred(unsigned int /*index*/) const
+{
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseImporter::IsAnimationDeferred(unsigned int /*index*/) const
+{
+    return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseImporter::GetExtensionList(std::set<std::string>& extensions)
 {
@@ -157,6 +157,61 @@ public:
         const Importer* pImp
         );
 
+    // -------------------------------------------------------------------
+    /** Called by #Importer::LoadMeshData to load the data of a mesh of
+     * the scene last returned by ReadFile() which InternReadFile() deferred.
+     * The default implementation does nothing, nothing is ever deferred.
+     * @param pScene The scene returned by the last ReadFile() call
+     * @param pIOHandler IO-Handler to reopen the file with
+     * @param index Index of the mesh in aiScene::mMeshes
+     * @return true if the mesh data is available now
+     */
+    virtual bool LoadDeferredMesh(
+        aiScene* pScene,
+        IOSystem* pIOHandler,
+        unsigned int index
+        );
+
+    // -------------------------------------------------------------------
+    /** Called by #Importer::LoadAnimationData, see LoadDeferredMesh().
+     * @param pScene The scene returned by the last ReadFile() call
+     * @param pIOHandler IO-Handler to reopen the file with
+     * @param index Index of the animation in aiScene::mAnimations
+     * @return true if the animation data is available now
+     */
+    virtual bool LoadDeferredAnimation(
+        aiScene* pScene,
+        IOSystem* pIOHandler,
+        unsigned int index
+        );
+
+    // -------------------------------------------------------------------
+    /** Returns whether the scene last returned by ReadFile() still lacks
+     * data which InternReadFile() deferred. Post-processing is refused
+     * until it is loaded. The default implementation returns false.
+     */
+    virtual bool HasDeferredData() const;
+
+    // -------------------------------------------------------------------
+    /** Returns whether the data of a mesh of the scene last returned by
+     * ReadFile() is still deferred. Such meshes are preprocessed once
+     * #Importer::LoadMeshData loads them. The default implementation
+     * returns false.
+     * @param index Index of the mesh in aiScene::mMeshes
+     */
+    virtual bool IsMeshDeferred(
+        unsigned int index
+        ) const;
+
+    // -------------------------------------------------------------------
+    /** Returns whether the data of an animation is still deferred, see
+     * IsMeshDeferred().
+     * @param index Index of the animation in aiScene::mAnimations
+     */
+    virtual bool IsAnimationDeferred(
+        unsigned int index
+        ) const;
+
     // -------------------------------------------------------------------
     /** Called by #Importer::GetImporterInfo to get a description of
      *  some loader features. Importers must provide this information. */
@@ -314,29 +314,34 @@ void DNA :: AddPrimitiveStructures()
     indices["int"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "int";
+    structures.back().primitive = Structure::Primitive_Int;
     structures.back().size = 4;
 
     indices["short"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "short";
+    structures.back().primitive = Structure::Primitive_Short;
     structures.back().size = 2;
 
 
     indices["char"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "char";
+    structures.back().primitive = Structure::Primitive_Char;
     structures.back().size = 1;
 
 
     indices["float"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "float";
+    structures.back().primitive = Structure::Primitive_Float;
     structures.back().size = 4;
 
 
     indices["double"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "double";
+    structures.back().primitive = Structure::Primitive_Double;
     structures.back().size = 8;
 
     // no long, seemingly.
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 #include <memory>
 #include <map>
+#include <unordered_map>
 
 // enable verbose log output. really verbose, so be careful.
 #ifdef ASSIMP_BUILD_DEBUG
@@ -214,8 +215,19 @@ class Structure {
     template <template <typename> class> friend class ObjectCache;
 
 public:
+    /** Primitive data types, see DNA::AddPrimitiveStructures */
+    enum Primitive {
+        Primitive_None,
+        Primitive_Int,
+        Primitive_Short,
+        Primitive_Char,
+        Primitive_Float,
+        Primitive_Double
+    };
+
     Structure()
-    : cache_idx(static_cast<size_t>(-1) ){
+    : primitive(Primitive_None)
+    , cache_idx(static_cast<size_t>(-1) ){
         // empty
     }
 
@@ -228,6 +240,10 @@ public:
 
     size_t size;
 
+    /** Set for the dummy structures of primitive data types, so
+     *  the primitive converters don't need to compare names */
+    Primitive primitive;
+
 public:
 
     // --------------------------------------------------------
@@ -310,6 +326,16 @@ public:
 
 private:
 
+    // --------------------------------------------------------
+    /** Look up a field and the structure of its type for one of the
+     *  ReadFieldXXX functions. The result is cached by the address of
+     *  the name, which is a literal in all converters, so the lookups
+     *  by string only happen once per field and structure. Raises an
+     *  error if there is no such field, @c type is NULL if the DNA
+     *  has no structure for the type of the field (i.e. void). */
+    inline const Field& LookupField(const char* name, const FileDatabase& db,
+        const Structure*& type) const;
+
     // --------------------------------------------------------
     template <template <typename> class TOUT, typename T>
     bool ResolvePointer(TOUT<T>& out, const Pointer & ptrval,
@@ -373,6 +399,13 @@ private:
 private:
 
     mutable size_t cache_idx;
+
+    // field lookups by name literal, the field is NULL if there is none
+    struct CachedField {
+        const Field* field;
+        const Structure* type;
+    };
+    mutable std::unordered_map<const char*, CachedField> field_cache;
 };
 
 // --------------------------------------------------------
@@ -84,6 +84,28 @@ const Field& Structure :: operator [] (const size_t i) const
     return fields[i];
 }
 
+//--------------------------------------------------------------------------------
+const Field& Structure :: LookupField(const char* name, const FileDatabase& db,
+    const Structure*& type) const
+{
+    std::unordered_map<const char*, CachedField>::const_iterator it = field_cache.find(name);
+    if (it == field_cache.end()) {
+        CachedField cached;
+        cached.field = Get(name);
+        cached.type = cached.field ? db.dna.Get(cached.field->type) : NULL;
+        it = field_cache.insert(std::make_pair(name,cached)).first;
+    }
+
+    if (!(*it).second.field) {
+        throw Error((Formatter::format(),
+            "BlendDNA: Did not find a field named `",name,"` in structure `",this->name,"`"
+            ));
+    }
+
+    type = (*it).second.type;
+    return *(*it).second.field;
+}
+
 //--------------------------------------------------------------------------------
 template <typename T> std::shared_ptr<ElemBase> Structure :: Allocate() const
 {
@@ -104,8 +126,9 @@ void Structure :: ReadFieldArray(T (& out)[M], const char* name, const FileDatab
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Structure* type;
+        const Field& f = LookupField(name,db,type);
+        const Structure& s = type ? *type : db.dna[f.type];
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -143,8 +166,9 @@ void Structure :: ReadFieldArray2(T (& out)[M][N], const char* name, const FileD
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Structure* type;
+        const Field& f = LookupField(name,db,type);
+        const Structure& s = type ? *type : db.dna[f.type];
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -191,7 +215,8 @@ bool Structure :: ReadFieldPtr(TOUT<T>& out, const char* name, const FileDatabas
     Pointer ptrval;
     const Field* f;
     try {
-        f = &(*this)[name];
+        const Structure* type;
+        f = &LookupField(name,db,type);
 
         // sanity check, should never happen if the genblenddna script is right
         if (!(f->flags & FieldFlag_Pointer)) {
@@ -236,7 +261,8 @@ bool Structure :: ReadFieldPtr(TOUT<T> (&out)[N], const char* name,
     Pointer ptrval[N];
     const Field* f;
     try {
-        f = &(*this)[name];
+        const Structure* type;
+        f = &LookupField(name,db,type);
 
         // sanity check, should never happen if the genblenddna script is right
         if ((FieldFlag_Pointer|FieldFlag_Pointer) != (f->flags & (FieldFlag_Pointer|FieldFlag_Pointer))) {
@@ -286,9 +312,10 @@ void Structure :: ReadField(T& out, const char* name, const FileDatabase& db) co
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        // find the structure definition pertaining to this field
-        const Structure& s = db.dna[f.type];
+        // find the field and the structure definition pertaining to it
+        const Structure* type;
+        const Field& f = LookupField(name,db,type);
+        const Structure& s = type ? *type : db.dna[f.type];
 
         db.reader->IncPtr(f.offset);
         s.Convert(out,db);
@@ -558,22 +585,23 @@ template <> struct static_cast_silent<double> {
 // ------------------------------------------------------------------------------------------------
 template <typename T> inline void ConvertDispatcher(T& out, const Structure& in,const FileDatabase& db)
 {
-    if (in.name == "int") {
+    switch (in.primitive) {
+    case Structure::Primitive_Int:
         out = static_cast_silent<T>()(db.reader->GetU4());
-    }
-    else if (in.name == "short") {
+        break;
+    case Structure::Primitive_Short:
         out = static_cast_silent<T>()(db.reader->GetU2());
-    }
-    else if (in.name == "char") {
+        break;
+    case Structure::Primitive_Char:
         out = static_cast_silent<T>()(db.reader->GetU1());
-    }
-    else if (in.name == "float") {
+        break;
+    case Structure::Primitive_Float:
         out = static_cast<T>(db.reader->GetF4());
-    }
-    else if (in.name == "double") {
+        break;
+    case Structure::Primitive_Double:
         out = static_cast<T>(db.reader->GetF8());
-    }
-    else {
+        break;
+    default:
         throw DeadlyImportError("Unknown source for conversion to primitive data type: "+in.name);
     }
 }
@@ -588,7 +616,7 @@ template <> inline void Structure :: Convert<int>    (int& dest,const FileDataba
 template<> inline void Structure :: Convert<short>  (short& dest,const FileDatabase& db) const
 {
     // automatic rescaling from short to float and vice versa (seems to be used by normals)
-    if (name == "float") {
+    if (primitive == Primitive_Float) {
         float f = db.reader->GetF4();
         if ( f > 1.0f )
             f = 1.0f;
@@ -596,7 +624,7 @@ template<> inline void Structure :: Convert<short>  (short& dest,const FileDatab
         //db.reader->IncPtr(-4);
         return;
     }
-    else if (name == "double") {
+    else if (primitive == Primitive_Double) {
         dest = static_cast<short>(db.reader->GetF8() * 32767.);
         //db.reader->IncPtr(-8);
         return;
@@ -608,11 +636,11 @@ template<> inline void Structure :: Convert<short>  (short& dest,const FileDatab
 template <> inline void Structure :: Convert<char>   (char& dest,const FileDatabase& db) const
 {
     // automatic rescaling from char to float and vice versa (seems useful for RGB colors)
-    if (name == "float") {
+    if (primitive == Primitive_Float) {
         dest = static_cast<char>(db.reader->GetF4() * 255.f);
         return;
     }
-    else if (name == "double") {
+    else if (primitive == Primitive_Double) {
         dest = static_cast<char>(db.reader->GetF8() * 255.f);
         return;
     }
@@ -623,11 +651,11 @@ template <> inline void Structure :: Convert<char>   (char& dest,const FileDatab
 template <> inline void Structure::Convert<unsigned char>(unsigned char& dest, const FileDatabase& db) const
 {
 	// automatic rescaling from char to float and vice versa (seems useful for RGB colors)
-	if (name == "float") {
+	if (primitive == Primitive_Float) {
 		dest = static_cast<unsigned char>(db.reader->GetF4() * 255.f);
 		return;
 	}
-	else if (name == "double") {
+	else if (primitive == Primitive_Double) {
 		dest = static_cast<unsigned char>(db.reader->GetF8() * 255.f);
 		return;
 	}
@@ -639,12 +667,12 @@ template <> inline void Structure::Convert<unsigned char>(unsigned char& dest, c
 template <> inline void Structure :: Convert<float>  (float& dest,const FileDatabase& db) const
 {
     // automatic rescaling from char to float and vice versa (seems useful for RGB colors)
-    if (name == "char") {
+    if (primitive == Primitive_Char) {
         dest = db.reader->GetI1() / 255.f;
         return;
     }
     // automatic rescaling from short to float and vice versa (used by normals)
-    else if (name == "short") {
+    else if (primitive == Primitive_Short) {
         dest = db.reader->GetI2() / 32767.f;
         return;
     }
@@ -654,11 +682,11 @@ template <> inline void Structure :: Convert<float>  (float& dest,const FileData
 // ------------------------------------------------------------------------------------------------
 template <> inline void Structure :: Convert<double> (double& dest,const FileDatabase& db) const
 {
-    if (name == "char") {
+    if (primitive == Primitive_Char) {
         dest = db.reader->GetI1() / 255.;
         return;
     }
-    else if (name == "short") {
+    else if (primitive == Primitive_Short) {
         dest = db.reader->GetI2() / 32767.;
         return;
     }
@@ -50,6 +50,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BlenderDNA.h"
 #include "BlenderScene.h"
 #include <deque>
+#include <map>
+#include <memory>
+#include <exception>
 #include <assimp/material.h>
 
 struct aiTexture;
@@ -130,6 +133,19 @@ namespace Blender {
     // When keeping objects in sets, sort them by their name.
     typedef std::set<const Object*, ObjectCompare> ObjectSet;
 
+    // --------------------------------------------------------------------
+    /** Geometry of a single mesh object, converted ahead of the node
+     *  hierarchy. The material indices of the meshes are still the
+     *  material slots of the source mesh. */
+    // --------------------------------------------------------------------
+    struct ConvertedMesh
+    {
+        TempArray <std::vector, aiMesh> meshes;
+
+        // set if the conversion failed, rethrown when the object is reached
+        std::exception_ptr error;
+    };
+
     // --------------------------------------------------------------------
     /** ConversionData acts as intermediate storage location for
      *  the various ConvertXXX routines in BlenderImporter.*/
@@ -156,6 +172,9 @@ namespace Blender {
         TempArray <std::vector, aiMaterial> materials;
         TempArray <std::vector, aiTexture> textures;
 
+        // geometry converted in parallel before the node hierarchy is built
+        std::map< const Object*, std::shared_ptr< ConvertedMesh > > converted_meshes;
+
         // set of all materials referenced by at least one mesh in the scene
         std::deque< std::shared_ptr< Material > > materials_raw;
 
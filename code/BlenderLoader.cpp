@@ -56,12 +56,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "StringUtils.h"
 #include <assimp/scene.h>
 #include <assimp/importerdesc.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 #include "StringComparison.h"
 #include "StreamReader.h"
 #include "MemoryIOWrapper.h"
+#include "ParallelFor.h"
 
 #include <cctype>
+#include <climits>
 
 
 // zlib is needed for compressed blend files
@@ -102,7 +106,8 @@ static const aiImporterDesc blenderDesc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BlenderImporter::BlenderImporter()
-: modifier_cache(new BlenderModifierShowcase()) {
+: modifier_cache(new BlenderModifierShowcase())
+, num_threads(0) {
     // empty
 }
 
@@ -148,28 +153,18 @@ const aiImporterDesc* BlenderImporter::GetInfo () const
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties for the loader
-void BlenderImporter::SetupProperties(const Importer* /*pImp*/)
+void BlenderImporter::SetupProperties(const Importer* pImp)
 {
-    // nothing to be done for the moment
+    num_threads = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_BLEND_NUM_THREADS, 0));
 }
 
-struct free_it {
-    free_it(void* free) : free(free) {}
-    ~free_it() {
-        ::free(this->free);
-    }
-
-    void* free;
-};
-
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure.
 void BlenderImporter::InternReadFile( const std::string& pFile,
     aiScene* pScene, IOSystem* pIOHandler)
 {
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-    Bytef* dest = NULL;
-    free_it free_it_really(dest);
+    std::vector<Bytef> uncompressed;
 #endif
 
 
@@ -199,8 +194,18 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
         }
 
         // http://www.gzip.org/zlib/rfc-gzip.html#header-trailer
+        // The trailer holds the size of the uncompressed data (modulo 2^32),
+        // which is used to allocate the output buffer at once.
+        const size_t compressed = stream->FileSize();
+        size_t expected = 0;
+        if (compressed >= 18) {
+            uint8_t isize[4];
+            stream->Seek(compressed - 4,aiOrigin_SET);
+            if (stream->Read(isize,4,1) == 1) {
+                expected = isize[0] | (isize[1] << 8) | (isize[2] << 16) | (static_cast<size_t>(isize[3]) << 24);
+            }
+        }
         stream->Seek(0L,aiOrigin_SET);
-        std::shared_ptr<StreamReaderLE> reader = std::shared_ptr<StreamReaderLE>(new StreamReaderLE(stream));
 
         // build a zlib stream
         z_stream zstream;
@@ -208,31 +213,39 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
         zstream.zalloc = Z_NULL;
         zstream.zfree  = Z_NULL;
         zstream.data_type = Z_BINARY;
+        zstream.next_in = Z_NULL;
+        zstream.avail_in = 0;
 
         // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
         inflateInit2(&zstream, 16+MAX_WBITS);
 
-        zstream.next_in   = reinterpret_cast<Bytef*>( reader->GetPtr() );
-        zstream.avail_in  = reader->GetRemainingSize();
-
-        size_t total = 0l;
+        // the compressed data is read in chunks from the input stream and inflated
+        // straight into the output buffer, which only grows if the trailer lied
+        const size_t BlockSize = 64 * 1024;
+        std::vector<Bytef> block(BlockSize);
+        uncompressed.resize(std::max(expected,BlockSize));
 
-        // and decompress the data .... do 1k chunks in the hope that we won't kill the stack
-#define MYBLOCK 1024
-        Bytef block[MYBLOCK];
+        size_t total = 0;
         int ret;
         do {
-            zstream.avail_out = MYBLOCK;
-            zstream.next_out = block;
+            if (!zstream.avail_in) {
+                zstream.avail_in = static_cast<uInt>(stream->Read(&block[0],1,BlockSize));
+                zstream.next_in = &block[0];
+            }
+            if (total == uncompressed.size()) {
+                uncompressed.resize(uncompressed.size() * 2);
+            }
+
+            const size_t avail = std::min(uncompressed.size() - total,static_cast<size_t>(UINT_MAX));
+            zstream.next_out = &uncompressed[total];
+            zstream.avail_out = static_cast<uInt>(avail);
             ret = inflate(&zstream, Z_NO_FLUSH);
 
             if (ret != Z_STREAM_END && ret != Z_OK) {
+                inflateEnd(&zstream);
                 ThrowException("Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
             }
-            const size_t have = MYBLOCK - zstream.avail_out;
-            total += have;
-            dest = reinterpret_cast<Bytef*>( realloc(dest,total) );
-            memcpy(dest + total - have,block,have);
+            total += avail - zstream.avail_out;
         }
         while (ret != Z_STREAM_END);
 
@@ -240,7 +253,7 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
         inflateEnd(&zstream);
 
         // replace the input stream with a memory stream
-        stream.reset(new MemoryIOStream(reinterpret_cast<uint8_t*>(dest),total));
+        stream.reset(new MemoryIOStream(&uncompressed[0],total));
 
         // .. and retry
         stream->Read(magic,7,1);
@@ -373,6 +386,8 @@ void BlenderImporter::ConvertBlendFile(aiScene* out, const Scene& in,const FileD
         ThrowException("Expected at least one object with no parent");
     }
 
+    ConvertMeshes(in, conv);
+
     aiNode* root = out->mRootNode = new aiNode("<BlenderRoot>");
 
     root->mNumChildren = static_cast<unsigned int>(no_parents.size());
@@ -797,9 +812,93 @@ void BlenderImporter::NotSupportedObjectType(const Object* obj, const char* type
 }
 
 // ------------------------------------------------------------------------------------------------
-void BlenderImporter::ConvertMesh(const Scene& /*in*/, const Object* /*obj*/, const Mesh* mesh,
+void BlenderImporter::ConvertMeshes(const Scene& in, ConversionData& conv_data)
+{
+    // collect all mesh objects of the scene, their geometry doesn't depend
+    // on anything else and is converted in parallel
+    std::vector<const Object*> objects;
+    std::vector< std::shared_ptr<ConvertedMesh> > results;
+    const std::shared_ptr<Base> lists[] = {
+        std::static_pointer_cast<Base>(in.base.first), in.basact
+    };
+    for (const std::shared_ptr<Base>& first : lists) {
+        for (std::shared_ptr<Base> cur = first; cur; cur = cur->next) {
+            const Object* obj = cur->object.get();
+            if (!obj || obj->type != Object::Type_MESH || !obj->data || strcmp(obj->data->dna_type,"Mesh")) {
+                continue;
+            }
+
+            std::shared_ptr<ConvertedMesh>& result = conv_data.converted_meshes[obj];
+            if (!result) {
+                result = std::make_shared<ConvertedMesh>();
+                objects.push_back(obj);
+                results.push_back(result);
+            }
+        }
+    }
+
+    // failures are stored and only reported once the node hierarchy gets to
+    // the object, as it would have happened sequentially
+    ParallelFor(objects.size(),num_threads,[&](size_t i) {
+        try {
+            ConvertMeshGeometry(static_cast<const Mesh*>(objects[i]->data.get()),results[i]->meshes);
+        }
+        catch(...) {
+            results[i]->error = std::current_exception();
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlenderImporter::ConvertMesh(const Scene& /*in*/, const Object* obj, const Mesh* mesh,
     ConversionData& conv_data, TempArray<std::vector,aiMesh>&  temp
     )
+{
+    const size_t old = temp->size();
+
+    // take the geometry converted up front, if there is any
+    std::map< const Object*, std::shared_ptr<ConvertedMesh> >::iterator found = conv_data.converted_meshes.find(obj);
+    if (found != conv_data.converted_meshes.end()) {
+        std::shared_ptr<ConvertedMesh> converted = found->second;
+        conv_data.converted_meshes.erase(found);
+
+        if (converted->error) {
+            std::rethrow_exception(converted->error);
+        }
+        temp->insert(temp->end(),converted->meshes->begin(),converted->meshes->end());
+        converted->meshes.dismiss();
+    }
+    else {
+        ConvertMeshGeometry(mesh,temp);
+    }
+
+    // resolve the material references and add the materials to the set of
+    // output materials. The (temporary) material index is the index
+    // of the material entry within the list of resolved materials.
+    if (!mesh->mat) {
+        return;
+    }
+    for (std::vector<aiMesh*>::iterator it = temp->begin()+old; it != temp->end(); ++it) {
+        aiMesh* const out = *it;
+
+        std::shared_ptr<Material> mat = mesh->mat[out->mMaterialIndex];
+        const std::deque< std::shared_ptr<Material> >::iterator has = std::find(
+                conv_data.materials_raw.begin(),
+                conv_data.materials_raw.end(),mat
+        );
+
+        if (has != conv_data.materials_raw.end()) {
+            out->mMaterialIndex = static_cast<unsigned int>( std::distance(conv_data.materials_raw.begin(),has));
+        }
+        else {
+            out->mMaterialIndex = static_cast<unsigned int>( conv_data.materials_raw.size() );
+            conv_data.materials_raw.push_back(mat);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlenderImporter::ConvertMeshGeometry(const Mesh* mesh, TempArray<std::vector,aiMesh>& temp)
 {
     // TODO: Resolve various problems with BMesh triangulation before re-enabling.
     //       See issues #400, #373, #318  #315 and #132.
@@ -868,28 +967,14 @@ void BlenderImporter::ConvertMesh(const Scene& /*in*/, const Object* /*obj*/, co
         out->mName = aiString(mesh->id.name+2);
             // skip over the name prefix 'ME'
 
-        // resolve the material reference and add this material to the set of
-        // output materials. The (temporary) material index is the index
-        // of the material entry within the list of resolved materials.
+        // the material slot is resolved by ConvertMesh, in the order
+        // of the nodes
         if (mesh->mat) {
 
             if (static_cast<size_t> ( it.first ) >= mesh->mat.size() ) {
                 ThrowException("Material index is out of range");
             }
-
-            std::shared_ptr<Material> mat = mesh->mat[it.first];
-            const std::deque< std::shared_ptr<Material> >::iterator has = std::find(
-                    conv_data.materials_raw.begin(),
-                    conv_data.materials_raw.end(),mat
-            );
-
-            if (has != conv_data.materials_raw.end()) {
-                out->mMaterialIndex = static_cast<unsigned int>( std::distance(conv_data.materials_raw.begin(),has));
-            }
-            else {
-                out->mMaterialIndex = static_cast<unsigned int>( conv_data.materials_raw.size() );
-                conv_data.materials_raw.push_back(mat);
-            }
+            out->mMaterialIndex = static_cast<unsigned int>( it.first );
         }
         else out->mMaterialIndex = static_cast<unsigned int>( -1 );
     }
@@ -156,6 +156,11 @@ private:
         const aiMatrix4x4& parentTransform
     );
 
+    // --------------------
+    void ConvertMeshes(const Blender::Scene& in,
+        Blender::ConversionData& conv_data
+    );
+
     // --------------------
     void ConvertMesh(const Blender::Scene& in,
         const Blender::Object* obj,
@@ -164,6 +169,11 @@ private:
         Blender::TempArray<std::vector,aiMesh>& temp
     );
 
+    // --------------------
+    void ConvertMeshGeometry(const Blender::Mesh* mesh,
+        Blender::TempArray<std::vector,aiMesh>& temp
+    );
+
     // --------------------
     aiLight* ConvertLight(const Blender::Scene& in,
         const Blender::Object* obj,
@@ -232,6 +242,7 @@ private: // static stuff, mostly logging and error reporting.
 private:
 
     Blender::BlenderModifierShowcase* modifier_cache;
+    unsigned int num_threads;
 
 }; // !class BlenderImporter
 
@@ -50,23 +50,32 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/cexport.h>
 #include <assimp/IOSystem.hpp>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Exporter.hpp>
 #include <stdint.h>
+#include <algorithm>
 #include <set>
 #include <vector>
 
 namespace Assimp    {
     class BlobIOSystem;
 
+// Largest chunk a BlobIOStream allocates, unless a single write needs more
+#define AI_BLOBIO_MAX_CHUNK (1u << 20)
+
 // --------------------------------------------------------------------------------------------
-/** Redirect IOStream to a blob */
+/** Redirect IOStream to a blob.
+ *
+ *  The data is kept in a list of chunks which never move, so growing the
+ *  stream doesn't copy what was written so far. The chunks double in size
+ *  up to AI_BLOBIO_MAX_CHUNK. */
 // --------------------------------------------------------------------------------------------
 class BlobIOStream : public IOStream
 {
 public:
 
     BlobIOStream(BlobIOSystem* creator, const std::string& file, size_t initial = 4096)
-        : buffer()
-        , cur_size()
+        : chunks()
+        , ends()
         , file_size()
         , cursor()
         , initial(initial)
@@ -81,17 +90,48 @@ public:
 public:
 
     // -------------------------------------------------------------------
+    /** Moves the data to a blob. A single chunk is handed over as it is,
+     *  otherwise the chunks are released while they are copied. */
     aiExportDataBlob* GetBlob()
     {
         aiExportDataBlob* blob = new aiExportDataBlob();
         blob->size = file_size;
-        blob->data = buffer;
 
-        buffer = NULL;
+        if (chunks.size() == 1) {
+            blob->data = chunks[0];
+        }
+        else if (!chunks.empty()) {
+            uint8_t* const data = new uint8_t[file_size];
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                memcpy(data + ChunkBegin(i), chunks[i], ChunkDataSize(i));
+                delete[] chunks[i];
+            }
+            blob->data = data;
+        }
 
+        chunks.clear();
+        ends.clear();
         return blob;
     }
 
+    // -------------------------------------------------------------------
+    /** Passes the data to a chunk handler, chunk by chunk in file order.
+     *  Each chunk is released after the handler returned. */
+    void HandChunks(ExportChunkHandler* handler, const char* name)
+    {
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            const size_t size = ChunkDataSize(i);
+            if (size) {
+                handler->Write(name, chunks[i], size);
+            }
+            delete[] chunks[i];
+            chunks[i] = NULL;
+        }
+
+        chunks.clear();
+        ends.clear();
+    }
+
 
 public:
 
@@ -110,12 +150,20 @@ public:
         size_t pCount)
     {
         pSize *= pCount;
-        if (cursor + pSize > cur_size) {
-            Grow(cursor + pSize);
+        if (!pSize) {
+            return pCount;
         }
+        Reserve(cursor + pSize);
+
+        const uint8_t* src = static_cast<const uint8_t*>(pvBuffer);
+        for (size_t i = FindChunk(cursor); pSize; ++i) {
+            const size_t n = std::min(pSize, ends[i] - cursor);
+            memcpy(chunks[i] + (cursor - ChunkBegin(i)), src, n);
 
-        memcpy(buffer+cursor, pvBuffer, pSize);
-        cursor += pSize;
+            src += n;
+            cursor += n;
+            pSize -= n;
+        }
 
         file_size = std::max(file_size,cursor);
         return pCount;
@@ -144,7 +192,7 @@ public:
         }
 
         if (cursor > file_size) {
-            Grow(cursor);
+            Reserve(cursor);
         }
 
         file_size = std::max(cursor,file_size);
@@ -174,31 +222,54 @@ public:
 private:
 
     // -------------------------------------------------------------------
-    void Grow(size_t need = 0)
+    /** Adds chunks until there is room for need bytes */
+    void Reserve(size_t need)
+    {
+        while ((ends.empty() ? 0 : ends.back()) < need) {
+            const size_t capacity = ends.empty() ? 0 : ends.back();
+
+            // Doubling the capacity keeps the number of chunks low for
+            // small files, large files don't waste more than one chunk.
+            // A single large write gets a chunk of its own size.
+            size_t size = std::max(initial, std::min<size_t>(capacity, AI_BLOBIO_MAX_CHUNK));
+            size = std::max(size, need - capacity);
+
+            // zeroed, so gaps left by seeking past the end read as zeros like in a file
+            chunks.push_back(new uint8_t[size]());
+            ends.push_back(capacity + size);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    /** Index of the chunk holding the given offset, which must be reserved */
+    size_t FindChunk(size_t offset) const
     {
-        // 1.5 and phi are very heap-friendly growth factors (the first
-        // allows for frequent re-use of heap blocks, the second
-        // forms a fibonacci sequence with similar characteristics -
-        // since this heavily depends on the heap implementation
-        // and other factors as well, i'll just go with 1.5 since
-        // it is quicker to compute).
-        size_t new_size = std::max(initial, std::max( need, cur_size+(cur_size>>1) ));
-
-        const uint8_t* const old = buffer;
-        buffer = new uint8_t[new_size];
-
-        if (old) {
-            memcpy(buffer,old,cur_size);
-            delete[] old;
+        // mostly, the offset is in the last chunk
+        if (ChunkBegin(ends.size() - 1) <= offset) {
+            return ends.size() - 1;
         }
+        return std::upper_bound(ends.begin(), ends.end(), offset) - ends.begin();
+    }
+
+    // -------------------------------------------------------------------
+    size_t ChunkBegin(size_t i) const
+    {
+        return i ? ends[i - 1] : 0;
+    }
 
-        cur_size = new_size;
+    // -------------------------------------------------------------------
+    /** Number of bytes of the file in the given chunk */
+    size_t ChunkDataSize(size_t i) const
+    {
+        const size_t begin = ChunkBegin(i);
+        return file_size > begin ? std::min(ends[i], file_size) - begin : 0;
     }
 
 private:
 
-    uint8_t* buffer;
-    size_t cur_size,file_size, cursor, initial;
+    std::vector<uint8_t*> chunks;
+    std::vector<size_t> ends;
+    size_t file_size, cursor, initial;
 
     const std::string file;
     BlobIOSystem* const creator;
@@ -218,7 +289,11 @@ class BlobIOSystem : public IOSystem
 
 public:
 
-    BlobIOSystem()
+    /** If a chunk handler is given, the data of each file is passed
+     *  to it when the file is closed, no blobs are made then. */
+    explicit BlobIOSystem(ExportChunkHandler* handler = NULL)
+        : handler(handler)
+        , failed()
     {
     }
 
@@ -237,6 +312,26 @@ public:
         return AI_BLOBIO_MAGIC;
     }
 
+    // -------------------------------------------------------------------
+    /** true if the chunk handler threw an exception */
+    bool HasFailed() const
+    {
+        return failed;
+    }
+
+    // -------------------------------------------------------------------
+    /** Name of the blob of a file: empty for the master file, the file
+     *  extension for all others. */
+    static std::string GetBlobName(const std::string& filename)
+    {
+        if (filename == AI_BLOBIO_MAGIC) {
+            return std::string();
+        }
+
+        // extract the file extension from the file written
+        const std::string::size_type s = filename.find_first_of('.');
+        return s == std::string::npos ? filename : filename.substr(s+1);
+    }
 
     // -------------------------------------------------------------------
     aiExportDataBlob* GetBlobChain()
@@ -264,10 +359,7 @@ public:
 
             cur->next = blobby.second;
             cur = cur->next;
-
-            // extract the file extension from the file written
-            const std::string::size_type s = blobby.first.find_first_of('.');
-            cur->name.Set(s == std::string::npos ? blobby.first : blobby.first.substr(s+1));
+            cur->name.Set(GetBlobName(blobby.first));
         }
 
         // give up blob ownership
@@ -312,6 +404,20 @@ private:
     // -------------------------------------------------------------------
     void OnDestruct(const std::string& filename, BlobIOStream* child)
     {
+        if (handler) {
+            // called from a destructor, so exceptions must not leave here
+            if (!failed) {
+                try {
+                    child->HandChunks(handler, GetBlobName(filename).c_str());
+                }
+                catch (...) {
+                    DefaultLogger::get()->error("BlobIOSystem: the chunk handler failed for " + filename);
+                    failed = true;
+                }
+            }
+            return;
+        }
+
         // we don't know in which the files are closed, so we
         // can't reliably say that the first must be the master
         // file ...
@@ -321,6 +427,9 @@ private:
 private:
     std::set<std::string> created;
     std::vector< BlobEntry > blobs;
+
+    ExportChunkHandler* const handler;
+    bool failed;
 };
 
 
@@ -328,7 +437,9 @@ private:
 BlobIOStream :: ~BlobIOStream()
 {
     creator->OnDestruct(file,this);
-    delete[] buffer;
+    for (uint8_t* chunk : chunks) {
+        delete[] chunk;
+    }
 }
 
 
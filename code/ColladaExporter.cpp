@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ColladaExporter.h"
 #include "Bitmap.h"
 #include "fast_atof.h"
+#include "fast_ftoa.h"
 #include <assimp/SceneCombiner.h>
 #include "StringUtils.h"
 #include "XMLTools.h"
@@ -73,21 +74,17 @@ void ExportSceneCollada(const char* pFile, IOSystem* pIOSystem, const aiScene* p
     std::string path = DefaultIOSystem::absolutePath(std::string(pFile));
     std::string file = DefaultIOSystem::completeBaseName(std::string(pFile));
 
-    // invoke the exporter
-    ColladaExporter iDoTheExportThing( pScene, pIOSystem, path, file);
-    
-    if (iDoTheExportThing.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write result to the given IOSYstem
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .dae file: " + std::string(pFile));
     }
 
-    // XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-    outfile->Write( iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()),1);
+    // invoke the exporter
+    ColladaExporter iDoTheExportThing( pScene, pIOSystem, path, file, outfile.get());
+
+    if (iDoTheExportThing.mOutput.flush().fail()) {
+        throw DeadlyExportError("could not write output .dae file: " + std::string(pFile));
+    }
 }
 
 } // end of namespace Assimp
@@ -96,11 +93,10 @@ void ExportSceneCollada(const char* pFile, IOSystem* pIOSystem, const aiScene* p
 
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
-ColladaExporter::ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file) : mIOSystem(pIOSystem), mPath(path), mFile(file)
+ColladaExporter::ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, IOStream* pOutput) : mOutput(pOutput), mIOSystem(pIOSystem), mPath(path), mFile(file)
 {
     // make sure that all formatting happens using the standard, C locale and not the user's current locale
     mOutput.imbue( std::locale("C") );
-    mOutput.precision(16);
 
     mScene = pScene;
     mSceneOwned = false;
@@ -176,7 +172,9 @@ void ColladaExporter::WriteHeader()
     static const unsigned int date_nb_chars = 20;
     char date_str[date_nb_chars];
     std::time_t date = std::time(NULL);
-    std::strftime(date_str, date_nb_chars, "%Y-%m-%dT%H:%M:%S", std::localtime(&date));
+    std::tm local;
+    ai_localtime(&date, &local);
+    std::strftime(date_str, date_nb_chars, "%Y-%m-%dT%H:%M:%S", &local);
 
     aiVector3D scaling;
     aiQuaternion rotation;
@@ -330,16 +328,16 @@ void ColladaExporter::WriteCamera(size_t pIndex){
     mOutput << startstr << "<perspective>" << endstr;
     PushTag();
     mOutput << startstr << "<xfov sid=\"xfov\">"<<
-                                AI_RAD_TO_DEG(cam->mHorizontalFOV)
+                                ShortestReals(AI_RAD_TO_DEG(cam->mHorizontalFOV))
                         <<"</xfov>" << endstr;
     mOutput << startstr << "<aspect_ratio>"
-                        <<      cam->mAspect
+                        <<      ShortestReals(cam->mAspect)
                         << "</aspect_ratio>" << endstr;
     mOutput << startstr << "<znear sid=\"znear\">"
-                        <<      cam->mClipPlaneNear
+                        <<      ShortestReals(cam->mClipPlaneNear)
                         <<  "</znear>" << endstr;
     mOutput << startstr << "<zfar sid=\"zfar\">"
-                        <<      cam->mClipPlaneFar
+                        <<      ShortestReals(cam->mClipPlaneFar)
                         << "</zfar>" << endstr;
     PopTag();
     mOutput << startstr << "</perspective>" << endstr;
@@ -411,16 +409,16 @@ void ColladaExporter::WritePointLight(const aiLight *const light){
     mOutput << startstr << "<point>" << endstr;
     PushTag();
     mOutput << startstr << "<color sid=\"color\">"
-                            << color.r<<" "<<color.g<<" "<<color.b
+                            << ShortestReals(color)
                         <<"</color>" << endstr;
     mOutput << startstr << "<constant_attenuation>"
-                            << light->mAttenuationConstant
+                            << ShortestReals(light->mAttenuationConstant)
                         <<"</constant_attenuation>" << endstr;
     mOutput << startstr << "<linear_attenuation>"
-                            << light->mAttenuationLinear
+                            << ShortestReals(light->mAttenuationLinear)
                         <<"</linear_attenuation>" << endstr;
     mOutput << startstr << "<quadratic_attenuation>"
-                            << light->mAttenuationQuadratic
+                            << ShortestReals(light->mAttenuationQuadratic)
                         <<"</quadratic_attenuation>" << endstr;
 
     PopTag();
@@ -432,7 +430,7 @@ void ColladaExporter::WriteDirectionalLight(const aiLight *const light){
     mOutput << startstr << "<directional>" << endstr;
     PushTag();
     mOutput << startstr << "<color sid=\"color\">"
-                            << color.r<<" "<<color.g<<" "<<color.b
+                            << ShortestReals(color)
                         <<"</color>" << endstr;
 
     PopTag();
@@ -445,16 +443,16 @@ void ColladaExporter::WriteSpotLight(const aiLight *const light){
     mOutput << startstr << "<spot>" << endstr;
     PushTag();
     mOutput << startstr << "<color sid=\"color\">"
-                            << color.r<<" "<<color.g<<" "<<color.b
+                            << ShortestReals(color)
                         <<"</color>" << endstr;
     mOutput << startstr << "<constant_attenuation>"
-                                << light->mAttenuationConstant
+                                << ShortestReals(light->mAttenuationConstant)
                             <<"</constant_attenuation>" << endstr;
     mOutput << startstr << "<linear_attenuation>"
-                            << light->mAttenuationLinear
+                            << ShortestReals(light->mAttenuationLinear)
                         <<"</linear_attenuation>" << endstr;
     mOutput << startstr << "<quadratic_attenuation>"
-                            << light->mAttenuationQuadratic
+                            << ShortestReals(light->mAttenuationQuadratic)
                         <<"</quadratic_attenuation>" << endstr;
     /*
     out->mAngleOuterCone = AI_DEG_TO_RAD (std::acos(std::pow(0.1f,1.f/srcLight->mFalloffExponent))+
@@ -463,7 +461,7 @@ void ColladaExporter::WriteSpotLight(const aiLight *const light){
 
     const ai_real fallOffAngle = AI_RAD_TO_DEG(light->mAngleInnerCone);
     mOutput << startstr <<"<falloff_angle sid=\"fall_off_angle\">"
-                                << fallOffAngle
+                                << ShortestReals(fallOffAngle)
                         <<"</falloff_angle>" << endstr;
     double temp = light->mAngleOuterCone-light->mAngleInnerCone;
 
@@ -471,7 +469,7 @@ void ColladaExporter::WriteSpotLight(const aiLight *const light){
     temp = std::log(temp)/std::log(0.1);
     temp = 1/temp;
     mOutput << startstr << "<falloff_exponent sid=\"fall_off_exponent\">"
-                            << temp
+                            << ShortestReals(temp)
                         <<"</falloff_exponent>" << endstr;
 
 
@@ -486,7 +484,7 @@ void ColladaExporter::WriteAmbienttLight(const aiLight *const light){
     mOutput << startstr << "<ambient>" << endstr;
     PushTag();
     mOutput << startstr << "<color sid=\"color\">"
-                            << color.r<<" "<<color.g<<" "<<color.b
+                            << ShortestReals(color)
                         <<"</color>" << endstr;
 
     PopTag();
@@ -580,7 +578,7 @@ void ColladaExporter::WriteTextureColorEntry( const Surface& pSurface, const std
     PushTag();
     if( pSurface.texture.empty() )
     {
-      mOutput << startstr << "<color sid=\"" << pTypeName << "\">" << pSurface.color.r << "   " << pSurface.color.g << "   " << pSurface.color.b << "   " << pSurface.color.a << "</color>" << endstr;
+      mOutput << startstr << "<color sid=\"" << pTypeName << "\">" << ShortestReals(&pSurface.color.r, 4) << "</color>" << endstr;
     }
     else
     {
@@ -627,7 +625,7 @@ void ColladaExporter::WriteFloatEntry( const Property& pProperty, const std::str
     if(pProperty.exist) {
         mOutput << startstr << "<" << pTypeName << ">" << endstr;
         PushTag();
-        mOutput << startstr << "<float sid=\"" << pTypeName << "\">" << pProperty.value << "</float>" << endstr;
+        mOutput << startstr << "<float sid=\"" << pTypeName << "\">" << ShortestReals(pProperty.value) << "</float>" << endstr;
         PopTag();
         mOutput << startstr << "</" << pTypeName << ">" << endstr;
     }
@@ -836,10 +834,8 @@ void ColladaExporter::WriteController( size_t pIndex)
 
     // I think it is identity in general cases.
     aiMatrix4x4 mat;
-    mOutput << startstr << mat.a1 << " " << mat.a2 << " " << mat.a3 << " " << mat.a4 << endstr;
-    mOutput << startstr << mat.b1 << " " << mat.b2 << " " << mat.b3 << " " << mat.b4 << endstr;
-    mOutput << startstr << mat.c1 << " " << mat.c2 << " " << mat.c3 << " " << mat.c4 << endstr;
-    mOutput << startstr << mat.d1 << " " << mat.d2 << " " << mat.d3 << " " << mat.d4 << endstr;
+    for( unsigned int i = 0; i < 4; ++i)
+        mOutput << startstr << ShortestReals(mat[i], 4) << endstr;
 
     PopTag();
     mOutput << startstr << "</bind_shape_matrix>" << endstr;
@@ -1150,23 +1146,20 @@ void ColladaExporter::WriteFloatArray( const std::string& pIdString, FloatDataTy
     {
         for( size_t a = 0; a < pElementCount; ++a )
         {
-            mOutput << pData[a*3+0] << " ";
-            mOutput << pData[a*3+1] << " ";
+            mOutput << ShortestReals(pData + a*3, 2) << " ";
         }
     }
     else if( pType == FloatType_Color )
     {
         for( size_t a = 0; a < pElementCount; ++a )
         {
-            mOutput << pData[a*4+0] << " ";
-            mOutput << pData[a*4+1] << " ";
-            mOutput << pData[a*4+2] << " ";
+            mOutput << ShortestReals(pData + a*4, 3) << " ";
         }
     }
     else
     {
-        for( size_t a = 0; a < pElementCount * floatsPerElement; ++a )
-            mOutput << pData[a] << " ";
+        if( pElementCount > 0 )
+            mOutput << ShortestReals(pData, pElementCount * floatsPerElement) << " ";
     }
     mOutput << "</float_array>" << endstr;
     PopTag();
@@ -1534,10 +1527,7 @@ void ColladaExporter::WriteNode( const aiScene* pScene, aiNode* pNode)
     //mOutput << startstr << "<matrix sid=\"transform\">";
 	mOutput << startstr << "<matrix sid=\"matrix\">";
 	
-    mOutput << mat.a1 << " " << mat.a2 << " " << mat.a3 << " " << mat.a4 << " ";
-    mOutput << mat.b1 << " " << mat.b2 << " " << mat.b3 << " " << mat.b4 << " ";
-    mOutput << mat.c1 << " " << mat.c2 << " " << mat.c3 << " " << mat.c4 << " ";
-    mOutput << mat.d1 << " " << mat.d2 << " " << mat.d3 << " " << mat.d4;
+    mOutput << ShortestReals(mat);
     mOutput << "</matrix>" << endstr;
 
     if(pNode->mNumMeshes==0){
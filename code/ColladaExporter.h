@@ -55,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <map>
 
 #include "StringUtils.h"
+#include "IOStreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -68,7 +69,7 @@ class ColladaExporter
 {
 public:
     /// Constructor for a specific scene to export
-    ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file);
+    ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, IOStream* pOutput);
 
     /// Destructor
     virtual ~ColladaExporter();
@@ -146,8 +147,8 @@ protected:
     }
 
 public:
-    /// Stringstream to write all output into
-    std::stringstream mOutput;
+    /// Stream to write all output into, it passes the data on to the output file
+    IOStreamWriter mOutput;
 
 protected:
     /// The IOSystem for output
@@ -96,8 +96,7 @@ ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
     }
 
     // generate a XML reader for it
-    std::unique_ptr<CIrrXML_IOStreamReader> mIOWrapper(new CIrrXML_IOStreamReader(file.get()));
-    mReader = irr::io::createIrrXMLReader( mIOWrapper.get());
+    mReader = new FastXmlReader(file.get());
     if (!mReader) {
         ThrowException("Collada: Unable to open file.");
     }
@@ -41,6 +41,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "CreateAnimMesh.h"
+#include "ParallelFor.h"
+#include <algorithm>
 
 namespace Assimp    {
 
@@ -89,4 +91,63 @@ aiAnimMesh *aiCreateAnimMesh(const aiMesh *mesh)
     return animesh;
 }
 
+void aiCreateKeyframeAnimMeshes(aiMesh *const *meshes, unsigned int numMeshes,
+    unsigned int numFrames, unsigned int numThreads, const KeyframeDecoder &decode)
+{
+    // allocate all targets up front, the workers only fill them in
+    for (unsigned int m = 0; m < numMeshes; ++m) {
+        aiMesh *mesh = meshes[m];
+        mesh->mMethod = aiMorphingMethod_VERTEX_BLEND;
+        mesh->mNumAnimMeshes = numFrames;
+        mesh->mAnimMeshes = new aiAnimMesh*[numFrames];
+        for (unsigned int f = 0; f < numFrames; ++f) {
+            aiAnimMesh *animesh = mesh->mAnimMeshes[f] = new aiAnimMesh();
+            animesh->mNumVertices = mesh->mNumVertices;
+            animesh->mVertices = new aiVector3D[mesh->mNumVertices];
+            if (mesh->mNormals) {
+                animesh->mNormals = new aiVector3D[mesh->mNumVertices];
+            }
+        }
+    }
+
+    // one work item per mesh and frame, handed out in frame-major order
+    ParallelFor(static_cast<size_t>(numMeshes) * numFrames, numThreads, [&](size_t i) {
+        const unsigned int f = static_cast<unsigned int>(i / numMeshes);
+        const unsigned int m = static_cast<unsigned int>(i % numMeshes);
+        decode(m, f, *meshes[m]->mAnimMeshes[f]);
+    });
+}
+
+aiAnimation *aiCreateKeyframeMorphAnimation(aiMesh *const *meshes, unsigned int numMeshes)
+{
+    aiAnimation *anim = new aiAnimation();
+    anim->mNumMorphMeshChannels = numMeshes;
+    anim->mMorphMeshChannels = new aiMeshMorphAnim*[numMeshes];
+
+    unsigned int numFrames = 0;
+    for (unsigned int m = 0; m < numMeshes; ++m) {
+        const aiMesh *mesh = meshes[m];
+        numFrames = std::max(numFrames, mesh->mNumAnimMeshes);
+
+        aiMeshMorphAnim *channel = anim->mMorphMeshChannels[m] = new aiMeshMorphAnim();
+        channel->mName = mesh->mName;
+        channel->mNumKeys = mesh->mNumAnimMeshes;
+        channel->mKeys = new aiMeshMorphKey[mesh->mNumAnimMeshes];
+
+        // key k shows anim mesh k at full weight
+        for (unsigned int k = 0; k < mesh->mNumAnimMeshes; ++k) {
+            aiMeshMorphKey &key = channel->mKeys[k];
+            key.mTime = k;
+            key.mNumValuesAndWeights = 1;
+            key.mValues = new unsigned int[1];
+            key.mValues[0] = k;
+            key.mWeights = new double[1];
+            key.mWeights[0] = 1.0;
+        }
+    }
+    anim->mDuration = numFrames ? numFrames - 1 : 0;
+    anim->mTicksPerSecond = 0;
+    return anim;
+}
+
 } // end of namespace Assimp
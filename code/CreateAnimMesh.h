@@ -46,12 +46,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_CREATE_ANIM_MESH_H
 
 #include <assimp/mesh.h>
+#include <assimp/anim.h>
+#include <functional>
 
 namespace Assimp    {
 
 /** Create aiAnimMesh from aiMesh. */
 aiAnimMesh *aiCreateAnimMesh(const aiMesh *mesh);
 
+/** Fills in the positions and normals of one keyframe of one mesh. */
+typedef std::function<void(unsigned int mesh, unsigned int frame, aiAnimMesh &target)> KeyframeDecoder;
+
+/** Create one aiAnimMesh per keyframe for each of the given meshes.
+ *  The anim meshes receive positions and, if the host mesh has normals,
+ *  normals, which @c decode fills in. Frames are decoded on up to
+ *  @c numThreads threads (0 for one per hardware thread, 1 decodes them
+ *  sequentially), exceptions thrown by @c decode are passed on to the caller. */
+void aiCreateKeyframeAnimMeshes(aiMesh *const *meshes, unsigned int numMeshes,
+    unsigned int numFrames, unsigned int numThreads, const KeyframeDecoder &decode);
+
+/** Create an animation which steps the given meshes through their
+ *  anim meshes, one morph key per anim mesh and tick. */
+aiAnimation *aiCreateKeyframeMorphAnimation(aiMesh *const *meshes, unsigned int numMeshes);
+
 } // end of namespace Assimp
 #endif // INCLUDED_AI_CREATE_ANIM_MESH_H
 
@@ -58,14 +58,22 @@ Here we implement only the C++ interface (Assimp::Exporter).
 #include "BaseProcess.h"
 #include "Importer.h" // need this for GetPostProcessingStepInstanceList()
 
-#include "JoinVerticesProcess.h"
 #include "MakeVerboseFormat.h"
-#include "ConvertToLHProcess.h"
+#include "ProcessHelper.h"
 #include "Exceptional.h"
 #include "ScenePrivate.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <exception>
 #include <memory>
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#endif
+
 #include <assimp/DefaultIOSystem.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/config.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/mesh.h>
 #include <assimp/postprocess.h>
@@ -92,6 +100,7 @@ void ExportScene3DS(const char*, IOSystem*, const aiScene*, const ExportProperti
 void ExportSceneGLTF(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 void ExportSceneGLB(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 void ExportSceneGLTF2(const char*, IOSystem*, const aiScene*, const ExportProperties*);
+void ExportSceneGLB2(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 void ExportSceneAssbin(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 void ExportSceneAssxml(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 void ExportSceneX3D(const char*, IOSystem*, const aiScene*, const ExportProperties*);
@@ -151,6 +160,10 @@ Exporter::ExportFormatEntry gExporters[] =
         aiProcess_JoinIdenticalVertices | aiProcess_Triangulate | aiProcess_SortByPType ),
     Exporter::ExportFormatEntry( "gltf2", "GL Transmission Format v. 2", "gltf2", &ExportSceneGLTF2,
         aiProcess_JoinIdenticalVertices | aiProcess_Triangulate | aiProcess_SortByPType ),
+    // shares the .glb extension with "glb" above, which stays the glTF 1 exporter for
+    // lookups by extension. Select glTF 2 binary output by the id "glb2".
+    Exporter::ExportFormatEntry( "glb2", "GL Transmission Format v. 2 (binary)", "glb", &ExportSceneGLB2,
+        aiProcess_JoinIdenticalVertices | aiProcess_Triangulate | aiProcess_SortByPType ),
 #endif
 
 #ifndef ASSIMP_BUILD_NO_ASSBIN_EXPORTER
@@ -182,6 +195,19 @@ public:
     {
         GetPostProcessingStepInstanceList(mPostProcessingSteps);
 
+        // Allocate a SharedPostProcessInfo object and store pointers to it in all post-process steps in the list.
+        mPPShared = new SharedPostProcessInfo();
+        mSpatialSortBegin = mSpatialSortEnd = mPostProcessingSteps.size();
+        for( unsigned int a = 0; a < mPostProcessingSteps.size(); a++) {
+            mPostProcessingSteps[a]->SetSharedData(mPPShared);
+
+            if (dynamic_cast<ComputeSpatialSortProcess*>(mPostProcessingSteps[a])) {
+                mSpatialSortBegin = a;
+            } else if (dynamic_cast<DestroySpatialSortProcess*>(mPostProcessingSteps[a])) {
+                mSpatialSortEnd = a + 1;
+            }
+        }
+
         // grab all built-in exporters
         if ( 0 != ( ASSIMP_NUM_EXPORTERS ) ) {
             mExporters.resize( ASSIMP_NUM_EXPORTERS );
@@ -197,6 +223,7 @@ public:
         for( unsigned int a = 0; a < mPostProcessingSteps.size(); a++) {
             delete mPostProcessingSteps[a];
         }
+        delete mPPShared;
     }
 
 public:
@@ -207,6 +234,12 @@ public:
     /** Post processing steps we can apply at the imported data. */
     std::vector< BaseProcess* > mPostProcessingSteps;
 
+    /** Data shared by the post processing steps, e.g. the spatial sort. */
+    SharedPostProcessInfo* mPPShared;
+
+    /** Range of the steps using the shared spatial sort, see ComputeSpatialSortProcess. */
+    size_t mSpatialSortBegin, mSpatialSortEnd;
+
     /** Last fatal export error */
     std::string mError;
 
@@ -249,7 +282,7 @@ bool Exporter::IsDefaultIOHandler() const {
 
 // ------------------------------------------------------------------------------------------------
 const aiExportDataBlob* Exporter::ExportToBlob( const aiScene* pScene, const char* pFormatId,
-                                                unsigned int, const ExportProperties* /*pProperties*/ ) {
+                                                unsigned int pPreprocessing, const ExportProperties* pProperties ) {
     if (pimpl->blob) {
         delete pimpl->blob;
         pimpl->blob = NULL;
@@ -259,7 +292,7 @@ const aiExportDataBlob* Exporter::ExportToBlob( const aiScene* pScene, const cha
     BlobIOSystem* blobio = new BlobIOSystem();
     pimpl->mIOSystem = std::shared_ptr<IOSystem>( blobio );
 
-    if (AI_SUCCESS != Export(pScene,pFormatId,blobio->GetMagicFileName())) {
+    if (AI_SUCCESS != Export(pScene,pFormatId,blobio->GetMagicFileName(),pPreprocessing,pProperties)) {
         pimpl->mIOSystem = old;
         return NULL;
     }
@@ -270,17 +303,39 @@ const aiExportDataBlob* Exporter::ExportToBlob( const aiScene* pScene, const cha
     return pimpl->blob;
 }
 
+// ------------------------------------------------------------------------------------------------
+aiReturn Exporter::ExportToChunks( const aiScene* pScene, const char* pFormatId, ExportChunkHandler* pHandler,
+                                   unsigned int pPreprocessing, const ExportProperties* pProperties ) {
+    ai_assert(NULL != pHandler);
+
+    std::shared_ptr<IOSystem> old = pimpl->mIOSystem;
+    BlobIOSystem* blobio = new BlobIOSystem(pHandler);
+    pimpl->mIOSystem = std::shared_ptr<IOSystem>( blobio );
+
+    aiReturn ret = Export(pScene,pFormatId,blobio->GetMagicFileName(),pPreprocessing,pProperties);
+    if (AI_SUCCESS == ret && blobio->HasFailed()) {
+        pimpl->mError = "The chunk handler failed";
+        ret = AI_FAILURE;
+    }
+
+    pimpl->mIOSystem = old;
+    return ret;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool IsVerboseFormat(const aiMesh* mesh) {
-    // avoid slow vector<bool> specialization
-    std::vector<unsigned int> seen(mesh->mNumVertices,0);
+    // one bit per vertex, set when the first index to it is seen
+    std::vector<uint32_t> seen((mesh->mNumVertices + 31) / 32, 0);
     for(unsigned int i = 0; i < mesh->mNumFaces; ++i) {
         const aiFace& f = mesh->mFaces[i];
         for(unsigned int j = 0; j < f.mNumIndices; ++j) {
-            if(++seen[f.mIndices[j]] == 2) {
+            const unsigned int idx = f.mIndices[j];
+            const uint32_t bit = 1u << (idx & 31);
+            if(seen[idx >> 5] & bit) {
                 // found a duplicate index
                 return false;
             }
+            seen[idx >> 5] |= bit;
         }
     }
     return true;
@@ -297,119 +352,391 @@ bool IsVerboseFormat(const aiScene* pScene) {
 }
 
 // ------------------------------------------------------------------------------------------------
-aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const char* pPath, unsigned int pPreprocessing, const ExportProperties* pProperties) {
-    ASSIMP_BEGIN_EXCEPTION_REGION();
+// Like IsVerboseFormat(), but checks all meshes and stores the result for each of them in pVerbose,
+// they are needed per mesh afterwards. If pVerbose is filled already, it is used as it is. With
+// private data, the result for each mesh is taken from the facts recorded there, and recorded
+// if it isn't known yet. The caller holds the export mutex of the scene.
+static bool IsVerboseFormat(const aiScene* pScene, ScenePrivateData* priv, std::vector<bool>& pVerbose) {
+    if (pVerbose.size() != pScene->mNumMeshes) {
+        pVerbose.resize(pScene->mNumMeshes);
+        if (priv) {
+            priv->mMeshFacts.resize(pScene->mNumMeshes);
+        }
+        for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            const aiMesh* mesh = pScene->mMeshes[i];
+            if (!priv) {
+                pVerbose[i] = IsVerboseFormat(mesh);
+                continue;
+            }
+            MeshFacts& facts = priv->mMeshFacts[i];
+            if (!facts.Matches(mesh)) {
+                facts = MeshFacts(mesh, IsVerboseFormat(mesh));
+            }
+            pVerbose[i] = facts.mVerbose;
+        }
+    }
+    return std::find(pVerbose.begin(), pVerbose.end(), false) == pVerbose.end();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Post-processing steps which modify nothing but the meshes, the mesh array and the node graph of
+// a scene. The scene copy made for them shares all other parts with the source scene.
+static const unsigned int GeometryOnlySteps = aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices
+    | aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_GenSmoothNormals | aiProcess_SplitLargeMeshes
+    | aiProcess_ValidateDataStructure | aiProcess_ImproveCacheLocality | aiProcess_FixInfacingNormals
+    | aiProcess_SortByPType | aiProcess_FindDegenerates | aiProcess_LimitBoneWeights | aiProcess_FindInstances
+    | aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph | aiProcess_FlipWindingOrder | aiProcess_SplitByBoneCount
+    | aiProcess_Debone;
+
+// ------------------------------------------------------------------------------------------------
+// Copies the meshes and the node graph of a scene, all other arrays are shared with the source.
+static void CopySceneGeometry(aiScene** _dest, const aiScene* src) {
+    aiScene* dest = *_dest = new aiScene();
+
+    dest->mNumMeshes = src->mNumMeshes;
+    if (dest->mNumMeshes) {
+        dest->mMeshes = new aiMesh*[dest->mNumMeshes];
+        for (unsigned int i = 0; i < dest->mNumMeshes; ++i) {
+            SceneCombiner::Copy(&dest->mMeshes[i], src->mMeshes[i]);
+        }
+    }
+    SceneCombiner::Copy(&dest->mRootNode, src->mRootNode);
+
+    dest->mNumAnimations = src->mNumAnimations;
+    dest->mAnimations = src->mAnimations;
+    dest->mNumTextures = src->mNumTextures;
+    dest->mTextures = src->mTextures;
+    dest->mNumMaterials = src->mNumMaterials;
+    dest->mMaterials = src->mMaterials;
+    dest->mNumLights = src->mNumLights;
+    dest->mLights = src->mLights;
+    dest->mNumCameras = src->mNumCameras;
+    dest->mCameras = src->mCameras;
+
+    dest->mFlags = src->mFlags;
+    ScenePriv(dest)->mPPStepsApplied = ScenePriv(src) ? ScenePriv(src)->mPPStepsApplied : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Deletes a scene copy, but leaves the parts it shares with its source scene alone.
+// A copy of a copy keeps its source alive as long as it shares parts of it.
+struct SceneCopyDeleter {
+    explicit SceneCopyDeleter(bool shared = false, const std::shared_ptr<const aiScene>& source = std::shared_ptr<const aiScene>())
+    : mShared(shared)
+    , mSource(shared ? source : std::shared_ptr<const aiScene>()) {
+        // empty
+    }
+
+    void operator()(aiScene* scene) const {
+        if (mShared) {
+            scene->mNumAnimations = 0;
+            scene->mAnimations = NULL;
+            scene->mNumTextures = 0;
+            scene->mTextures = NULL;
+            scene->mNumMaterials = 0;
+            scene->mMaterials = NULL;
+            scene->mNumLights = 0;
+            scene->mLights = NULL;
+            scene->mNumCameras = 0;
+            scene->mCameras = NULL;
+        }
+        delete scene;
+    }
+
+    bool mShared;
+    std::shared_ptr<const aiScene> mSource;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Runs the post-processing steps [pBegin, pEnd) of the step list which are active for pFlags on a
+// scene, with the shared data Importer::ApplyPostProcessing() uses.
+static void ApplyPostProcessing(ExporterPimpl* pimpl, aiScene* pScene, unsigned int pFlags, size_t pBegin, size_t pEnd) {
+    pimpl->mPPShared->Clean();
+    for( size_t a = pBegin; a < pEnd; a++) {
+        BaseProcess* const p = pimpl->mPostProcessingSteps[a];
+        if (p->IsActive(pFlags)) {
+            p->Execute(pScene);
+        }
+    }
+    pimpl->mPPShared->Clean();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the end of the group of steps starting at a. The steps which use the shared spatial sort
+// form one group with the steps computing and destroying it, the scene must not be copied in between.
+static size_t NextStepGroup(const ExporterPimpl* pimpl, size_t a) {
+    return a == pimpl->mSpatialSortBegin ? pimpl->mSpatialSortEnd : a + 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether the same steps of [pBegin, pEnd) are active for two sets of flags.
+static bool IsSameSteps(const ExporterPimpl* pimpl, unsigned int pFlags1, unsigned int pFlags2, size_t pBegin, size_t pEnd) {
+    for( size_t a = pBegin; a < pEnd; a++) {
+        const BaseProcess* const p = pimpl->mPostProcessingSteps[a];
+        if (p->IsActive(pFlags1) != p->IsActive(pFlags2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the post-processing steps an exporter has to run on a scene, zero if the scene can be
+// exported as it is. pVerbose receives which meshes are verbose once that had to be checked.
+// The caller holds the export mutex of the scene.
+static unsigned int GetExportSteps(ExporterPimpl* pimpl, const aiScene* pScene, ScenePrivateData* priv,
+        unsigned int pFlags, std::vector<bool>& pVerbose, bool& pVerbosify) {
+    // steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
+    // original state before the step was applied first. When checking which steps we don't need
+    // to run, those are excluded.
+    const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
+
+    // Erase all pp steps that were already applied to this scene
+    const unsigned int pp = pFlags & ~(priv && !priv->mIsCopy
+        ? (priv->mPPStepsApplied & ~nonIdempotentSteps)
+        : 0u);
+
+    // If no extra post-processing was specified, and we obtained this scene from an
+    // Assimp importer, apply the reverse steps automatically.
+    // TODO: either drop this, or document it. Otherwise it is just a bad surprise.
+    //if (!pPreprocessing && priv) {
+    //  pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
+    //}
+
+    pVerbosify = false;
+    if (!pp) {
+        return 0;
+    }
 
     // when they create scenes from scratch, users will likely create them not in verbose
     // format. They will likely not be aware that there is a flag in the scene to indicate
     // this, however. To avoid surprises and bug reports, we check for duplicates in
-    // meshes upfront.
-    const bool is_verbose_format = !(pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) || IsVerboseFormat(pScene);
+    // meshes upfront. The result is remembered per mesh, so this is done once per scene.
+    if ((pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) && !IsVerboseFormat(pScene, priv, pVerbose)) {
+        // If the input scene is not in verbose format, but there is at least post-processing step that
+        // relies on it, we need to run the MakeVerboseFormat step first.
+        for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
+            BaseProcess* const p = pimpl->mPostProcessingSteps[a];
+
+            if (p->IsActive(pp) && p->RequireVerboseFormat()) {
+                pVerbosify = true;
+                break;
+            }
+        }
+    }
+
+    // Joining the vertices again restores the indexed layout of the input scene. It runs as part
+    // of the pipeline, so it shares the spatial sort with the normal and tangent steps.
+    return pVerbosify ? (pp | aiProcess_JoinIdenticalVertices) : pp;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies a scene for post-processing with pSteps. Steps which work on the geometry alone get a copy
+// of the meshes and the node graph, everything else stays shared with the source, which the copy
+// keeps alive if it is a copy itself.
+static std::shared_ptr<aiScene> CopyForExport(const aiScene* pScene, unsigned int pSteps,
+        const std::shared_ptr<const aiScene>& pSource = std::shared_ptr<const aiScene>()) {
+    const bool geometry_only = !(pSteps & ~GeometryOnlySteps);
+    aiScene* scenecopy_tmp = NULL;
+    if (geometry_only) {
+        CopySceneGeometry(&scenecopy_tmp,pScene);
+    } else {
+        SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
+    }
+    return std::shared_ptr<aiScene>(scenecopy_tmp, SceneCopyDeleter(geometry_only, pSource));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Makes the meshes of a scene copy verbose which share vertices in the source scene, as found by
+// IsVerboseFormat().
+static void MakeVerboseCopy(aiScene* pScene, const std::vector<bool>& pVerbose) {
+    DefaultLogger::get()->debug("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
+
+    // the copy has the meshes in the same order as the source
+    MakeVerboseFormatProcess proc;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (!pVerbose[i]) {
+            proc.MakeVerboseFormat(pScene->mMeshes[i]);
+        }
+    }
+    pScene->mFlags &= ~AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
+}
+
+// ------------------------------------------------------------------------------------------------
+// One output of an export: the exporter, the steps it needs and the scene it gets.
+struct ExportJob {
+    ExportJob()
+    : mEntry()
+    , mTarget()
+    , mSteps()
+    , mVerbosify() {
+        // empty
+    }
+
+    const Exporter::ExportFormatEntry* mEntry;
+    const Exporter::ExportTarget* mTarget;
+    unsigned int mSteps;
+    bool mVerbosify;
+    std::shared_ptr<const aiScene> mScene;
+    std::string mError;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Runs the post-processing of a group of jobs on pScene, starting at step pBegin. The steps the jobs
+// have in common run once, the scene is copied only where their steps differ.
+static void PrepareJobGroup(ExporterPimpl* pimpl, std::shared_ptr<aiScene> pScene, size_t pBegin,
+        const std::vector<ExportJob*>& pJobs) {
+    const size_t numSteps = pimpl->mPostProcessingSteps.size();
+    const unsigned int flags = pJobs.front()->mSteps;
+
+    size_t end = pBegin;
+    for (bool same = true; same && end < numSteps; ) {
+        const size_t next = NextStepGroup(pimpl, end);
+        for (const ExportJob* job : pJobs) {
+            same = same && IsSameSteps(pimpl, flags, job->mSteps, end, next);
+        }
+        if (same) {
+            end = next;
+        }
+    }
+    ApplyPostProcessing(pimpl, pScene.get(), flags, pBegin, end);
+
+    // jobs without further steps get the scene as it is, the rest is grouped by the next steps
+    bool used = false;
+    unsigned int steps = 0;
+    std::vector< std::vector<ExportJob*> > groups;
+    for (ExportJob* job : pJobs) {
+        steps |= job->mSteps;
+        if (IsSameSteps(pimpl, job->mSteps, 0u, end, numSteps)) {
+            ScenePriv(pScene.get())->mPPStepsApplied |= job->mSteps;
+            job->mScene = pScene;
+            used = true;
+            continue;
+        }
+
+        const size_t next = NextStepGroup(pimpl, end);
+        std::vector< std::vector<ExportJob*> >::iterator it = groups.begin();
+        while (it != groups.end() && !IsSameSteps(pimpl, it->front()->mSteps, job->mSteps, end, next)) {
+            ++it;
+        }
+        if (it == groups.end()) {
+            groups.push_back(std::vector<ExportJob*>());
+            it = groups.end() - 1;
+        }
+        it->push_back(job);
+    }
+
+    // The scene is modified further by the last group, unless the scene is used by a job. Copies
+    // share data with it only if no group runs steps on more than the geometry.
+    for (size_t i = 0; i < groups.size(); ++i) {
+        std::shared_ptr<aiScene> scene = pScene;
+        if (used || i + 1 < groups.size()) {
+            scene = CopyForExport(pScene.get(), steps, pScene);
+        }
+        PrepareJobGroup(pimpl, scene, end, groups[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Prepares the scenes for a list of jobs. Jobs which need no post-processing export the source
+// scene, the others share one copy up to where their post-processing steps differ.
+static void PrepareJobs(ExporterPimpl* pimpl, const aiScene* pScene, std::vector<ExportJob>& pJobs) {
+    // The scene stays const, but the exporter keeps its caches in the private data of the scene.
+    ScenePrivateData* const priv = const_cast<ScenePrivateData*>(ScenePriv(pScene));
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::unique_lock<std::mutex> lock;
+    if (priv) {
+        lock = std::unique_lock<std::mutex>(priv->mExportMutex);
+    }
+#endif
+
+    std::vector<bool> verbose;
+    std::vector<ExportJob*> roots[2];
+    unsigned int steps[2] = { 0, 0 };
+    for (ExportJob& job : pJobs) {
+        job.mSteps = GetExportSteps(pimpl, pScene, priv,
+            job.mEntry->mEnforcePP | job.mTarget->mPreprocessing, verbose, job.mVerbosify);
+        if (job.mSteps) {
+            roots[job.mVerbosify].push_back(&job);
+            steps[job.mVerbosify] |= job.mSteps;
+        }
+    }
+
+    for (unsigned int i = 0; i < 2; ++i) {
+        if (!roots[i].empty()) {
+            std::shared_ptr<aiScene> scenecopy = CopyForExport(pScene, steps[i]);
+            if (i) {
+                MakeVerboseCopy(scenecopy.get(), verbose);
+            }
+            PrepareJobGroup(pimpl, scenecopy, 0, roots[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Prepares a scene for an exporter which needs the post-processing steps given by pFlags.
+// Returns the post-processed copy of the scene, or NULL if the scene can be exported as it is.
+static std::shared_ptr<const aiScene> PrepareScene(ExporterPimpl* pimpl, const aiScene* pScene,
+        unsigned int pFlags, bool pKeep) {
+    // The scene stays const, but the exporter keeps its caches in the private data of the scene.
+    ScenePrivateData* const priv = const_cast<ScenePrivateData*>(ScenePriv(pScene));
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::unique_lock<std::mutex> lock;
+    if (priv) {
+        lock = std::unique_lock<std::mutex>(priv->mExportMutex);
+    }
+#endif
+
+    if (priv && !pKeep) {
+        priv->mPreparedScene.reset();
+    }
+
+    ExportJob job;
+    std::vector<bool> verbose;
+    job.mSteps = GetExportSteps(pimpl, pScene, priv, pFlags, verbose, job.mVerbosify);
+    if (!job.mSteps) {
+        return std::shared_ptr<const aiScene>();
+    }
+
+    if (priv && priv->mPreparedScene && priv->mPreparedSteps == job.mSteps) {
+        DefaultLogger::get()->debug("export: Reusing the post-processed copy of the scene");
+        return priv->mPreparedScene;
+    }
+
+    std::shared_ptr<aiScene> scenecopy = CopyForExport(pScene, job.mSteps);
+    if (job.mVerbosify) {
+        MakeVerboseCopy(scenecopy.get(), verbose);
+    }
+    PrepareJobGroup(pimpl, scenecopy, 0, std::vector<ExportJob*>(1, &job));
+
+    if (priv && pKeep) {
+        priv->mPreparedScene = job.mScene;
+        priv->mPreparedSteps = job.mSteps;
+    }
+    return job.mScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const char* pPath, unsigned int pPreprocessing, const ExportProperties* pProperties) {
+    ASSIMP_BEGIN_EXCEPTION_REGION();
 
     pimpl->mError = "";
     for (size_t i = 0; i < pimpl->mExporters.size(); ++i) {
         const Exporter::ExportFormatEntry& exp = pimpl->mExporters[i];
         if (!strcmp(exp.mDescription.id,pFormatId)) {
             try {
-                // Always create a full copy of the scene. We might optimize this one day,
-                // but for now it is the most pragmatic way.
-                aiScene* scenecopy_tmp = NULL;
-                SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
-
-                std::unique_ptr<aiScene> scenecopy(scenecopy_tmp);
-                const ScenePrivateData* const priv = ScenePriv(pScene);
-
-                // steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
-                // original state before the step was applied first. When checking which steps we don't need
-                // to run, those are excluded.
-                const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
-
-                // Erase all pp steps that were already applied to this scene
-                const unsigned int pp = (exp.mEnforcePP | pPreprocessing) & ~(priv && !priv->mIsCopy
-                    ? (priv->mPPStepsApplied & ~nonIdempotentSteps)
-                    : 0u);
-
-                // If no extra post-processing was specified, and we obtained this scene from an
-                // Assimp importer, apply the reverse steps automatically.
-                // TODO: either drop this, or document it. Otherwise it is just a bad surprise.
-                //if (!pPreprocessing && priv) {
-                //  pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
-                //}
-
-                // If the input scene is not in verbose format, but there is at least post-processing step that relies on it,
-                // we need to run the MakeVerboseFormat step first.
-                bool must_join_again = false;
-                if (!is_verbose_format) {
-                    bool verbosify = false;
-                    for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-                        BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-                        if (p->IsActive(pp) && p->RequireVerboseFormat()) {
-                            verbosify = true;
-                            break;
-                        }
-                    }
-
-                    if (verbosify || (exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
-                        DefaultLogger::get()->debug("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
-
-                        MakeVerboseFormatProcess proc;
-                        proc.Execute(scenecopy.get());
-
-                        if(!(exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
-                            must_join_again = true;
-                        }
-                    }
-                }
-
-                if (pp) {
-                    // the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
-                    {
-                        FlipWindingOrderProcess step;
-                        if (step.IsActive(pp)) {
-                            step.Execute(scenecopy.get());
-                        }
-                    }
-
-                    {
-                        FlipUVsProcess step;
-                        if (step.IsActive(pp)) {
-                            step.Execute(scenecopy.get());
-                        }
-                    }
-
-                    {
-                        MakeLeftHandedProcess step;
-                        if (step.IsActive(pp)) {
-                            step.Execute(scenecopy.get());
-                        }
-                    }
-
-                    // dispatch other processes
-                    for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-                        BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-                        if (p->IsActive(pp)
-                            && !dynamic_cast<FlipUVsProcess*>(p)
-                            && !dynamic_cast<FlipWindingOrderProcess*>(p)
-                            && !dynamic_cast<MakeLeftHandedProcess*>(p)) {
-
-                            p->Execute(scenecopy.get());
-                        }
-                    }
-                    ScenePrivateData* const privOut = ScenePriv(scenecopy.get());
-                    ai_assert(privOut);
-
-                    privOut->mPPStepsApplied |= pp;
+                ExportProperties emptyProperties;  // Never pass NULL ExportProperties so Exporters don't have to worry.
+                if (!pProperties) {
+                    pProperties = &emptyProperties;
                 }
 
-                if(must_join_again) {
-                    JoinVerticesProcess proc;
-                    proc.Execute(scenecopy.get());
-                }
+                // Only create a copy of the scene if something is going to modify it.
+                const std::shared_ptr<const aiScene> prepared = PrepareScene(pimpl, pScene, exp.mEnforcePP | pPreprocessing,
+                    pProperties->GetPropertyBool(AI_CONFIG_EXPORT_REUSE_PREPARED_SCENE, false));
 
-                ExportProperties emptyProperties;  // Never pass NULL ExportProperties so Exporters don't have to worry.
-                exp.mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.get(), pProperties ? pProperties : &emptyProperties);
+                exp.mExportFunction(pPath,pimpl->mIOSystem.get(),prepared ? prepared.get() : pScene, pProperties);
             } catch (DeadlyExportError& err) {
                 pimpl->mError = err.what();
                 return AI_FAILURE;
@@ -424,6 +751,66 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
     return AI_FAILURE;
 }
 
+// ------------------------------------------------------------------------------------------------
+aiReturn Exporter::Export( const aiScene* pScene, const std::vector<ExportTarget>& pTargets) {
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    pimpl->mError = "";
+    std::vector<ExportJob> jobs(pTargets.size());
+    for (size_t i = 0; i < pTargets.size(); ++i) {
+        jobs[i].mTarget = &pTargets[i];
+        for (const ExportFormatEntry& exp : pimpl->mExporters) {
+            if (!strcmp(exp.mDescription.id,pTargets[i].mFormatId)) {
+                jobs[i].mEntry = &exp;
+                break;
+            }
+        }
+        if (!jobs[i].mEntry) {
+            pimpl->mError = std::string("Found no exporter to handle this file format: ") + pTargets[i].mFormatId;
+            return AI_FAILURE;
+        }
+    }
+
+    try {
+        PrepareJobs(pimpl, pScene, jobs);
+    } catch (DeadlyExportError& err) {
+        pimpl->mError = err.what();
+        return AI_FAILURE;
+    }
+
+    // The exporters run concurrently on the fewest threads any target asks for,
+    // unless a custom IO handler has to be called from one thread.
+    ExportProperties emptyProperties;  // Never pass NULL ExportProperties so Exporters don't have to worry.
+    unsigned int numThreads = 0;
+    for (const ExportJob& job : jobs) {
+        const int n = job.mTarget->mProperties ? job.mTarget->mProperties->GetPropertyInteger(AI_CONFIG_EXPORT_NUM_THREADS, 0) : 0;
+        if (n > 0 && (!numThreads || static_cast<unsigned int>(n) < numThreads)) {
+            numThreads = n;
+        }
+    }
+    ParallelFor(jobs.size(), pimpl->mIsDefaultIOHandler ? numThreads : 1u, [&](size_t i) {
+        ExportJob& job = jobs[i];
+        try {
+            job.mEntry->mExportFunction(job.mTarget->mPath, pimpl->mIOSystem.get(),
+                job.mScene ? job.mScene.get() : pScene,
+                job.mTarget->mProperties ? job.mTarget->mProperties : &emptyProperties);
+        } catch (DeadlyExportError& err) {
+            job.mError = err.what();
+        }
+        job.mScene.reset();
+    });
+
+    for (const ExportJob& job : jobs) {
+        if (!job.mError.empty()) {
+            pimpl->mError += (pimpl->mError.empty() ? "" : "\n") + std::string(job.mTarget->mFormatId) + ": " + job.mError;
+        }
+    }
+    return pimpl->mError.empty() ? AI_SUCCESS : AI_FAILURE;
+
+    ASSIMP_END_EXCEPTION_REGION(aiReturn);
+    return AI_FAILURE;
+}
+
 // ------------------------------------------------------------------------------------------------
 const char* Exporter::GetErrorString() const {
     return pimpl->mError.c_str();
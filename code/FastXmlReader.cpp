@@ -0,0 +1,601 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  FastXmlReader.cpp
+ *  @brief Implementation of the in-situ XML pull reader.
+ */
+#include "FastXmlReader.h"
+#include "BaseImporter.h"
+#include "fast_atof.h"
+#include <assimp/IOStream.hpp>
+
+#include <string.h>
+
+using namespace Assimp;
+using namespace irr::io;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsXmlSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// ------------------------------------------------------------------------------------------------
+// Encodes a code point as UTF8, returns the number of bytes written.
+unsigned int EncodeUTF8(unsigned int cp, char* out) {
+    if (cp < 0x80) {
+        out[0] = static_cast<char>(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (cp >> 6));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (cp >> 12));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (cp >> 18));
+    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+char EmptyString[] = "";
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+FastXmlReader::FastXmlReader(IOStream* stream)
+: mBuffer()
+, mP(NULL)
+, mTagPending(false)
+, mNodeType(EXN_NONE)
+, mSourceFormat(ETF_ASCII)
+, mNodeName(EmptyString)
+, mNodeDecoded(true)
+, mIsEmptyElement(false)
+, mAttributes() {
+    ai_assert(NULL != stream);
+
+    mBuffer.resize(stream->FileSize());
+    if (!mBuffer.empty()) {
+        stream->Read(&mBuffer[0], mBuffer.size(), 1);
+    }
+    setup();
+}
+
+// ------------------------------------------------------------------------------------------------
+FastXmlReader::FastXmlReader(const char* data, size_t length)
+: mBuffer(data, data + length)
+, mP(NULL)
+, mTagPending(false)
+, mNodeType(EXN_NONE)
+, mSourceFormat(ETF_ASCII)
+, mNodeName(EmptyString)
+, mNodeDecoded(true)
+, mIsEmptyElement(false)
+, mAttributes() {
+    setup();
+}
+
+// ------------------------------------------------------------------------------------------------
+FastXmlReader::~FastXmlReader() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastXmlReader::setup() {
+    // Remove null characters from the input sequence otherwise the parsing will utterly fail
+    size_t size = 0;
+    for (size_t i = 0; i < mBuffer.size(); ++i) {
+        if (mBuffer[i] != '\0') {
+            mBuffer[size++] = mBuffer[i];
+        }
+    }
+    mBuffer.resize(size);
+
+    // For UTF16 files containing ASCII only, removing the null characters
+    // leaves the byte order mark as the only remainder of the encoding.
+    if (size >= 2 && (uint8_t)mBuffer[0] == 0xFF && (uint8_t)mBuffer[1] == 0xFE) {
+        mSourceFormat = ETF_UTF16_LE;
+        mBuffer.erase(mBuffer.begin(), mBuffer.begin() + 2);
+    } else if (size >= 2 && (uint8_t)mBuffer[0] == 0xFE && (uint8_t)mBuffer[1] == 0xFF) {
+        mSourceFormat = ETF_UTF16_BE;
+        mBuffer.erase(mBuffer.begin(), mBuffer.begin() + 2);
+    } else if (size >= 3 && (uint8_t)mBuffer[0] == 0xEF && (uint8_t)mBuffer[1] == 0xBB && (uint8_t)mBuffer[2] == 0xBF) {
+        mSourceFormat = ETF_UTF8;
+    }
+    BaseImporter::ConvertToUTF8(mBuffer);
+
+    // Two terminators so the parser may always look one character ahead
+    mBuffer.push_back('\0');
+    mBuffer.push_back('\0');
+    mP = &mBuffer[0];
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FastXmlReader::read() {
+    if (!mTagPending) {
+        char* start = mP;
+
+        // move forward until '<' found
+        while (*mP && *mP != '<') {
+            ++mP;
+        }
+
+        // Trailing text after the last tag is not reported
+        if (!*mP) {
+            return false;
+        }
+
+        // The '<' is about to be overwritten by the terminator of the text,
+        // so remember that we already consumed it.
+        ++mP;
+        mTagPending = true;
+        if (mP - 1 != start && setText(start, mP - 1)) {
+            return true;
+        }
+    }
+
+    mTagPending = false;
+    mNodeDecoded = true;
+
+    // based on current token, parse and report next element
+    switch (*mP) {
+    case '/':
+        parseClosingElement();
+        break;
+    case '?':
+        parseDefinition();
+        break;
+    case '!':
+        if (!parseCDATA()) {
+            parseComment();
+        }
+        break;
+    default:
+        parseOpeningElement();
+        break;
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FastXmlReader::setText(char* begin, char* end) {
+    // IrrXML skips whitespace-only texts shorter than 3 characters, mimic this
+    // so the sequence of reported nodes is identical.
+    if (end - begin < 3) {
+        char* p = begin;
+        for (; p != end; ++p) {
+            if (!IsXmlSpace(*p)) {
+                break;
+            }
+        }
+        if (p == end) {
+            return false;
+        }
+    }
+
+    *end = '\0';
+    mNodeName = begin;
+    mNodeDecoded = false;
+    mNodeType = EXN_TEXT;
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastXmlReader::parseDefinition() {
+    mNodeType = EXN_UNKNOWN;
+    mNodeName = EmptyString;
+
+    // move until end marked with '>' reached
+    while (*mP && *mP != '>') {
+        ++mP;
+    }
+    if (*mP) {
+        ++mP;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastXmlReader::parseComment() {
+    mNodeType = EXN_COMMENT;
+    mNodeName = EmptyString;
+    ++mP;
+
+    if (mP[0] == '-' && mP[1] == '-') {
+        // regular comment, search for the closing "-->"
+        char* begin = mP + 2;
+        char* end = strstr(begin, "-->");
+        if (NULL == end) {
+            mP += strlen(mP);
+            return;
+        }
+        *end = '\0';
+        mNodeName = begin;
+        mP = end + 3;
+        return;
+    }
+
+    // some other declaration like <!DOCTYPE ..>, which may be nested
+    char* begin = mP;
+    int count = 1;
+    while (*mP && count) {
+        if (*mP == '>') {
+            --count;
+        } else if (*mP == '<') {
+            ++count;
+        }
+        ++mP;
+    }
+    if (!count) {
+        mP[-1] = '\0';
+        mNodeName = begin;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FastXmlReader::parseCDATA() {
+    if (mP[1] != '[') {
+        return false;
+    }
+
+    mNodeType = EXN_CDATA;
+    mNodeName = EmptyString;
+
+    // skip '![CDATA['
+    for (int count = 0; *mP && count < 8; ++count) {
+        ++mP;
+    }
+
+    char* begin = mP;
+    char* end = strstr(begin, "]]>");
+    if (NULL == end) {
+        mP += strlen(mP);
+        return true;
+    }
+
+    *end = '\0';
+    mNodeName = begin;
+    mP = end + 3;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastXmlReader::parseOpeningElement() {
+    mNodeType = EXN_ELEMENT;
+    mIsEmptyElement = false;
+    mAttributes.clear();
+
+    char* startName = mP;
+
+    // find end of element name
+    while (*mP && *mP != '>' && !IsXmlSpace(*mP)) {
+        ++mP;
+    }
+    char* endName = mP;
+
+    // find attributes, each name and value is terminated in place as soon as
+    // its closing quote is found. The element name is terminated last, its end
+    // character may be the '>' or '/' the loop still has to see.
+    while (*mP && *mP != '>') {
+        if (IsXmlSpace(*mP)) {
+            ++mP;
+            continue;
+        }
+
+        if (*mP == '/') {
+            // tag is closed directly
+            ++mP;
+            mIsEmptyElement = true;
+            break;
+        }
+
+        // read the attribute name
+        char* attributeNameBegin = mP;
+        while (*mP && !IsXmlSpace(*mP) && *mP != '=') {
+            ++mP;
+        }
+        char* attributeNameEnd = mP;
+        if (!*mP) {
+            break;
+        }
+        ++mP;
+
+        // read the attribute value, check for quotes and single quotes
+        while (*mP && *mP != '\"' && *mP != '\'') {
+            ++mP;
+        }
+        if (!*mP) {
+            // malformatted xml file
+            break;
+        }
+
+        const char quote = *mP++;
+        char* attributeValueBegin = mP;
+        while (*mP && *mP != quote) {
+            ++mP;
+        }
+        if (!*mP) {
+            // malformatted xml file
+            break;
+        }
+
+        *attributeNameEnd = '\0';
+        *mP++ = '\0';
+
+        Attribute attr;
+        attr.mName = attributeNameBegin;
+        attr.mValue = attributeValueBegin;
+        attr.mDecoded = false;
+        mAttributes.push_back(attr);
+    }
+
+    // check if this tag is closing directly
+    if (endName > startName && endName[-1] == '/') {
+        mIsEmptyElement = true;
+        --endName;
+    }
+
+    if (*mP) {
+        ++mP;
+    }
+
+    *endName = '\0';
+    mNodeName = startName;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastXmlReader::parseClosingElement() {
+    mNodeType = EXN_ELEMENT_END;
+    mIsEmptyElement = false;
+    mAttributes.clear();
+
+    ++mP;
+    char* begin = mP;
+    while (*mP && *mP != '>') {
+        ++mP;
+    }
+
+    // remove trailing whitespace, if any
+    char* end = mP;
+    while (end > begin && IsXmlSpace(end[-1])) {
+        --end;
+    }
+
+    if (*mP) {
+        ++mP;
+    }
+
+    *end = '\0';
+    mNodeName = begin;
+}
+
+// ------------------------------------------------------------------------------------------------
+const FastXmlReader::Attribute* FastXmlReader::findAttribute(const char* name) const {
+    if (NULL == name) {
+        return NULL;
+    }
+
+    for (std::vector<Attribute>::const_iterator it = mAttributes.begin(); it != mAttributes.end(); ++it) {
+        if (0 == ::strcmp((*it).mName, name)) {
+            return &(*it);
+        }
+    }
+
+    return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* FastXmlReader::decoded(char* str, bool& isDecoded) const {
+    if (!isDecoded) {
+        decodeEntities(str);
+        isDecoded = true;
+    }
+    return str;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastXmlReader::decodeEntities(char* str) {
+    char* in = ::strchr(str, '&');
+    if (NULL == in) {
+        return;
+    }
+
+    // All replacements are shorter than the entities, so we can work in place
+    char* out = in;
+    while (*in) {
+        if (*in != '&') {
+            *out++ = *in++;
+            continue;
+        }
+
+        if (in[1] == '#') {
+            // numeric character reference
+            const bool hex = (in[2] == 'x' || in[2] == 'X');
+            const char* digits = hex ? in + 3 : in + 2;
+            const char* end = digits;
+            const unsigned int cp = hex ? strtoul16(digits, &end) : strtoul10(digits, &end);
+            if (*end == ';' && end > digits && cp > 0 && cp <= 0x10FFFF) {
+                out += EncodeUTF8(cp, out);
+                in = const_cast<char*>(end) + 1;
+                continue;
+            }
+        } else {
+            static const struct {
+                const char* mName;
+                size_t mLength;
+                char mChar;
+            } Entities[] = {
+                { "amp;",  4, '&'  },
+                { "lt;",   3, '<'  },
+                { "gt;",   3, '>'  },
+                { "quot;", 5, '\"' },
+                { "apos;", 5, '\'' }
+            };
+
+            bool found = false;
+            for (size_t i = 0; i < sizeof(Entities) / sizeof(Entities[0]); ++i) {
+                if (0 == ::strncmp(in + 1, Entities[i].mName, Entities[i].mLength)) {
+                    *out++ = Entities[i].mChar;
+                    in += Entities[i].mLength + 1;
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                continue;
+            }
+        }
+
+        // unknown entity, keep it as it is
+        *out++ = *in++;
+    }
+    *out = '\0';
+}
+
+// ------------------------------------------------------------------------------------------------
+EXML_NODE FastXmlReader::getNodeType() const {
+    return mNodeType;
+}
+
+// ------------------------------------------------------------------------------------------------
+int FastXmlReader::getAttributeCount() const {
+    return static_cast<int>(mAttributes.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* FastXmlReader::getAttributeName(int idx) const {
+    if (idx < 0 || idx >= static_cast<int>(mAttributes.size())) {
+        return NULL;
+    }
+
+    return mAttributes[idx].mName;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* FastXmlReader::getAttributeValue(int idx) const {
+    if (idx < 0 || idx >= static_cast<int>(mAttributes.size())) {
+        return NULL;
+    }
+
+    const Attribute& attr = mAttributes[idx];
+    return decoded(attr.mValue, attr.mDecoded);
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* FastXmlReader::getAttributeValue(const char* name) const {
+    const Attribute* attr = findAttribute(name);
+    if (NULL == attr) {
+        return NULL;
+    }
+
+    return decoded(attr->mValue, attr->mDecoded);
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* FastXmlReader::getAttributeValueSafe(const char* name) const {
+    const char* value = getAttributeValue(name);
+    return NULL == value ? EmptyString : value;
+}
+
+// ------------------------------------------------------------------------------------------------
+int FastXmlReader::getAttributeValueAsInt(const char* name) const {
+    return static_cast<int>(getAttributeValueAsFloat(name));
+}
+
+// ------------------------------------------------------------------------------------------------
+int FastXmlReader::getAttributeValueAsInt(int idx) const {
+    return static_cast<int>(getAttributeValueAsFloat(idx));
+}
+
+// ------------------------------------------------------------------------------------------------
+float FastXmlReader::getAttributeValueAsFloat(const char* name) const {
+    const char* value = getAttributeValue(name);
+    if (NULL == value) {
+        return 0.f;
+    }
+
+    return static_cast<float>(fast_atof(value));
+}
+
+// ------------------------------------------------------------------------------------------------
+float FastXmlReader::getAttributeValueAsFloat(int idx) const {
+    const char* value = getAttributeValue(idx);
+    if (NULL == value) {
+        return 0.f;
+    }
+
+    return static_cast<float>(fast_atof(value));
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* FastXmlReader::getNodeName() const {
+    return decoded(mNodeName, mNodeDecoded);
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* FastXmlReader::getNodeData() const {
+    return decoded(mNodeName, mNodeDecoded);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FastXmlReader::isEmptyElement() const {
+    return mIsEmptyElement;
+}
+
+// ------------------------------------------------------------------------------------------------
+ETEXT_FORMAT FastXmlReader::getSourceFormat() const {
+    return mSourceFormat;
+}
+
+// ------------------------------------------------------------------------------------------------
+ETEXT_FORMAT FastXmlReader::getParserFormat() const {
+    return ETF_UTF8;
+}
@@ -0,0 +1,154 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  FastXmlReader.h
+ *  @brief In-situ implementation of the IrrXML pull reader interface.
+ */
+#ifndef INCLUDED_AI_FAST_XML_READER_H
+#define INCLUDED_AI_FAST_XML_READER_H
+
+#include <irrXML.h>
+#include <assimp/defs.h>
+
+#include <vector>
+#include <stddef.h>
+
+namespace Assimp {
+
+class IOStream;
+
+// ---------------------------------------------------------------------------------
+/** @brief Pull XML reader working directly on the loaded file buffer.
+ *
+ *  This is a drop-in replacement for the reader returned by
+ *  irr::io::createIrrXMLReader(). It exposes the very same pull interface
+ *  (irr::io::IrrXMLReader), so loaders do not need to change their parsing
+ *  code, but it avoids the costs of the original implementation:
+ *
+ *  - The file is read into memory exactly once. There is no second copy
+ *    for the character conversion of IrrXML.
+ *  - Node names, attribute names and attribute values are not copied into
+ *    separate strings. They are terminated in place and handed out as
+ *    pointers into the file buffer.
+ *  - XML entities (&amp;, &lt;, &#65; ...) are only decoded when a value
+ *    or text is actually requested. Decoding happens in place as well.
+ *
+ *  As with IrrXML, all returned strings remain valid until the next call
+ *  to read(), and the attributes of an element stay accessible while its
+ *  text, comment or CDATA children are read.
+ *
+ *  @code
+ *  std::unique_ptr<IOStream> file( pIOHandler->Open( pFile));
+ *  if( file.get() == NULL) {
+ *     throw DeadlyImportError( "Failed to open file " + pFile + ".");
+ *  }
+ *  mReader = new FastXmlReader( file.get());
+ *  @endcode
+ */
+class ASSIMP_API FastXmlReader : public irr::io::IrrXMLReader {
+public:
+    // ----------------------------------------------------------------------------------
+    /** @brief Reads the whole stream and converts it to UTF8.
+     *  @param stream   The stream to read from, must not be NULL. The stream
+     *                  is not needed anymore after construction. */
+    explicit FastXmlReader(IOStream* stream);
+
+    // ----------------------------------------------------------------------------------
+    /** @brief Parses a copy of the given memory block.
+     *  @param data     The XML text.
+     *  @param length   Length of the text in bytes. */
+    FastXmlReader(const char* data, size_t length);
+
+    // ----------------------------------------------------------------------------------
+    virtual ~FastXmlReader();
+
+    virtual bool read();
+    virtual irr::io::EXML_NODE getNodeType() const;
+    virtual int getAttributeCount() const;
+    virtual const char* getAttributeName(int idx) const;
+    virtual const char* getAttributeValue(int idx) const;
+    virtual const char* getAttributeValue(const char* name) const;
+    virtual const char* getAttributeValueSafe(const char* name) const;
+    virtual int getAttributeValueAsInt(const char* name) const;
+    virtual int getAttributeValueAsInt(int idx) const;
+    virtual float getAttributeValueAsFloat(const char* name) const;
+    virtual float getAttributeValueAsFloat(int idx) const;
+    virtual const char* getNodeName() const;
+    virtual const char* getNodeData() const;
+    virtual bool isEmptyElement() const;
+    virtual irr::io::ETEXT_FORMAT getSourceFormat() const;
+    virtual irr::io::ETEXT_FORMAT getParserFormat() const;
+
+private:
+    // Attribute stored as pointers into the buffer.
+    struct Attribute {
+        char* mName;
+        char* mValue;
+        mutable bool mDecoded;
+    };
+
+    void setup();
+    bool setText(char* begin, char* end);
+    void parseDefinition();
+    void parseComment();
+    bool parseCDATA();
+    void parseOpeningElement();
+    void parseClosingElement();
+    const Attribute* findAttribute(const char* name) const;
+    const char* decoded(char* str, bool& isDecoded) const;
+
+    static void decodeEntities(char* str);
+
+private:
+    std::vector<char> mBuffer;
+    char* mP;
+    bool mTagPending;
+    irr::io::EXML_NODE mNodeType;
+    irr::io::ETEXT_FORMAT mSourceFormat;
+    char* mNodeName;
+    mutable bool mNodeDecoded;
+    bool mIsEmptyElement;
+    std::vector<Attribute> mAttributes;
+};
+
+} // Namespace Assimp
+
+#endif // INCLUDED_AI_FAST_XML_READER_H
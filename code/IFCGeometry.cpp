@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 
 #include <iterator>
+#include <limits>
 
 namespace Assimp {
     namespace IFC {
@@ -810,8 +811,13 @@ bool ProcessGeometricItem(const IfcRepresentationItem& geo, unsigned int matid,
     aiMesh* const mesh = meshtmp->ToMesh();
     if(mesh) {
         mesh->mMaterialIndex = matid;
-        mesh_indices.push_back(static_cast<unsigned int>(conv.meshes.size()));
-        conv.meshes.push_back(mesh);
+
+        ConversionData::SharedData& shared = *conv.shared;
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(shared.mutex);
+#endif
+        mesh_indices.push_back(static_cast<unsigned int>(shared.meshes.size()));
+        shared.meshes.push_back(mesh);
         return true;
     }
     return false;
@@ -837,26 +843,75 @@ void AssignAddedMeshes(std::vector<unsigned int>& mesh_indices,aiNode* nd,
 }
 
 // ------------------------------------------------------------------------------------------------
+// Entries computed on behalf of an earlier part of the file are reused, waiting for them if need be.
+// Otherwise the caller claims the entry and must compute and publish it via PopulateMeshCache().
+// Later parts never hand their results to earlier ones, this keeps the result independent of the
+// order in which geometry tasks happen to run.
 bool TryQueryMeshCache(const IfcRepresentationItem& item,
     std::vector<unsigned int>& mesh_indices, unsigned int mat_index,
     ConversionData& conv)
 {
-    ConversionData::MeshCacheIndex idx(&item, mat_index);
-    ConversionData::MeshCache::const_iterator it = conv.cached_meshes.find(idx);
-    if (it != conv.cached_meshes.end()) {
-        std::copy((*it).second.begin(),(*it).second.end(),std::back_inserter(mesh_indices));
-        return true;
+    ConversionData::SharedData& shared = *conv.shared;
+    const ConversionData::MeshCacheIndex idx(&item, mat_index);
+    const size_t order = conv.journal->order;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::unique_lock<std::mutex> lock(shared.mutex);
+#endif
+    for(;;) {
+        ConversionData::MeshCache::iterator it = shared.cached_meshes.find(idx);
+        if (it == shared.cached_meshes.end() || (*it).second.owner > order) {
+            shared.cached_meshes[idx] = ConversionData::MeshCacheEntry(order);
+            return false;
+        }
+        if ((*it).second.ready) {
+            mesh_indices.push_back((*it).second.mesh);
+            conv.journal->meshes.push_back(ConversionData::Journal::MeshEvent(idx,(*it).second.mesh,true));
+            return true;
+        }
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        shared.mesh_cache_changed.wait(lock);
+#else
+        ai_assert(false);
+#endif
     }
-    return false;
 }
 
 // ------------------------------------------------------------------------------------------------
+// Publish the outcome of a claim made by TryQueryMeshCache(). first_new is the index of the first
+// entry in mesh_indices that was generated for item, a geometric item yields one mesh at most.
 void PopulateMeshCache(const IfcRepresentationItem& item,
-    const std::vector<unsigned int>& mesh_indices, unsigned int mat_index,
+    const std::vector<unsigned int>& mesh_indices, size_t first_new, unsigned int mat_index,
     ConversionData& conv)
 {
-    ConversionData::MeshCacheIndex idx(&item, mat_index);
-    conv.cached_meshes[idx] = mesh_indices;
+    ConversionData::SharedData& shared = *conv.shared;
+    const ConversionData::MeshCacheIndex idx(&item, mat_index);
+    const bool got = first_new < mesh_indices.size();
+    ai_assert(mesh_indices.size() <= first_new + 1);
+
+    {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(shared.mutex);
+#endif
+        ConversionData::MeshCache::iterator it = shared.cached_meshes.find(idx);
+
+        // an earlier part of the file may have taken over the entry meanwhile
+        if (it != shared.cached_meshes.end() && (*it).second.owner == conv.journal->order) {
+            if (got) {
+                (*it).second.mesh = mesh_indices[first_new];
+                (*it).second.ready = true;
+            }
+            else {
+                shared.cached_meshes.erase(it);
+            }
+        }
+    }
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    shared.mesh_cache_changed.notify_all();
+#endif
+
+    conv.journal->meshes.push_back(ConversionData::Journal::MeshEvent(idx,
+        got ? mesh_indices[first_new] : std::numeric_limits<unsigned int>::max(), false));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -868,17 +923,22 @@ bool ProcessRepresentationItem(const IfcRepresentationItem& item, unsigned int m
     unsigned int localmatid = ProcessMaterials(item.GetID(), matid, conv, true);
 
     if (!TryQueryMeshCache(item,mesh_indices,localmatid,conv)) {
-        if(ProcessGeometricItem(item,localmatid,mesh_indices,conv)) {
-            if(mesh_indices.size()) {
-                PopulateMeshCache(item,mesh_indices,localmatid,conv);
-            }
+        const size_t first_new = mesh_indices.size();
+        bool res;
+        try {
+            res = ProcessGeometricItem(item,localmatid,mesh_indices,conv);
         }
-        else return false;
+        catch(...) {
+            // release the claim, or anybody waiting for this entry would be stuck forever
+            PopulateMeshCache(item,mesh_indices,mesh_indices.size(),localmatid,conv);
+            throw;
+        }
+        PopulateMeshCache(item,mesh_indices,first_new,localmatid,conv);
+        return res;
     }
     return true;
 }
 
-
 } // ! IFC
 } // ! Assimp
 
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iterator>
 #include <limits>
 #include <tuple>
+#include <exception>
 
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_IFC
 #   include <contrib/unzip/unzip.h>
@@ -58,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFileReader.h"
 
 #include "IFCUtil.h"
+#include "ParallelFor.h"
 
 #include "MemoryIOWrapper.h"
 #include <assimp/scene.h>
@@ -98,6 +100,7 @@ namespace {
 void SetUnits(ConversionData& conv);
 void SetCoordinateSpace(ConversionData& conv);
 void ProcessSpatialStructures(ConversionData& conv);
+void ProcessProductGeometry(ConversionData& conv, unsigned int num_threads);
 void MakeTreeRelative(ConversionData& conv);
 void ConvertUnit(const EXPRESS::DataType& dt,ConversionData& conv);
 
@@ -162,6 +165,7 @@ void IFCImporter::SetupProperties(const Importer* pImp)
     settings.conicSamplingAngle = std::min(std::max((float) pImp->GetPropertyFloat(AI_CONFIG_IMPORT_IFC_SMOOTHING_ANGLE, AI_IMPORT_IFC_DEFAULT_SMOOTHING_ANGLE), 5.0f), 120.0f);
 	settings.cylindricalTessellation = std::min(std::max(pImp->GetPropertyInteger(AI_CONFIG_IMPORT_IFC_CYLINDRICAL_TESSELLATION, AI_IMPORT_IFC_DEFAULT_CYLINDRICAL_TESSELLATION), 3), 180);
 	settings.skipAnnotations = true;
+    settings.numThreads = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_IFC_NUM_THREADS, 0));
 }
 
 
@@ -268,6 +272,12 @@ void IFCImporter::InternReadFile( const std::string& pFile,
 
     // feed the IFC schema into the reader and pre-parse all lines
     STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track);
+
+    // parsing the argument lists and converting the entities dominates the
+    // loading time for large models. Conversion of an entity never touches
+    // other entities, so do all of them concurrently before walking the model.
+    db->EvaluateParallel(NULL,0,settings.numThreads);
+
     const STEP::LazyObject* proj =  db->GetObject("ifcproject");
     if (!proj) {
         ThrowException("missing IfcProject entity");
@@ -277,6 +287,7 @@ void IFCImporter::InternReadFile( const std::string& pFile,
     SetUnits(conv);
     SetCoordinateSpace(conv);
     ProcessSpatialStructures(conv);
+    ProcessProductGeometry(conv,settings.numThreads);
     MakeTreeRelative(conv);
 
     // NOTE - this is a stress test for the importer, but it works only
@@ -288,22 +299,24 @@ void IFCImporter::InternReadFile( const std::string& pFile,
     #endif
 
     // do final data copying
-    if (conv.meshes.size()) {
-        pScene->mNumMeshes = static_cast<unsigned int>(conv.meshes.size());
+    std::vector<aiMesh*>& meshes = conv.shared->meshes;
+    if (meshes.size()) {
+        pScene->mNumMeshes = static_cast<unsigned int>(meshes.size());
         pScene->mMeshes = new aiMesh*[pScene->mNumMeshes]();
-        std::copy(conv.meshes.begin(),conv.meshes.end(),pScene->mMeshes);
+        std::copy(meshes.begin(),meshes.end(),pScene->mMeshes);
 
         // needed to keep the d'tor from burning us
-        conv.meshes.clear();
+        meshes.clear();
     }
 
-    if (conv.materials.size()) {
-        pScene->mNumMaterials = static_cast<unsigned int>(conv.materials.size());
+    std::vector<aiMaterial*>& materials = conv.shared->materials;
+    if (materials.size()) {
+        pScene->mNumMaterials = static_cast<unsigned int>(materials.size());
         pScene->mMaterials = new aiMaterial*[pScene->mNumMaterials]();
-        std::copy(conv.materials.begin(),conv.materials.end(),pScene->mMaterials);
+        std::copy(materials.begin(),materials.end(),pScene->mMaterials);
 
         // needed to keep the d'tor from burning us
-        conv.materials.clear();
+        materials.clear();
     }
 
     // apply world coordinate system (which includes the scaling to convert to meters and a -90 degrees rotation around x)
@@ -584,6 +597,144 @@ void ProcessProductRepresentation(const IfcProduct& el, aiNode* nd, std::vector<
     AssignAddedMeshes(meshes,nd,conv);
 }
 
+// ------------------------------------------------------------------------------------------------
+void EnqueueGeometryTask(const IfcProduct& el, aiNode* nd, std::vector<TempOpening>& openings, ConversionData& conv)
+{
+    ConversionData::SharedData& shared = *conv.shared;
+
+    std::unique_ptr<GeometryTask> task(new GeometryTask(el,nd,shared.journals.size()));
+    task->openings.swap(openings);
+    shared.journals.push_back(ConversionData::Journal(task->order));
+    shared.tasks.push_back(task.release());
+
+    // anything the main conversion does from now on comes after the task in file order
+    shared.journals.push_back(ConversionData::Journal(shared.journals.size()));
+    conv.journal = &shared.journals.back();
+}
+
+// ------------------------------------------------------------------------------------------------
+void RemapNodeMeshes(aiNode* nd, const std::vector<unsigned int>& mesh_remap)
+{
+    // keep the indices sorted and unique, see AssignAddedMeshes()
+    for(unsigned int i = 0; i < nd->mNumMeshes; ++i) {
+        nd->mMeshes[i] = mesh_remap[nd->mMeshes[i]];
+    }
+    std::sort(nd->mMeshes,nd->mMeshes+nd->mNumMeshes);
+    nd->mNumMeshes = static_cast<unsigned int>(std::distance(nd->mMeshes,std::unique(nd->mMeshes,nd->mMeshes+nd->mNumMeshes)));
+
+    for(unsigned int i = 0; i < nd->mNumChildren; ++i) {
+        RemapNodeMeshes(nd->mChildren[i],mesh_remap);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replay the journals in file order to give meshes and materials the indices they would have
+// got in a sequential run. Meshes computed more than once because tasks ran concurrently are
+// merged into the one a sequential run would have kept.
+void FinalizeMeshesAndMaterials(ConversionData& conv)
+{
+    ConversionData::SharedData& shared = *conv.shared;
+    const unsigned int none = std::numeric_limits<unsigned int>::max();
+
+    std::vector<unsigned int> mesh_remap(shared.meshes.size(),none), mat_remap(shared.materials.size(),none);
+    std::vector<aiMesh*> meshes;
+    std::vector<aiMaterial*> materials;
+    std::map<ConversionData::MeshCacheIndex, unsigned int> cache;
+
+    for(const ConversionData::Journal& journal : shared.journals) {
+        for(unsigned int m : journal.materials) {
+            if (mat_remap[m] == none) {
+                mat_remap[m] = static_cast<unsigned int>(materials.size());
+                materials.push_back(shared.materials[m]);
+            }
+        }
+        for(const ConversionData::Journal::MeshEvent& ev : journal.meshes) {
+            // cache hits always refer to a mesh from an earlier journal, which has been remapped already
+            if (ev.hit || ev.mesh == none) {
+                continue;
+            }
+            const std::map<ConversionData::MeshCacheIndex, unsigned int>::const_iterator it = cache.find(ev.key);
+            if (it != cache.end()) {
+                mesh_remap[ev.mesh] = (*it).second;
+                delete shared.meshes[ev.mesh];
+            }
+            else {
+                mesh_remap[ev.mesh] = cache[ev.key] = static_cast<unsigned int>(meshes.size());
+                meshes.push_back(shared.meshes[ev.mesh]);
+            }
+        }
+    }
+
+    // every mesh and material is in a journal, but better safe than sorry
+    for(size_t i = 0; i < shared.meshes.size(); ++i) {
+        if (mesh_remap[i] == none) {
+            mesh_remap[i] = static_cast<unsigned int>(meshes.size());
+            meshes.push_back(shared.meshes[i]);
+        }
+    }
+    for(size_t i = 0; i < shared.materials.size(); ++i) {
+        if (mat_remap[i] == none) {
+            mat_remap[i] = static_cast<unsigned int>(materials.size());
+            materials.push_back(shared.materials[i]);
+        }
+    }
+
+    for(aiMesh* mesh : meshes) {
+        mesh->mMaterialIndex = mat_remap[mesh->mMaterialIndex];
+    }
+    if (conv.out->mRootNode) {
+        RemapNodeMeshes(conv.out->mRootNode,mesh_remap);
+    }
+
+    shared.meshes.swap(meshes);
+    shared.materials.swap(materials);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ProcessProductGeometry(ConversionData& conv, unsigned int num_threads)
+{
+    ConversionData::SharedData& shared = *conv.shared;
+    const std::vector<GeometryTask*>& tasks = shared.tasks;
+
+    // if some tasks fail, the first one to fail in file order gets reported - just as sequentially.
+    std::exception_ptr error;
+    try {
+        ParallelFor(tasks.size(),num_threads,[&conv,&tasks](size_t i) {
+            ConversionData taskconv(conv,*tasks[i]);
+            ProcessProductRepresentation(*tasks[i]->el,tasks[i]->nd,tasks[i]->subnodes,taskconv);
+        });
+    }
+    catch(...) {
+        error = std::current_exception();
+    }
+
+    // nodes for mapped items go behind the regular children, as they always did
+    for(GeometryTask* task : tasks) {
+        if (error) {
+            std::for_each(task->subnodes.begin(),task->subnodes.end(),delete_fun<aiNode>());
+        }
+        else if (!task->subnodes.empty()) {
+            aiNode* const nd = task->nd;
+            aiNode** const children = new aiNode*[nd->mNumChildren + task->subnodes.size()]();
+            std::copy(nd->mChildren,nd->mChildren + nd->mNumChildren,children);
+            delete[] nd->mChildren;
+            nd->mChildren = children;
+
+            for(aiNode* nd2 : task->subnodes) {
+                nd->mChildren[nd->mNumChildren++] = nd2;
+                nd2->mParent = nd;
+            }
+        }
+        task->subnodes.clear();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    FinalizeMeshesAndMaterials(conv);
+}
+
 typedef std::map<std::string, std::string> Metadata;
 
 // ------------------------------------------------------------------------------------------------
@@ -835,14 +986,17 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
             }
         }
 
-        conv.collect_openings = collect_openings;
-        if(!conv.collect_openings) {
-            conv.apply_openings = &openings;
-        }
-
         if (!skipGeometry) {
-          ProcessProductRepresentation(el,nd.get(),subnodes,conv);
-          conv.apply_openings = conv.collect_openings = NULL;
+            if (collect_openings) {
+                // the parent element needs the opening geometry right away
+                conv.collect_openings = collect_openings;
+                ProcessProductRepresentation(el,nd.get(),subnodes,conv);
+                conv.apply_openings = conv.collect_openings = NULL;
+            }
+            else if (el.Representation) {
+                // leave the heavy lifting to ProcessProductGeometry()
+                EnqueueGeometryTask(el,nd.get(),openings,conv);
+            }
         }
 
         if (subnodes.size()) {
@@ -112,6 +112,7 @@ public:
             , skipAnnotations()
             , conicSamplingAngle(10.f)
 			, cylindricalTessellation(32)
+            , numThreads()
         {}
 
 
@@ -120,6 +121,7 @@ public:
         bool skipAnnotations;
         float conicSamplingAngle;
 		int cylindricalTessellation;
+        unsigned int numThreads;
     };
 
 
@@ -140,10 +140,16 @@ unsigned int ProcessMaterials(uint64_t id, unsigned int prevMatId, ConversionDat
                 for(std::shared_ptr<const IFC::IfcPresentationStyleSelect> sel : as.Styles) {
 
                     if( const IFC::IfcSurfaceStyle* const surf = sel->ResolveSelectPtr<IFC::IfcSurfaceStyle>(conv.db) ) {
+                        ConversionData::SharedData& shared = *conv.shared;
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+                        std::lock_guard<std::mutex> lock(shared.mutex);
+#endif
                         // try to satisfy from cache
-                        ConversionData::MaterialCache::iterator mit = conv.cached_materials.find(surf);
-                        if( mit != conv.cached_materials.end() )
+                        ConversionData::MaterialCache::iterator mit = shared.cached_materials.find(surf);
+                        if( mit != shared.cached_materials.end() ) {
+                            conv.journal->materials.push_back(mit->second);
                             return mit->second;
+                        }
 
                         // not found, create new material
                         const std::string side = static_cast<std::string>(surf->Side);
@@ -155,9 +161,10 @@ unsigned int ProcessMaterials(uint64_t id, unsigned int prevMatId, ConversionDat
 
                         FillMaterial(mat.get(), surf, conv);
 
-                        conv.materials.push_back(mat.release());
-                        unsigned int matindex = static_cast<unsigned int>(conv.materials.size() - 1);
-                        conv.cached_materials[surf] = matindex;
+                        shared.materials.push_back(mat.release());
+                        unsigned int matindex = static_cast<unsigned int>(shared.materials.size() - 1);
+                        shared.cached_materials[surf] = matindex;
+                        conv.journal->materials.push_back(matindex);
                         return matindex;
                     }
                 }
@@ -179,11 +186,17 @@ unsigned int ProcessMaterials(uint64_t id, unsigned int prevMatId, ConversionDat
     name.Set("<IFCDefault>");
     //  ConvertColorToString( color, name);
 
+    ConversionData::SharedData& shared = *conv.shared;
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(shared.mutex);
+#endif
+
     // look if there's already a default material with this base color
-    for( size_t a = 0; a < conv.materials.size(); ++a ) {
+    for( size_t a = 0; a < shared.materials.size(); ++a ) {
         aiString mname;
-        conv.materials[a]->Get(AI_MATKEY_NAME, mname);
+        shared.materials[a]->Get(AI_MATKEY_NAME, mname);
         if ( name == mname ) {
+            conv.journal->materials.push_back(( unsigned int )a);
             return ( unsigned int )a;
         }
     }
@@ -195,8 +208,9 @@ unsigned int ProcessMaterials(uint64_t id, unsigned int prevMatId, ConversionDat
     const aiColor4D col = aiColor4D( 0.6f, 0.6f, 0.6f, 1.0f); // aiColor4D( color.r, color.g, color.b, 1.0f);
     mat->AddProperty(&col,1, AI_MATKEY_COLOR_DIFFUSE);
 
-    conv.materials.push_back(mat.release());
-    return (unsigned int) conv.materials.size() - 1;
+    shared.materials.push_back(mat.release());
+    conv.journal->materials.push_back((unsigned int) shared.materials.size() - 1);
+    return (unsigned int) shared.materials.size() - 1;
 }
 
 } // ! IFC
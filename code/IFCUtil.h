@@ -51,6 +51,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFile.h"
 #include <assimp/mesh.h>
 #include <assimp/material.h>
+#include <deque>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#   include <condition_variable>
+#endif
 
 struct aiNode;
 
@@ -169,27 +175,129 @@ struct TempOpening
 };
 
 
+// ------------------------------------------------------------------------------------------------
+// Geometry of the products in a model is generated by tasks that may run concurrently.
+// A task describes one product whose representation still needs to be converted.
+// ------------------------------------------------------------------------------------------------
+struct GeometryTask
+{
+    GeometryTask(const IFC::IfcProduct& el, aiNode* nd, size_t order)
+        : el(&el)
+        , nd(nd)
+        , order(order)
+    {}
+
+    const IFC::IfcProduct* el;
+    aiNode* nd;
+
+    // position of the task's journal in ConversionData::SharedData::journals
+    size_t order;
+
+    // openings to be cut into the product's geometry
+    std::vector<TempOpening> openings;
+
+    // nodes generated for mapped items, appended to nd once the task is done
+    std::vector<aiNode*> subnodes;
+};
+
+
 // ------------------------------------------------------------------------------------------------
 // Intermediate data storage during conversion. Keeps everything and a bit more.
 // ------------------------------------------------------------------------------------------------
 struct ConversionData
 {
+    struct MeshCacheIndex {
+        const IFC::IfcRepresentationItem* item; unsigned int matindex;
+        MeshCacheIndex() : item(NULL), matindex(0) { }
+        MeshCacheIndex(const IFC::IfcRepresentationItem* i, unsigned int mi) : item(i), matindex(mi) { }
+        bool operator == (const MeshCacheIndex& o) const { return item == o.item && matindex == o.matindex; }
+        bool operator < (const MeshCacheIndex& o) const { return item < o.item || (item == o.item && matindex < o.matindex); }
+    };
+
+    // a cached mesh along with the journal that generated it. Entries are pending
+    // while their owner is still busy computing the mesh.
+    struct MeshCacheEntry {
+        size_t owner; unsigned int mesh; bool ready;
+        MeshCacheEntry() : owner(), mesh(), ready() { }
+        explicit MeshCacheEntry(size_t o) : owner(o), mesh(), ready(false) { }
+    };
+    typedef std::map<MeshCacheIndex, MeshCacheEntry> MeshCache;
+
+    typedef std::map<const IFC::IfcSurfaceStyle*, unsigned int> MaterialCache;
+
+    // Meshes and materials get provisional indices in the order they are created,
+    // which depends on thread scheduling. Every part of the conversion logs the
+    // meshes and materials it used in a journal, replaying the journals in file
+    // order at the end yields the numbering of a sequential run.
+    struct Journal {
+        struct MeshEvent {
+            MeshCacheIndex key; unsigned int mesh; bool hit;
+            MeshEvent(const MeshCacheIndex& k, unsigned int m, bool h) : key(k), mesh(m), hit(h) { }
+        };
+
+        explicit Journal(size_t order) : order(order) { }
+
+        size_t order;
+        std::vector<MeshEvent> meshes;
+        std::vector<unsigned int> materials;
+    };
+
+    // everything shared between the main conversion and the geometry tasks
+    struct SharedData {
+        ~SharedData() {
+            std::for_each(meshes.begin(),meshes.end(),delete_fun<aiMesh>());
+            std::for_each(materials.begin(),materials.end(),delete_fun<aiMaterial>());
+            std::for_each(tasks.begin(),tasks.end(),delete_fun<GeometryTask>());
+        }
+
+        std::vector<aiMesh*> meshes;
+        std::vector<aiMaterial*> materials;
+        MeshCache cached_meshes;
+        MaterialCache cached_materials;
+
+        // deque, so journals never move while they are written to
+        std::deque<Journal> journals;
+        std::vector<GeometryTask*> tasks;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::mutex mutex;
+        std::condition_variable mesh_cache_changed;
+#endif
+    };
+
     ConversionData(const STEP::DB& db, const IFC::IfcProject& proj, aiScene* out,const IFCImporter::Settings& settings)
         : len_scale(1.0)
         , angle_scale(-1.0)
+        , plane_angle_in_radians()
         , db(db)
         , proj(proj)
         , out(out)
         , settings(settings)
         , apply_openings()
         , collect_openings()
-    {}
-
-    ~ConversionData() {
-        std::for_each(meshes.begin(),meshes.end(),delete_fun<aiMesh>());
-        std::for_each(materials.begin(),materials.end(),delete_fun<aiMaterial>());
+        , shared(std::make_shared<SharedData>())
+    {
+        shared->journals.push_back(Journal(0));
+        journal = &shared->journals.back();
     }
 
+    // view used by a geometry task, shares all results with parent but has
+    // its own opening state and logs to the journal of the task.
+    ConversionData(const ConversionData& parent, GeometryTask& task)
+        : len_scale(parent.len_scale)
+        , angle_scale(parent.angle_scale)
+        , plane_angle_in_radians(parent.plane_angle_in_radians)
+        , db(parent.db)
+        , proj(parent.proj)
+        , out(parent.out)
+        , wcs(parent.wcs)
+        , settings(parent.settings)
+        , apply_openings(&task.openings)
+        , collect_openings()
+        , shared(parent.shared)
+        , journal(&shared->journals[task.order])
+    {}
+
     IfcFloat len_scale, angle_scale;
     bool plane_angle_in_radians;
 
@@ -198,21 +306,6 @@ struct ConversionData
     aiScene* out;
 
     IfcMatrix4 wcs;
-    std::vector<aiMesh*> meshes;
-    std::vector<aiMaterial*> materials;
-
-    struct MeshCacheIndex {
-        const IFC::IfcRepresentationItem* item; unsigned int matindex;
-        MeshCacheIndex() : item(NULL), matindex(0) { }
-        MeshCacheIndex(const IFC::IfcRepresentationItem* i, unsigned int mi) : item(i), matindex(mi) { }
-        bool operator == (const MeshCacheIndex& o) const { return item == o.item && matindex == o.matindex; }
-        bool operator < (const MeshCacheIndex& o) const { return item < o.item || (item == o.item && matindex < o.matindex); }
-    };
-    typedef std::map<MeshCacheIndex, std::vector<unsigned int> > MeshCache;
-    MeshCache cached_meshes;
-
-    typedef std::map<const IFC::IfcSurfaceStyle*, unsigned int> MaterialCache;
-    MaterialCache cached_materials;
 
     const IFCImporter::Settings& settings;
 
@@ -226,6 +319,9 @@ struct ConversionData
     std::vector<TempOpening>* collect_openings;
 
     std::set<uint64_t> already_processed;
+
+    std::shared_ptr<SharedData> shared;
+    Journal* journal;
 };
 
 
@@ -0,0 +1,164 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file IOStreamWriter.h
+ *  Defines IOStreamWriter, a std::ostream writing straight into an IOStream.
+ */
+#ifndef AI_IOSTREAMWRITER_H_INC
+#define AI_IOSTREAMWRITER_H_INC
+
+#include <assimp/IOStream.hpp>
+
+#include <locale>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** std::streambuf which collects the written data in a chunk of fixed size and
+ *  passes every full chunk on to an IOStream. The memory needed for writing is
+ *  independent of the size of the written file.
+ */
+class IOStreamBuf : public std::streambuf {
+public:
+    /// @brief  The class constructor.
+    /// @param  stream      The stream to write into, not owned.
+    /// @param  chunkSize   The number of bytes collected before writing them.
+    explicit IOStreamBuf( IOStream *stream, size_t chunkSize = 64 * 1024 )
+    : m_stream( stream )
+    , m_chunk( chunkSize > 0 ? chunkSize : 1 ) {
+        setp( &m_chunk[ 0 ], &m_chunk[ 0 ] + m_chunk.size() );
+    }
+
+    /// @brief  The class destructor, writes the pending data.
+    ~IOStreamBuf() {
+        flushChunk();
+    }
+
+protected:
+    int_type overflow( int_type c ) override {
+        if ( !flushChunk() ) {
+            return traits_type::eof();
+        }
+        if ( !traits_type::eq_int_type( c, traits_type::eof() ) ) {
+            *pptr() = traits_type::to_char_type( c );
+            pbump( 1 );
+        }
+        return traits_type::not_eof( c );
+    }
+
+    std::streamsize xsputn( const char *s, std::streamsize n ) override {
+        const std::streamsize avail = epptr() - pptr();
+        if ( n <= avail ) {
+            traits_type::copy( pptr(), s, static_cast<size_t>( n ) );
+            pbump( static_cast<int>( n ) );
+            return n;
+        }
+
+        // large blocks bypass the chunk
+        if ( !flushChunk() ) {
+            return 0;
+        }
+        if ( n >= static_cast<std::streamsize>( m_chunk.size() ) ) {
+            return nullptr != m_stream && m_stream->Write( s, 1, static_cast<size_t>( n ) ) == static_cast<size_t>( n ) ? n : 0;
+        }
+        traits_type::copy( pptr(), s, static_cast<size_t>( n ) );
+        pbump( static_cast<int>( n ) );
+        return n;
+    }
+
+    int sync() override {
+        return flushChunk() ? 0 : -1;
+    }
+
+private:
+    bool flushChunk() {
+        const size_t size = static_cast<size_t>( pptr() - pbase() );
+        if ( 0 == size ) {
+            return true;
+        }
+        setp( &m_chunk[ 0 ], &m_chunk[ 0 ] + m_chunk.size() );
+        return nullptr != m_stream && m_stream->Write( &m_chunk[ 0 ], 1, size ) == size;
+    }
+
+    IOStreamBuf( const IOStreamBuf & ) = delete;
+    IOStreamBuf &operator = ( const IOStreamBuf & ) = delete;
+
+    IOStream *m_stream;
+    std::vector<char> m_chunk;
+};
+
+// ---------------------------------------------------------------------------
+/** std::ostream on top of an IOStream. Exporters use it instead of a std::stringstream
+ *  so the output goes to the file while it is generated: the export function opens the
+ *  output file before it runs the exporter, which then writes into an IOStreamWriter
+ *  on top of it. Formatting always uses the standard C locale. Write errors set the
+ *  badbit, check fail() after flush().
+ */
+class IOStreamWriter : public std::ostream {
+public:
+    /// @brief  The class constructor.
+    /// @param  stream      The stream to write into, not owned.
+    /// @param  chunkSize   The number of bytes collected before writing them.
+    explicit IOStreamWriter( IOStream *stream, size_t chunkSize = 64 * 1024 )
+    : std::ostream( nullptr )
+    , m_buffer( stream, chunkSize ) {
+        rdbuf( &m_buffer );
+        imbue( std::locale::classic() );
+    }
+
+    /// @brief  The class destructor, writes the pending data.
+    ~IOStreamWriter() {
+        flush();
+    }
+
+private:
+    IOStreamWriter( const IOStreamWriter & ) = delete;
+    IOStreamWriter &operator = ( const IOStreamWriter & ) = delete;
+
+    IOStreamBuf m_buffer;
+};
+
+} // !ns Assimp
+
+#endif // AI_IOSTREAMWRITER_H_INC
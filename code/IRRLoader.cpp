@@ -910,9 +910,8 @@ void IRRImporter::InternReadFile( const std::string& pFile,
     if( file.get() == NULL)
         throw DeadlyImportError( "Failed to open IRR file " + pFile + "");
 
-    // Construct the irrXML parser
-    CIrrXML_IOStreamReader st(file.get());
-    reader = createIrrXMLReader((IFileReadCallBack*) &st);
+    // Construct the XML parser
+    reader = new FastXmlReader(file.get());
 
     // The root node of the scene
     Node* root = new Node(Node::DUMMY);
@@ -151,6 +151,7 @@ Importer::Importer()
     pimpl = new ImporterPimpl();
 
     pimpl->mScene = NULL;
+    pimpl->mSceneImporter = NULL;
     pimpl->mErrorString = "";
 
     // Allocate a default IO handler
@@ -392,6 +393,20 @@ bool _ValidateFlags(unsigned int pFlags)
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Post-processing steps would work on the missing mesh and animation data of a lazily loaded
+// scene, and they would re-index the meshes LoadMeshData() refers to.
+static bool RefuseDeferredData( ImporterPimpl* pimpl )
+{
+    if (!pimpl->mSceneImporter || !pimpl->mSceneImporter->HasDeferredData()) {
+        return false;
+    }
+    pimpl->mErrorString = "Post-processing can't be applied to a scene with deferred mesh or animation data. "
+        "Load it with LoadMeshData() and LoadAnimationData() first, then call ApplyPostProcessing().";
+    DefaultLogger::get()->error( pimpl->mErrorString );
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Free the current scene
 void Importer::FreeScene( )
@@ -399,6 +414,7 @@ void Importer::FreeScene( )
     ASSIMP_BEGIN_EXCEPTION_REGION();
     delete pimpl->mScene;
     pimpl->mScene = NULL;
+    pimpl->mSceneImporter = NULL;
 
     pimpl->mErrorString = "";
     ASSIMP_END_EXCEPTION_REGION(void);
@@ -426,6 +442,59 @@ const aiScene* Importer::GetScene() const
     return pimpl->mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Load the deferred data of a mesh of the current scene
+bool Importer::LoadMeshData( unsigned int pIndex )
+{
+    if (!pimpl->mScene || pIndex >= pimpl->mScene->mNumMeshes) {
+        return false;
+    }
+
+    try {
+        // the preprocessing left out the mesh as long as its data was missing
+        const bool deferred = pimpl->mSceneImporter->IsMeshDeferred( pIndex );
+        if (!pimpl->mSceneImporter->LoadDeferredMesh( pimpl->mScene, pimpl->mIOHandler, pIndex )) {
+            return false;
+        }
+        if (deferred) {
+            ScenePreprocessor pre( pimpl->mScene );
+            pre.ProcessDeferredMesh( pIndex );
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        pimpl->mErrorString = e.what();
+        DefaultLogger::get()->error( pimpl->mErrorString );
+        return false;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Load the deferred data of an animation of the current scene
+bool Importer::LoadAnimationData( unsigned int pIndex )
+{
+    if (!pimpl->mScene || pIndex >= pimpl->mScene->mNumAnimations) {
+        return false;
+    }
+
+    try {
+        const bool deferred = pimpl->mSceneImporter->IsAnimationDeferred( pIndex );
+        if (!pimpl->mSceneImporter->LoadDeferredAnimation( pimpl->mScene, pimpl->mIOHandler, pIndex )) {
+            return false;
+        }
+        if (deferred) {
+            ScenePreprocessor pre( pimpl->mScene );
+            pre.ProcessDeferredAnimation( pIndex );
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        pimpl->mErrorString = e.what();
+        DefaultLogger::get()->error( pimpl->mErrorString );
+        return false;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Orphan the current scene and return it.
 aiScene* Importer::GetOrphanedScene()
@@ -434,6 +503,7 @@ aiScene* Importer::GetOrphanedScene()
 
     ASSIMP_BEGIN_EXCEPTION_REGION();
     pimpl->mScene = NULL;
+    pimpl->mSceneImporter = NULL;
 
     pimpl->mErrorString = ""; /* reset error string */
     ASSIMP_END_EXCEPTION_REGION(aiScene*);
@@ -671,6 +741,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
         }
 
         pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
+        pimpl->mSceneImporter = imp;
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
         if (profiler) {
@@ -680,6 +751,13 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
         // If successful, apply all active post processing steps to the imported data
         if( pimpl->mScene)  {
 
+            if (pFlags && RefuseDeferredData(pimpl)) {
+                const std::string error = pimpl->mErrorString;
+                FreeScene();
+                pimpl->mErrorString = error;
+                return NULL;
+            }
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure)
@@ -698,7 +776,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             }
 
             ScenePreprocessor pre(pimpl->mScene);
-            pre.ProcessScene();
+            pre.ProcessScene(imp);
 
             if (profiler) {
                 profiler->EndRegion("preprocess");
@@ -755,6 +833,11 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
         return pimpl->mScene;
     }
 
+    // The scene stays as it is, it just can't be post-processed yet
+    if (RefuseDeferredData(pimpl)) {
+        return NULL;
+    }
+
     // In debug builds: run basic flag validation
     ai_assert(_ValidateFlags(pFlags));
     DefaultLogger::get()->info("Entering post processing pipeline");
@@ -852,6 +935,10 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
         return pimpl->mScene;
     }
 
+    if ( RefuseDeferredData( pimpl ) ) {
+        return NULL;
+    }
+
     // In debug builds: run basic flag validation
     DefaultLogger::get()->info( "Entering customized post processing pipeline" );
 
@@ -100,6 +100,9 @@ public:
     /** The imported data, if ReadFile() was successful, NULL otherwise. */
     aiScene* mScene;
 
+    /** The importer which read mScene, it loads deferred data on demand. */
+    BaseImporter* mSceneImporter;
+
     /** The error description, if there was one. */
     std::string mErrorString;
 
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MD2Loader.h"
 #include "ByteSwapper.h"
 #include "MD2NormalTable.h" // shouldn't be included by other units
+#include "CreateAnimMesh.h"
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/IOSystem.hpp>
@@ -93,6 +94,8 @@ void MD2::LookupNormalIndex(uint8_t iNormalIndex,aiVector3D& vOut)
 // Constructor to be privately used by Importer
 MD2Importer::MD2Importer()
     : configFrameID(),
+    configAllFrames(),
+    configNumThreads(),
     m_pcHeader(),
     mBuffer(),
     fileSize()
@@ -138,6 +141,8 @@ void MD2Importer::SetupProperties(const Importer* pImp)
     if(static_cast<unsigned int>(-1) == configFrameID){
         configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
     }
+    configAllFrames = pImp->GetPropertyBool(AI_CONFIG_IMPORT_ALL_KEYFRAMES,false);
+    configNumThreads = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NUM_THREADS,0));
 }
 // ------------------------------------------------------------------------------------------------
 // Validate the file header
@@ -196,6 +201,8 @@ void MD2Importer::ValidateHeader( )
         m_pcHeader->offsetTexCoords + m_pcHeader->numTexCoords * sizeof (MD2::TexCoord) >= fileSize ||
         m_pcHeader->offsetTriangles + m_pcHeader->numTriangles * sizeof (MD2::Triangle) >= fileSize ||
         m_pcHeader->offsetFrames    + m_pcHeader->numFrames * frameSize                 >= fileSize ||
+        m_pcHeader->frameSize < frameSize ||
+        m_pcHeader->offsetFrames + (uint64_t)m_pcHeader->numFrames * m_pcHeader->frameSize > fileSize ||
         m_pcHeader->offsetEnd           > fileSize)
     {
         throw DeadlyImportError("Invalid MD2 header: some offsets are outside the file");
@@ -274,10 +281,6 @@ void MD2Importer::InternReadFile( const std::string& pFile,
     aiMesh* pcMesh = pScene->mMeshes[0] = new aiMesh();
     pcMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
 
-    // navigate to the begin of the current frame data
-	BE_NCONST MD2::Frame* pcFrame = (BE_NCONST MD2::Frame*) ((uint8_t*)
-		m_pcHeader + m_pcHeader->offsetFrames + (m_pcHeader->frameSize * configFrameID));
-
     // navigate to the begin of the triangle data
     MD2::Triangle* pcTriangles = (MD2::Triangle*) ((uint8_t*)
         m_pcHeader + m_pcHeader->offsetTriangles);
@@ -286,9 +289,6 @@ void MD2Importer::InternReadFile( const std::string& pFile,
     BE_NCONST MD2::TexCoord* pcTexCoords = (BE_NCONST MD2::TexCoord*) ((uint8_t*)
         m_pcHeader + m_pcHeader->offsetTexCoords);
 
-    // navigate to the begin of the vertex data
-    BE_NCONST MD2::Vertex* pcVerts = (BE_NCONST MD2::Vertex*) (pcFrame->vertices);
-
 #ifdef AI_BUILD_BIG_ENDIAN
     for (uint32_t i = 0; i< m_pcHeader->numTriangles; ++i)
     {
@@ -303,12 +303,6 @@ void MD2Importer::InternReadFile( const std::string& pFile,
         ByteSwap::Swap2(& pcTexCoords[i].s);
         ByteSwap::Swap2(& pcTexCoords[i].t);
     }
-    ByteSwap::Swap4( & pcFrame->scale[0] );
-    ByteSwap::Swap4( & pcFrame->scale[1] );
-    ByteSwap::Swap4( & pcFrame->scale[2] );
-    ByteSwap::Swap4( & pcFrame->translate[0] );
-    ByteSwap::Swap4( & pcFrame->translate[1] );
-    ByteSwap::Swap4( & pcFrame->translate[2] );
 #endif
 
     pcMesh->mNumFaces = m_pcHeader->numTriangles;
@@ -377,7 +371,7 @@ void MD2Importer::InternReadFile( const std::string& pFile,
     }
 
 
-    // now read all triangles of the first frame, apply scaling and translation
+    // now read all triangles, the vertices of the frame are filled in below
     unsigned int iCurrent = 0;
 
     float fDivisorU = 1.0f,fDivisorV = 1.0f;
@@ -409,35 +403,13 @@ void MD2Importer::InternReadFile( const std::string& pFile,
         for (unsigned int c = 0; c < 3;++c,++iCurrent)  {
 
             // validate vertex indices
-            unsigned int iIndex = (unsigned int)pcTriangles[i].vertexIndices[c];
-            if (iIndex >= m_pcHeader->numVertices)  {
+            if (pcTriangles[i].vertexIndices[c] >= m_pcHeader->numVertices)  {
                 DefaultLogger::get()->error("MD2: Vertex index is outside the allowed range");
-                iIndex = m_pcHeader->numVertices-1;
             }
 
-            // read x,y, and z component of the vertex
-            aiVector3D& vec = pcMesh->mVertices[iCurrent];
-
-            vec.x = (float)pcVerts[iIndex].vertex[0] * pcFrame->scale[0];
-            vec.x += pcFrame->translate[0];
-
-            vec.y = (float)pcVerts[iIndex].vertex[1] * pcFrame->scale[1];
-            vec.y += pcFrame->translate[1];
-
-            vec.z = (float)pcVerts[iIndex].vertex[2] * pcFrame->scale[2];
-            vec.z += pcFrame->translate[2];
-
-            // read the normal vector from the precalculated normal table
-            aiVector3D& vNormal = pcMesh->mNormals[iCurrent];
-            LookupNormalIndex(pcVerts[iIndex].lightNormalIndex,vNormal);
-
-            // flip z and y to become right-handed
-            std::swap((float&)vNormal.z,(float&)vNormal.y);
-            std::swap((float&)vec.z,(float&)vec.y);
-
             if (m_pcHeader->numTexCoords)   {
                 // validate texture coordinates
-                iIndex = pcTriangles[i].textureIndices[c];
+                unsigned int iIndex = pcTriangles[i].textureIndices[c];
                 if (iIndex >= m_pcHeader->numTexCoords) {
                     DefaultLogger::get()->error("MD2: UV index is outside the allowed range");
                     iIndex = m_pcHeader->numTexCoords-1;
@@ -453,6 +425,78 @@ void MD2Importer::InternReadFile( const std::string& pFile,
             pScene->mMeshes[0]->mFaces[i].mIndices[c] = iCurrent;
         }
     }
+
+    // read the vertices of the requested frame, apply scaling and translation
+    ReadFrame(configFrameID,pcMesh->mVertices,pcMesh->mNormals);
+
+    // decode all other frames as morph targets, frame by frame in parallel
+    if (configAllFrames) {
+        pcMesh->mName.Set("<MD2Mesh>");
+        aiCreateKeyframeAnimMeshes(&pcMesh,1,m_pcHeader->numFrames,configNumThreads,
+            [this](unsigned int, unsigned int iFrame, aiAnimMesh& target) {
+                ReadFrame(iFrame,target.mVertices,target.mNormals);
+            });
+
+        pScene->mNumAnimations = 1;
+        pScene->mAnimations = new aiAnimation*[1];
+        pScene->mAnimations[0] = aiCreateKeyframeMorphAnimation(&pcMesh,1);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Read the vertex positions and normals of a frame, one per triangle corner
+void MD2Importer::ReadFrame(unsigned int iFrame, aiVector3D* pcVertOut, aiVector3D* pcNorOut) const
+{
+    // navigate to the begin of the frame data
+    const MD2::Frame* pcFrame = (const MD2::Frame*) ((const uint8_t*)
+        m_pcHeader + m_pcHeader->offsetFrames + (m_pcHeader->frameSize * iFrame));
+
+    // navigate to the begin of the triangle data
+    const MD2::Triangle* pcTriangles = (const MD2::Triangle*) ((const uint8_t*)
+        m_pcHeader + m_pcHeader->offsetTriangles);
+
+    // navigate to the begin of the vertex data
+    const MD2::Vertex* pcVerts = pcFrame->vertices;
+
+    // the frame is shared with the other decoders, so swap a copy
+    float scale[3], translate[3];
+    for (unsigned int i = 0; i < 3; ++i) {
+        scale[i] = pcFrame->scale[i];
+        translate[i] = pcFrame->translate[i];
+        AI_SWAP4(scale[i]);
+        AI_SWAP4(translate[i]);
+    }
+
+    for (unsigned int i = 0; i < (unsigned int)m_pcHeader->numTriangles;++i)    {
+        for (unsigned int c = 0; c < 3;++c,++pcVertOut,++pcNorOut)  {
+
+            // invalid vertex indices have been reported already
+            unsigned int iIndex = (unsigned int)pcTriangles[i].vertexIndices[c];
+            if (iIndex >= m_pcHeader->numVertices)  {
+                iIndex = m_pcHeader->numVertices-1;
+            }
+
+            // read x,y, and z component of the vertex
+            aiVector3D& vec = *pcVertOut;
+
+            vec.x = (float)pcVerts[iIndex].vertex[0] * scale[0];
+            vec.x += translate[0];
+
+            vec.y = (float)pcVerts[iIndex].vertex[1] * scale[1];
+            vec.y += translate[1];
+
+            vec.z = (float)pcVerts[iIndex].vertex[2] * scale[2];
+            vec.z += translate[2];
+
+            // read the normal vector from the precalculated normal table
+            aiVector3D& vNormal = *pcNorOut;
+            LookupNormalIndex(pcVerts[iIndex].lightNormalIndex,vNormal);
+
+            // flip z and y to become right-handed
+            std::swap((float&)vNormal.z,(float&)vNormal.y);
+            std::swap((float&)vec.z,(float&)vec.y);
+        }
+    }
 }
 
 #endif // !! ASSIMP_BUILD_NO_MD2_IMPORTER
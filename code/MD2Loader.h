@@ -103,11 +103,23 @@ protected:
     */
     void ValidateHeader();
 
+    // -------------------------------------------------------------------
+    /** Read the vertex positions and normals of a frame
+    */
+    void ReadFrame(unsigned int iFrame, aiVector3D* pcVertOut,
+        aiVector3D* pcNorOut) const;
+
 protected:
 
     /** Configuration option: frame to be loaded */
     unsigned int configFrameID;
 
+    /** Configuration option: import all frames as morph targets */
+    bool configAllFrames;
+
+    /** Configuration option: number of threads to decode the frames on */
+    unsigned int configNumThreads;
+
     /** Header of the MD2 file */
     BE_NCONST MD2::Header* m_pcHeader;
 
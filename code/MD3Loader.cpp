@@ -58,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "RemoveComments.h"
 #include "ParsingUtils.h"
 #include "Importer.h"
+#include "CreateAnimMesh.h"
 #include <assimp/DefaultLogger.hpp>
 #include <memory>
 #include <assimp/IOSystem.hpp>
@@ -355,6 +356,8 @@ void Q3Shader::ConvertShaderToMaterial(aiMaterial* out, const ShaderDataBlock& s
 // Constructor to be privately used by Importer
 MD3Importer::MD3Importer()
     : configFrameID  (0)
+    , configAllFrames(false)
+    , configNumThreads(0)
     , configHandleMP (true)
     , configSpeedFlag()
     , pcHeader()
@@ -417,6 +420,11 @@ void MD3Importer::ValidateHeaderOffsets()
 
     if (pcHeader->NUM_FRAMES <= configFrameID )
         throw DeadlyImportError("The requested frame is not existing the file");
+
+    // Each frame has its own set of tags
+    if (pcHeader->OFS_TAGS + (uint64_t)pcHeader->NUM_FRAMES * pcHeader->NUM_TAGS * sizeof(MD3::Tag) > fileSize) {
+        throw DeadlyImportError("Invalid MD3 header: some tags are outside the file");
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -429,11 +437,16 @@ void MD3Importer::ValidateSurfaceHeaderOffsets(const MD3::Surface* pcSurf)
     if (pcSurf->OFS_TRIANGLES + ofs + pcSurf->NUM_TRIANGLES * sizeof(MD3::Triangle) > fileSize  ||
         pcSurf->OFS_SHADERS + ofs + pcSurf->NUM_SHADER * sizeof(MD3::Shader) > fileSize         ||
         pcSurf->OFS_ST + ofs + pcSurf->NUM_VERTICES * sizeof(MD3::TexCoord) > fileSize          ||
-        pcSurf->OFS_XYZNORMAL + ofs + pcSurf->NUM_VERTICES * sizeof(MD3::Vertex) > fileSize)    {
+        pcSurf->OFS_XYZNORMAL + ofs + (uint64_t)pcSurf->NUM_FRAMES * pcSurf->NUM_VERTICES * sizeof(MD3::Vertex) > fileSize)    {
 
         throw DeadlyImportError("Invalid MD3 surface header: some offsets are outside the file");
     }
 
+    // Every surface stores one set of vertices per frame
+    if (pcSurf->NUM_VERTICES && pcSurf->NUM_FRAMES < pcHeader->NUM_FRAMES) {
+        throw DeadlyImportError("Invalid MD3 surface header: some frames are missing");
+    }
+
     // Check whether all requirements for Q3 files are met. We don't
     // care, but probably someone does.
     if (pcSurf->NUM_TRIANGLES > AI_MD3_MAX_TRIANGLES) {
@@ -471,6 +484,12 @@ void MD3Importer::SetupProperties(const Importer* pImp)
         configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
     }
 
+    // AI_CONFIG_IMPORT_ALL_KEYFRAMES
+    configAllFrames = pImp->GetPropertyBool(AI_CONFIG_IMPORT_ALL_KEYFRAMES,false);
+
+    // AI_CONFIG_IMPORT_NUM_THREADS
+    configNumThreads = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NUM_THREADS,0));
+
     // AI_CONFIG_IMPORT_MD3_HANDLE_MULTIPART
     configHandleMP = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MD3_HANDLE_MULTIPART,1));
 
@@ -584,6 +603,9 @@ bool MD3Importer::ReadMultipartFile()
         BatchLoader::PropertyMap props;
         SetGenericProperty( props.ints, AI_CONFIG_IMPORT_MD3_HANDLE_MULTIPART, 0);
 
+        // the parts have different frame counts, so only pass on whether all of them are wanted
+        SetGenericProperty( props.ints, AI_CONFIG_IMPORT_ALL_KEYFRAMES, configAllFrames ? 1 : 0);
+
         // now read these three files
         BatchLoader batch(mIOHandler);
         const unsigned int _lower = batch.AddLoadRequest(lower,0,&props);
@@ -680,6 +702,33 @@ error_cleanup:
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Read the vertex positions and normals of a surface frame, one per triangle corner
+void MD3Importer::ReadSurfaceFrame(const MD3::Surface* pcSurf, unsigned int iFrame,
+    aiVector3D* pcVertOut, aiVector3D* pcNorOut) const
+{
+    const MD3::Vertex* pcVertices = (const MD3::Vertex*)
+        (((const uint8_t*)pcSurf) + pcSurf->OFS_XYZNORMAL) + iFrame * pcSurf->NUM_VERTICES;
+
+    const MD3::Triangle* pcTriangles = (const MD3::Triangle*)
+        (((const uint8_t*)pcSurf) + pcSurf->OFS_TRIANGLES);
+
+    for (unsigned int i = 0; i < (unsigned int)pcSurf->NUM_TRIANGLES;++i,++pcTriangles)   {
+        for (unsigned int c = 0; c < 3;++c,++pcVertOut,++pcNorOut)  {
+            uint32_t index = pcTriangles->INDEXES[c];
+            if (index >= pcSurf->NUM_VERTICES) {
+                throw DeadlyImportError( "MD3: Invalid vertex index");
+            }
+            pcVertOut->x = pcVertices[index].X*AI_MD3_XYZ_SCALE;
+            pcVertOut->y = pcVertices[index].Y*AI_MD3_XYZ_SCALE;
+            pcVertOut->z = pcVertices[index].Z*AI_MD3_XYZ_SCALE;
+
+            // Convert the normal vector to uncompressed float3 format
+            LatLngNormalToVec3(pcVertices[index].NORMAL,(ai_real*)pcNorOut);
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Convert a MD3 path to a proper value
 void MD3Importer::ConvertPath(const char* texture_name, const char* header_name, std::string& out) const
@@ -786,8 +835,9 @@ void MD3Importer::InternReadFile( const std::string& pFile,
     // Navigate to the list of surfaces
     BE_NCONST MD3::Surface* pcSurfaces = (BE_NCONST MD3::Surface*)(mBuffer + pcHeader->OFS_SURFACES);
 
-    // Navigate to the list of tags
-    BE_NCONST MD3::Tag* pcTags = (BE_NCONST MD3::Tag*)(mBuffer + pcHeader->OFS_TAGS);
+    // Navigate to the list of tags of the requested frame
+    BE_NCONST MD3::Tag* pcTags = (BE_NCONST MD3::Tag*)(mBuffer + pcHeader->OFS_TAGS) +
+        configFrameID * pcHeader->NUM_TAGS;
 
     // Allocate output storage
     pScene->mNumMeshes = pcHeader->NUM_SURFACES;
@@ -827,6 +877,10 @@ void MD3Importer::InternReadFile( const std::string& pFile,
         }
     }
 
+    // Surfaces and meshes to decode all frames of, if requested
+    std::vector<const MD3::Surface*> animSurfaces;
+    std::vector<aiMesh*> animMeshes;
+
     // Read all surfaces from the file
     unsigned int iNum = pcHeader->NUM_SURFACES;
     unsigned int iNumMaterials = 0;
@@ -852,10 +906,6 @@ void MD3Importer::InternReadFile( const std::string& pFile,
         // Validate the surface header
         ValidateSurfaceHeaderOffsets(pcSurfaces);
 
-        // Navigate to the vertex list of the surface
-        BE_NCONST MD3::Vertex* pcVertices = (BE_NCONST MD3::Vertex*)
-            (((uint8_t*)pcSurfaces) + pcSurfaces->OFS_XYZNORMAL);
-
         // Navigate to the triangle list of the surface
         BE_NCONST MD3::Triangle* pcTriangles = (BE_NCONST MD3::Triangle*)
             (((uint8_t*)pcSurfaces) + pcSurfaces->OFS_TRIANGLES);
@@ -968,14 +1018,19 @@ void MD3Importer::InternReadFile( const std::string& pFile,
             // Ensure correct endianness
 #ifdef AI_BUILD_BIG_ENDIAN
 
-        for (uint32_t i = 0; i < pcSurfaces->NUM_VERTICES;++i)  {
+        // Vertices of all frames
+        BE_NCONST MD3::Vertex* pcVertices = (BE_NCONST MD3::Vertex*)
+            (((uint8_t*)pcSurfaces) + pcSurfaces->OFS_XYZNORMAL);
+
+        for (uint32_t i = 0; i < pcSurfaces->NUM_VERTICES*pcSurfaces->NUM_FRAMES;++i)  {
             AI_SWAP2( pcVertices[i].NORMAL );
             AI_SWAP2( pcVertices[i].X );
             AI_SWAP2( pcVertices[i].Y );
             AI_SWAP2( pcVertices[i].Z );
-
-            AI_SWAP4( pcUVs[i].U );
+        }
+        for (uint32_t i = 0; i < pcSurfaces->NUM_VERTICES;++i)  {
             AI_SWAP4( pcUVs[i].U );
+            AI_SWAP4( pcUVs[i].V );
         }
         for (uint32_t i = 0; i < pcSurfaces->NUM_TRIANGLES;++i) {
             AI_SWAP4(pcTriangles[i].INDEXES[0]);
@@ -1006,19 +1061,11 @@ void MD3Importer::InternReadFile( const std::string& pFile,
             for (unsigned int c = 0; c < 3;++c,++iCurrent)  {
                 pcMesh->mFaces[i].mIndices[c] = iCurrent;
 
-                // Read vertices
-                aiVector3D& vec = pcMesh->mVertices[iCurrent];
+                // Validate vertex indices
                 uint32_t index = pcTriangles->INDEXES[c];
                 if (index >= pcSurfaces->NUM_VERTICES) {
                     throw DeadlyImportError( "MD3: Invalid vertex index");
                 }
-                vec.x = pcVertices[index].X*AI_MD3_XYZ_SCALE;
-                vec.y = pcVertices[index].Y*AI_MD3_XYZ_SCALE;
-                vec.z = pcVertices[index].Z*AI_MD3_XYZ_SCALE;
-
-                // Convert the normal vector to uncompressed float3 format
-                aiVector3D& nor = pcMesh->mNormals[iCurrent];
-                LatLngNormalToVec3(pcVertices[index].NORMAL,(ai_real*)&nor);
 
                 // Read texture coordinates
                 pcMesh->mTextureCoords[0][iCurrent].x = pcUVs[index].U;
@@ -1031,6 +1078,15 @@ void MD3Importer::InternReadFile( const std::string& pFile,
             pcTriangles++;
         }
 
+        // Read vertices and normals of the requested frame
+        ReadSurfaceFrame(pcSurfaces,configFrameID,pcMesh->mVertices,pcMesh->mNormals);
+
+        if (configAllFrames) {
+            pcMesh->mName.Set(pcSurfaces->NAME);
+            animSurfaces.push_back(pcSurfaces);
+            animMeshes.push_back(pcMesh);
+        }
+
         // Go to the next surface
         pcSurfaces = (BE_NCONST MD3::Surface*)(((unsigned char*)pcSurfaces) + pcSurfaces->OFS_END);
     }
@@ -1048,6 +1104,18 @@ void MD3Importer::InternReadFile( const std::string& pFile,
         throw DeadlyImportError( "MD3: File contains no valid mesh");
     pScene->mNumMaterials = iNumMaterials;
 
+    // Decode all frames of all surfaces as morph targets, in parallel
+    if (configAllFrames) {
+        aiCreateKeyframeAnimMeshes(&animMeshes[0],(unsigned int)animMeshes.size(),pcHeader->NUM_FRAMES,configNumThreads,
+            [this,&animSurfaces](unsigned int iMesh, unsigned int iFrame, aiAnimMesh& target) {
+                ReadSurfaceFrame(animSurfaces[iMesh],iFrame,target.mVertices,target.mNormals);
+            });
+
+        pScene->mNumAnimations = 1;
+        pScene->mAnimations = new aiAnimation*[1];
+        pScene->mAnimations[0] = aiCreateKeyframeMorphAnimation(&animMeshes[0],(unsigned int)animMeshes.size());
+    }
+
     // Now we need to generate an empty node graph
     pScene->mRootNode = new aiNode("<MD3Root>");
     pScene->mRootNode->mNumMeshes = pScene->mNumMeshes;
@@ -258,6 +258,13 @@ protected:
     void ValidateHeaderOffsets();
     void ValidateSurfaceHeaderOffsets(const MD3::Surface* pcSurfHeader);
 
+    // -------------------------------------------------------------------
+    /** Read the vertex positions and normals of one frame of a surface,
+     *  one for each triangle corner
+     */
+    void ReadSurfaceFrame(const MD3::Surface* pcSurf, unsigned int iFrame,
+        aiVector3D* pcVertOut, aiVector3D* pcNorOut) const;
+
     // -------------------------------------------------------------------
     /** Read a Q3 multipart file
      *  @return true if multi part has been processed
@@ -290,6 +297,12 @@ protected:
     /** Configuration option: frame to be loaded */
     unsigned int configFrameID;
 
+    /** Configuration option: import all frames as morph targets */
+    bool configAllFrames;
+
+    /** Configuration option: number of threads to decode the frames on */
+    unsigned int configNumThreads;
+
     /** Configuration option: process multi-part files */
     bool configHandleMP;
 
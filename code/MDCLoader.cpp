@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MDCLoader.h"
 #include "MD3FileData.h"
 #include "MDCNormalTable.h" // shouldn't be included by other units
+#include "CreateAnimMesh.h"
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/IOSystem.hpp>
@@ -98,6 +99,8 @@ void MDC::BuildVertex(const Frame& frame,
 // Constructor to be privately used by Importer
 MDCImporter::MDCImporter()
     : configFrameID(),
+    configAllFrames(),
+    configNumThreads(),
     pcHeader(),
     mBuffer(),
     fileSize()
@@ -192,13 +195,17 @@ void MDCImporter::ValidateSurfaceHeader(BE_NCONST MDC::Surface* pcSurf)
 
     const unsigned int iMax = this->fileSize - (unsigned int)((int8_t*)pcSurf-(int8_t*)pcHeader);
 
-    if (pcSurf->ulOffsetBaseVerts + pcSurf->ulNumVertices * sizeof(MDC::BaseVertex)         > iMax ||
-        (pcSurf->ulNumCompFrames && pcSurf->ulOffsetCompVerts + pcSurf->ulNumVertices * sizeof(MDC::CompressedVertex)   > iMax) ||
+    // the base and compressed frame tables have one entry per frame
+    const uint64_t iBaseVerts = (uint64_t)pcSurf->ulNumBaseFrames * pcSurf->ulNumVertices;
+    const uint64_t iCompVerts = (uint64_t)pcSurf->ulNumCompFrames * pcSurf->ulNumVertices;
+
+    if (pcSurf->ulOffsetBaseVerts + iBaseVerts * sizeof(MDC::BaseVertex)                    > iMax ||
+        (pcSurf->ulNumCompFrames && pcSurf->ulOffsetCompVerts + iCompVerts * sizeof(MDC::CompressedVertex)  > iMax) ||
         pcSurf->ulOffsetTriangles + pcSurf->ulNumTriangles * sizeof(MDC::Triangle)          > iMax ||
         pcSurf->ulOffsetTexCoords + pcSurf->ulNumVertices * sizeof(MDC::TexturCoord)        > iMax ||
         pcSurf->ulOffsetShaders + pcSurf->ulNumShaders * sizeof(MDC::Shader)                > iMax ||
-        pcSurf->ulOffsetFrameBaseFrames + pcSurf->ulNumBaseFrames * 2                       > iMax ||
-        (pcSurf->ulNumCompFrames && pcSurf->ulOffsetFrameCompFrames + pcSurf->ulNumCompFrames * 2   > iMax))
+        pcSurf->ulOffsetFrameBaseFrames + pcHeader->ulNumFrames * 2                         > iMax ||
+        (pcSurf->ulNumCompFrames && pcSurf->ulOffsetFrameCompFrames + pcHeader->ulNumFrames * 2   > iMax))
     {
         throw DeadlyImportError("Some of the offset values in the MDC surface header "
             "are invalid and point somewhere behind the file.");
@@ -214,6 +221,8 @@ void MDCImporter::SetupProperties(const Importer* pImp)
     if(static_cast<unsigned int>(-1) == (configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MDC_KEYFRAME,-1))){
         configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
     }
+    configAllFrames = pImp->GetPropertyBool(AI_CONFIG_IMPORT_ALL_KEYFRAMES,false);
+    configNumThreads = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NUM_THREADS,0));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -242,19 +251,24 @@ void MDCImporter::InternReadFile(
 
     std::vector<std::string> aszShaders;
 
-    // get a pointer to the frame we want to read
+#if (defined AI_BUILD_BIG_ENDIAN)
+
+    // swap the origins of all frames, no need to swap the other members, we won't need them
     BE_NCONST MDC::Frame* pcFrame = (BE_NCONST MDC::Frame*)(this->mBuffer+
         this->pcHeader->ulOffsetBorderFrames);
+    for (unsigned int i = 0; i < pcHeader->ulNumFrames;++i,++pcFrame)
+    {
+        AI_SWAP4( pcFrame->localOrigin[0] );
+        AI_SWAP4( pcFrame->localOrigin[1] );
+        AI_SWAP4( pcFrame->localOrigin[2] );
+    }
 
-    // no need to swap the other members, we won't need them
-    pcFrame += configFrameID;
-    AI_SWAP4( pcFrame->localOrigin[0] );
-    AI_SWAP4( pcFrame->localOrigin[1] );
-    AI_SWAP4( pcFrame->localOrigin[2] );
+#endif
 
-    // get the number of valid surfaces
+    // get the number of valid surfaces. Don't construct the surfaces in
+    // place, the constructor would clear the file data.
     BE_NCONST MDC::Surface* pcSurface, *pcSurface2;
-    pcSurface = pcSurface2 = new (mBuffer + pcHeader->ulOffsetSurfaces) MDC::Surface;
+    pcSurface = pcSurface2 = (BE_NCONST MDC::Surface*)(mBuffer + pcHeader->ulOffsetSurfaces);
     unsigned int iNumShaders = 0;
     for (unsigned int i = 0; i < pcHeader->ulNumSurfaces;++i)
     {
@@ -263,7 +277,7 @@ void MDCImporter::InternReadFile(
 
         if (pcSurface2->ulNumVertices && pcSurface2->ulNumTriangles)++pScene->mNumMeshes;
         iNumShaders += pcSurface2->ulNumShaders;
-        pcSurface2 = new ((int8_t*)pcSurface2 + pcSurface2->ulOffsetEnd) MDC::Surface;
+        pcSurface2 = (BE_NCONST MDC::Surface*)((int8_t*)pcSurface2 + pcSurface2->ulOffsetEnd);
     }
     aszShaders.reserve(iNumShaders);
     pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
@@ -272,12 +286,17 @@ void MDCImporter::InternReadFile(
     for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
         pScene->mMeshes[i] = NULL;
 
+    // surfaces of all output meshes, for decoding all frames if requested
+    std::vector<const MDC::Surface*> apcSurfaces;
+
     // now read all surfaces
     unsigned int iDefaultMatIndex = UINT_MAX;
-    for (unsigned int i = 0, iNum = 0; i < pcHeader->ulNumSurfaces;++i)
+    for (unsigned int i = 0, iNum = 0; i < pcHeader->ulNumSurfaces;++i,
+        pcSurface = (BE_NCONST MDC::Surface*)((int8_t*)pcSurface + pcSurface->ulOffsetEnd))
     {
         if (!pcSurface->ulNumVertices || !pcSurface->ulNumTriangles)continue;
         aiMesh* pcMesh = pScene->mMeshes[iNum++] = new aiMesh();
+        apcSurfaces.push_back(pcSurface);
 
         pcMesh->mNumFaces = pcSurface->ulNumTriangles;
         pcMesh->mNumVertices = pcMesh->mNumFaces * 3;
@@ -307,8 +326,8 @@ void MDCImporter::InternReadFile(
         else pcMesh->mMaterialIndex = iDefaultMatIndex;
 
         // allocate output storage for the mesh
-        aiVector3D* pcVertCur   = pcMesh->mVertices         = new aiVector3D[pcMesh->mNumVertices];
-        aiVector3D* pcNorCur    = pcMesh->mNormals          = new aiVector3D[pcMesh->mNumVertices];
+        pcMesh->mVertices                                   = new aiVector3D[pcMesh->mNumVertices];
+        pcMesh->mNormals                                    = new aiVector3D[pcMesh->mNumVertices];
         aiVector3D* pcUVCur     = pcMesh->mTextureCoords[0] = new aiVector3D[pcMesh->mNumVertices];
         aiFace* pcFaceCur       = pcMesh->mFaces            = new aiFace[pcMesh->mNumFaces];
 
@@ -319,18 +338,14 @@ void MDCImporter::InternReadFile(
         BE_NCONST MDC::TexturCoord* const pcUVs = (BE_NCONST MDC::TexturCoord*)
             ((int8_t*)pcSurface+pcSurface->ulOffsetTexCoords);
 
-        // get a pointer to the uncompressed vertices
-        int16_t iOfs = *((int16_t*) ((int8_t*) pcSurface +
-            pcSurface->ulOffsetFrameBaseFrames) +  this->configFrameID);
-
-        AI_SWAP2(iOfs);
+        // do the main swapping stuff ...
+#if (defined AI_BUILD_BIG_ENDIAN)
 
         BE_NCONST MDC::BaseVertex* const pcVerts = (BE_NCONST MDC::BaseVertex*)
-            ((int8_t*)pcSurface+pcSurface->ulOffsetBaseVerts) +
-            ((int)iOfs * pcSurface->ulNumVertices * 4);
+            ((int8_t*)pcSurface+pcSurface->ulOffsetBaseVerts);
 
-        // do the main swapping stuff ...
-#if (defined AI_BUILD_BIG_ENDIAN)
+        int16_t* const piBaseFrames = (int16_t*)((int8_t*)pcSurface+pcSurface->ulOffsetFrameBaseFrames);
+        int16_t* const piCompFrames = (int16_t*)((int8_t*)pcSurface+pcSurface->ulOffsetFrameCompFrames);
 
         // swap all triangles
         for (unsigned int i = 0; i < pcSurface->ulNumTriangles;++i)
@@ -343,37 +358,30 @@ void MDCImporter::InternReadFile(
         // swap all vertices
         for (unsigned int i = 0; i < pcSurface->ulNumVertices*pcSurface->ulNumBaseFrames;++i)
         {
-            AI_SWAP2( pcVerts->normal );
-            AI_SWAP2( pcVerts->x );
-            AI_SWAP2( pcVerts->y );
-            AI_SWAP2( pcVerts->z );
+            AI_SWAP2( pcVerts[i].normal );
+            AI_SWAP2( pcVerts[i].x );
+            AI_SWAP2( pcVerts[i].y );
+            AI_SWAP2( pcVerts[i].z );
+        }
+
+        // swap the frame tables
+        for (unsigned int i = 0; i < pcHeader->ulNumFrames;++i)
+        {
+            AI_SWAP2( piBaseFrames[i] );
+            if (pcSurface->ulNumCompFrames) {
+                AI_SWAP2( piCompFrames[i] );
+            }
         }
 
         // swap all texture coordinates
         for (unsigned int i = 0; i < pcSurface->ulNumVertices;++i)
         {
-            AI_SWAP4( pcUVs->v );
-            AI_SWAP4( pcUVs->v );
+            AI_SWAP4( pcUVs[i].u );
+            AI_SWAP4( pcUVs[i].v );
         }
 
 #endif
 
-        const MDC::CompressedVertex* pcCVerts = NULL;
-        int16_t* mdcCompVert = NULL;
-
-        // access compressed frames for large frame numbers, but never for the first
-        if( this->configFrameID && pcSurface->ulNumCompFrames > 0 )
-        {
-            mdcCompVert = (int16_t*) ((int8_t*)pcSurface+pcSurface->ulOffsetFrameCompFrames) + this->configFrameID;
-            AI_SWAP2P(mdcCompVert);
-            if( *mdcCompVert >= 0 )
-            {
-                pcCVerts = (const MDC::CompressedVertex*)((int8_t*)pcSurface +
-                    pcSurface->ulOffsetCompVerts) + *mdcCompVert * pcSurface->ulNumVertices;
-            }
-            else mdcCompVert = NULL;
-        }
-
         // copy all faces
         for (unsigned int iFace = 0; iFace < pcSurface->ulNumTriangles;++iFace,
             ++pcTriangle,++pcFaceCur)
@@ -382,8 +390,7 @@ void MDCImporter::InternReadFile(
             pcFaceCur->mNumIndices = 3;
             pcFaceCur->mIndices = new unsigned int[3];
 
-            for (unsigned int iIndex = 0; iIndex < 3;++iIndex,
-                ++pcVertCur,++pcUVCur,++pcNorCur)
+            for (unsigned int iIndex = 0; iIndex < 3;++iIndex,++pcUVCur)
             {
                 uint32_t quak = pcTriangle->aiIndices[iIndex];
                 if (quak >= pcSurface->ulNumVertices)
@@ -392,29 +399,9 @@ void MDCImporter::InternReadFile(
                     quak = pcSurface->ulNumVertices-1;
                 }
 
-                // compressed vertices?
-                if (mdcCompVert)
-                {
-                    MDC::BuildVertex(*pcFrame,pcVerts[quak],pcCVerts[quak],
-                        *pcVertCur,*pcNorCur);
-                }
-                else
-                {
-                    // copy position
-                    pcVertCur->x = pcVerts[quak].x * AI_MDC_BASE_SCALING;
-                    pcVertCur->y = pcVerts[quak].y * AI_MDC_BASE_SCALING;
-                    pcVertCur->z = pcVerts[quak].z * AI_MDC_BASE_SCALING;
-
-                    // copy normals
-                    MD3::LatLngNormalToVec3( pcVerts[quak].normal, &pcNorCur->x );
-
-                    // copy texture coordinates
-                    pcUVCur->x = pcUVs[quak].u;
-                    pcUVCur->y = ai_real( 1.0 )-pcUVs[quak].v; // DX to OGL
-                }
-                pcVertCur->x += pcFrame->localOrigin[0] ;
-                pcVertCur->y += pcFrame->localOrigin[1] ;
-                pcVertCur->z += pcFrame->localOrigin[2] ;
+                // copy texture coordinates
+                pcUVCur->x = pcUVs[quak].u;
+                pcUVCur->y = ai_real( 1.0 )-pcUVs[quak].v; // DX to OGL
             }
 
             // swap the face order - DX to OGL
@@ -423,7 +410,8 @@ void MDCImporter::InternReadFile(
             pcFaceCur->mIndices[2] = iOutIndex + 0;
         }
 
-        pcSurface =  new ((int8_t*)pcSurface + pcSurface->ulOffsetEnd) MDC::Surface;
+        // read the vertices of the requested frame
+        ReadSurfaceFrame(pcSurface,configFrameID,pcMesh->mVertices,pcMesh->mNormals);
     }
 
     // create a flat node graph with a root node and one child for each surface
@@ -458,6 +446,22 @@ void MDCImporter::InternReadFile(
     for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
         pScene->mMeshes[i]->mTextureCoords[3] = NULL;
 
+    // decode all frames of all surfaces as morph targets, in parallel
+    if (configAllFrames)
+    {
+        for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
+            pScene->mMeshes[i]->mName.Set(apcSurfaces[i]->ucName);
+
+        aiCreateKeyframeAnimMeshes(pScene->mMeshes,pScene->mNumMeshes,pcHeader->ulNumFrames,configNumThreads,
+            [this,&apcSurfaces](unsigned int iMesh, unsigned int iFrame, aiAnimMesh& target) {
+                ReadSurfaceFrame(apcSurfaces[iMesh],iFrame,target.mVertices,target.mNormals);
+            });
+
+        pScene->mNumAnimations = 1;
+        pScene->mAnimations = new aiAnimation*[1];
+        pScene->mAnimations[0] = aiCreateKeyframeMorphAnimation(pScene->mMeshes,pScene->mNumMeshes);
+    }
+
     // create materials
     pScene->mNumMaterials = (unsigned int)aszShaders.size();
     pScene->mMaterials = new aiMaterial*[pScene->mNumMaterials];
@@ -491,4 +495,69 @@ void MDCImporter::InternReadFile(
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Read the vertex positions and normals of a surface frame, one per triangle corner
+void MDCImporter::ReadSurfaceFrame(const MDC::Surface* pcSurface, unsigned int iFrame,
+    aiVector3D* pcVertOut, aiVector3D* pcNorOut) const
+{
+    const MDC::Frame& frame = ((const MDC::Frame*)(mBuffer + pcHeader->ulOffsetBorderFrames))[iFrame];
+
+    const MDC::Triangle* pcTriangle = (const MDC::Triangle*)
+        ((const int8_t*)pcSurface+pcSurface->ulOffsetTriangles);
+
+    // get a pointer to the uncompressed vertices
+    const int16_t iBase = ((const int16_t*)((const int8_t*)pcSurface +
+        pcSurface->ulOffsetFrameBaseFrames))[iFrame];
+    if (iBase < 0 || (uint32_t)iBase >= pcSurface->ulNumBaseFrames) {
+        throw DeadlyImportError("MDC: Base frame index is out of range");
+    }
+
+    const MDC::BaseVertex* const pcVerts = (const MDC::BaseVertex*)
+        ((const int8_t*)pcSurface+pcSurface->ulOffsetBaseVerts) + iBase * pcSurface->ulNumVertices;
+
+    // access compressed frames for large frame numbers, but never for the first
+    const MDC::CompressedVertex* pcCVerts = NULL;
+    if (iFrame && pcSurface->ulNumCompFrames > 0)
+    {
+        const int16_t iComp = ((const int16_t*)((const int8_t*)pcSurface +
+            pcSurface->ulOffsetFrameCompFrames))[iFrame];
+        if (iComp >= 0)
+        {
+            if ((uint32_t)iComp >= pcSurface->ulNumCompFrames) {
+                throw DeadlyImportError("MDC: Compressed frame index is out of range");
+            }
+            pcCVerts = (const MDC::CompressedVertex*)((const int8_t*)pcSurface +
+                pcSurface->ulOffsetCompVerts) + iComp * pcSurface->ulNumVertices;
+        }
+    }
+
+    for (unsigned int iFace = 0; iFace < pcSurface->ulNumTriangles;++iFace,++pcTriangle)
+    {
+        for (unsigned int iIndex = 0; iIndex < 3;++iIndex,++pcVertOut,++pcNorOut)
+        {
+            // invalid vertex indices have been reported already
+            uint32_t quak = pcTriangle->aiIndices[iIndex];
+            if (quak >= pcSurface->ulNumVertices)
+                quak = pcSurface->ulNumVertices-1;
+
+            // compressed vertices?
+            if (pcCVerts)
+            {
+                MDC::BuildVertex(frame,pcVerts[quak],pcCVerts[quak],
+                    *pcVertOut,*pcNorOut);
+            }
+            else
+            {
+                // copy position
+                pcVertOut->x = frame.localOrigin.x + pcVerts[quak].x * AI_MDC_BASE_SCALING;
+                pcVertOut->y = frame.localOrigin.y + pcVerts[quak].y * AI_MDC_BASE_SCALING;
+                pcVertOut->z = frame.localOrigin.z + pcVerts[quak].z * AI_MDC_BASE_SCALING;
+
+                // copy normals
+                MD3::LatLngNormalToVec3( pcVerts[quak].normal, &pcNorOut->x );
+            }
+        }
+    }
+}
+
 #endif // !! ASSIMP_BUILD_NO_MDC_IMPORTER
@@ -108,12 +108,25 @@ protected:
     */
     void ValidateSurfaceHeader(BE_NCONST MDC::Surface* pcSurf);
 
+    // -------------------------------------------------------------------
+    /** Read the vertex positions and normals of one frame of a surface,
+     *  one for each triangle corner
+    */
+    void ReadSurfaceFrame(const MDC::Surface* pcSurf, unsigned int iFrame,
+        aiVector3D* pcVertOut, aiVector3D* pcNorOut) const;
+
 protected:
 
 
     /** Configuration option: frame to be loaded */
     unsigned int configFrameID;
 
+    /** Configuration option: import all frames as morph targets */
+    bool configAllFrames;
+
+    /** Configuration option: number of threads to decode the frames on */
+    unsigned int configNumThreads;
+
     /** Header of the MDC file */
     BE_NCONST MDC::Header* pcHeader;
 
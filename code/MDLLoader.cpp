@@ -55,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MDLDefaultColorMap.h"
 #include "MD2FileData.h"
 #include "StringUtils.h"
+#include "CreateAnimMesh.h"
 #include <assimp/Importer.hpp>
 #include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
@@ -93,6 +94,8 @@ static const aiImporterDesc desc = {
 // Constructor to be privately used by Importer
 MDLImporter::MDLImporter()
     : configFrameID(),
+    configAllFrames(),
+    configNumThreads(),
     mBuffer(),
     iGSFileVersion(),
     pIOHandler(),
@@ -140,6 +143,12 @@ void MDLImporter::SetupProperties(const Importer* pImp)
         configFrameID =  pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
     }
 
+    // AI_CONFIG_IMPORT_ALL_KEYFRAMES - Quake 1 files only
+    configAllFrames = pImp->GetPropertyBool(AI_CONFIG_IMPORT_ALL_KEYFRAMES,false);
+
+    // AI_CONFIG_IMPORT_NUM_THREADS
+    configNumThreads = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NUM_THREADS,0));
+
     // AI_CONFIG_IMPORT_MDL_COLORMAP - pallette file
     configPalette =  pImp->GetPropertyString(AI_CONFIG_IMPORT_MDL_COLORMAP,"colormap.lmp");
 }
@@ -403,23 +412,46 @@ void MDLImporter::InternReadFile_Quake1( )
     szCurrent += sizeof(MDL::Triangle) * pcHeader->num_tris;
     VALIDATE_FILE_SIZE(szCurrent);
 
-    // now get a pointer to the first frame in the file
-    BE_NCONST MDL::Frame* pcFrames = (BE_NCONST MDL::Frame*)szCurrent;
-    BE_NCONST MDL::SimpleFrame* pcFirstFrame;
-
-    if (0 == pcFrames->type)
-    {
-        // get address of single frame
-        pcFirstFrame = &pcFrames->frame;
-    }
-    else
+    if (configFrameID >= (unsigned int)pcHeader->num_frames)
+        throw DeadlyImportError("[Quake 1 MDL] The requested frame is not available");
+
+    // Frames vary in size, so walk them up to the last one we need. Each
+    // frame is either a single pose or a group of poses, of which we take
+    // the first: the frame type is followed by the pose count, the bounding
+    // box and one interval per pose for groups, then by the poses, each of
+    // them a bounding box, a name and the vertices.
+    const unsigned int iNumFrames = configAllFrames ? pcHeader->num_frames : configFrameID + 1;
+    const size_t iPoseSize = 2 * sizeof(MDL::Vertex) + sizeof(MDL::SimpleFrame::name) +
+        pcHeader->num_verts * sizeof(MDL::Vertex);
+
+    std::vector<const MDL::Vertex*> apcFrameVertices;
+    apcFrameVertices.reserve(iNumFrames);
+    for (unsigned int i = 0; i < iNumFrames;++i)
     {
-        // get the first frame in the group
-        BE_NCONST MDL::GroupFrame* pcFrames2 = (BE_NCONST MDL::GroupFrame*)pcFrames;
-        pcFirstFrame = (BE_NCONST MDL::SimpleFrame*)(&pcFrames2->time + pcFrames->type);
+        VALIDATE_FILE_SIZE(szCurrent + sizeof(int32_t));
+        int32_t iType = *((const int32_t*)szCurrent);
+        AI_SWAP4(iType);
+        szCurrent += sizeof(int32_t);
+
+        size_t iNumPoses = 1;
+        if (0 != iType)
+        {
+            VALIDATE_FILE_SIZE(szCurrent + sizeof(int32_t) + 2 * sizeof(MDL::Vertex));
+            int32_t iPoses = *((const int32_t*)szCurrent);
+            AI_SWAP4(iPoses);
+            if (iPoses <= 0 || (size_t)iPoses > iFileSize / iPoseSize)
+                throw DeadlyImportError("[Quake 1 MDL] Invalid number of poses in frame group");
+
+            iNumPoses = (size_t)iPoses;
+            szCurrent += sizeof(int32_t) + 2 * sizeof(MDL::Vertex) + iNumPoses * sizeof(float);
+        }
+        apcFrameVertices.push_back((const MDL::Vertex*)(szCurrent + iPoseSize -
+            pcHeader->num_verts * sizeof(MDL::Vertex)));
+
+        // only the first pose needs to be there for the last frame
+        VALIDATE_FILE_SIZE(szCurrent + iPoseSize);
+        szCurrent += iNumPoses * iPoseSize;
     }
-    BE_NCONST MDL::Vertex* pcVertices = (BE_NCONST MDL::Vertex*) ((pcFirstFrame->name) + sizeof(pcFirstFrame->name));
-    VALIDATE_FILE_SIZE((const unsigned char*)(pcVertices + pcHeader->num_verts));
 
 #ifdef AI_BUILD_BIG_ENDIAN
     for (int i = 0; i<pcHeader->num_verts;++i)
@@ -482,21 +514,6 @@ void MDLImporter::InternReadFile_Quake1( )
                 DefaultLogger::get()->warn("Index overflow in Q1-MDL vertex list.");
             }
 
-            aiVector3D& vec = pcMesh->mVertices[iCurrent];
-            vec.x = (float)pcVertices[iIndex].v[0] * pcHeader->scale[0];
-            vec.x += pcHeader->translate[0];
-
-            vec.y = (float)pcVertices[iIndex].v[1] * pcHeader->scale[1];
-            vec.y += pcHeader->translate[1];
-            //vec.y *= -1.0f;
-
-            vec.z = (float)pcVertices[iIndex].v[2] * pcHeader->scale[2];
-            vec.z += pcHeader->translate[2];
-
-            // read the normal vector from the precalculated normal table
-            MD2::LookupNormalIndex(pcVertices[iIndex].normalIndex,pcMesh->mNormals[iCurrent]);
-            //pcMesh->mNormals[iCurrent].y *= -1.0f;
-
             // read texture coordinates
             float s = (float)pcTexCoords[iIndex].s;
             float t = (float)pcTexCoords[iIndex].t;
@@ -516,7 +533,60 @@ void MDLImporter::InternReadFile_Quake1( )
         pcMesh->mFaces[i].mIndices[2] = iTemp+0;
         pcTriangles++;
     }
-    return;
+    pcTriangles -= pcHeader->num_tris;
+
+    // read the vertices of the requested frame
+    ReadFrame_Quake1(pcHeader,pcTriangles,apcFrameVertices[configFrameID],
+        pcMesh->mVertices,pcMesh->mNormals);
+
+    // decode all frames as morph targets, in parallel
+    if (configAllFrames)
+    {
+        pcMesh->mName.Set("<MDLMesh>");
+        aiCreateKeyframeAnimMeshes(&pcMesh,1,iNumFrames,configNumThreads,
+            [&](unsigned int, unsigned int iFrame, aiAnimMesh& target) {
+                ReadFrame_Quake1(pcHeader,pcTriangles,apcFrameVertices[iFrame],
+                    target.mVertices,target.mNormals);
+            });
+
+        pScene->mNumAnimations = 1;
+        pScene->mAnimations = new aiAnimation*[1];
+        pScene->mAnimations[0] = aiCreateKeyframeMorphAnimation(&pcMesh,1);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Read the vertex positions and normals of a quake 1 frame, one per triangle corner
+void MDLImporter::ReadFrame_Quake1(const MDL::Header* pcHeader,
+    const MDL::Triangle* pcTriangles,
+    const MDL::Vertex* pcVertices,
+    aiVector3D* pcVertOut, aiVector3D* pcNorOut) const
+{
+    for (unsigned int i = 0; i < (unsigned int) pcHeader->num_tris;++i,++pcTriangles)
+    {
+        for (unsigned int c = 0; c < 3;++c,++pcVertOut,++pcNorOut)
+        {
+            // index overflows have been reported already
+            unsigned int iIndex = pcTriangles->vertex[c];
+            if (iIndex >= (unsigned int)pcHeader->num_verts)
+                iIndex = pcHeader->num_verts-1;
+
+            aiVector3D& vec = *pcVertOut;
+            vec.x = (float)pcVertices[iIndex].v[0] * pcHeader->scale[0];
+            vec.x += pcHeader->translate[0];
+
+            vec.y = (float)pcVertices[iIndex].v[1] * pcHeader->scale[1];
+            vec.y += pcHeader->translate[1];
+            //vec.y *= -1.0f;
+
+            vec.z = (float)pcVertices[iIndex].v[2] * pcHeader->scale[2];
+            vec.z += pcHeader->translate[2];
+
+            // read the normal vector from the precalculated normal table
+            MD2::LookupNormalIndex(pcVertices[iIndex].normalIndex,*pcNorOut);
+            //pcNorOut->y *= -1.0f;
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -128,6 +128,15 @@ protected:
     */
     void InternReadFile_Quake1( );
 
+    // -------------------------------------------------------------------
+    /** Read the vertex positions and normals of a quake 1 frame, one
+     *  for each triangle corner
+    */
+    void ReadFrame_Quake1(const MDL::Header* pcHeader,
+        const MDL::Triangle* pcTriangles,
+        const MDL::Vertex* pcVertices,
+        aiVector3D* pcVertOut, aiVector3D* pcNorOut) const;
+
     // -------------------------------------------------------------------
     /** Import a GameStudio A4/A5 file (MDL 3,4,5)
     */
@@ -433,6 +442,13 @@ protected:
     /** Configuration option: frame to be loaded */
     unsigned int configFrameID;
 
+    /** Configuration option: import all frames of quake 1 files as
+     *  morph targets */
+    bool configAllFrames;
+
+    /** Configuration option: number of threads to decode the frames on */
+    unsigned int configNumThreads;
+
     /** Configuration option: palette to be used to decode palletized images*/
     std::string configPalette;
 
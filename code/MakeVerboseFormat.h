@@ -92,10 +92,11 @@ public:
     * @param pScene The imported data to work at. */
     void Execute( aiScene* pScene);
 
-
-private:
-
-    //! Apply the postprocess step to a given submesh
+    // -------------------------------------------------------------------
+    /** Apply the postprocess step to a given submesh. Unlike Execute()
+    * this doesn't reset the AI_SCENE_FLAGS_NON_VERBOSE_FORMAT flag.
+    * @param pcMesh The mesh to work at.
+    * @return true if the mesh got a new number of vertices */
     bool MakeVerboseFormat (aiMesh* pcMesh);
 };
 
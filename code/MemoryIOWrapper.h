@@ -79,6 +79,10 @@ public:
     // -------------------------------------------------------------------
     // Read from stream
     size_t Read(void* pvBuffer, size_t pSize, size_t pCount)    {
+        if (0 == pSize) {
+            // like fread(), e.g. for an empty string
+            return 0;
+        }
         const size_t cnt = std::min(pCount,(length-pos)/pSize),ofs = pSize*cnt;
 
         memcpy(pvBuffer,buffer+pos,ofs);
@@ -136,6 +140,18 @@ public:
         ai_assert(false); // won't be needed
     }
 
+    // -------------------------------------------------------------------
+    // Get the memory block the stream reads from
+    const uint8_t* GetBuffer() const {
+        return buffer;
+    }
+
+    // -------------------------------------------------------------------
+    // Returns true if the memory block is released with the stream
+    bool IsOwner() const {
+        return own;
+    }
+
 private:
     const uint8_t* buffer;
     size_t length,pos;
@@ -45,6 +45,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjExporter.h"
 #include "Exceptional.h"
 #include "StringComparison.h"
+#include "IOStreamWriter.h"
+#include "fast_ftoa.h"
 #include <assimp/version.h>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
@@ -62,47 +64,47 @@ void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
     // invoke the exporter
     ObjExporter exporter(pFile, pScene);
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
+    // write both the main OBJ file and the material script, the output is streamed into the files
     {
         std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
         if(outfile == NULL) {
             throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
         }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+        IOStreamWriter output(outfile.get());
+        exporter.WriteGeometryFile(output);
+        if (output.flush().fail()) {
+            throw DeadlyExportError("could not write output .obj file: " + std::string(pFile));
+        }
     }
     {
         std::unique_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
         if(outfile == NULL) {
             throw DeadlyExportError("could not open output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
         }
-        outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
+        IOStreamWriter output(outfile.get());
+        exporter.WriteMaterialFile(output);
+        if (output.flush().fail()) {
+            throw DeadlyExportError("could not write output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
+        }
     }
 }
 
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to Wavefront OBJ without the material file. Prototyped and registered in Exporter.cpp
-void ExportSceneObjNoMtl(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties) {
+void ExportSceneObjNoMtl(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/) {
     // invoke the exporter
     ObjExporter exporter(pFile, pScene, true);
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
+    // write the main OBJ file, the output is streamed into the file
+    std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+    if(outfile == NULL) {
+        throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
     }
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
-    {
-        std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-        if(outfile == NULL) {
-            throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
-        }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    IOStreamWriter output(outfile.get());
+    exporter.WriteGeometryFile(output);
+    if (output.flush().fail()) {
+        throw DeadlyExportError("could not write output .obj file: " + std::string(pFile));
     }
-
-
 }
 
 } // end of namespace Assimp
@@ -122,17 +124,9 @@ ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMt
 , mVtMap()
 , mVcMap()
 , mMeshes()
+, mNoMtl(noMtl)
 , endl("\n") {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(16);
-    mOutputMat.imbue(l);
-    mOutputMat.precision(16);
-
-    WriteGeometryFile(noMtl);
-    if (!noMtl)
-        WriteMaterialFile();
+    // empty
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -164,7 +158,7 @@ std::string ObjExporter::GetMaterialLibFileName() {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter::WriteHeader(std::ostringstream& out) {
+void ObjExporter::WriteHeader(std::ostream& out) {
     out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
     out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.'
         << aiGetVersionRevision() << ")" << endl  << endl;
@@ -190,78 +184,83 @@ std::string ObjExporter::GetMaterialName(unsigned int index)
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter::WriteMaterialFile()
+void ObjExporter::WriteMaterialFile(std::ostream& out)
 {
-    WriteHeader(mOutputMat);
+    // make sure that all formatting happens using the standard, C locale and not the user's current locale
+    out.imbue(std::locale("C"));
+    WriteHeader(out);
 
     for(unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
         const aiMaterial* const mat = pScene->mMaterials[i];
 
         int illum = 1;
-        mOutputMat << "newmtl " << GetMaterialName(i)  << endl;
+        out << "newmtl " << GetMaterialName(i)  << endl;
 
         aiColor4D c;
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_DIFFUSE,c)) {
-            mOutputMat << "Kd " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Kd " << ShortestReals(&c.r, 3) << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_AMBIENT,c)) {
-            mOutputMat << "Ka " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Ka " << ShortestReals(&c.r, 3) << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_SPECULAR,c)) {
-            mOutputMat << "Ks " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Ks " << ShortestReals(&c.r, 3) << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_EMISSIVE,c)) {
-            mOutputMat << "Ke " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Ke " << ShortestReals(&c.r, 3) << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_TRANSPARENT,c)) {
-            mOutputMat << "Tf " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Tf " << ShortestReals(&c.r, 3) << endl;
         }
 
         ai_real o;
         if(AI_SUCCESS == mat->Get(AI_MATKEY_OPACITY,o)) {
-            mOutputMat << "d " << o << endl;
+            out << "d " << ShortestReals(o) << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_REFRACTI,o)) {
-            mOutputMat << "Ni " << o << endl;
+            out << "Ni " << ShortestReals(o) << endl;
         }
 
         if(AI_SUCCESS == mat->Get(AI_MATKEY_SHININESS,o) && o) {
-            mOutputMat << "Ns " << o << endl;
+            out << "Ns " << ShortestReals(o) << endl;
             illum = 2;
         }
 
-        mOutputMat << "illum " << illum << endl;
+        out << "illum " << illum << endl;
 
         aiString s;
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_DIFFUSE(0),s)) {
-            mOutputMat << "map_Kd " << s.data << endl;
+            out << "map_Kd " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_AMBIENT(0),s)) {
-            mOutputMat << "map_Ka " << s.data << endl;
+            out << "map_Ka " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_SPECULAR(0),s)) {
-            mOutputMat << "map_Ks " << s.data << endl;
+            out << "map_Ks " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_SHININESS(0),s)) {
-            mOutputMat << "map_Ns " << s.data << endl;
+            out << "map_Ns " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_OPACITY(0),s)) {
-            mOutputMat << "map_d " << s.data << endl;
+            out << "map_d " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_HEIGHT(0),s) || AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_NORMALS(0),s)) {
             // implementations seem to vary here, so write both variants
-            mOutputMat << "bump " << s.data << endl;
-            mOutputMat << "map_bump " << s.data << endl;
+            out << "bump " << s.data << endl;
+            out << "map_bump " << s.data << endl;
         }
 
-        mOutputMat << endl;
+        out << endl;
     }
 }
 
-void ObjExporter::WriteGeometryFile(bool noMtl) {
-    WriteHeader(mOutput);
-    if (!noMtl)
-        mOutput << "mtllib "  << GetMaterialLibName() << endl << endl;
+// ------------------------------------------------------------------------------------------------
+void ObjExporter::WriteGeometryFile(std::ostream& out) {
+    // make sure that all formatting happens using the standard, C locale and not the user's current locale
+    out.imbue(std::locale("C"));
+    WriteHeader(out);
+    if (!mNoMtl)
+        out << "mtllib "  << GetMaterialLibName() << endl << endl;
 
     // collect mesh geometry
     aiMatrix4x4 mBase;
@@ -271,68 +270,68 @@ void ObjExporter::WriteGeometryFile(bool noMtl) {
     mVpMap.getVectors( vp );
     mVcMap.getColors( vc );
     if ( vc.empty() ) {
-        mOutput << "# " << vp.size() << " vertex positions" << endl;
+        out << "# " << vp.size() << " vertex positions" << endl;
         for ( const aiVector3D& v : vp ) {
-            mOutput << "v  " << v.x << " " << v.y << " " << v.z << endl;
+            out << "v  " << ShortestReals(v) << endl;
         }
     } else {
-        mOutput << "# " << vp.size() << " vertex positions and colors" << endl;
+        out << "# " << vp.size() << " vertex positions and colors" << endl;
         size_t colIdx = 0;
         for ( const aiVector3D& v : vp ) {
             if ( colIdx < vc.size() ) {
-                mOutput << "v  " << v.x << " " << v.y << " " << v.z << " " << vc[ colIdx ].r << " " << vc[ colIdx ].g << " " << vc[ colIdx ].b << endl;
+                out << "v  " << ShortestReals(v) << " " << ShortestReals(&vc[ colIdx ].r, 3) << endl;
             }
             ++colIdx;
         }
     }
-    mOutput << endl;
+    out << endl;
 
     // write uv coordinates
     mVtMap.getVectors(vt);
-    mOutput << "# " << vt.size() << " UV coordinates" << endl;
+    out << "# " << vt.size() << " UV coordinates" << endl;
     for(const aiVector3D& v : vt) {
-        mOutput << "vt " << v.x << " " << v.y << " " << v.z << endl;
+        out << "vt " << ShortestReals(v) << endl;
     }
-    mOutput << endl;
+    out << endl;
 
     // write vertex normals
     mVnMap.getVectors(vn);
-    mOutput << "# " << vn.size() << " vertex normals" << endl;
+    out << "# " << vn.size() << " vertex normals" << endl;
     for(const aiVector3D& v : vn) {
-        mOutput << "vn " << v.x << " " << v.y << " " << v.z << endl;
+        out << "vn " << ShortestReals(v) << endl;
     }
-    mOutput << endl;
+    out << endl;
 
     // now write all mesh instances
     for(const MeshInstance& m : mMeshes) {
-        mOutput << "# Mesh \'" << m.name << "\' with " << m.faces.size() << " faces" << endl;
+        out << "# Mesh \'" << m.name << "\' with " << m.faces.size() << " faces" << endl;
         if (!m.name.empty()) {
-            mOutput << "g " << m.name << endl;
+            out << "g " << m.name << endl;
         }
-        if (!noMtl)
-            mOutput << "usemtl " << m.matname << endl;
+        if (!mNoMtl)
+            out << "usemtl " << m.matname << endl;
 
         for(const Face& f : m.faces) {
-            mOutput << f.kind << ' ';
+            out << f.kind << ' ';
             for(const FaceVertex& fv : f.indices) {
-                mOutput << ' ' << fv.vp;
+                out << ' ' << fv.vp;
 
                 if (f.kind != 'p') {
                     if (fv.vt || f.kind == 'f') {
-                        mOutput << '/';
+                        out << '/';
                     }
                     if (fv.vt) {
-                        mOutput << fv.vt;
+                        out << fv.vt;
                     }
                     if (f.kind == 'f' && fv.vn) {
-                        mOutput << '/' << fv.vn;
+                        out << '/' << fv.vn;
                     }
                 }
             }
 
-            mOutput << endl;
+            out << endl;
         }
-        mOutput << endl;
+        out << endl;
     }
 }
 
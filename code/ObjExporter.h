@@ -46,7 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_OBJEXPORTER_H_INC
 
 #include <assimp/types.h>
-#include <sstream>
+#include <ostream>
 #include <vector>
 #include <map>
 
@@ -66,9 +66,12 @@ public:
     ~ObjExporter();
     std::string GetMaterialLibName();
     std::string GetMaterialLibFileName();
-    
-    /// public string-streams to write all output into
-    std::ostringstream mOutput, mOutputMat;
+
+    /// Writes the geometry file into the given stream
+    void WriteGeometryFile(std::ostream& out);
+
+    /// Writes the material library into the given stream
+    void WriteMaterialFile(std::ostream& out);
 
 private:
     // intermediate data structures
@@ -95,9 +98,7 @@ private:
         std::vector<Face> faces;
     };
 
-    void WriteHeader(std::ostringstream& out);
-    void WriteMaterialFile();
-    void WriteGeometryFile(bool noMtl=false);
+    void WriteHeader(std::ostream& out);
     std::string GetMaterialName(unsigned int index);
     void AddMesh(const aiString& name, const aiMesh* m, const aiMatrix4x4& mat);
     void AddNode(const aiNode* nd, const aiMatrix4x4& mParent);
@@ -166,6 +167,7 @@ private:
     vecIndexMap mVpMap, mVnMap, mVtMap;
     colIndexMap mVcMap;
     std::vector<MeshInstance> mMeshes;
+    const bool mNoMtl;
 
     // this endl() doesn't flush() the stream
     const std::string endl;
@@ -746,8 +746,7 @@ XmlReaderPtr OgreXmlSerializer::OpenReader(Assimp::IOSystem *pIOHandler, const s
         throw DeadlyImportError("Failed to open skeleton file " + filename);
     }
 
-    std::unique_ptr<CIrrXML_IOStreamReader> stream(new CIrrXML_IOStreamReader(file.get()));
-    XmlReaderPtr reader = XmlReaderPtr(irr::io::createIrrXMLReader(stream.get()));
+    XmlReaderPtr reader = XmlReaderPtr(new FastXmlReader(file.get()));
     if (!reader.get()) {
         throw DeadlyImportError("Failed to create XML reader for skeleton file " + filename);
     }
@@ -51,6 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/importerdesc.h>
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 static const aiImporterDesc desc = {
@@ -310,6 +312,7 @@ void OpenGEXImporter::InternReadFile( const std::string &filename, aiScene *pSce
     pIOHandler->Close( file );
 
     OpenDDLParser myParser;
+    myParser.setTypedArrayMode( true );
     myParser.setBuffer( &buffer[ 0 ], buffer.size() );
     bool success( myParser.parse() );
     if( success ) {
@@ -637,22 +640,65 @@ void OpenGEXImporter::handleLightObject( ODDLParser::DDLNode *node, aiScene *pSc
     handleNodes( node, pScene );
 }
 
+//------------------------------------------------------------------------------------------------
+template<class T>
+static void copyTypedArrays( const T *src, size_t srcComps, size_t numArrays, size_t numComps, ai_real fill, ai_real *dest ) {
+    const size_t numCopied( std::min( srcComps, numComps ) );
+    for( size_t i = 0; i < numArrays; i++ ) {
+        for( size_t comp = 0; comp < numCopied; comp++ ) {
+            dest[ comp ] = static_cast<ai_real>( src[ comp ] );
+        }
+        for( size_t comp = numCopied; comp < numComps; comp++ ) {
+            dest[ comp ] = fill;
+        }
+        src += srcComps;
+        dest += numComps;
+    }
+}
+
+//------------------------------------------------------------------------------------------------
+// Copies numArrays arrays of numComps components out of a data array list. Missing components are
+// set to fill. Typed data array lists are copied in bulk, others are read value by value.
+static void copyFloatArrays( DataArrayList *vaList, size_t numArrays, size_t numComps, ai_real fill, ai_real *dest ) {
+    if( nullptr != vaList->m_typedData ) {
+        numArrays = std::min( numArrays, vaList->m_numArrays );
+        const Value *data( vaList->m_typedData );
+        if( Value::ddl_double == data->m_type ) {
+            copyTypedArrays( reinterpret_cast<const double*>( data->m_data ), vaList->m_numItems, numArrays, numComps, fill, dest );
+        } else if( Value::ddl_float == data->m_type ) {
+            if( std::is_same<ai_real, float>::value && vaList->m_numItems == numComps ) {
+                ::memcpy( dest, data->m_data, numArrays * numComps * sizeof( float ) );
+            } else {
+                copyTypedArrays( reinterpret_cast<const float*>( data->m_data ), vaList->m_numItems, numArrays, numComps, fill, dest );
+            }
+        } else {
+            throw DeadlyImportError( "OpenGEX: Floating point data expected." );
+        }
+        return;
+    }
+
+    for( size_t i = 0; i < numArrays && nullptr != vaList; i++ ) {
+        Value *next( vaList->m_dataList );
+        for( size_t comp = 0; comp < numComps; comp++ ) {
+            if( nullptr != next ) {
+                dest[ comp ] = next->getFloat();
+                next = next->m_next;
+            } else {
+                dest[ comp ] = fill;
+            }
+        }
+        dest += numComps;
+        vaList = vaList->m_next;
+    }
+}
+
 //------------------------------------------------------------------------------------------------
 static void setMatrix( aiNode *node, DataArrayList *transformData ) {
     ai_assert( nullptr != node );
     ai_assert( nullptr != transformData );
 
-    float m[ 16 ];
-    size_t i( 1 );
-    Value *next( transformData->m_dataList->m_next );
-    m[ 0 ] = transformData->m_dataList->getFloat();
-    while(  next != nullptr ) {
-        m[ i ] = next->getFloat();
-        next = next->m_next;
-        i++;
-    }
-
-    ai_assert(i == 16);
+    ai_real m[ 16 ];
+    copyFloatArrays( transformData, 1, 16, 0.0f, m );
 
     node->mTransformation.a1 = m[ 0 ];
     node->mTransformation.a2 = m[ 4 ];
@@ -752,39 +798,6 @@ static MeshAttribute getAttributeByName( const char *attribName ) {
     return None;
 }
 
-//------------------------------------------------------------------------------------------------
-static void fillVector3( aiVector3D *vec3, Value *vals ) {
-    ai_assert( nullptr != vec3 );
-    ai_assert( nullptr != vals );
-
-    float x( 0.0f ), y( 0.0f ), z( 0.0f );
-    Value *next( vals );
-    x = next->getFloat();
-    next = next->m_next;
-    y = next->getFloat();
-    next = next->m_next;
-    if( nullptr != next ) {
-        z = next->getFloat();
-    }
-
-    vec3->Set( x, y, z );
-}
-
-//------------------------------------------------------------------------------------------------
-static void fillColor4( aiColor4D *col4, Value *vals ) {
-    ai_assert( nullptr != col4 );
-    ai_assert( nullptr != vals );
-
-    Value *next( vals );
-    col4->r = next->getFloat();
-    next = next->m_next;
-    col4->g = next->getFloat();
-    next = next->m_next;
-    col4->b = next->getFloat();
-    next = next->m_next;
-    col4->a = next->getFloat();
-}
-
 //------------------------------------------------------------------------------------------------
 static size_t countDataArrayListItems( DataArrayList *vaList ) {
     size_t numItems( 0 );
@@ -792,9 +805,13 @@ static size_t countDataArrayListItems( DataArrayList *vaList ) {
         return numItems;
     }
 
+    if( nullptr != vaList->m_typedData ) {
+        return vaList->m_numArrays;
+    }
+
     DataArrayList *next( vaList );
     while( nullptr != next ) {
-        if( nullptr != vaList->m_dataList ) {
+        if( nullptr != next->m_dataList ) {
             numItems++;
         }
         next = next->m_next;
@@ -805,18 +822,61 @@ static size_t countDataArrayListItems( DataArrayList *vaList ) {
 
 //------------------------------------------------------------------------------------------------
 static void copyVectorArray( size_t numItems, DataArrayList *vaList, aiVector3D *vectorArray ) {
-    for( size_t i = 0; i < numItems; i++ ) {
-        Value *next( vaList->m_dataList );
-        fillVector3( &vectorArray[ i ], next );
-        vaList = vaList->m_next;
-    }
+    static_assert( sizeof( aiVector3D ) == 3 * sizeof( ai_real ), "aiVector3D must be tightly packed" );
+    copyFloatArrays( vaList, numItems, 3, 0.0f, &vectorArray[ 0 ].x );
 }
 
 //------------------------------------------------------------------------------------------------
 static void copyColor4DArray( size_t numItems, DataArrayList *vaList, aiColor4D *colArray ) {
-    for ( size_t i = 0; i < numItems; i++ ) {
+    static_assert( sizeof( aiColor4D ) == 4 * sizeof( ai_real ), "aiColor4D must be tightly packed" );
+    copyFloatArrays( vaList, numItems, 4, 1.0f, &colArray[ 0 ].r );
+}
+
+//------------------------------------------------------------------------------------------------
+template<class T>
+static void copyTypedIndices( const T *src, size_t numIndices, unsigned int *dest ) {
+    for( size_t i = 0; i < numIndices; i++ ) {
+        dest[ i ] = static_cast<unsigned int>( src[ i ] );
+    }
+}
+
+//------------------------------------------------------------------------------------------------
+// Copies numFaces faces of faceSize indices out of an index data array list.
+static void copyIndexArray( DataArrayList *vaList, size_t numFaces, size_t faceSize, unsigned int *dest ) {
+    if( nullptr != vaList->m_typedData ) {
+        const size_t numIndices( numFaces * faceSize );
+        const Value *data( vaList->m_typedData );
+        const void *src( data->m_data );
+        switch( data->m_type ) {
+            case Value::ddl_unsigned_int8:
+            case Value::ddl_int8:
+                copyTypedIndices( static_cast<const uint8*>( src ), numIndices, dest );
+                break;
+            case Value::ddl_unsigned_int16:
+            case Value::ddl_int16:
+                copyTypedIndices( static_cast<const uint16*>( src ), numIndices, dest );
+                break;
+            case Value::ddl_unsigned_int32:
+            case Value::ddl_int32:
+                ::memcpy( dest, src, numIndices * sizeof( unsigned int ) );
+                break;
+            case Value::ddl_unsigned_int64:
+            case Value::ddl_int64:
+                copyTypedIndices( static_cast<const uint64*>( src ), numIndices, dest );
+                break;
+            default:
+                throw DeadlyImportError( "OpenGEX: Integer data expected for index array." );
+        }
+        return;
+    }
+
+    for( size_t i = 0; i < numFaces && nullptr != vaList; i++ ) {
         Value *next( vaList->m_dataList );
-        fillColor4( &colArray[ i ], next );
+        for( size_t idx = 0; idx < faceSize; idx++ ) {
+            *dest++ = nullptr != next ? next->getUnsignedInt32() : 0;
+            next = nullptr != next ? next->m_next : nullptr;
+        }
+        vaList = vaList->m_next;
     }
 }
 
@@ -881,13 +941,19 @@ void OpenGEXImporter::handleIndexArrayNode( ODDLParser::DDLNode *node, aiScene *
     }
 
     const size_t numItems( countDataArrayListItems( vaList ) );
+    const size_t faceSize( nullptr != vaList->m_typedData ? vaList->m_numItems : 3 );
+    std::vector<unsigned int> faceIndices( numItems * faceSize );
+    if( !faceIndices.empty() ) {
+        copyIndexArray( vaList, numItems, faceSize, &faceIndices[ 0 ] );
+    }
+
     m_currentMesh->mNumFaces = static_cast<unsigned int>(numItems);
     m_currentMesh->mFaces = new aiFace[ numItems ];
-    m_currentMesh->mNumVertices = static_cast<unsigned int>(numItems * 3);
+    m_currentMesh->mNumVertices = static_cast<unsigned int>(numItems * faceSize);
     m_currentMesh->mVertices = new aiVector3D[ m_currentMesh->mNumVertices ];
     bool hasColors( false );
     if ( m_currentVertices.m_numColors > 0 ) {
-        m_currentMesh->mColors[0] = new aiColor4D[ m_currentVertices.m_numColors ];
+        m_currentMesh->mColors[0] = new aiColor4D[ m_currentMesh->mNumVertices ];
         hasColors = true;
     }
     bool hasNormalCoords( false );
@@ -904,33 +970,26 @@ void OpenGEXImporter::handleIndexArrayNode( ODDLParser::DDLNode *node, aiScene *
     unsigned int index( 0 );
     for( size_t i = 0; i < m_currentMesh->mNumFaces; i++ ) {
         aiFace &current(  m_currentMesh->mFaces[ i ] );
-        current.mNumIndices = 3;
+        current.mNumIndices = static_cast<unsigned int>( faceSize );
         current.mIndices = new unsigned int[ current.mNumIndices ];
-        Value *next( vaList->m_dataList );
-        for( size_t indices = 0; indices < current.mNumIndices; indices++ ) {
-            const int idx( next->getUnsignedInt32() );
-            ai_assert( static_cast<size_t>( idx ) <= m_currentVertices.m_numVerts );
-            ai_assert( index < m_currentMesh->mNumVertices );
-            aiVector3D &pos = ( m_currentVertices.m_vertices[ idx ] );
-            m_currentMesh->mVertices[ index ].Set( pos.x, pos.y, pos.z );
-            if ( hasColors ) {
-                aiColor4D &col = m_currentVertices.m_colors[ idx ];
-                m_currentMesh->mColors[ 0 ][ index ] = col;
+        for( size_t j = 0; j < current.mNumIndices; j++ ) {
+            const unsigned int idx( faceIndices[ index ] );
+            if( idx >= m_currentVertices.m_numVerts ) {
+                throw DeadlyImportError( "OpenGEX: Vertex index out of range." );
             }
-            if ( hasNormalCoords ) {
-                aiVector3D &normal = ( m_currentVertices.m_normals[ idx ] );
-                m_currentMesh->mNormals[ index ].Set( normal.x, normal.y, normal.z );
+            m_currentMesh->mVertices[ index ] = m_currentVertices.m_vertices[ idx ];
+            if ( hasColors && idx < m_currentVertices.m_numColors ) {
+                m_currentMesh->mColors[ 0 ][ index ] = m_currentVertices.m_colors[ idx ];
             }
-            if ( hasTexCoords ) {
-                aiVector3D &tex = ( m_currentVertices.m_textureCoords[ 0 ][ idx ] );
-                m_currentMesh->mTextureCoords[ 0 ][ index ].Set( tex.x, tex.y, tex.z );
+            if ( hasNormalCoords && idx < m_currentVertices.m_numNormals ) {
+                m_currentMesh->mNormals[ index ] = m_currentVertices.m_normals[ idx ];
             }
-            current.mIndices[ indices ] = index;
+            if ( hasTexCoords && idx < m_currentVertices.m_numUVComps[ 0 ] ) {
+                m_currentMesh->mTextureCoords[ 0 ][ index ] = m_currentVertices.m_textureCoords[ 0 ][ idx ];
+            }
+            current.mIndices[ j ] = index;
             index++;
-
-            next = next->m_next;
         }
-        vaList = vaList->m_next;
     }
 }
 
@@ -941,12 +1000,8 @@ static void getColorRGB3( aiColor3D *pColor, DataArrayList *colList ) {
     }
 
     ai_assert( 3 == colList->m_numItems );
-    Value *val( colList->m_dataList );
-    pColor->r = val->getFloat();
-    val = val->getNext();
-    pColor->g = val->getFloat();
-    val = val->getNext();
-    pColor->b = val->getFloat();
+    static_assert( sizeof( aiColor3D ) == 3 * sizeof( ai_real ), "aiColor3D must be tightly packed" );
+    copyFloatArrays( colList, 1, 3, 0.0f, &pColor->r );
 }
 
 //------------------------------------------------------------------------------------------------
@@ -956,14 +1011,7 @@ static void getColorRGB4( aiColor4D *pColor, DataArrayList *colList ) {
     }
 
     ai_assert( 4 == colList->m_numItems );
-    Value *val( colList->m_dataList );
-    pColor->r = val->getFloat();
-    val = val->getNext();
-    pColor->g = val->getFloat();
-    val = val->getNext();
-    pColor->b = val->getFloat();
-    val = val->getNext();
-    pColor->a = val->getFloat();
+    copyFloatArrays( colList, 1, 4, 1.0f, &pColor->r );
 }
 
 //------------------------------------------------------------------------------------------------
@@ -0,0 +1,141 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ParallelFor.h
+ *  @brief Runs the iterations of a loop on several threads.
+ */
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include <assimp/defs.h>
+#include <algorithm>
+#include <stddef.h>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <atomic>
+#   include <exception>
+#   include <mutex>
+#   include <thread>
+#   include <vector>
+#endif
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Returns the number of threads ParallelFor() runs a loop on.
+ *  @param numThreads Requested number of threads, 0 for one per hardware thread.
+ *  @param numItems Number of iterations, there is never more than one thread per iteration. */
+inline unsigned int GetParallelThreadCount(unsigned int numThreads, size_t numItems)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    if (!numThreads) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return static_cast<unsigned int>(std::min<size_t>(numThreads, std::max<size_t>(numItems, 1)));
+#else
+    (void)numThreads;
+    (void)numItems;
+    return 1;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Calls func(i) for each i in [0,numItems), spread over up to numThreads threads.
+ *
+ *  The calling thread takes part in the work. Iterations are handed out in ascending
+ *  order. Once an iteration throws, no further ones are started, and after all threads
+ *  are done the exception of the lowest failed iteration is rethrown - the one a plain
+ *  loop would have thrown.
+ *  @param numItems Number of iterations.
+ *  @param numThreads Maximum number of threads, 0 for one per hardware thread. 1 runs
+ *    the loop sequentially on the calling thread.
+ *  @param func Callable taking the size_t index of an iteration. */
+template <typename Func>
+void ParallelFor(size_t numItems, unsigned int numThreads, const Func& func)
+{
+    numThreads = GetParallelThreadCount(numThreads, numItems);
+    if (numThreads <= 1) {
+        for (size_t i = 0; i < numItems; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    size_t failed = numItems;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        for (size_t i; (i = next++) < numItems; ) {
+            try {
+                func(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (i < failed) {
+                    failed = i;
+                    error = std::current_exception();
+                }
+                next = numItems;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numThreads; ++i) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+#endif
+}
+
+} // end of namespace Assimp
+
+#endif // AI_PARALLELFOR_H_INC
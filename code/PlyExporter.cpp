@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
 #include "qnan.h"
+#include "fast_ftoa.h"
 
 
 //using namespace Assimp;
@@ -67,34 +68,32 @@ template<> const char* type_of(double&) { return "double"; }
 // Worker function for exporting a scene to PLY. Prototyped and registered in Exporter.cpp
 void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
 {
-    // invoke the exporter
-    PlyExporter exporter(pFile, pScene);
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter
+    PlyExporter exporter(pFile, pScene, outfile.get());
+
+    if (exporter.mOutput.flush().fail()) {
+        throw DeadlyExportError("could not write output .ply file: " + std::string(pFile));
+    }
 }
 
 void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
 {
-    // invoke the exporter
-    PlyExporter exporter(pFile, pScene, true);
-
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile(pIOSystem->Open(pFile, "wb"));
     if (outfile == NULL) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
 
-    outfile->Write(exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()), 1);
+    // invoke the exporter
+    PlyExporter exporter(pFile, pScene, outfile.get(), true);
+
+    if (exporter.mOutput.flush().fail()) {
+        throw DeadlyExportError("could not write output .ply file: " + std::string(pFile));
+    }
 }
 
 #define PLY_EXPORT_HAS_NORMALS 0x1
@@ -103,14 +102,14 @@ void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene*
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, IOStream* pOutput, bool binary)
+: mOutput(pOutput)
+, filename(_filename)
 , endl("\n")
 {
     // make sure that all formatting happens using the standard, C locale and not the user's current locale
     const std::locale& l = std::locale("C");
     mOutput.imbue(l);
-    mOutput.precision(16);
 
     unsigned int faces = 0u, vertices = 0u, components = 0u;
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
@@ -245,17 +244,10 @@ void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
     // If a component (for instance normal vectors) is present in at least one mesh in the scene,
     // then default values are written for meshes that do not contain this component.
     for (unsigned int i = 0; i < m->mNumVertices; ++i) {
-        mOutput <<
-            m->mVertices[i].x << " " <<
-            m->mVertices[i].y << " " <<
-            m->mVertices[i].z
-        ;
+        mOutput << ShortestReals(m->mVertices[i]);
         if(components & PLY_EXPORT_HAS_NORMALS) {
             if (m->HasNormals() && is_not_qnan(m->mNormals[i].x) && std::fabs(m->mNormals[i].x) != inf) {
-                mOutput <<
-                    " " << m->mNormals[i].x <<
-                    " " << m->mNormals[i].y <<
-                    " " << m->mNormals[i].z;
+                mOutput << " " << ShortestReals(m->mNormals[i]);
             }
             else {
                 mOutput << " 0.0 0.0 0.0";
@@ -264,9 +256,7 @@ void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
 
         for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
             if (m->HasTextureCoords(c)) {
-                mOutput <<
-                    " " << m->mTextureCoords[c][i].x <<
-                    " " << m->mTextureCoords[c][i].y;
+                mOutput << " " << ShortestReals(&m->mTextureCoords[c][i].x, 2);
             }
             else {
                 mOutput << " -1.0 -1.0";
@@ -275,11 +265,7 @@ void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
 
         for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
             if (m->HasVertexColors(c)) {
-                mOutput <<
-                    " " << m->mColors[c][i].r <<
-                    " " << m->mColors[c][i].g <<
-                    " " << m->mColors[c][i].b <<
-                    " " << m->mColors[c][i].a;
+                mOutput << " " << ShortestReals(m->mColors[c][i]);
             }
             else {
                 mOutput << " -1.0 -1.0 -1.0 -1.0";
@@ -288,14 +274,7 @@ void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
 
         if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
             if (m->HasTangentsAndBitangents()) {
-                mOutput <<
-                " " << m->mTangents[i].x <<
-                " " << m->mTangents[i].y <<
-                " " << m->mTangents[i].z <<
-                " " << m->mBitangents[i].x <<
-                " " << m->mBitangents[i].y <<
-                " " << m->mBitangents[i].z
-                ;
+                mOutput << " " << ShortestReals(m->mTangents[i]) << " " << ShortestReals(m->mBitangents[i]);
             }
             else {
                 mOutput << " 0.0 0.0 0.0 0.0 0.0 0.0";
@@ -370,7 +349,7 @@ void PlyExporter::WriteMeshIndices(const aiMesh* m, unsigned int offset)
 
 // Generic method in case we want to use different data types for the indices or make this configurable.
 template<typename NumIndicesType, typename IndexType>
-void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, std::ostringstream& output)
+void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, std::ostream& output)
 {
     for (unsigned int i = 0; i < m->mNumFaces; ++i) {
         const aiFace& f = m->mFaces[i];
@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "IOStreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -59,13 +59,13 @@ namespace Assimp {
 class PlyExporter {
 public:
     /// The class constructor for a specific scene to export
-    PlyExporter(const char* filename, const aiScene* pScene, bool binary = false);
+    PlyExporter(const char* filename, const aiScene* pScene, IOStream* pOutput, bool binary = false);
     /// The class destructor, empty.
     ~PlyExporter();
 
 public:
-    /// public string-streams to write all output into:
-    std::ostringstream mOutput;
+    /// public stream to write all output into, it passes the data on to the output file:
+    IOStreamWriter mOutput;
 
 private:
     void WriteMeshVerts(const aiMesh* m, unsigned int components);
@@ -300,170 +300,88 @@ void PLYImporter::InternReadFile(const std::string& pFile,
   }
 }
 
-void PLYImporter::LoadVertex(const PLY::Element* pcElement, const PLY::ElementInstance* instElement, unsigned int pos) {
+void PLYImporter::LoadVertex(const PLY::ElementLayout& layout, unsigned int pos) {
+    const PLY::Element* pcElement = layout.pcElement;
     ai_assert(NULL != pcElement);
-    ai_assert(NULL != instElement);
-
-    ai_uint aiPositions[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiTypes[3] = { EDT_Char, EDT_Char, EDT_Char };
-
-    ai_uint aiNormal[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiNormalTypes[3] = { EDT_Char, EDT_Char, EDT_Char };
-
-    unsigned int aiColors[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiColorsTypes[4] = { EDT_Char, EDT_Char, EDT_Char, EDT_Char };
-
-    unsigned int aiTexcoord[2] = { 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiTexcoordTypes[2] = { EDT_Char, EDT_Char };
-
-    // now check whether which normal components are available
-    unsigned int _a( 0 ), cnt( 0 );
-    for ( std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
-            a != pcElement->alProperties.end(); ++a, ++_a) {
-        if ((*a).bIsList) {
-            continue;
-        }
-
-        // Positions
-        if (PLY::EST_XCoord == (*a).Semantic) {
-            ++cnt;
-            aiPositions[0] = _a;
-            aiTypes[0] = (*a).eType;
-        } else if (PLY::EST_YCoord == (*a).Semantic) {
-            ++cnt;
-            aiPositions[1] = _a;
-            aiTypes[1] = (*a).eType;
-        } else if (PLY::EST_ZCoord == (*a).Semantic) {
-            ++cnt;
-            aiPositions[2] = _a;
-            aiTypes[2] = (*a).eType;
-        } else if (PLY::EST_XNormal == (*a).Semantic) {
-            // Normals
-            ++cnt;
-            aiNormal[0] = _a;
-            aiNormalTypes[0] = (*a).eType;
-        } else if (PLY::EST_YNormal == (*a).Semantic) {
-            ++cnt;
-            aiNormal[1] = _a;
-            aiNormalTypes[1] = (*a).eType;
-        } else if (PLY::EST_ZNormal == (*a).Semantic) {
-            ++cnt;
-            aiNormal[2] = _a;
-            aiNormalTypes[2] = (*a).eType;
-        } else if (PLY::EST_Red == (*a).Semantic) {
-            // Colors
-            ++cnt;
-            aiColors[0] = _a;
-            aiColorsTypes[0] = (*a).eType;
-        } else if (PLY::EST_Green == (*a).Semantic) {
-            ++cnt;
-            aiColors[1] = _a;
-            aiColorsTypes[1] = (*a).eType;
-        } else if (PLY::EST_Blue == (*a).Semantic) {
-            ++cnt;
-            aiColors[2] = _a;
-            aiColorsTypes[2] = (*a).eType;
-        } else if (PLY::EST_Alpha == (*a).Semantic) {
-            ++cnt;
-            aiColors[3] = _a;
-            aiColorsTypes[3] = (*a).eType;
-        } else if (PLY::EST_UTextureCoord == (*a).Semantic) {
-            // Texture coordinates
-            ++cnt;
-            aiTexcoord[0] = _a;
-            aiTexcoordTypes[0] = (*a).eType;
-        } else if (PLY::EST_VTextureCoord == (*a).Semantic) {
-            ++cnt;
-            aiTexcoord[1] = _a;
-            aiTexcoordTypes[1] = (*a).eType;
-        }
-    }
+
+    // the slots have been resolved once for the whole element
+    const int aiPositions[3] = { layout.aiScalar[PLY::EST_XCoord],
+        layout.aiScalar[PLY::EST_YCoord], layout.aiScalar[PLY::EST_ZCoord] };
+    const int aiNormal[3] = { layout.aiScalar[PLY::EST_XNormal],
+        layout.aiScalar[PLY::EST_YNormal], layout.aiScalar[PLY::EST_ZNormal] };
+    const int aiColors[4] = { layout.aiScalar[PLY::EST_Red], layout.aiScalar[PLY::EST_Green],
+        layout.aiScalar[PLY::EST_Blue], layout.aiScalar[PLY::EST_Alpha] };
+    const int aiTexcoord[2] = { layout.aiScalar[PLY::EST_UTextureCoord],
+        layout.aiScalar[PLY::EST_VTextureCoord] };
 
     // check whether we have a valid source for the vertex data
-    if (0 != cnt) {
+    const bool haveNormal = -1 != aiNormal[0] || -1 != aiNormal[1] || -1 != aiNormal[2];
+    const bool haveColor = -1 != aiColors[0] || -1 != aiColors[1] || -1 != aiColors[2] || -1 != aiColors[3];
+    const bool haveTextureCoords = -1 != aiTexcoord[0] || -1 != aiTexcoord[1];
+    if (haveNormal || haveColor || haveTextureCoords ||
+        -1 != aiPositions[0] || -1 != aiPositions[1] || -1 != aiPositions[2]) {
         // Position
         aiVector3D vOut;
-        if (0xFFFFFFFF != aiPositions[0]) {
-            vOut.x = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiPositions[0]).avList.front(), aiTypes[0]);
+        if (-1 != aiPositions[0]) {
+            vOut.x = layout.Get<ai_real>(aiPositions[0]);
         }
 
-        if (0xFFFFFFFF != aiPositions[1]) {
-            vOut.y = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiPositions[1]).avList.front(), aiTypes[1]);
+        if (-1 != aiPositions[1]) {
+            vOut.y = layout.Get<ai_real>(aiPositions[1]);
         }
 
-        if (0xFFFFFFFF != aiPositions[2]) {
-            vOut.z = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiPositions[2]).avList.front(), aiTypes[2]);
+        if (-1 != aiPositions[2]) {
+            vOut.z = layout.Get<ai_real>(aiPositions[2]);
         }
 
         // Normals
         aiVector3D nOut;
-        bool haveNormal = false;
-        if (0xFFFFFFFF != aiNormal[0]) {
-            nOut.x = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiNormal[0]).avList.front(), aiNormalTypes[0]);
-            haveNormal = true;
+        if (-1 != aiNormal[0]) {
+            nOut.x = layout.Get<ai_real>(aiNormal[0]);
         }
 
-        if (0xFFFFFFFF != aiNormal[1]) {
-            nOut.y = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiNormal[1]).avList.front(), aiNormalTypes[1]);
-            haveNormal = true;
+        if (-1 != aiNormal[1]) {
+            nOut.y = layout.Get<ai_real>(aiNormal[1]);
         }
 
-        if (0xFFFFFFFF != aiNormal[2]) {
-            nOut.z = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiNormal[2]).avList.front(), aiNormalTypes[2]);
-            haveNormal = true;
+        if (-1 != aiNormal[2]) {
+            nOut.z = layout.Get<ai_real>(aiNormal[2]);
         }
 
         //Colors
         aiColor4D cOut;
-        bool haveColor = false;
-        if (0xFFFFFFFF != aiColors[0]) {
-            cOut.r = NormalizeColorValue(GetProperty(instElement->alProperties,
-                aiColors[0]).avList.front(), aiColorsTypes[0]);
-            haveColor = true;
+        if (-1 != aiColors[0]) {
+            cOut.r = NormalizeColorValue(layout.avValues[aiColors[0]],
+                pcElement->alProperties[aiColors[0]].eType);
         }
 
-        if (0xFFFFFFFF != aiColors[1]) {
-            cOut.g = NormalizeColorValue(GetProperty(instElement->alProperties,
-                aiColors[1]).avList.front(), aiColorsTypes[1]);
-            haveColor = true;
+        if (-1 != aiColors[1]) {
+            cOut.g = NormalizeColorValue(layout.avValues[aiColors[1]],
+                pcElement->alProperties[aiColors[1]].eType);
         }
 
-        if (0xFFFFFFFF != aiColors[2]) {
-            cOut.b = NormalizeColorValue(GetProperty(instElement->alProperties,
-                aiColors[2]).avList.front(), aiColorsTypes[2]);
-            haveColor = true;
+        if (-1 != aiColors[2]) {
+            cOut.b = NormalizeColorValue(layout.avValues[aiColors[2]],
+                pcElement->alProperties[aiColors[2]].eType);
         }
 
         // assume 1.0 for the alpha channel ifit is not set
-        if (0xFFFFFFFF == aiColors[3]) {
+        if (-1 == aiColors[3]) {
             cOut.a = 1.0;
         } else {
-            cOut.a = NormalizeColorValue(GetProperty(instElement->alProperties,
-                aiColors[3]).avList.front(), aiColorsTypes[3]);
-
-            haveColor = true;
+            cOut.a = NormalizeColorValue(layout.avValues[aiColors[3]],
+                pcElement->alProperties[aiColors[3]].eType);
         }
 
         //Texture coordinates
         aiVector3D tOut;
         tOut.z = 0;
-        bool haveTextureCoords = false;
-        if (0xFFFFFFFF != aiTexcoord[0]) {
-            tOut.x = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiTexcoord[0]).avList.front(), aiTexcoordTypes[0]);
-            haveTextureCoords = true;
+        if (-1 != aiTexcoord[0]) {
+            tOut.x = layout.Get<ai_real>(aiTexcoord[0]);
         }
 
-        if (0xFFFFFFFF != aiTexcoord[1]) {
-            tOut.y = PLY::PropertyInstance::ConvertTo<ai_real>(
-                GetProperty(instElement->alProperties, aiTexcoord[1]).avList.front(), aiTexcoordTypes[1]);
-            haveTextureCoords = true;
+        if (-1 != aiTexcoord[1]) {
+            tOut.y = layout.Get<ai_real>(aiTexcoord[1]);
         }
 
         //create aiMesh if needed
@@ -533,19 +451,16 @@ ai_real PLYImporter::NormalizeColorValue(PLY::PropertyInstance::ValueUnion val,
 
 // ------------------------------------------------------------------------------------------------
 // Try to extract proper faces from the PLY DOM
-void PLYImporter::LoadFace(const PLY::Element* pcElement, const PLY::ElementInstance* instElement, unsigned int pos)
+void PLYImporter::LoadFace(const PLY::ElementLayout& layout, unsigned int pos)
 {
+  const PLY::Element* pcElement = layout.pcElement;
   ai_assert(NULL != pcElement);
-  ai_assert(NULL != instElement);
 
   if (mGeneratedMesh == NULL)
     throw DeadlyImportError("Invalid .ply file: Vertices should be declared before faces");
 
-  bool bOne = false;
-
   // index of the vertex index list
-  unsigned int iProperty = 0xFFFFFFFF;
-  PLY::EDataType eType = EDT_Char;
+  int iProperty = -1;
   bool bIsTriStrip = false;
 
   // index of the material index property
@@ -553,63 +468,26 @@ void PLYImporter::LoadFace(const PLY::Element* pcElement, const PLY::ElementInst
   //PLY::EDataType eType2 = EDT_Char;
 
   // texture coordinates
-  unsigned int iTextureCoord = 0xFFFFFFFF;
-  PLY::EDataType eType3 = EDT_Char;
+  int iTextureCoord = -1;
 
   // face = unique number of vertex indices
   if (PLY::EEST_Face == pcElement->eSemantic)
   {
-    unsigned int _a = 0;
-    for (std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
-      a != pcElement->alProperties.end(); ++a, ++_a)
-    {
-      if (PLY::EST_VertexIndex == (*a).Semantic)
-      {
-        // must be a dynamic list!
-        if (!(*a).bIsList)
-          continue;
-
-        iProperty = _a;
-        bOne = true;
-        eType = (*a).eType;
-      }
-      /*else if (PLY::EST_MaterialIndex == (*a).Semantic)
-      {
-      if ((*a).bIsList)
-      continue;
-      iMaterialIndex = _a;
-      bOne = true;
-      eType2 = (*a).eType;
-      }*/
-      else if (PLY::EST_TextureCoordinates == (*a).Semantic)
-      {
-        // must be a dynamic list!
-        if (!(*a).bIsList)
-          continue;
-        iTextureCoord = _a;
-        bOne = true;
-        eType3 = (*a).eType;
-      }
-    }
+    // both must be dynamic lists!
+    iProperty = layout.aiList[PLY::EST_VertexIndex];
+    iTextureCoord = layout.aiList[PLY::EST_TextureCoordinates];
   }
   // triangle strip
   // TODO: triangle strip and material index support???
   else if (PLY::EEST_TriStrip == pcElement->eSemantic)
   {
-    unsigned int _a = 0;
-    for (std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
-      a != pcElement->alProperties.end(); ++a, ++_a)
-    {
-      // must be a dynamic list!
-      if (!(*a).bIsList)
-        continue;
-      iProperty = _a;
-      bOne = true;
-      bIsTriStrip = true;
-      eType = (*a).eType;
-      break;
-    }
+    // the first dynamic list
+    iProperty = layout.iFirstList;
+    bIsTriStrip = true;
   }
+  const bool bOne = -1 != iProperty || -1 != iTextureCoord;
+  const PLY::EDataType eType = -1 != iProperty ? pcElement->alProperties[iProperty].eType : EDT_Char;
+  const PLY::EDataType eType3 = -1 != iTextureCoord ? pcElement->alProperties[iTextureCoord].eType : EDT_Char;
 
   // check whether we have at least one per-face information set
   if (bOne)
@@ -623,14 +501,14 @@ void PLYImporter::LoadFace(const PLY::Element* pcElement, const PLY::ElementInst
     if (!bIsTriStrip)
     {
       // parse the list of vertex indices
-      if (0xFFFFFFFF != iProperty)
+      if (-1 != iProperty)
       {
-        const unsigned int iNum = (unsigned int)GetProperty(instElement->alProperties, iProperty).avList.size();
+        const unsigned int iNum = (unsigned int)layout.aavLists[iProperty].size();
         mGeneratedMesh->mFaces[pos].mNumIndices = iNum;
         mGeneratedMesh->mFaces[pos].mIndices = new unsigned int[iNum];
 
         std::vector<PLY::PropertyInstance::ValueUnion>::const_iterator p =
-          GetProperty(instElement->alProperties, iProperty).avList.begin();
+          layout.aavLists[iProperty].begin();
 
         for (unsigned int a = 0; a < iNum; ++a, ++p)
         {
@@ -646,13 +524,13 @@ void PLYImporter::LoadFace(const PLY::Element* pcElement, const PLY::ElementInst
       GetProperty(instElement->alProperties, iMaterialIndex).avList.front(), eType2);
       }*/
 
-      if (0xFFFFFFFF != iTextureCoord)
+      if (-1 != iTextureCoord)
       {
-        const unsigned int iNum = (unsigned int)GetProperty(instElement->alProperties, iTextureCoord).avList.size();
+        const unsigned int iNum = (unsigned int)layout.aavLists[iTextureCoord].size();
 
         //should be 6 coords
         std::vector<PLY::PropertyInstance::ValueUnion>::const_iterator p =
-          GetProperty(instElement->alProperties, iTextureCoord).avList.begin();
+          layout.aavLists[iTextureCoord].begin();
 
         if ((iNum / 3) == 2) // X Y coord
         {
@@ -683,7 +561,7 @@ void PLYImporter::LoadFace(const PLY::Element* pcElement, const PLY::ElementInst
       // normally we have only one triangle strip instance where
       // a value of -1 indicates a restart of the strip
       bool flip = false;
-      const std::vector<PLY::PropertyInstance::ValueUnion>& quak = GetProperty(instElement->alProperties, iProperty).avList;
+      const std::vector<PLY::PropertyInstance::ValueUnion>& quak = layout.aavLists[iProperty];
       //pvOut->reserve(pvOut->size() + quak.size() + (quak.size()>>2u)); //Limits memory consumption
 
       int aiTable[2] = { -1, -1 };
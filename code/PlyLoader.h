@@ -78,14 +78,14 @@ public:
         bool checkSig) const;
 
     // -------------------------------------------------------------------
-    /** Extract a vertex from the DOM
+    /** Extract a vertex from the current instance of a vertex element
     */
-    void LoadVertex(const PLY::Element* pcElement, const PLY::ElementInstance* instElement, unsigned int pos);
+    void LoadVertex(const PLY::ElementLayout& layout, unsigned int pos);
 
     // -------------------------------------------------------------------
-    /** Extract a face from the DOM
+    /** Extract a face from the current instance of a face or tristrip element
     */
-    void LoadFace(const PLY::Element* pcElement, const PLY::ElementInstance* instElement, unsigned int pos);
+    void LoadFace(const PLY::ElementLayout& layout, unsigned int pos);
 
 protected:
 
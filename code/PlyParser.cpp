@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include "ByteSwapper.h"
 #include "PlyLoader.h"
+#include <string.h>
 
 using namespace Assimp;
 
@@ -687,31 +688,32 @@ bool PLY::ElementInstanceList::ParseInstanceList(
   else
   {
     const char* pCur = (const char*)&buffer[0];
-    // be sure to have enough storage
+
+    // compiled once, the instances are decoded into the same storage
+    PLY::ElementLayout layout(pcElement);
     for (unsigned int i = 0; i < pcElement->NumOccur; ++i)
     {
       if (p_pcOut)
         PLY::ElementInstance::ParseInstance(pCur, pcElement, &p_pcOut->alInstances[i]);
       else
       {
-        ElementInstance elt;
-        PLY::ElementInstance::ParseInstance(pCur, pcElement, &elt);
+        layout.ParseInstance(pCur);
 
         // Create vertex or face
         if (pcElement->eSemantic == EEST_Vertex)
         {
           //call loader instance from here
-          loader->LoadVertex(pcElement, &elt, i);
+          loader->LoadVertex(layout, i);
         }
         else if (pcElement->eSemantic == EEST_Face)
         {
           //call loader instance from here
-          loader->LoadFace(pcElement, &elt, i);
+          loader->LoadFace(layout, i);
         }
         else if (pcElement->eSemantic == EEST_TriStrip)
         {
           //call loader instance from here
-          loader->LoadFace(pcElement, &elt, i);
+          loader->LoadFace(layout, i);
         }
       }
 
@@ -739,30 +741,30 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
   // we can't skip it as a whole block (we don't know its exact size
   // due to the fact that lists could be contained in the property list
   // of the unknown element)
+  PLY::ElementLayout layout(pcElement);
   for (unsigned int i = 0; i < pcElement->NumOccur; ++i)
   {
     if (p_pcOut)
       PLY::ElementInstance::ParseInstanceBinary(streamBuffer, buffer, pCur, bufferSize, pcElement, &p_pcOut->alInstances[i], p_bBE);
     else
     {
-      ElementInstance elt;
-      PLY::ElementInstance::ParseInstanceBinary(streamBuffer, buffer, pCur, bufferSize, pcElement, &elt, p_bBE);
+      layout.ParseInstanceBinary(streamBuffer, buffer, pCur, bufferSize, p_bBE);
 
       // Create vertex or face
       if (pcElement->eSemantic == EEST_Vertex)
       {
         //call loader instance from here
-        loader->LoadVertex(pcElement, &elt, i);
+        loader->LoadVertex(layout, i);
       }
       else if (pcElement->eSemantic == EEST_Face)
       {
         //call loader instance from here
-        loader->LoadFace(pcElement, &elt, i);
+        loader->LoadFace(layout, i);
       }
       else if (pcElement->eSemantic == EEST_TriStrip)
       {
         //call loader instance from here
-        loader->LoadFace(pcElement, &elt, i);
+        loader->LoadFace(layout, i);
       }
     }
   }
@@ -980,47 +982,41 @@ bool PLY::PropertyInstance::ParseValue(const char* &pCur,
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
-  std::vector<char> &buffer,
-  const char* &pCur,
-  unsigned int &bufferSize,
-  PLY::EDataType eType,
-  PLY::PropertyInstance::ValueUnion* out,
-  bool p_bBE)
+unsigned int PLY::PropertyInstance::SizeOf(PLY::EDataType eType)
 {
-  ai_assert(NULL != out);
-
-  //calc element size
-  unsigned int lsize = 0;
   switch (eType)
   {
   case EDT_Char:
   case EDT_UChar:
-    lsize = 1;
-    break;
+    return 1;
 
   case EDT_UShort:
   case EDT_Short:
-    lsize = 2;
-    break;
+    return 2;
 
   case EDT_UInt:
   case EDT_Int:
   case EDT_Float:
-    lsize = 4;
-    break;
+    return 4;
 
   case EDT_Double:
-    lsize = 8;
-    break;
+    return 8;
 
   case EDT_INVALID:
   default:
-      break;
+    return 0;
   }
+}
 
-  //read the next file block if needed
-  if (bufferSize < lsize)
+// ------------------------------------------------------------------------------------------------
+void PLY::PropertyInstance::RequireBinary(IOStreamBuffer<char> &streamBuffer,
+  std::vector<char> &buffer,
+  const char* &pCur,
+  unsigned int &bufferSize,
+  unsigned int iSize)
+{
+  //read the next file block(s) if needed
+  while (bufferSize < iSize)
   {
     std::vector<char> nbuffer;
     if (streamBuffer.getNextBlock(nbuffer))
@@ -1037,85 +1033,282 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
       throw DeadlyImportError("Invalid .ply file: File corrupted");
     }
   }
+}
 
-  bool ret = true;
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::PropertyInstance::DecodeValueBinary(const char* pCur,
+  PLY::EDataType eType,
+  PLY::PropertyInstance::ValueUnion* out,
+  bool p_bBE)
+{
+  ai_assert(NULL != out);
+
+  // the data is not necessarily aligned, so always go through memcpy
   switch (eType)
   {
   case EDT_UInt:
-    out->iUInt = (uint32_t)*((uint32_t*)pCur);
-    pCur += 4;
+    ::memcpy(&out->iUInt, pCur, 4);
 
     // Swap endianness
-    if (p_bBE)ByteSwap::Swap((int32_t*)&out->iUInt);
-    break;
+    if (p_bBE)ByteSwap::Swap(&out->iUInt);
+    return 4;
 
   case EDT_UShort:
   {
-    uint16_t i = *((uint16_t*)pCur);
+    uint16_t i;
+    ::memcpy(&i, pCur, 2);
 
     // Swap endianness
     if (p_bBE)ByteSwap::Swap(&i);
     out->iUInt = (uint32_t)i;
-    pCur += 2;
-    break;
+    return 2;
   }
 
   case EDT_UChar:
-  {
-    out->iUInt = (uint32_t)(*((uint8_t*)pCur));
-    pCur++;
-    break;
-  }
+    out->iUInt = (uint32_t)(*((const uint8_t*)pCur));
+    return 1;
 
   case EDT_Int:
-    out->iInt = *((int32_t*)pCur);
-    pCur += 4;
+    ::memcpy(&out->iInt, pCur, 4);
 
     // Swap endianness
     if (p_bBE)ByteSwap::Swap(&out->iInt);
-    break;
+    return 4;
 
   case EDT_Short:
   {
-    int16_t i = *((int16_t*)pCur);
+    int16_t i;
+    ::memcpy(&i, pCur, 2);
 
     // Swap endianness
     if (p_bBE)ByteSwap::Swap(&i);
     out->iInt = (int32_t)i;
-    pCur += 2;
-    break;
+    return 2;
   }
 
   case EDT_Char:
-    out->iInt = (int32_t)*((int8_t*)pCur);
-    pCur++;
-    break;
+    out->iInt = (int32_t)*((const int8_t*)pCur);
+    return 1;
 
   case EDT_Float:
-  {
-    out->fFloat = *((float*)pCur);
+    ::memcpy(&out->fFloat, pCur, 4);
 
     // Swap endianness
-    if (p_bBE)ByteSwap::Swap((int32_t*)&out->fFloat);
-    pCur += 4;
-    break;
-  }
+    if (p_bBE)ByteSwap::Swap(&out->fFloat);
+    return 4;
+
   case EDT_Double:
-  {
-    out->fDouble = *((double*)pCur);
+    ::memcpy(&out->fDouble, pCur, 8);
 
     // Swap endianness
-    if (p_bBE)ByteSwap::Swap((int64_t*)&out->fDouble);
-    pCur += 8;
-    break;
-  }
+    if (p_bBE)ByteSwap::Swap(&out->fDouble);
+    return 8;
+
+  case EDT_INVALID:
   default:
-    ret = false;
+    return 0;
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
+  std::vector<char> &buffer,
+  const char* &pCur,
+  unsigned int &bufferSize,
+  PLY::EDataType eType,
+  PLY::PropertyInstance::ValueUnion* out,
+  bool p_bBE)
+{
+  ai_assert(NULL != out);
+
+  const unsigned int lsize = SizeOf(eType);
+  if (!lsize)
+  {
+    return false;
   }
 
+  RequireBinary(streamBuffer, buffer, pCur, bufferSize, lsize);
+  DecodeValueBinary(pCur, eType, out, p_bBE);
+  pCur += lsize;
   bufferSize -= lsize;
 
-  return ret;
+  return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+PLY::ElementLayout::ElementLayout(const PLY::Element* pcElement)
+  : pcElement(pcElement)
+  , avValues(pcElement->alProperties.size())
+  , aavLists(pcElement->alProperties.size())
+  , iRecordSize(0)
+  , iFirstList(-1)
+{
+  for (unsigned int n = 0; n < EST_INVALID; ++n)
+  {
+    aiScalar[n] = aiList[n] = -1;
+  }
+
+  bool bFixed = true;
+  for (unsigned int i = 0; i < pcElement->alProperties.size(); ++i)
+  {
+    const PLY::Property& prop = pcElement->alProperties[i];
+    if (prop.bIsList)
+    {
+      bFixed = false;
+      if (-1 == iFirstList)
+      {
+        iFirstList = (int)i;
+      }
+      if (prop.Semantic < EST_INVALID)
+      {
+        aiList[prop.Semantic] = (int)i;
+      }
+    }
+    else
+    {
+      const unsigned int iSize = PLY::PropertyInstance::SizeOf(prop.eType);
+      if (!iSize)
+      {
+        bFixed = false;
+      }
+      iRecordSize += iSize;
+      if (prop.Semantic < EST_INVALID)
+      {
+        aiScalar[prop.Semantic] = (int)i;
+      }
+    }
+  }
+  if (!bFixed)
+  {
+    iRecordSize = 0;
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::ElementLayout::ParseInstance(const char* &pCur)
+{
+  bool bOk = true;
+  for (unsigned int i = 0; i < avValues.size(); ++i)
+  {
+    const PLY::Property& prop = pcElement->alProperties[i];
+    bool bParsed = false;
+
+    // skip spaces at the beginning
+    if (NULL != pCur && SkipSpaces(&pCur))
+    {
+      if (prop.bIsList)
+      {
+        // parse the number of elements in the list
+        PLY::PropertyInstance::ValueUnion v;
+        PLY::PropertyInstance::ParseValue(pCur, prop.eFirstType, &v);
+
+        // parse all list elements
+        std::vector<PLY::PropertyInstance::ValueUnion>& avList = aavLists[i];
+        avList.resize(PLY::PropertyInstance::ConvertTo<unsigned int>(v, prop.eFirstType));
+        bParsed = true;
+        for (unsigned int a = 0; a < avList.size(); ++a)
+        {
+          if (!SkipSpaces(&pCur))
+          {
+            avList.resize(a);
+            bParsed = false;
+            break;
+          }
+          PLY::PropertyInstance::ParseValue(pCur, prop.eType, &avList[a]);
+        }
+      }
+      else
+      {
+        PLY::PropertyInstance::ParseValue(pCur, prop.eType, &avValues[i]);
+        bParsed = true;
+      }
+      if (bParsed)
+      {
+        SkipSpacesAndLineEnd(&pCur);
+      }
+    }
+
+    if (!bParsed)
+    {
+      DefaultLogger::get()->warn("Unable to parse property instance. "
+        "Skipping this element instance");
+
+      if (prop.bIsList)
+      {
+        aavLists[i].push_back(PLY::PropertyInstance::DefaultValue(prop.eType));
+      }
+      else
+      {
+        avValues[i] = PLY::PropertyInstance::DefaultValue(prop.eType);
+      }
+      bOk = false;
+    }
+  }
+  return bOk;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::ElementLayout::ParseInstanceBinary(IOStreamBuffer<char> &streamBuffer,
+  std::vector<char> &buffer,
+  const char* &pCur,
+  unsigned int &bufferSize,
+  bool p_bBE)
+{
+  if (iRecordSize)
+  {
+    // fixed size record, a single check for the whole instance
+    PLY::PropertyInstance::RequireBinary(streamBuffer, buffer, pCur, bufferSize, iRecordSize);
+    const char* p = pCur;
+    for (unsigned int i = 0; i < avValues.size(); ++i)
+    {
+      p += PLY::PropertyInstance::DecodeValueBinary(p, pcElement->alProperties[i].eType, &avValues[i], p_bBE);
+    }
+    pCur += iRecordSize;
+    bufferSize -= iRecordSize;
+    return true;
+  }
+
+  bool bOk = true;
+  for (unsigned int i = 0; i < avValues.size(); ++i)
+  {
+    const PLY::Property& prop = pcElement->alProperties[i];
+    bool bParsed;
+    if (prop.bIsList)
+    {
+      // parse the number of elements in the list
+      PLY::PropertyInstance::ValueUnion v;
+      bParsed = PLY::PropertyInstance::ParseValueBinary(streamBuffer, buffer, pCur, bufferSize, prop.eFirstType, &v, p_bBE);
+
+      // parse all list elements
+      std::vector<PLY::PropertyInstance::ValueUnion>& avList = aavLists[i];
+      avList.resize(bParsed ? PLY::PropertyInstance::ConvertTo<unsigned int>(v, prop.eFirstType) : 0);
+      for (unsigned int a = 0; a < avList.size(); ++a)
+      {
+        PLY::PropertyInstance::ParseValueBinary(streamBuffer, buffer, pCur, bufferSize, prop.eType, &avList[a], p_bBE);
+      }
+    }
+    else
+    {
+      bParsed = PLY::PropertyInstance::ParseValueBinary(streamBuffer, buffer, pCur, bufferSize, prop.eType, &avValues[i], p_bBE);
+    }
+
+    if (!bParsed)
+    {
+      DefaultLogger::get()->warn("Unable to parse binary property instance. "
+        "Skipping this element instance");
+
+      if (prop.bIsList)
+      {
+        aavLists[i].push_back(PLY::PropertyInstance::DefaultValue(prop.eType));
+      }
+      else
+      {
+        avValues[i] = PLY::PropertyInstance::DefaultValue(prop.eType);
+      }
+      bOk = false;
+    }
+  }
+  return bOk;
 }
 
 #endif // !! ASSIMP_BUILD_NO_PLY_IMPORTER
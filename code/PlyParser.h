@@ -353,6 +353,19 @@ public:
     static bool ParseValueBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
         const char* &pCur, unsigned int &bufferSize, EDataType eType, ValueUnion* out, bool p_bBE);
 
+    // -------------------------------------------------------------------
+    //! Decode a binary value from memory, returns its size in bytes
+    static unsigned int DecodeValueBinary(const char* pCur, EDataType eType, ValueUnion* out, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Get the size of a data type in binary files
+    static unsigned int SizeOf(EDataType eType);
+
+    // -------------------------------------------------------------------
+    //! Make sure at least iSize bytes of binary data are available at pCur
+    static void RequireBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char* &pCur, unsigned int &bufferSize, unsigned int iSize);
+
     // -------------------------------------------------------------------
     //! Convert a property value to a given type TYPE
     template <typename TYPE>
@@ -384,6 +397,62 @@ public:
         const char* &pCur, unsigned int &bufferSize, const Element* pcElement, ElementInstance* p_pcOut, bool p_bBE);
 };
 
+// ---------------------------------------------------------------------------------
+/** \brief Decoding plan for the instances of an element, compiled once from
+ *  the element's declaration in the header.
+ *
+ * Every property gets a fixed slot, so all instances of the element are
+ * decoded into the same storage one after the other. Unlike ElementInstance
+ * this does not allocate anything per instance, which matters for point
+ * clouds with hundreds of millions of vertices.
+ */
+class ElementLayout
+{
+public:
+
+    //! Compile the layout for an element
+    explicit ElementLayout(const Element* pcElement);
+
+    //! The element the layout was compiled for
+    const Element* pcElement;
+
+    //! Values of the scalar properties of the current instance, indexed
+    //! like the properties of the element. Unused for list properties.
+    std::vector<PropertyInstance::ValueUnion> avValues;
+
+    //! Values of the list properties of the current instance, indexed
+    //! like the properties of the element. Empty for scalar properties.
+    std::vector< std::vector<PropertyInstance::ValueUnion> > aavLists;
+
+    //! Size of an instance in binary files, 0 if the element contains lists
+    unsigned int iRecordSize;
+
+    //! Index of the last scalar property with a given semantic, -1 if none
+    int aiScalar[EST_INVALID];
+
+    //! Index of the last list property with a given semantic, -1 if none
+    int aiList[EST_INVALID];
+
+    //! Index of the first list property, -1 if there is no list at all
+    int iFirstList;
+
+    // -------------------------------------------------------------------
+    //! Parse the next instance of the element
+    bool ParseInstance(const char* &pCur);
+
+    // -------------------------------------------------------------------
+    //! Parse the next instance of the element in binary format
+    bool ParseInstanceBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char* &pCur, unsigned int &bufferSize, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Get the value of a scalar property of the current instance
+    template <typename TYPE>
+    TYPE Get(int iProperty) const {
+        return PropertyInstance::ConvertTo<TYPE>(avValues[iProperty], pcElement->alProperties[iProperty].eType);
+    }
+};
+
 // ---------------------------------------------------------------------------------
 /** \brief Class for an element instance list in a PLY file
  */
@@ -141,6 +141,33 @@ struct SubPatch {
     int lightmapID;
 };
 
+/// A tessellated bezier patch, the indices form triangles.
+struct sQ3BSPPatchMesh {
+    std::vector<sQ3BSPVertex> m_Vertices;
+    std::vector<unsigned int> m_Indices;
+};
+
+/// Typed read-only view of the entries of a lump. The entries are not copied,
+/// they are used in place from the file data of the model.
+template<class T>
+struct Q3BSPLumpView {
+    const T *m_pData;
+    size_t m_Size;
+
+    Q3BSPLumpView() :
+        m_pData( NULL ),
+        m_Size( 0 )
+    {
+        // empty
+    }
+
+    size_t size() const { return m_Size; }
+    bool empty() const { return 0 == m_Size; }
+    const T &operator[]( size_t idx ) const { return m_pData[ idx ]; }
+    const T *begin() const { return m_pData; }
+    const T *end() const { return m_pData + m_Size; }
+};
+
 enum eLumps {
     kEntities = 0,
     kTextures,
@@ -163,18 +190,20 @@ enum eLumps {
 };
 
 struct Q3BSPModel {
-    std::vector<unsigned char> m_Data;
-    std::vector<sQ3BSPLump*> m_Lumps;
-    std::vector<sQ3BSPVertex*> m_Vertices;
-    std::vector<sQ3BSPFace*> m_Faces;
-    std::vector<int> m_Indices;
-    std::vector<sQ3BSPTexture*> m_Textures;
-    std::vector<sQ3BSPLightmap*> m_Lightmaps;
+    std::vector<unsigned char> m_Data;          ///< The file data, the lump views point into it
+    std::vector< std::vector<int> > m_LumpCopies; ///< Aligned copies of misaligned lumps
+    Q3BSPLumpView<sQ3BSPLump> m_Lumps;
+    Q3BSPLumpView<sQ3BSPVertex> m_Vertices;
+    Q3BSPLumpView<sQ3BSPFace> m_Faces;
+    Q3BSPLumpView<int> m_Indices;
+    Q3BSPLumpView<sQ3BSPTexture> m_Textures;
+    Q3BSPLumpView<sQ3BSPLightmap> m_Lightmaps;
     std::vector<char> m_EntityData;
     std::string m_ModelName;
 
     Q3BSPModel() :
         m_Data(),
+        m_LumpCopies(),
         m_Lumps(),
         m_Vertices(),
         m_Faces(),
@@ -186,30 +215,6 @@ struct Q3BSPModel {
     {
         // empty
     }
-
-    ~Q3BSPModel() {
-        for ( unsigned int i=0; i<m_Lumps.size(); i++ ) {
-            delete m_Lumps[ i ];
-        }
-        for ( unsigned int i=0; i<m_Vertices.size(); i++ ) {
-            delete m_Vertices[ i ];
-        }
-        for ( unsigned int i=0; i<m_Faces.size(); i++ ) {
-            delete m_Faces[ i ];
-        }
-        for ( unsigned int i=0; i<m_Textures.size(); i++ ) {
-            delete m_Textures[ i ];
-        }
-        for ( unsigned int i=0; i<m_Lightmaps.size(); i++ ) {
-            delete m_Lightmaps[ i ];
-        }
-
-        m_Lumps.clear();
-        m_Vertices.clear();
-        m_Faces.clear();
-        m_Textures.clear();
-        m_Lightmaps.clear();
-    }
 };
 
 } // Namespace Q3BSP
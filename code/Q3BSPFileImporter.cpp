@@ -42,7 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_Q3BSP_IMPORTER
 
 #include "Q3BSPFileImporter.h"
-#include "Q3BSPZipArchive.h"
+#include "ZipArchiveIOSystem.h"
 #include "Q3BSPFileParser.h"
 #include "Q3BSPFileData.h"
 
@@ -58,9 +58,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/importerdesc.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <sstream>
 #include "StringComparison.h"
+#include "ParallelFor.h"
 
 static const aiImporterDesc desc = {
     "Quake III BSP Importer",
@@ -139,9 +144,10 @@ static void normalizePathName( const std::string &rPath, std::string &rNormalize
 // ------------------------------------------------------------------------------------------------
 //  Constructor.
 Q3BSPFileImporter::Q3BSPFileImporter() :
-    m_pCurrentMesh( NULL ),
-    m_pCurrentFace( NULL ),
     m_MaterialLookupMap(),
+    m_Patches(),
+    m_PatchTessellation( AI_IMPORT_Q3BSP_DEFAULT_PATCH_TESSELLATION ),
+    m_NumThreads( 0 ),
     mTextures()
 {
     // empty
@@ -150,17 +156,7 @@ Q3BSPFileImporter::Q3BSPFileImporter() :
 // ------------------------------------------------------------------------------------------------
 //  Destructor.
 Q3BSPFileImporter::~Q3BSPFileImporter() {
-    m_pCurrentMesh = NULL;
-    m_pCurrentFace = NULL;
-
-    // Clear face-to-material map
-    for ( FaceMap::iterator it = m_MaterialLookupMap.begin(); it != m_MaterialLookupMap.end(); ++it ) {
-        const std::string &matName = it->first;
-        if ( !matName.empty() ) {
-            delete it->second;
-        }
-    }
-    m_MaterialLookupMap.clear();
+    // empty
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -174,6 +170,15 @@ bool Q3BSPFileImporter::CanRead( const std::string& rFile, IOSystem* /*pIOHandle
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Reads the importer properties.
+void Q3BSPFileImporter::SetupProperties( const Importer* pImp )
+{
+    m_PatchTessellation = static_cast<unsigned int>( std::max( 0, pImp->GetPropertyInteger(
+        AI_CONFIG_IMPORT_Q3BSP_PATCH_TESSELLATION, AI_IMPORT_Q3BSP_DEFAULT_PATCH_TESSELLATION ) ) );
+    m_NumThreads = static_cast<unsigned int>( std::max( 0, pImp->GetPropertyInteger( AI_CONFIG_IMPORT_NUM_THREADS, 0 ) ) );
+}
+
 // ------------------------------------------------------------------------------------------------
 //  Adds extensions.
 const aiImporterDesc* Q3BSPFileImporter::GetInfo () const
@@ -185,7 +190,7 @@ const aiImporterDesc* Q3BSPFileImporter::GetInfo () const
 //  Import method.
 void Q3BSPFileImporter::InternReadFile(const std::string &rFile, aiScene* pScene, IOSystem* pIOHandler)
 {
-    Q3BSPZipArchive Archive( pIOHandler, rFile );
+    ZipArchiveIOSystem Archive( pIOHandler, rFile );
     if ( !Archive.isOpen() )
     {
         throw DeadlyImportError( "Failed to open file " + rFile + "." );
@@ -202,6 +207,11 @@ void Q3BSPFileImporter::InternReadFile(const std::string &rFile, aiScene* pScene
         }
     }
 
+    // Start from scratch, the importer instance may be reused
+    m_MaterialLookupMap.clear();
+    m_Patches.clear();
+    mTextures.clear();
+
     Q3BSPFileParser fileParser( mapName, &Archive );
     Q3BSPModel *pBSPModel = fileParser.getModel();
     if ( NULL != pBSPModel )
@@ -233,7 +243,7 @@ void Q3BSPFileImporter::separateMapName( const std::string &rImportName, std::st
 
 // ------------------------------------------------------------------------------------------------
 //  Returns the first map in the map archive.
-bool Q3BSPFileImporter::findFirstMapInArchive( Q3BSPZipArchive &rArchive, std::string &rMapName )
+bool Q3BSPFileImporter::findFirstMapInArchive( ZipArchiveIOSystem &rArchive, std::string &rMapName )
 {
     rMapName = "";
     std::vector<std::string> fileList;
@@ -262,7 +272,7 @@ bool Q3BSPFileImporter::findFirstMapInArchive( Q3BSPZipArchive &rArchive, std::s
 // ------------------------------------------------------------------------------------------------
 //  Creates the assimp specific data.
 void Q3BSPFileImporter::CreateDataFromImport( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene,
-                                             Q3BSPZipArchive *pArchive )
+                                             ZipArchiveIOSystem *pArchive )
 {
     if ( NULL == pModel || NULL == pScene )
         return;
@@ -276,6 +286,9 @@ void Q3BSPFileImporter::CreateDataFromImport( const Q3BSP::Q3BSPModel *pModel, a
     // Create the face to material relation map
     createMaterialMap( pModel );
 
+    // Tessellate the bezier patches
+    tessellatePatches( pModel );
+
     // Create all nodes
     CreateNodes( pModel, pScene, pScene->mRootNode );
 
@@ -299,21 +312,16 @@ void Q3BSPFileImporter::CreateNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* p
     std::vector<aiNode*> NodeArray;
     for ( FaceMapIt it = m_MaterialLookupMap.begin(); it != m_MaterialLookupMap.end(); ++it )
     {
-        std::vector<Q3BSP::sQ3BSPFace*> *pArray = (*it).second;
-        size_t numVerts = countData( *pArray );
-        if ( 0 != numVerts )
+        aiMesh* pMesh = new aiMesh;
+        aiNode *pNode = CreateTopology( pModel, matIdx, (*it).second, pMesh );
+        if ( NULL != pNode )
         {
-            aiMesh* pMesh = new aiMesh;
-            aiNode *pNode = CreateTopology( pModel, matIdx, *pArray, pMesh );
-            if ( NULL != pNode )
-            {
-                NodeArray.push_back( pNode );
-                MeshArray.push_back( pMesh );
-            }
-            else
-            {
-                delete pMesh;
-            }
+            NodeArray.push_back( pNode );
+            MeshArray.push_back( pMesh );
+        }
+        else
+        {
+            delete pMesh;
         }
         matIdx++;
     }
@@ -343,26 +351,63 @@ void Q3BSPFileImporter::CreateNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* p
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Local function to check the mesh vertex references of a polygon or triangle mesh face.
+static bool isValidTriangleFace( const Q3BSPModel *pModel, const sQ3BSPFace &rQ3BSPFace )
+{
+    if ( rQ3BSPFace.iNumOfFaceVerts <= 0 || rQ3BSPFace.iFaceVertexIndex < 0
+        || static_cast<size_t>( rQ3BSPFace.iFaceVertexIndex ) + rQ3BSPFace.iNumOfFaceVerts > pModel->m_Indices.size() )
+    {
+        return false;
+    }
+
+    for ( int i = 0; i < rQ3BSPFace.iNumOfFaceVerts; i++ )
+    {
+        const size_t index = rQ3BSPFace.iVertexIndex + pModel->m_Indices[ rQ3BSPFace.iFaceVertexIndex + i ];
+        if ( index >= pModel->m_Vertices.size() )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 //  Creates the topology.
 aiNode *Q3BSPFileImporter::CreateTopology( const Q3BSP::Q3BSPModel *pModel,
                                           unsigned int materialIdx,
-                                          std::vector<sQ3BSPFace*> &rArray,
+                                          const FaceArray &rArray,
                                           aiMesh* pMesh )
 {
-    size_t numVerts = countData( rArray );
-    if ( 0 == numVerts )
+    // Count the vertices and triangles of all faces in one pass
+    size_t numVerts = 0;
+    size_t numTriangles = 0;
+    for ( FaceArray::const_iterator it = rArray.begin(); it != rArray.end(); ++it )
     {
-        return NULL;
+        const sQ3BSPFace &rQ3BSPFace = **it;
+        if ( rQ3BSPFace.iType == Polygon || rQ3BSPFace.iType == TriangleMesh )
+        {
+            if ( isValidTriangleFace( pModel, rQ3BSPFace ) )
+            {
+                // triangles don't share vertices
+                numVerts += ( rQ3BSPFace.iNumOfFaceVerts / 3 ) * 3;
+                numTriangles += rQ3BSPFace.iNumOfFaceVerts / 3;
+            }
+        }
+        else if ( rQ3BSPFace.iType == Patch && !m_Patches.empty() )
+        {
+            const sQ3BSPPatchMesh &rPatch = m_Patches[ *it - pModel->m_Faces.begin() ];
+            numVerts += rPatch.m_Vertices.size();
+            numTriangles += rPatch.m_Indices.size() / 3;
+        }
     }
 
-    size_t numFaces = countFaces( rArray );
-    if ( 0 == numFaces )
+    if ( 0 == numTriangles )
     {
         return NULL;
     }
 
-    size_t numTriangles = countTriangles( rArray );
     pMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
 
     pMesh->mFaces = new aiFace[ numTriangles ];
@@ -379,23 +424,23 @@ aiNode *Q3BSPFileImporter::CreateTopology( const Q3BSP::Q3BSPModel *pModel,
     unsigned int vertIdx = 0;
     pMesh->mNumUVComponents[ 0 ] = 2;
     pMesh->mNumUVComponents[ 1 ] = 2;
-    for ( std::vector<sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end(); ++it )
+    for ( FaceArray::const_iterator it = rArray.begin(); it != rArray.end(); ++it )
     {
-        Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
-        ai_assert( NULL != pQ3BSPFace );
-        if ( NULL == pQ3BSPFace )
+        const sQ3BSPFace &rQ3BSPFace = **it;
+        if ( rQ3BSPFace.iType == Polygon || rQ3BSPFace.iType == TriangleMesh )
         {
-            continue;
-        }
-
-        if ( pQ3BSPFace->iNumOfFaceVerts > 0 )
-        {
-            if ( pQ3BSPFace->iType == Polygon || pQ3BSPFace->iType == TriangleMesh )
+            if ( isValidTriangleFace( pModel, rQ3BSPFace ) )
             {
-                createTriangleTopology( pModel, pQ3BSPFace, pMesh, faceIdx, vertIdx );
+                createTriangleTopology( pModel, rQ3BSPFace, pMesh, faceIdx, vertIdx );
             }
         }
+        else if ( rQ3BSPFace.iType == Patch && !m_Patches.empty() )
+        {
+            createPatchTopology( m_Patches[ *it - pModel->m_Faces.begin() ], pMesh, faceIdx, vertIdx );
+        }
     }
+    ai_assert( faceIdx == pMesh->mNumFaces );
+    ai_assert( vertIdx == pMesh->mNumVertices );
 
     aiNode *pNode = new aiNode;
     pNode->mNumMeshes = 1;
@@ -404,71 +449,231 @@ aiNode *Q3BSPFileImporter::CreateTopology( const Q3BSP::Q3BSPModel *pModel,
     return pNode;
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Local function to copy a bsp vertex into the vertex arrays of a mesh.
+static void setVertex( aiMesh *pMesh, unsigned int vertIdx, const sQ3BSPVertex &rVertex )
+{
+    pMesh->mVertices[ vertIdx ].Set( rVertex.vPosition.x, rVertex.vPosition.y, rVertex.vPosition.z );
+    pMesh->mNormals[ vertIdx ].Set( rVertex.vNormal.x, rVertex.vNormal.y, rVertex.vNormal.z );
+
+    pMesh->mTextureCoords[ 0 ][ vertIdx ].Set( rVertex.vTexCoord.x, rVertex.vTexCoord.y, 0.0f );
+    pMesh->mTextureCoords[ 1 ][ vertIdx ].Set( rVertex.vLightmap.x, rVertex.vLightmap.y, 0.0f );
+}
+
 // ------------------------------------------------------------------------------------------------
 //  Creates the triangle topology from a face array.
 void Q3BSPFileImporter::createTriangleTopology( const Q3BSP::Q3BSPModel *pModel,
-                                              Q3BSP::sQ3BSPFace *pQ3BSPFace,
+                                              const Q3BSP::sQ3BSPFace &rQ3BSPFace,
                                               aiMesh* pMesh,
                                               unsigned int &rFaceIdx,
                                               unsigned int &rVertIdx )
 {
-    ai_assert( rFaceIdx < pMesh->mNumFaces );
-
-    m_pCurrentFace = getNextFace( pMesh, rFaceIdx );
-    ai_assert( NULL != m_pCurrentFace );
-    if ( NULL == m_pCurrentFace )
+    const int *pIndices = &pModel->m_Indices[ rQ3BSPFace.iFaceVertexIndex ];
+    const int numTriangles = rQ3BSPFace.iNumOfFaceVerts / 3;
+    for ( int i = 0; i < numTriangles; i++ )
     {
-        return;
+        ai_assert( rFaceIdx < pMesh->mNumFaces );
+        aiFace &face = pMesh->mFaces[ rFaceIdx++ ];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[ 3 ];
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            const size_t index = rQ3BSPFace.iVertexIndex + *pIndices++;
+            setVertex( pMesh, rVertIdx, pModel->m_Vertices[ index ] );
+            face.mIndices[ j ] = rVertIdx++;
+        }
     }
+}
 
-    m_pCurrentFace->mNumIndices = 3;
-    m_pCurrentFace->mIndices = new unsigned int[ m_pCurrentFace->mNumIndices ];
+// ------------------------------------------------------------------------------------------------
+//  Appends a tessellated bezier patch to the mesh.
+void Q3BSPFileImporter::createPatchTopology( const Q3BSP::sQ3BSPPatchMesh &rPatch,
+                                            aiMesh* pMesh,
+                                            unsigned int &rFaceIdx,
+                                            unsigned int &rVertIdx )
+{
+    const unsigned int baseIdx = rVertIdx;
+    for ( size_t i = 0; i < rPatch.m_Vertices.size(); i++ )
+    {
+        setVertex( pMesh, rVertIdx++, rPatch.m_Vertices[ i ] );
+    }
 
-    size_t idx = 0;
-    for ( size_t i = 0; i < (size_t) pQ3BSPFace->iNumOfFaceVerts; i++ )
+    for ( size_t i = 0; i + 2 < rPatch.m_Indices.size(); i += 3 )
     {
-        const size_t index = pQ3BSPFace->iVertexIndex + pModel->m_Indices[ pQ3BSPFace->iFaceVertexIndex + i ];
-        ai_assert( index < pModel->m_Vertices.size() );
-        if ( index >= pModel->m_Vertices.size() )
+        ai_assert( rFaceIdx < pMesh->mNumFaces );
+        aiFace &face = pMesh->mFaces[ rFaceIdx++ ];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[ 3 ];
+        for ( unsigned int j = 0; j < 3; j++ )
         {
-            continue;
+            face.mIndices[ j ] = baseIdx + rPatch.m_Indices[ i + j ];
         }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+//  Local function to evaluate a biquadratic bezier patch from 3x3 control points.
+static void evalPatchVertex( const sQ3BSPVertex *pControl[ 9 ], float u, float v, sQ3BSPVertex &rVertex )
+{
+    const float bu[ 3 ] = { ( 1.0f - u ) * ( 1.0f - u ), 2.0f * u * ( 1.0f - u ), u * u };
+    const float bv[ 3 ] = { ( 1.0f - v ) * ( 1.0f - v ), 2.0f * v * ( 1.0f - v ), v * v };
 
-        sQ3BSPVertex *pVertex = pModel->m_Vertices[ index ];
-        ai_assert( NULL != pVertex );
-        if ( NULL == pVertex )
+    ::memset( &rVertex, 0, sizeof( sQ3BSPVertex ) );
+    float color[ 4 ] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for ( unsigned int row = 0; row < 3; row++ )
+    {
+        for ( unsigned int col = 0; col < 3; col++ )
         {
-            continue;
+            const sQ3BSPVertex &c = *pControl[ row * 3 + col ];
+            const float w = bv[ row ] * bu[ col ];
+            rVertex.vPosition.x += w * c.vPosition.x;
+            rVertex.vPosition.y += w * c.vPosition.y;
+            rVertex.vPosition.z += w * c.vPosition.z;
+            rVertex.vNormal.x += w * c.vNormal.x;
+            rVertex.vNormal.y += w * c.vNormal.y;
+            rVertex.vNormal.z += w * c.vNormal.z;
+            rVertex.vTexCoord.x += w * c.vTexCoord.x;
+            rVertex.vTexCoord.y += w * c.vTexCoord.y;
+            rVertex.vLightmap.x += w * c.vLightmap.x;
+            rVertex.vLightmap.y += w * c.vLightmap.y;
+            for ( unsigned int k = 0; k < 4; k++ )
+            {
+                color[ k ] += w * c.bColor[ k ];
+            }
         }
+    }
 
-        pMesh->mVertices[ rVertIdx ].Set( pVertex->vPosition.x, pVertex->vPosition.y, pVertex->vPosition.z );
-        pMesh->mNormals[ rVertIdx ].Set( pVertex->vNormal.x, pVertex->vNormal.y, pVertex->vNormal.z );
+    const float len = std::sqrt( rVertex.vNormal.x * rVertex.vNormal.x + rVertex.vNormal.y * rVertex.vNormal.y
+        + rVertex.vNormal.z * rVertex.vNormal.z );
+    if ( len > 0.0f )
+    {
+        rVertex.vNormal.x /= len;
+        rVertex.vNormal.y /= len;
+        rVertex.vNormal.z /= len;
+    }
+    for ( unsigned int k = 0; k < 4; k++ )
+    {
+        rVertex.bColor[ k ] = static_cast<unsigned char>( std::min( 255.0f, color[ k ] + 0.5f ) );
+    }
+}
 
-        pMesh->mTextureCoords[ 0 ][ rVertIdx ].Set( pVertex->vTexCoord.x, pVertex->vTexCoord.y, 0.0f );
-        pMesh->mTextureCoords[ 1 ][ rVertIdx ].Set( pVertex->vLightmap.x, pVertex->vLightmap.y, 0.0f );
+// ------------------------------------------------------------------------------------------------
+//  Local function to tessellate a bezier patch face. The control point grid is made of
+//  biquadratic 3x3 sub-patches sharing their border rows, each of them is split into
+//  level x level quads.
+static void tessellatePatch( const Q3BSPModel *pModel, const sQ3BSPFace &rQ3BSPFace, unsigned int level,
+                            sQ3BSPPatchMesh &rPatch )
+{
+    const int width = rQ3BSPFace.patchWidth;
+    const int height = rQ3BSPFace.patchHeight;
+    if ( width < 3 || height < 3 || 0 == ( width & 1 ) || 0 == ( height & 1 )
+        || rQ3BSPFace.iNumOfVerts != width * height || rQ3BSPFace.iVertexIndex < 0
+        || static_cast<size_t>( rQ3BSPFace.iVertexIndex ) + rQ3BSPFace.iNumOfVerts > pModel->m_Vertices.size() )
+    {
+        return;
+    }
 
-        m_pCurrentFace->mIndices[ idx ] = rVertIdx;
-        rVertIdx++;
+    const sQ3BSPVertex *pGrid = &pModel->m_Vertices[ rQ3BSPFace.iVertexIndex ];
+    const unsigned int numX = ( width - 1 ) / 2;
+    const unsigned int numY = ( height - 1 ) / 2;
+    const unsigned int stride = level + 1;
+    rPatch.m_Vertices.resize( numX * numY * stride * stride );
+    rPatch.m_Indices.reserve( numX * numY * level * level * 6 );
 
-        idx++;
-        if ( idx > 2 )
+    float orientation = 0.0f;
+    for ( unsigned int py = 0; py < numY; py++ )
+    {
+        for ( unsigned int px = 0; px < numX; px++ )
         {
-            idx = 0;
-            m_pCurrentFace = getNextFace( pMesh, rFaceIdx );
-            if ( NULL != m_pCurrentFace )
+            const sQ3BSPVertex *pControl[ 9 ];
+            for ( unsigned int row = 0; row < 3; row++ )
             {
-                m_pCurrentFace->mNumIndices = 3;
-                m_pCurrentFace->mIndices = new unsigned int[ 3 ];
+                for ( unsigned int col = 0; col < 3; col++ )
+                {
+                    pControl[ row * 3 + col ] = &pGrid[ ( py * 2 + row ) * width + px * 2 + col ];
+                }
+            }
+
+            const unsigned int base = ( py * numX + px ) * stride * stride;
+            for ( unsigned int j = 0; j < stride; j++ )
+            {
+                for ( unsigned int i = 0; i < stride; i++ )
+                {
+                    evalPatchVertex( pControl, float( i ) / level, float( j ) / level,
+                        rPatch.m_Vertices[ base + j * stride + i ] );
+                }
+            }
+
+            for ( unsigned int j = 0; j < level; j++ )
+            {
+                for ( unsigned int i = 0; i < level; i++ )
+                {
+                    const unsigned int a = base + j * stride + i;
+                    const unsigned int b = a + 1;
+                    const unsigned int c = a + stride;
+                    const unsigned int d = c + 1;
+                    const unsigned int quad[ 6 ] = { a, b, c, b, d, c };
+                    rPatch.m_Indices.insert( rPatch.m_Indices.end(), quad, quad + 6 );
+
+                    // compare the winding with the interpolated normals
+                    const vec3f &pa = rPatch.m_Vertices[ a ].vPosition;
+                    const vec3f &pb = rPatch.m_Vertices[ b ].vPosition;
+                    const vec3f &pc = rPatch.m_Vertices[ c ].vPosition;
+                    const vec3f &n = rPatch.m_Vertices[ a ].vNormal;
+                    const aiVector3D e1( pb.x - pa.x, pb.y - pa.y, pb.z - pa.z );
+                    const aiVector3D e2( pc.x - pa.x, pc.y - pa.y, pc.z - pa.z );
+                    orientation += ( e1 ^ e2 ) * aiVector3D( n.x, n.y, n.z );
+                }
             }
         }
     }
-    rFaceIdx--;
+
+    // Quake III winds its faces clockwise when looking at them along their normals,
+    // flip the patch if it came out the other way.
+    if ( orientation > 0.0f )
+    {
+        for ( size_t i = 0; i + 2 < rPatch.m_Indices.size(); i += 3 )
+        {
+            std::swap( rPatch.m_Indices[ i + 1 ], rPatch.m_Indices[ i + 2 ] );
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+//  Tessellates all bezier patches of the level, the patches are independent of each other
+//  and are tessellated in parallel.
+void Q3BSPFileImporter::tessellatePatches( const Q3BSP::Q3BSPModel *pModel )
+{
+    m_Patches.clear();
+    if ( 0 == m_PatchTessellation )
+    {
+        return;
+    }
+
+    std::vector<size_t> patchFaces;
+    for ( size_t i = 0; i < pModel->m_Faces.size(); i++ )
+    {
+        if ( pModel->m_Faces[ i ].iType == Patch )
+        {
+            patchFaces.push_back( i );
+        }
+    }
+    if ( patchFaces.empty() )
+    {
+        return;
+    }
+    m_Patches.resize( pModel->m_Faces.size() );
+
+    ParallelFor( patchFaces.size(), m_NumThreads, [&]( size_t i ) {
+        const size_t faceIdx = patchFaces[ i ];
+        tessellatePatch( pModel, pModel->m_Faces[ faceIdx ], m_PatchTessellation, m_Patches[ faceIdx ] );
+    } );
 }
 
 // ------------------------------------------------------------------------------------------------
 //  Creates all referenced materials.
 void Q3BSPFileImporter::createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene,
-                                        Q3BSPZipArchive *pArchive )
+                                        ZipArchiveIOSystem *pArchive )
 {
     if ( m_MaterialLookupMap.empty() )
     {
@@ -494,21 +699,17 @@ void Q3BSPFileImporter::createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScen
         extractIds( matName, textureId, lightmapId );
 
         // Adding the texture
-        if ( -1 != textureId )
+        if ( -1 != textureId && textureId < static_cast<int>( pModel->m_Textures.size() ) )
         {
-            sQ3BSPTexture *pTexture = pModel->m_Textures[ textureId ];
-            if ( NULL != pTexture )
-            {
-                std::string tmp( "*" ), texName( "" );
-                tmp += pTexture->strName;
-                tmp += ".jpg";
-                normalizePathName( tmp, texName );
+            const sQ3BSPTexture *pTexture = &pModel->m_Textures[ textureId ];
+            std::string tmp( "*" ), texName( "" );
+            tmp += pTexture->strName;
+            tmp += ".jpg";
+            normalizePathName( tmp, texName );
 
-                if ( !importTextureFromArchive( pModel, pArchive, pScene, pMatHelper, textureId ) )
-                {
-                }
+            if ( !importTextureFromArchive( pModel, pArchive, pScene, pMatHelper, textureId ) )
+            {
             }
-
         }
         if ( -1 != lightmapId )
         {
@@ -518,113 +719,37 @@ void Q3BSPFileImporter::createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScen
         pScene->mNumMaterials++;
     }
     pScene->mNumTextures = static_cast<unsigned int>(mTextures.size());
-    pScene->mTextures = new aiTexture*[ pScene->mNumTextures ];
-    std::copy( mTextures.begin(), mTextures.end(), pScene->mTextures );
-}
-
-// ------------------------------------------------------------------------------------------------
-//  Counts the number of referenced vertices.
-size_t Q3BSPFileImporter::countData( const std::vector<sQ3BSPFace*> &rArray ) const
-{
-    size_t numVerts = 0;
-    for ( std::vector<sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end();
-        ++it )
-    {
-        sQ3BSPFace *pQ3BSPFace = *it;
-        if ( pQ3BSPFace->iType == Polygon || pQ3BSPFace->iType == TriangleMesh )
-        {
-            Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
-            ai_assert( NULL != pQ3BSPFace );
-            numVerts += pQ3BSPFace->iNumOfFaceVerts;
-        }
-    }
-
-    return numVerts;
-}
-
-// ------------------------------------------------------------------------------------------------
-//  Counts the faces with vertices.
-size_t Q3BSPFileImporter::countFaces( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const
-{
-    size_t numFaces = 0;
-    for ( std::vector<sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end();
-        ++it )
-    {
-        Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
-        if ( pQ3BSPFace->iNumOfFaceVerts > 0 )
-        {
-            numFaces++;
-        }
-    }
-
-    return numFaces;
-}
-
-// ------------------------------------------------------------------------------------------------
-//  Counts the number of triangles in a Q3-face-array.
-size_t Q3BSPFileImporter::countTriangles( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const
-{
-    size_t numTriangles = 0;
-    for ( std::vector<Q3BSP::sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end();
-        ++it )
+    if ( pScene->mNumTextures > 0 )
     {
-        const Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
-        if ( NULL != pQ3BSPFace )
-        {
-            numTriangles += pQ3BSPFace->iNumOfFaceVerts / 3;
-        }
+        pScene->mTextures = new aiTexture*[ pScene->mNumTextures ];
+        std::copy( mTextures.begin(), mTextures.end(), pScene->mTextures );
     }
-
-    return numTriangles;
 }
 
 // ------------------------------------------------------------------------------------------------
-//  Creates the faces-to-material map.
+//  Creates the faces-to-material map in one pass over the faces.
 void Q3BSPFileImporter::createMaterialMap( const Q3BSP::Q3BSPModel *pModel )
 {
+    // the key is only built once for each combination of texture and light-map
+    std::map<std::pair<int, int>, FaceArray*> groups;
     std::string key( "" );
-    std::vector<sQ3BSPFace*> *pCurFaceArray = NULL;
-    for ( size_t idx = 0; idx < pModel->m_Faces.size(); idx++ )
-    {
-        Q3BSP::sQ3BSPFace *pQ3BSPFace = pModel->m_Faces[ idx ];
-        const int texId = pQ3BSPFace->iTextureID;
-        const int lightMapId = pQ3BSPFace->iLightmapID;
-        createKey( texId, lightMapId, key );
-        FaceMapIt it = m_MaterialLookupMap.find( key );
-        if ( m_MaterialLookupMap.end() == it )
-        {
-            pCurFaceArray = new std::vector<Q3BSP::sQ3BSPFace*>;
-            m_MaterialLookupMap[ key ] = pCurFaceArray;
-        }
-        else
-        {
-            pCurFaceArray = (*it).second;
-        }
-        ai_assert( NULL != pCurFaceArray );
-        if ( NULL != pCurFaceArray )
+    for ( const sQ3BSPFace *pQ3BSPFace = pModel->m_Faces.begin(); pQ3BSPFace != pModel->m_Faces.end(); ++pQ3BSPFace )
+    {
+        const std::pair<int, int> ids( pQ3BSPFace->iTextureID, pQ3BSPFace->iLightmapID );
+        FaceArray *&pCurFaceArray = groups[ ids ];
+        if ( NULL == pCurFaceArray )
         {
-            pCurFaceArray->push_back( pQ3BSPFace );
+            createKey( ids.first, ids.second, key );
+            pCurFaceArray = &m_MaterialLookupMap[ key ];
         }
+        pCurFaceArray->push_back( pQ3BSPFace );
     }
 }
 
-// ------------------------------------------------------------------------------------------------
-//  Returns the next face.
-aiFace *Q3BSPFileImporter::getNextFace( aiMesh *pMesh, unsigned int &rFaceIdx )
-{
-    aiFace *pFace( NULL );
-    if ( rFaceIdx < pMesh->mNumFaces ) {
-        pFace = &pMesh->mFaces[ rFaceIdx ];
-        rFaceIdx++;
-    }
-
-    return pFace;
-}
-
 // ------------------------------------------------------------------------------------------------
 //  Imports a texture file.
 bool Q3BSPFileImporter::importTextureFromArchive( const Q3BSP::Q3BSPModel *pModel,
-                                                 Q3BSP::Q3BSPZipArchive *pArchive, aiScene*,
+                                                 ZipArchiveIOSystem *pArchive, aiScene*,
                                                  aiMaterial *pMatHelper, int textureId ) {
     if ( NULL == pArchive || NULL == pMatHelper ) {
         return false;
@@ -635,10 +760,7 @@ bool Q3BSPFileImporter::importTextureFromArchive( const Q3BSP::Q3BSPModel *pMode
     }
 
     bool res = true;
-    sQ3BSPTexture *pTexture = pModel->m_Textures[ textureId ];
-    if ( !pTexture ) {
-        return false;
-    }
+    const sQ3BSPTexture *pTexture = &pModel->m_Textures[ textureId ];
 
     std::vector<std::string> supportedExtensions;
     supportedExtensions.push_back( ".jpg" );
@@ -699,11 +821,7 @@ bool Q3BSPFileImporter::importLightmap( const Q3BSP::Q3BSPModel *pModel, aiScene
         return false;
     }
 
-    sQ3BSPLightmap *pLightMap = pModel->m_Lightmaps[ lightmapId ];
-    if ( NULL == pLightMap )
-    {
-        return false;
-    }
+    const sQ3BSPLightmap *pLightMap = &pModel->m_Lightmaps[ lightmapId ];
 
     aiTexture *pTexture = new aiTexture;
 
@@ -734,7 +852,7 @@ bool Q3BSPFileImporter::importLightmap( const Q3BSP::Q3BSPModel *pModel, aiScene
 
 // ------------------------------------------------------------------------------------------------
 //  Will search for a supported extension.
-bool Q3BSPFileImporter::expandFile(  Q3BSP::Q3BSPZipArchive *pArchive, const std::string &rFilename,
+bool Q3BSPFileImporter::expandFile(  ZipArchiveIOSystem *pArchive, const std::string &rFilename,
                                    const std::vector<std::string> &rExtList, std::string &rFile,
                                    std::string &rExt )
 {
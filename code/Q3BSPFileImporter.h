@@ -42,8 +42,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ASSIMP_Q3BSPFILEIMPORTER_H_INC
 
 #include "BaseImporter.h"
+#include "Q3BSPFileData.h"
 
 #include <map>
+#include <vector>
 
 struct aiMesh;
 struct aiNode;
@@ -52,11 +54,8 @@ struct aiMaterial;
 struct aiTexture;
 
 namespace Assimp {
-namespace Q3BSP {
-    class Q3BSPZipArchive;
-    struct Q3BSPModel;
-    struct sQ3BSPFace;
-}
+
+class ZipArchiveIOSystem;
 
 // ------------------------------------------------------------------------------------------------
 /** Loader to import BSP-levels from a PK3 archive or from a unpacked BSP-level.
@@ -75,38 +74,42 @@ public:
     /// @remark See BaseImporter::CanRead() for details.
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig ) const;
 
+    /// @brief  Reads the patch tessellation level from the importer properties.
+    void SetupProperties( const Importer* pImp );
+
 private:
-    typedef std::map<std::string, std::vector<Q3BSP::sQ3BSPFace*>*> FaceMap;
-    typedef std::map<std::string, std::vector<Q3BSP::sQ3BSPFace*>* >::iterator FaceMapIt;
-    typedef std::map<std::string, std::vector<Q3BSP::sQ3BSPFace*>*>::const_iterator FaceMapConstIt;
+    typedef std::vector<const Q3BSP::sQ3BSPFace*> FaceArray;
+    typedef std::map<std::string, FaceArray> FaceMap;
+    typedef std::map<std::string, FaceArray>::iterator FaceMapIt;
+    typedef std::map<std::string, FaceArray>::const_iterator FaceMapConstIt;
 
     const aiImporterDesc* GetInfo () const;
     void InternReadFile(const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler);
     void separateMapName( const std::string &rImportName, std::string &rArchiveName, std::string &rMapName );
-    bool findFirstMapInArchive( Q3BSP::Q3BSPZipArchive &rArchive, std::string &rMapName );
-    void CreateDataFromImport( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, Q3BSP::Q3BSPZipArchive *pArchive );
+    bool findFirstMapInArchive( ZipArchiveIOSystem &rArchive, std::string &rMapName );
+    void CreateDataFromImport( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, ZipArchiveIOSystem *pArchive );
     void CreateNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, aiNode *pParent );
     aiNode *CreateTopology( const Q3BSP::Q3BSPModel *pModel, unsigned int materialIdx,
-        std::vector<Q3BSP::sQ3BSPFace*> &rArray, aiMesh* pMesh );
-    void createTriangleTopology( const Q3BSP::Q3BSPModel *pModel, Q3BSP::sQ3BSPFace *pQ3BSPFace, aiMesh* pMesh, unsigned int &rFaceIdx,
-        unsigned int &rVertIdx  );
-    void createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, Q3BSP::Q3BSPZipArchive *pArchive );
-    size_t countData( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const;
-    size_t countFaces( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const;
-    size_t countTriangles( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const;
+        const FaceArray &rArray, aiMesh* pMesh );
+    void createTriangleTopology( const Q3BSP::Q3BSPModel *pModel, const Q3BSP::sQ3BSPFace &rQ3BSPFace, aiMesh* pMesh,
+        unsigned int &rFaceIdx, unsigned int &rVertIdx );
+    void createPatchTopology( const Q3BSP::sQ3BSPPatchMesh &rPatch, aiMesh* pMesh, unsigned int &rFaceIdx,
+        unsigned int &rVertIdx );
+    void tessellatePatches( const Q3BSP::Q3BSPModel *pModel );
+    void createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, ZipArchiveIOSystem *pArchive );
     void createMaterialMap( const Q3BSP::Q3BSPModel *pModel);
-    aiFace *getNextFace( aiMesh *pMesh, unsigned int &rFaceIdx );
-    bool importTextureFromArchive( const Q3BSP::Q3BSPModel *pModel, Q3BSP::Q3BSPZipArchive *pArchive, aiScene* pScene,
+    bool importTextureFromArchive( const Q3BSP::Q3BSPModel *pModel, ZipArchiveIOSystem *pArchive, aiScene* pScene,
         aiMaterial *pMatHelper, int textureId );
     bool importLightmap( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, aiMaterial *pMatHelper, int lightmapId );
     bool importEntities( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene );
-    bool expandFile(  Q3BSP::Q3BSPZipArchive *pArchive, const std::string &rFilename, const std::vector<std::string> &rExtList,
+    bool expandFile(  ZipArchiveIOSystem *pArchive, const std::string &rFilename, const std::vector<std::string> &rExtList,
         std::string &rFile, std::string &rExt );
 
 private:
-    aiMesh *m_pCurrentMesh;
-    aiFace *m_pCurrentFace;
     FaceMap m_MaterialLookupMap;
+    std::vector<Q3BSP::sQ3BSPPatchMesh> m_Patches;  ///< Tessellated patches, by face index
+    unsigned int m_PatchTessellation;
+    unsigned int m_NumThreads;                      ///< Threads to tessellate the patches on
     std::vector<aiTexture*> mTextures;
 };
 
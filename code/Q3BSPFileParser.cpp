@@ -44,8 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Q3BSPFileParser.h"
 #include "Q3BSPFileData.h"
-#include "Q3BSPZipArchive.h"
+#include "ZipArchiveIOSystem.h"
 #include <vector>
+#include <string.h>
+#include <stdint.h>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/ai_assert.h>
 
@@ -54,21 +56,17 @@ namespace Assimp {
 using namespace Q3BSP;
 
 // ------------------------------------------------------------------------------------------------
-Q3BSPFileParser::Q3BSPFileParser( const std::string &rMapName, Q3BSPZipArchive *pZipArchive ) :
+Q3BSPFileParser::Q3BSPFileParser( const std::string &rMapName, ZipArchiveIOSystem *pZipArchive ) :
     m_sOffset( 0 ),
-    m_Data(),
     m_pModel( NULL ),
     m_pZipArchive( pZipArchive )
 {
     ai_assert( NULL != m_pZipArchive );
     ai_assert( !rMapName.empty() );
 
-    if ( !readData( rMapName ) )
-        return;
-
     m_pModel = new Q3BSPModel;
     m_pModel->m_ModelName = rMapName;
-    if ( !parseFile() )
+    if ( !readData( rMapName ) || !parseFile() )
     {
         delete m_pModel;
         m_pModel = NULL;
@@ -89,6 +87,7 @@ Q3BSP::Q3BSPModel *Q3BSPFileParser::getModel() const
 }
 
 // ------------------------------------------------------------------------------------------------
+//  Inflates the map from the archive into the model, the lumps are used in place from there.
 bool Q3BSPFileParser::readData( const std::string &rMapName )
 {
     if ( !m_pZipArchive->Exists( rMapName.c_str() ) )
@@ -98,16 +97,17 @@ bool Q3BSPFileParser::readData( const std::string &rMapName )
     if ( NULL == pMapFile )
         return false;
 
+    std::vector<unsigned char> &data = m_pModel->m_Data;
     const size_t size = pMapFile->FileSize();
-    m_Data.resize( size );
+    data.resize( size );
 
-    const size_t readSize = pMapFile->Read( &m_Data[0], sizeof( char ), size );
+    const size_t readSize = size ? pMapFile->Read( &data[0], sizeof( char ), size ) : 0;
+    m_pZipArchive->Close( pMapFile );
     if ( readSize != size )
     {
-        m_Data.clear();
+        data.clear();
         return false;
     }
-    m_pZipArchive->Close( pMapFile );
 
     return true;
 }
@@ -115,7 +115,7 @@ bool Q3BSPFileParser::readData( const std::string &rMapName )
 // ------------------------------------------------------------------------------------------------
 bool Q3BSPFileParser::parseFile()
 {
-    if ( m_Data.empty() )
+    if ( m_pModel->m_Data.empty() )
     {
         return false;
     }
@@ -125,37 +125,25 @@ bool Q3BSPFileParser::parseFile()
         return false;
     }
 
-    // Imports the dictionary of the level
-    getLumps();
-
-    // Conunt data and prepare model data
-    countLumps();
-
-    // Read in Vertices
-    getVertices();
-
-    // Read in Indices
-    getIndices();
-
-    // Read Faces
-    getFaces();
-
-    // Read Textures
-    getTextures();
-
-    // Read Lightmaps
-    getLightMaps();
-
-    // Load the entities
-    getEntities();
-
-    return true;
+    // Imports the dictionary of the level, then maps the lumps it describes
+    return getLumps()
+        && getVertices()
+        && getIndices()
+        && getFaces()
+        && getTextures()
+        && getLightMaps()
+        && getEntities();
 }
 
 // ------------------------------------------------------------------------------------------------
 bool Q3BSPFileParser::validateFormat()
 {
-    sQ3BSPHeader *pHeader = (sQ3BSPHeader*) &m_Data[ 0 ];
+    if ( m_pModel->m_Data.size() < sizeof( sQ3BSPHeader ) + kMaxLumps * sizeof( sQ3BSPLump ) )
+    {
+        return false;
+    }
+
+    const sQ3BSPHeader *pHeader = (const sQ3BSPHeader*) &m_pModel->m_Data[ 0 ];
     m_sOffset += sizeof( sQ3BSPHeader );
 
     // Version and identify string validation
@@ -169,109 +157,92 @@ bool Q3BSPFileParser::validateFormat()
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::getLumps()
+//  Points the view to the entries of a lump. Lumps which are not aligned for their
+//  entry type are copied, the others are used in place.
+template<class T>
+bool Q3BSPFileParser::mapLump( int lumpIdx, Q3BSPLumpView<T> &rView )
 {
-    size_t Offset = m_sOffset;
-    m_pModel->m_Lumps.resize( kMaxLumps );
-    for ( size_t idx=0; idx < kMaxLumps; idx++ )
+    static_assert( alignof( T ) <= alignof( int ), "lump entries must not need more than int alignment" );
+
+    const sQ3BSPLump &lump = m_pModel->m_Lumps[ lumpIdx ];
+    const std::vector<unsigned char> &data = m_pModel->m_Data;
+    if ( lump.iOffset < 0 || lump.iSize < 0 || static_cast<size_t>( lump.iOffset ) > data.size()
+        || static_cast<size_t>( lump.iSize ) > data.size() - lump.iOffset )
+    {
+        return false;
+    }
+
+    rView.m_Size = lump.iSize / sizeof( T );
+    if ( 0 == rView.m_Size )
     {
-        sQ3BSPLump *pLump = new sQ3BSPLump;
-        memcpy( pLump, &m_Data[ Offset ], sizeof( sQ3BSPLump ) );
-        Offset += sizeof( sQ3BSPLump );
-        m_pModel->m_Lumps[ idx ] = pLump;
+        rView.m_pData = NULL;
+        return true;
     }
+
+    const unsigned char *pData = &data[ lump.iOffset ];
+    if ( 0 != reinterpret_cast<uintptr_t>( pData ) % alignof( T ) )
+    {
+        std::vector<int> copy( ( rView.m_Size * sizeof( T ) + sizeof( int ) - 1 ) / sizeof( int ) );
+        ::memcpy( &copy[ 0 ], pData, rView.m_Size * sizeof( T ) );
+        m_pModel->m_LumpCopies.push_back( std::vector<int>() );
+        m_pModel->m_LumpCopies.back().swap( copy );
+        pData = reinterpret_cast<const unsigned char*>( &m_pModel->m_LumpCopies.back()[ 0 ] );
+    }
+    rView.m_pData = reinterpret_cast<const T*>( pData );
+
+    return true;
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::countLumps()
+bool Q3BSPFileParser::getLumps()
 {
-    m_pModel->m_Vertices.resize( m_pModel->m_Lumps[ kVertices ]->iSize / sizeof( sQ3BSPVertex ) );
-    m_pModel->m_Indices.resize( m_pModel->m_Lumps[ kMeshVerts ]->iSize  / sizeof( int ) );
-    m_pModel->m_Faces.resize( m_pModel->m_Lumps[ kFaces ]->iSize / sizeof( sQ3BSPFace ) );
-    m_pModel->m_Textures.resize( m_pModel->m_Lumps[ kTextures ]->iSize / sizeof( sQ3BSPTexture ) );
-    m_pModel->m_Lightmaps.resize( m_pModel->m_Lumps[ kLightmaps ]->iSize / sizeof( sQ3BSPLightmap ) );
+    // the lump directory directly follows the header
+    m_pModel->m_Lumps.m_pData = reinterpret_cast<const sQ3BSPLump*>( &m_pModel->m_Data[ m_sOffset ] );
+    m_pModel->m_Lumps.m_Size = kMaxLumps;
+    return true;
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::getVertices()
+bool Q3BSPFileParser::getVertices()
 {
-    size_t Offset = m_pModel->m_Lumps[ kVertices ]->iOffset;
-    for ( size_t idx = 0; idx < m_pModel->m_Vertices.size(); idx++ )
-    {
-        sQ3BSPVertex *pVertex = new sQ3BSPVertex;
-        memcpy( pVertex, &m_Data[ Offset ], sizeof( sQ3BSPVertex ) );
-        Offset += sizeof( sQ3BSPVertex );
-        m_pModel->m_Vertices[ idx ] = pVertex;
-    }
+    return mapLump( kVertices, m_pModel->m_Vertices );
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::getIndices()
+bool Q3BSPFileParser::getIndices()
 {
-    ai_assert( NULL != m_pModel );
-
-    sQ3BSPLump *lump = m_pModel->m_Lumps[ kMeshVerts ];
-    size_t Offset = (size_t) lump->iOffset;
-    const size_t nIndices = lump->iSize / sizeof( int );
-    m_pModel->m_Indices.resize( nIndices );
-    memcpy( &m_pModel->m_Indices[ 0 ], &m_Data[ Offset ], lump->iSize );
+    return mapLump( kMeshVerts, m_pModel->m_Indices );
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::getFaces()
+bool Q3BSPFileParser::getFaces()
 {
-    ai_assert( NULL != m_pModel );
-
-    size_t Offset = m_pModel->m_Lumps[ kFaces ]->iOffset;
-    for ( size_t idx = 0; idx < m_pModel->m_Faces.size(); idx++ )
-    {
-        sQ3BSPFace *pFace = new sQ3BSPFace;
-        memcpy( pFace, &m_Data[ Offset ], sizeof( sQ3BSPFace ) );
-        m_pModel->m_Faces[ idx ] = pFace;
-        Offset += sizeof( sQ3BSPFace );
-    }
+    return mapLump( kFaces, m_pModel->m_Faces );
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::getTextures()
+bool Q3BSPFileParser::getTextures()
 {
-    ai_assert( NULL != m_pModel );
-
-    size_t Offset = m_pModel->m_Lumps[ kTextures ]->iOffset;
-    for ( size_t idx=0; idx < m_pModel->m_Textures.size(); idx++ )
-    {
-        sQ3BSPTexture *pTexture = new sQ3BSPTexture;
-        memcpy( pTexture, &m_Data[ Offset ], sizeof(sQ3BSPTexture) );
-        m_pModel->m_Textures[ idx ] = pTexture;
-        Offset += sizeof(sQ3BSPTexture);
-    }
+    return mapLump( kTextures, m_pModel->m_Textures );
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::getLightMaps()
+bool Q3BSPFileParser::getLightMaps()
 {
-    ai_assert( NULL != m_pModel );
-
-    size_t Offset = m_pModel->m_Lumps[kLightmaps]->iOffset;
-    for ( size_t idx=0; idx < m_pModel->m_Lightmaps.size(); idx++ )
-    {
-        sQ3BSPLightmap *pLightmap = new sQ3BSPLightmap;
-        memcpy( pLightmap, &m_Data[ Offset ], sizeof( sQ3BSPLightmap ) );
-        Offset += sizeof( sQ3BSPLightmap );
-        m_pModel->m_Lightmaps[ idx ] = pLightmap;
-    }
+    return mapLump( kLightmaps, m_pModel->m_Lightmaps );
 }
 
 // ------------------------------------------------------------------------------------------------
-void Q3BSPFileParser::getEntities()
+bool Q3BSPFileParser::getEntities()
 {
-    int size = m_pModel->m_Lumps[ kEntities ]->iSize;
-    m_pModel->m_EntityData.resize( size );
-    if ( size > 0 )
+    Q3BSPLumpView<char> entities;
+    if ( !mapLump( kEntities, entities ) )
     {
-        size_t Offset = m_pModel->m_Lumps[ kEntities ]->iOffset;
-        memcpy( &m_pModel->m_EntityData[ 0 ], &m_Data[ Offset ], sizeof( char ) * size );
+        return false;
     }
+
+    m_pModel->m_EntityData.assign( entities.begin(), entities.end() );
+    return true;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -47,12 +47,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp
 {
+
+class ZipArchiveIOSystem;
+
 namespace Q3BSP
 {
 
-class Q3BSPZipArchive;
 struct Q3BSPModel;
-class ZipFile;
+template<class T> struct Q3BSPLumpView;
 
 }
 
@@ -61,7 +63,7 @@ class ZipFile;
 class Q3BSPFileParser
 {
 public:
-    Q3BSPFileParser( const std::string &rMapName, Q3BSP::Q3BSPZipArchive *pZipArchive );
+    Q3BSPFileParser( const std::string &rMapName, ZipArchiveIOSystem *pZipArchive );
     ~Q3BSPFileParser();
     Q3BSP::Q3BSPModel *getModel() const;
 
@@ -69,20 +71,21 @@ protected:
     bool readData(const std::string &rMapName);
     bool parseFile();
     bool validateFormat();
-    void getLumps();
-    void countLumps();
-    void getVertices();
-    void getIndices();
-    void getFaces();
-    void getTextures();
-    void getLightMaps();
-    void getEntities();
+    bool getLumps();
+    bool getVertices();
+    bool getIndices();
+    bool getFaces();
+    bool getTextures();
+    bool getLightMaps();
+    bool getEntities();
+
+    template<class T>
+    bool mapLump( int lumpIdx, Q3BSP::Q3BSPLumpView<T> &rView );
 
 private:
     size_t m_sOffset;
-    std::vector<char> m_Data;
     Q3BSP::Q3BSPModel *m_pModel;
-    Q3BSP::Q3BSPZipArchive *m_pZipArchive;
+    ZipArchiveIOSystem *m_pZipArchive;
 };
 
 } // Namespace Assimp
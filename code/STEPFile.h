@@ -48,12 +48,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <map>
 #include <set>
+#include <atomic>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#endif
 
 #include "FBXDocument.h" //ObjectMap::value_type
 #include <assimp/DefaultLogger.hpp>
 
 //
-#if _MSC_VER > 1500 || (defined __GNUC___)
+#if _MSC_VER > 1500 || (defined __GNUC__)
 #   define ASSIMP_STEP_USE_UNORDERED_MULTIMAP
 #else
 #   define step_unordered_map map
@@ -62,7 +67,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifdef ASSIMP_STEP_USE_UNORDERED_MULTIMAP
 #   include <unordered_map>
-#   if _MSC_VER > 1600
+#   if _MSC_VER > 1600 || (defined __GNUC__)
 #       define step_unordered_map unordered_map
 #       define step_unordered_multimap unordered_multimap
 #   else
@@ -602,7 +607,7 @@ namespace STEP {
                 LazyInit();
                 ai_assert(obj);
             }
-            return *obj;
+            return *obj.load(std::memory_order_acquire);
         }
 
         const Object& operator * () const {
@@ -610,7 +615,7 @@ namespace STEP {
                 LazyInit();
                 ai_assert(obj);
             }
-            return *obj;
+            return *obj.load(std::memory_order_acquire);
         }
 
         template <typename T>
@@ -663,8 +668,10 @@ namespace STEP {
         const char* const type;
         DB& db;
 
+        // args is released and obj published once conversion succeeded, obj is
+        // atomic so other threads can test it without taking the DB lock.
         mutable const char* args;
-        mutable Object* obj;
+        mutable std::atomic<Object*> obj;
     };
 
     template <typename T>
@@ -836,8 +843,9 @@ namespace STEP {
     public:
 
         // objects indexed by ID - this can grow pretty large (i.e some hundred million
-        // entries), so use raw pointers to avoid *any* overhead.
-        typedef std::map<uint64_t,const LazyObject* > ObjectMap;
+        // entries), so use raw pointers to avoid *any* overhead. Lookups by id are
+        // by far the most frequent operation, ordering is never needed.
+        typedef std::step_unordered_map<uint64_t,const LazyObject* > ObjectMap;
 
         // objects indexed by their declarative type, but only for those that we truly want
         typedef std::set< const LazyObject*> ObjectSet;
@@ -858,7 +866,7 @@ namespace STEP {
         DB(std::shared_ptr<StreamReaderLE> reader)
             : reader(reader)
             , splitter(*reader,true,true)
-            , evaluated_count()
+            , evaluated_count(0)
             , schema( NULL )
         {}
 
@@ -877,7 +885,7 @@ namespace STEP {
         }
 
         uint64_t GetEvaluatedObjectCount() const {
-            return evaluated_count;
+            return evaluated_count.load();
         }
 
         const HeaderInfo& GetHeader() const {
@@ -943,6 +951,12 @@ namespace STEP {
         }
 
 
+        // convert all entities of the given types (or all entities for which the
+        // schema has a converter if types is NULL) ahead of time, spreading the
+        // work over up to num_threads threads. Entities that fail to convert are
+        // left untouched so the error surfaces when the loader requests them.
+        void EvaluateParallel(const char* const* types = NULL, size_t len = 0, unsigned int num_threads = 0);
+
 #ifdef ASSIMP_IFC_TEST
 
         // evaluate *all* entities in the file. this is a power test for the loader
@@ -964,6 +978,14 @@ namespace STEP {
             return splitter;
         }
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        // lock guarding the evaluation of the entity with the given id. Converters
+        // never evaluate other entities, so a thread holds at most one of them.
+        std::mutex& GetEvaluationLock(uint64_t id) const {
+            return eval_locks[id % EvaluationLockCount];
+        }
+#endif
+
         void InternInsert(const LazyObject* lz) {
             objects[lz->GetID()] = lz;
 
@@ -1008,8 +1030,13 @@ namespace STEP {
         InverseWhitelist inv_whitelist;
         std::shared_ptr<StreamReaderLE> reader;
         LineSplitter splitter;
-        uint64_t evaluated_count;
+        std::atomic<uint64_t> evaluated_count;
         const EXPRESS::ConversionSchema* schema;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        enum { EvaluationLockCount = 64 };
+        mutable std::mutex eval_locks[EvaluationLockCount];
+#endif
     };
 
 }
@@ -48,7 +48,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFileEncoding.h"
 #include "TinyFormatter.h"
 #include "fast_atof.h"
+#include "ParallelFor.h"
 #include <memory>
+#include <algorithm>
 
 
 using namespace Assimp;
@@ -175,12 +177,18 @@ void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
     db.SetTypesToTrack(types_to_track,len);
     db.SetInverseIndicesToTrack(inverse_indices_to_track,len2);
 
+    // typical entity records are about 60-100 bytes, so this gets the index
+    // close to its final size without rehashing during the read
+    db.objects.reserve(db.reader->GetRemainingSize() / 80);
+
     const DB::ObjectMap& map = db.GetObjects();
     LineSplitter& splitter = db.GetSplitter();
 
+    // reused for all lines to avoid a heap allocation per record
+    std::string s, type;
     while (splitter) {
         bool has_next = false;
-        std::string s = *splitter;
+        s = *splitter;
         if (s == "ENDSEC;") {
             break;
         }
@@ -206,7 +214,8 @@ void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
             continue;
         }
 
-        const uint64_t id = strtoul10_64(s.substr(1,n0-1).c_str());
+        // the digits end at the '=' token, no need to cut them out first
+        const uint64_t id = strtoul10_64(s.c_str()+1);
         if (!id) {
             DefaultLogger::get()->warn(AddLineNumber("expected positive, numeric entity id",line));
             ++splitter;
@@ -275,7 +284,7 @@ void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
         do ++ns; while( IsSpace(s.at(ns)));
         std::string::size_type ne = n1;
         do --ne; while( IsSpace(s.at(ne)));
-        std::string type = s.substr(ns,ne-ns+1);
+        type.assign(s,ns,ne-ns+1);
         std::transform( type.begin(), type.end(), type.begin(), &Assimp::ToLower<char>  );
         const char* sz = scheme.GetStaticStringForToken(type);
         if(sz) {
@@ -506,8 +515,9 @@ STEP::LazyObject::LazyObject(DB& db, uint64_t id,uint64_t /*line*/, const char*
 STEP::LazyObject::~LazyObject()
 {
     // make sure the right dtor/operator delete get called
-    if (obj) {
-        delete obj;
+    Object* const o = obj.load();
+    if (o) {
+        delete o;
     }
     else delete[] args;
 }
@@ -515,6 +525,14 @@ STEP::LazyObject::~LazyObject()
 // ------------------------------------------------------------------------------------------------
 void STEP::LazyObject::LazyInit() const
 {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // another thread may have converted the object while we were waiting for the lock
+    std::lock_guard<std::mutex> lock(db.GetEvaluationLock(id));
+    if (obj.load(std::memory_order_relaxed)) {
+        return;
+    }
+#endif
+
     const EXPRESS::ConversionSchema& schema = db.GetSchema();
     STEP::ConvertObjectProc proc = schema.GetConverterProc(type);
 
@@ -524,21 +542,73 @@ void STEP::LazyObject::LazyInit() const
 
     const char* acopy = args;
     std::shared_ptr<const EXPRESS::LIST> conv_args = EXPRESS::LIST::Parse(acopy,STEP::SyntaxError::LINE_NOT_SPECIFIED,&db.GetSchema());
-    delete[] args;
-    args = NULL;
 
     // if the converter fails, it should throw an exception, but it should never return NULL
+    Object* result;
     try {
-        obj = proc(db,*conv_args);
+        result = proc(db,*conv_args);
     }
     catch(const TypeError& t) {
         // augment line and entity information
         throw TypeError(t.what(),id);
     }
-    ++db.evaluated_count;
-    ai_assert(obj);
+    ai_assert(result);
 
     // store the original id in the object instance
-    obj->SetID(id);
+    result->SetID(id);
+
+    // only drop the argument string once conversion succeeded, so a failed
+    // attempt can be repeated (and fail with the same error) later on
+    delete[] args;
+    args = NULL;
+
+    ++db.evaluated_count;
+    obj.store(result, std::memory_order_release);
+}
+
+// ------------------------------------------------------------------------------------------------
+void STEP::DB::EvaluateParallel(const char* const* types, size_t len, unsigned int num_threads)
+{
+    // collect the work up front, the object index must not change while workers run
+    std::vector<const LazyObject*> todo;
+    if (types) {
+        for(size_t i = 0; i < len; ++i) {
+            const ObjectMapByType::const_iterator it = objects_bytype.find(types[i]);
+            if (it != objects_bytype.end()) {
+                todo.insert(todo.end(),(*it).second.begin(),(*it).second.end());
+            }
+        }
+    }
+    else {
+        todo.reserve(objects.size());
+        for(const ObjectMap::value_type& e : objects) {
+            if (schema->GetConverterProc(e.second->type)) {
+                todo.push_back(e.second);
+            }
+        }
+    }
+
+    // workers grab fixed-size batches, conversion cost varies a lot between entity types
+    static const size_t BatchSize = 1024;
+    ParallelFor((todo.size() + BatchSize - 1) / BatchSize, num_threads, [&todo](size_t batch) {
+        const size_t end = std::min((batch + 1) * BatchSize, todo.size());
+        for(size_t i = batch * BatchSize; i < end; ++i) {
+            const LazyObject* const lz = todo[i];
+            if (lz->obj.load(std::memory_order_acquire)) {
+                continue;
+            }
+            try {
+                lz->LazyInit();
+            }
+            catch(...) {
+                // leave it to the loader to report the error if it really needs this entity
+            }
+        }
+    });
+
+    if ( !DefaultLogger::isNullLogger()){
+        DefaultLogger::get()->debug((Formatter::format(),"STEP: evaluated ",GetEvaluatedObjectCount()," of ",
+            objects.size()," object records ahead of conversion"));
+    }
 }
 
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 #include "Exceptional.h"
 #include "ByteSwapper.h"
+#include "fast_ftoa.h"
 
 using namespace Assimp;
 namespace Assimp    {
@@ -59,51 +60,45 @@ namespace Assimp    {
 // Worker function for exporting a scene to Stereolithograpy. Prototyped and registered in Exporter.cpp
 void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
 {
-    // invoke the exporter
-    STLExporter exporter(pFile, pScene);
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-    
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
-}
-void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
-{
     // invoke the exporter
-    STLExporter exporter(pFile, pScene, true);
+    STLExporter exporter(pFile, pScene, outfile.get());
 
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
+    if (exporter.mOutput.flush().fail()) {
+        throw DeadlyExportError("could not write output .stl file: " + std::string(pFile));
     }
-    
-    // we're still here - export successfully completed. Write the file.
+}
+void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
+{
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter
+    STLExporter exporter(pFile, pScene, outfile.get(), true);
+
+    if (exporter.mOutput.flush().fail()) {
+        throw DeadlyExportError("could not write output .stl file: " + std::string(pFile));
+    }
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, IOStream* pOutput, bool binary)
+: mOutput(pOutput)
+, filename(_filename)
 , endl("\n")
 {
     // make sure that all formatting happens using the standard, C locale and not the user's current locale
     const std::locale& l = std::locale("C");
     mOutput.imbue(l);
-    mOutput.precision(16);
     if (binary) {
         char buf[80] = {0} ;
         buf[0] = 'A'; buf[1] = 's'; buf[2] = 's'; buf[3] = 'i'; buf[4] = 'm'; buf[5] = 'p';
@@ -146,11 +141,11 @@ void STLExporter :: WriteMesh(const aiMesh* m)
             }
             nor.Normalize();
         }
-        mOutput << " facet normal " << nor.x << " " << nor.y << " " << nor.z << endl;
+        mOutput << " facet normal " << ShortestReals(nor) << endl;
         mOutput << "  outer loop" << endl;
         for(unsigned int a = 0; a < f.mNumIndices; ++a) {
             const aiVector3D& v  = m->mVertices[f.mIndices[a]];
-            mOutput << "  vertex " << v.x << " " << v.y << " " << v.z << endl;
+            mOutput << "  vertex " << ShortestReals(v) << endl;
         }
 
         mOutput << "  endloop" << endl;
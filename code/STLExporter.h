@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "IOStreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -61,12 +61,12 @@ class STLExporter
 {
 public:
     /// Constructor for a specific scene to export
-    STLExporter(const char* filename, const aiScene* pScene, bool binary = false);
+    STLExporter(const char* filename, const aiScene* pScene, IOStream* pOutput, bool binary = false);
 
 public:
 
-    /// public stringstreams to write all output into
-    std::ostringstream mOutput;
+    /// public stream to write all output into, it passes the data on to the output file
+    IOStreamWriter mOutput;
 
 private:
 
@@ -50,10 +50,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "fast_atof.h"
 #include <memory>
+#include <algorithm>
 #include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/importerdesc.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 using namespace Assimp;
 
@@ -119,6 +122,126 @@ static bool IsAsciiSTL(const char* buffer, unsigned int fileSize) {
     }
     return isASCII;
 }
+
+// Size of a binary facet record: normal, three vertices and the attribute word
+static const unsigned int BinaryFacetSize = 50;
+
+// Decode the 15 bit color of a binary facet. The channel order is reversed
+// in Materialise files.
+static aiColor4D DecodeFacetColor(uint16_t color, bool bIsMaterialise) {
+    const ai_real invVal( (ai_real)1.0 / ( ai_real )31.0 );
+    const ai_real lo = (color & 0x1Fu) * invVal;
+    const ai_real mid = ((color >> 5u) & 0x1Fu) * invVal;
+    const ai_real hi = ((color >> 10u) & 0x1Fu) * invVal;
+    if (bIsMaterialise) {
+        return aiColor4D(lo, mid, hi, (ai_real)1.0);
+    }
+    return aiColor4D(hi, mid, lo, (ai_real)1.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hash table mapping vertices with bitwise identical position and color to
+// a single output vertex. Used to weld the facet soup of STL files while loading.
+class VertexWelder {
+public:
+    VertexWelder(size_t expectedVertices, bool withColors)
+    : mWithColors(withColors)
+    , mMask(0) {
+        positions.reserve(expectedVertices);
+        if (withColors) {
+            colors.reserve(expectedVertices);
+        }
+        size_t capacity = 64;
+        while (capacity < expectedVertices * 2) {
+            capacity <<= 1;
+        }
+        Rehash(capacity);
+    }
+
+    // Returns the index of the output vertex for the given input vertex
+    unsigned int Add(const aiVector3D& pos, const aiColor4D& clr) {
+        size_t slot = Hash(pos) & mMask;
+        for ( ;; slot = (slot + 1) & mMask) {
+            const unsigned int idx = mTable[slot];
+            if (Empty == idx) {
+                break;
+            }
+            if (!::memcmp(&positions[idx], &pos, sizeof(aiVector3D)) &&
+                (!mWithColors || !::memcmp(&colors[idx], &clr, sizeof(aiColor4D)))) {
+                return idx;
+            }
+        }
+
+        const unsigned int idx = static_cast<unsigned int>(positions.size());
+        positions.push_back(pos);
+        if (mWithColors) {
+            colors.push_back(clr);
+        }
+        mTable[slot] = idx;
+        if (positions.size() * 2 > mTable.size()) {
+            Rehash(mTable.size() * 2);
+        }
+        return idx;
+    }
+
+    std::vector<aiVector3D> positions;
+    std::vector<aiColor4D> colors;
+
+private:
+    enum { Empty = 0xffffffff };
+
+    static size_t Hash(const aiVector3D& pos) {
+        uint32_t words[sizeof(aiVector3D) / sizeof(uint32_t)];
+        ::memcpy(words, &pos, sizeof(words));
+        uint32_t h = 0;
+        for (unsigned int i = 0; i < sizeof(words) / sizeof(uint32_t); ++i) {
+            h = (h ^ words[i]) * 0x9E3779B1u;
+            h ^= h >> 16;
+        }
+        h *= 0x85EBCA6Bu;
+        return h ^ (h >> 13);
+    }
+
+    void Rehash(size_t capacity) {
+        mTable.assign(capacity, static_cast<unsigned int>(Empty));
+        mMask = capacity - 1;
+        for (unsigned int idx = 0; idx < positions.size(); ++idx) {
+            size_t slot = Hash(positions[idx]) & mMask;
+            while (Empty != mTable[slot]) {
+                slot = (slot + 1) & mMask;
+            }
+            mTable[slot] = idx;
+        }
+    }
+
+    bool mWithColors;
+    std::vector<unsigned int> mTable;
+    size_t mMask;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Store the welded vertices and faces in a mesh. Face normals can't be kept
+// for shared vertices, so the mesh gets none.
+static void SetupWeldedMesh(aiMesh* pMesh, VertexWelder& welder,
+    const std::vector<unsigned int>& indices, bool bHasColors) {
+    pMesh->mNumVertices = static_cast<unsigned int>(welder.positions.size());
+    pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+    ::memcpy(pMesh->mVertices, &welder.positions[0], pMesh->mNumVertices * sizeof(aiVector3D));
+    if (bHasColors) {
+        pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+        ::memcpy(pMesh->mColors[0], &welder.colors[0], pMesh->mNumVertices * sizeof(aiColor4D));
+    }
+
+    pMesh->mNumFaces = static_cast<unsigned int>(indices.size() / 3);
+    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i, p += 3) {
+        aiFace& face = pMesh->mFaces[i];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        face.mIndices[0] = indices[p];
+        face.mIndices[1] = indices[p + 1];
+        face.mIndices[2] = indices[p + 2];
+    }
+}
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -126,7 +249,8 @@ static bool IsAsciiSTL(const char* buffer, unsigned int fileSize) {
 STLImporter::STLImporter()
     : mBuffer(),
     fileSize(),
-    pScene()
+    pScene(),
+    mWeldVertices(false)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -158,6 +282,13 @@ const aiImporterDesc* STLImporter::GetInfo () const {
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties
+void STLImporter::SetupProperties(const Importer* pImp)
+{
+    mWeldVertices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, false);
+}
+
 void addFacesToMesh(aiMesh* pMesh)
 {
     pMesh->mFaces = new aiFace[pMesh->mNumFaces];
@@ -361,17 +492,28 @@ void STLImporter::LoadASCIIFile( aiNode *root ) {
             pMesh->mNumFaces = 0;
             throw DeadlyImportError("Normal buffer size does not match position buffer size");
         }
-        pMesh->mNumFaces = static_cast<unsigned int>(positionBuffer.size() / 3);
-        pMesh->mNumVertices = static_cast<unsigned int>(positionBuffer.size());
-        pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-        memcpy(pMesh->mVertices, &positionBuffer[0].x, pMesh->mNumVertices * sizeof(aiVector3D));
-        positionBuffer.clear();
-        pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-        memcpy(pMesh->mNormals, &normalBuffer[0].x, pMesh->mNumVertices * sizeof(aiVector3D));
-        normalBuffer.clear();
-
-        // now copy faces
-        addFacesToMesh(pMesh);
+        if (mWeldVertices) {
+            VertexWelder welder(positionBuffer.size() / 2, false);
+            std::vector<unsigned int> indices(positionBuffer.size());
+            for (size_t i = 0; i < positionBuffer.size(); ++i) {
+                indices[i] = welder.Add(positionBuffer[i], clrColorDefault);
+            }
+            SetupWeldedMesh(pMesh, welder, indices, false);
+            positionBuffer.clear();
+            normalBuffer.clear();
+        } else {
+            pMesh->mNumFaces = static_cast<unsigned int>(positionBuffer.size() / 3);
+            pMesh->mNumVertices = static_cast<unsigned int>(positionBuffer.size());
+            pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+            memcpy(pMesh->mVertices, &positionBuffer[0].x, pMesh->mNumVertices * sizeof(aiVector3D));
+            positionBuffer.clear();
+            pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
+            memcpy(pMesh->mNormals, &normalBuffer[0].x, pMesh->mNumVertices * sizeof(aiVector3D));
+            normalBuffer.clear();
+
+            // now copy faces
+            addFacesToMesh(pMesh);
+        }
 
         // assign the meshes to the current node
         pushMeshesToNode( meshIndices, node );
@@ -431,80 +573,106 @@ bool STLImporter::LoadBinaryFile()
     // now read the number of facets
     pScene->mRootNode->mName.Set("<STL_BINARY>");
 
-    pMesh->mNumFaces = *((uint32_t*)sz);
+    uint32_t numFaces;
+    ::memcpy(&numFaces, sz, sizeof(uint32_t));
     sz += 4;
 
-    if (fileSize < 84 + pMesh->mNumFaces*50) {
+    if ((uint64_t)fileSize < 84 + (uint64_t)numFaces * BinaryFacetSize) {
         throw DeadlyImportError("STL: file is too small to hold all facets");
     }
 
-    if (!pMesh->mNumFaces) {
+    if (!numFaces) {
         throw DeadlyImportError("STL: file is empty. There are no facets defined");
     }
 
-    pMesh->mNumVertices = pMesh->mNumFaces*3;
+    // the facets are decoded in blocks: the packed, unaligned records are
+    // copied to an aligned scratch buffer first, from which the compiler can
+    // move the coordinates with wide loads and stores.
+    static const unsigned int BlockSize = 256;
+    float block[BlockSize][12];
+    uint16_t attributes[BlockSize];
+    bool bHasColors = false;
+
+    if (mWeldVertices) {
+        // facet soups usually share each vertex between about six facets
+        VertexWelder welder(numFaces / 2 + 3, true);
+        std::vector<unsigned int> indices(numFaces * 3);
+        unsigned int* idx = &indices[0];
+
+        for (unsigned int first = 0; first < numFaces; first += BlockSize) {
+            const unsigned int count = std::min(BlockSize, numFaces - first);
+            for (unsigned int i = 0; i < count; ++i, sz += BinaryFacetSize) {
+                ::memcpy(block[i], sz, 12 * sizeof(float));
+                ::memcpy(&attributes[i], sz + 12 * sizeof(float), sizeof(uint16_t));
+            }
+
+            for (unsigned int i = 0; i < count; ++i) {
+                aiColor4D clr = clrColorDefault;
+                if (attributes[i] & (1 << 15)) {
+                    clr = DecodeFacetColor(attributes[i], bIsMaterialise);
+                    bHasColors = true;
+                }
+
+                // the face normal in block[i][0..2] can't be kept for shared vertices
+                for (unsigned int v = 3; v < 12; v += 3) {
+                    *idx++ = welder.Add(aiVector3D(block[i][v], block[i][v + 1], block[i][v + 2]), clr);
+                }
+            }
+        }
 
-    aiVector3D* vp,*vn;
-    vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-    vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
+        if (bHasColors) {
+            DefaultLogger::get()->info("STL: Mesh has vertex colors");
+        }
+        SetupWeldedMesh(pMesh, welder, indices, bHasColors);
+    } else {
+        pMesh->mNumFaces = numFaces;
+        pMesh->mNumVertices = pMesh->mNumFaces*3;
 
-    for (unsigned int i = 0; i < pMesh->mNumFaces;++i) {
+        aiVector3D* vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+        aiVector3D* vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-        // NOTE: Blender sometimes writes empty normals ... this is not
-        // our fault ... the RemoveInvalidData helper step should fix that
-        *vn = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
-        *(vn+1) = *vn;
-        *(vn+2) = *vn;
-        vn += 3;
+        for (unsigned int first = 0; first < numFaces; first += BlockSize) {
+            const unsigned int count = std::min(BlockSize, numFaces - first);
+            for (unsigned int i = 0; i < count; ++i, sz += BinaryFacetSize) {
+                ::memcpy(block[i], sz, 12 * sizeof(float));
+                ::memcpy(&attributes[i], sz + 12 * sizeof(float), sizeof(uint16_t));
+            }
 
-        *vp++ = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
+            for (unsigned int i = 0; i < count; ++i) {
+                const float* f = block[i];
 
-        *vp++ = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
+                // NOTE: Blender sometimes writes empty normals ... this is not
+                // our fault ... the RemoveInvalidData helper step should fix that
+                vn[0].Set(f[0], f[1], f[2]);
+                vn[2] = vn[1] = vn[0];
+                vn += 3;
 
-        *vp++ = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
+                vp[0].Set(f[3], f[4], f[5]);
+                vp[1].Set(f[6], f[7], f[8]);
+                vp[2].Set(f[9], f[10], f[11]);
+                vp += 3;
 
-        uint16_t color = *((uint16_t*)sz);
-        sz += 2;
+                if (attributes[i] & (1 << 15)) {
+                    // seems we need to take the color
+                    if (!bHasColors) {
+                        pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+                        std::fill(pMesh->mColors[0], pMesh->mColors[0] + pMesh->mNumVertices, clrColorDefault);
+                        bHasColors = true;
 
-        if (color & (1 << 15))
-        {
-            // seems we need to take the color
-            if (!pMesh->mColors[0])
-            {
-                pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int i = 0; i <pMesh->mNumVertices;++i)
-                    *pMesh->mColors[0]++ = this->clrColorDefault;
-                pMesh->mColors[0] -= pMesh->mNumVertices;
+                        DefaultLogger::get()->info("STL: Mesh has vertex colors");
+                    }
 
-                DefaultLogger::get()->info("STL: Mesh has vertex colors");
-            }
-            aiColor4D* clr = &pMesh->mColors[0][i*3];
-            clr->a = 1.0;
-            const ai_real invVal( (ai_real)1.0 / ( ai_real )31.0 );
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x31u) *invVal;
-                clr->g = ((color & (0x31u<<5))>>5u) *invVal;
-                clr->b = ((color & (0x31u<<10))>>10u) *invVal;
-            }
-            else
-            {
-                clr->b = (color & 0x31u) *invVal;
-                clr->g = ((color & (0x31u<<5))>>5u) *invVal;
-                clr->r = ((color & (0x31u<<10))>>10u) *invVal;
+                    // assign the color to all vertices of the face
+                    aiColor4D* clr = &pMesh->mColors[0][(first + i) * 3];
+                    clr[0] = DecodeFacetColor(attributes[i], bIsMaterialise);
+                    clr[2] = clr[1] = clr[0];
+                }
             }
-            // assign the color to all vertices of the face
-            *(clr+1) = *clr;
-            *(clr+2) = *clr;
         }
-    }
 
-    // now copy faces
-    addFacesToMesh(pMesh);
+        // now copy faces
+        addFacesToMesh(pMesh);
+    }
 
     // add all created meshes to the single node
     pScene->mRootNode->mNumMeshes = pScene->mNumMeshes;
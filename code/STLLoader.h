@@ -84,6 +84,13 @@ protected:
      */
     const aiImporterDesc* GetInfo () const;
 
+    /**
+     * @brief   Called prior to ReadFile().
+     * The function is a request to the importer to update its configuration
+     * basing on the Importer's configuration property list.
+     */
+    void SetupProperties(const Importer* pImp);
+
     /**
      * @brief   Imports the given file into the given scene structure.
     * See BaseImporter::InternReadFile() for details
@@ -117,6 +124,9 @@ protected:
 
     /** Default vertex color */
     aiColor4D clrColorDefault;
+
+    /** Weld identical vertices while loading, see #AI_CONFIG_IMPORT_STL_WELD_VERTICES */
+    bool mWeldVertices;
 };
 
 } // end of namespace Assimp
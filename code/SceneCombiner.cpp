@@ -1072,6 +1072,9 @@ void SceneCombiner::Copy( aiMesh** _dest, const aiMesh* src ) {
     // make a deep copy of all bones
     CopyPtrArray(dest->mBones,dest->mBones,dest->mNumBones);
 
+    // make a deep copy of all morph targets
+    CopyPtrArray(dest->mAnimMeshes,dest->mAnimMeshes,dest->mNumAnimMeshes);
+
     // make a deep copy of all faces
     GetArrayCopy(dest->mFaces,dest->mNumFaces);
     for (unsigned int i = 0; i < dest->mNumFaces;++i) {
@@ -1154,6 +1157,8 @@ void SceneCombiner::Copy( aiAnimation** _dest, const aiAnimation* src ) {
 
     // and reallocate all arrays
     CopyPtrArray( dest->mChannels, src->mChannels, dest->mNumChannels );
+    CopyPtrArray( dest->mMeshChannels, src->mMeshChannels, dest->mNumMeshChannels );
+    CopyPtrArray( dest->mMorphMeshChannels, src->mMorphMeshChannels, dest->mNumMorphMeshChannels );
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1173,6 +1178,65 @@ void SceneCombiner::Copy(aiNodeAnim** _dest, const aiNodeAnim* src) {
     GetArrayCopy( dest->mRotationKeys, dest->mNumRotationKeys );
 }
 
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiMeshAnim** _dest, const aiMeshAnim* src) {
+    if ( nullptr == _dest || nullptr == src ) {
+        return;
+    }
+
+    aiMeshAnim* dest = *_dest = new aiMeshAnim();
+
+    // get a flat copy
+    ::memcpy(dest,src,sizeof(aiMeshAnim));
+
+    // and reallocate all arrays
+    GetArrayCopy( dest->mKeys, dest->mNumKeys );
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiMeshMorphAnim** _dest, const aiMeshMorphAnim* src) {
+    if ( nullptr == _dest || nullptr == src ) {
+        return;
+    }
+
+    aiMeshMorphAnim* dest = *_dest = new aiMeshMorphAnim();
+
+    // get a flat copy
+    ::memcpy(dest,src,sizeof(aiMeshMorphAnim));
+
+    // and reallocate all arrays, the keys own their values and weights
+    GetArrayCopy( dest->mKeys, dest->mNumKeys );
+    for (unsigned int i = 0; i < dest->mNumKeys; ++i) {
+        aiMeshMorphKey& key = dest->mKeys[i];
+        GetArrayCopy( key.mValues,  key.mNumValuesAndWeights );
+        GetArrayCopy( key.mWeights, key.mNumValuesAndWeights );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiAnimMesh** _dest, const aiAnimMesh* src) {
+    if ( nullptr == _dest || nullptr == src ) {
+        return;
+    }
+
+    aiAnimMesh* dest = *_dest = new aiAnimMesh();
+
+    // get a flat copy
+    ::memcpy(dest,src,sizeof(aiAnimMesh));
+
+    // and reallocate all arrays
+    GetArrayCopy( dest->mVertices,   dest->mNumVertices );
+    GetArrayCopy( dest->mNormals ,   dest->mNumVertices );
+    GetArrayCopy( dest->mTangents,   dest->mNumVertices );
+    GetArrayCopy( dest->mBitangents, dest->mNumVertices );
+
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n)
+        GetArrayCopy( dest->mTextureCoords[n], dest->mNumVertices );
+
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n)
+        GetArrayCopy( dest->mColors[n], dest->mNumVertices );
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy( aiCamera** _dest,const  aiCamera* src) {
     if ( nullptr == _dest || nullptr == src ) {
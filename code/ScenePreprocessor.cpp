@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ScenePreprocessor.h"
+#include "BaseImporter.h"
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
@@ -48,13 +49,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 using namespace Assimp;
 
 // ---------------------------------------------------------------------------------------------
-void ScenePreprocessor::ProcessScene ()
+void ScenePreprocessor::ProcessScene (const BaseImporter* importer)
 {
     ai_assert(scene != NULL);
 
-    // Process all meshes
+    // Process all meshes, except for those the importer hasn't loaded yet
     for (unsigned int i = 0; i < scene->mNumMeshes;++i)
-        ProcessMesh(scene->mMeshes[i]);
+        if (!importer || !importer->IsMeshDeferred(i))
+            ProcessMesh(scene->mMeshes[i]);
 
     // - nothing to do for nodes for the moment
     // - nothing to do for textures for the moment
@@ -63,7 +65,8 @@ void ScenePreprocessor::ProcessScene ()
 
     // Process all animations
     for (unsigned int i = 0; i < scene->mNumAnimations;++i)
-        ProcessAnimation(scene->mAnimations[i]);
+        if (!importer || !importer->IsAnimationDeferred(i))
+            ProcessAnimation(scene->mAnimations[i]);
 
     // Generate a default material if none was specified
     if (!scene->mNumMaterials && scene->mNumMeshes) {
@@ -90,6 +93,20 @@ void ScenePreprocessor::ProcessScene ()
     }
 }
 
+// ---------------------------------------------------------------------------------------------
+void ScenePreprocessor::ProcessDeferredMesh (unsigned int index)
+{
+    ai_assert(scene != NULL && index < scene->mNumMeshes);
+    ProcessMesh(scene->mMeshes[index]);
+}
+
+// ---------------------------------------------------------------------------------------------
+void ScenePreprocessor::ProcessDeferredAnimation (unsigned int index)
+{
+    ai_assert(scene != NULL && index < scene->mNumAnimations);
+    ProcessAnimation(scene->mAnimations[index]);
+}
+
 // ---------------------------------------------------------------------------------------------
 void ScenePreprocessor::ProcessMesh (aiMesh* mesh)
 {
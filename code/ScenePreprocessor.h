@@ -54,6 +54,8 @@ struct aiMesh;
 class ScenePreprocessorTest;
 namespace Assimp    {
 
+class BaseImporter;
+
 // ----------------------------------------------------------------------------------
 /** ScenePreprocessor: Preprocess a scene before any post-processing
  *  steps are executed.
@@ -94,8 +96,26 @@ public:
 
     // ----------------------------------------------------------------
     /** Preprocess the current scene
+     *  @param importer Importer which loaded the scene. Meshes and
+     *    animations whose data it deferred are left out, they are
+     *    preprocessed by ProcessDeferredMesh() and ProcessDeferredAnimation()
+     *    once loaded. Pass NULL to preprocess everything.
+     */
+    void ProcessScene (const BaseImporter* importer = NULL);
+
+    // ----------------------------------------------------------------
+    /** Preprocess a mesh of the current scene whose data was deferred
+     *  by the importer and is loaded now.
+     *  @param index Index of the mesh in aiScene::mMeshes
+     */
+    void ProcessDeferredMesh (unsigned int index);
+
+    // ----------------------------------------------------------------
+    /** Preprocess an animation of the current scene whose data was
+     *  deferred by the importer and is loaded now.
+     *  @param index Index of the animation in aiScene::mAnimations
      */
-    void ProcessScene ();
+    void ProcessDeferredAnimation (unsigned int index);
 
 protected:
 
@@ -45,17 +45,58 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_SCENEPRIVATE_H_INCLUDED
 
 #include <assimp/scene.h>
+#include <memory>
+#include <vector>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#endif
 
 namespace Assimp    {
 
 class Importer;
 
+// Facts the exporter has verified about a single mesh. They are trusted as
+// long as the mesh keeps its face array and its element counts.
+struct MeshFacts {
+
+    MeshFacts()
+        : mMesh()
+        , mFaces()
+        , mNumFaces()
+        , mNumVertices()
+        , mVerbose()
+    {}
+
+    MeshFacts(const aiMesh* mesh, bool verbose)
+        : mMesh(mesh)
+        , mFaces(mesh->mFaces)
+        , mNumFaces(mesh->mNumFaces)
+        , mNumVertices(mesh->mNumVertices)
+        , mVerbose(verbose)
+    {}
+
+    bool Matches(const aiMesh* mesh) const {
+        return mMesh == mesh && mFaces == mesh->mFaces
+            && mNumFaces == mesh->mNumFaces && mNumVertices == mesh->mNumVertices;
+    }
+
+    const aiMesh* mMesh;
+    const aiFace* mFaces;
+    unsigned int mNumFaces;
+    unsigned int mNumVertices;
+
+    // true if no vertex is referenced by more than one face index
+    bool mVerbose;
+};
+
 struct ScenePrivateData {
 
     ScenePrivateData()
         : mOrigImporter()
         , mPPStepsApplied()
         , mIsCopy()
+        , mPreparedSteps()
     {}
 
     // Importer that originally loaded the scene though the C-API
@@ -71,6 +112,20 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Per-mesh facts collected by the exporter, indexed like mMeshes.
+    std::vector<MeshFacts> mMeshFacts;
+
+    // Copy of the scene with the export post-processing applied, kept
+    // for further exports (see AI_CONFIG_EXPORT_REUSE_PREPARED_SCENE),
+    // and the post-processing steps it was prepared with.
+    std::shared_ptr<const aiScene> mPreparedScene;
+    unsigned int mPreparedSteps;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // Guards the exporter's caches above, the scene itself stays const.
+    std::mutex mExportMutex;
+#endif
 };
 
 // Access private data stored in the scene
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Bitmap.h"
 #include "BaseImporter.h"
 #include "fast_atof.h"
+#include "StringUtils.h"
 #include <assimp/SceneCombiner.h>
 #include <iostream>
 #include <ctime>
@@ -100,17 +101,17 @@ void ExportSceneStep(const char* pFile,IOSystem* pIOSystem, const aiScene* pScen
     // create/copy Properties
     ExportProperties props(*pProperties);
 
-    // invoke the exporter
-    StepExporter iDoTheExportThing( pScene, pIOSystem, path, file, &props);
-
-    // we're still here - export successfully completed. Write result to the given IOSYstem
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .stp file: " + std::string(pFile));
     }
 
-    // XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-    outfile->Write( iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()),1);
+    // invoke the exporter
+    StepExporter iDoTheExportThing( pScene, pIOSystem, path, file, &props, outfile.get());
+
+    if (iDoTheExportThing.mOutput.flush().fail()) {
+        throw DeadlyExportError("could not write output .stp file: " + std::string(pFile));
+    }
 }
 
 } // end of namespace Assimp
@@ -140,8 +141,8 @@ namespace {
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
 StepExporter::StepExporter(const aiScene* pScene, IOSystem* pIOSystem, const std::string& path,
-		const std::string& file, const ExportProperties* pProperties):
-				 mProperties(pProperties),mIOSystem(pIOSystem),mFile(file), mPath(path),
+		const std::string& file, const ExportProperties* pProperties, IOStream* pOutput):
+				 mOutput(pOutput), mProperties(pProperties),mIOSystem(pIOSystem),mFile(file), mPath(path),
 				 mScene(pScene), endstr(";\n") {
 	CollectTrafos(pScene->mRootNode, trafos);
 	CollectMeshes(pScene->mRootNode, meshes);
@@ -202,7 +203,9 @@ void StepExporter::WriteFile()
     static const unsigned int date_nb_chars = 20;
     char date_str[date_nb_chars];
     std::time_t date = std::time(NULL);
-    std::strftime(date_str, date_nb_chars, "%Y-%m-%dT%H:%M:%S", std::localtime(&date));
+    std::tm local;
+    ai_localtime(&date, &local);
+    std::strftime(date_str, date_nb_chars, "%Y-%m-%dT%H:%M:%S", &local);
 
     // write the header
     mOutput << "ISO-10303-21" << endstr;
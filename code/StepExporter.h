@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/matrix4x4.h>
 #include <assimp/Exporter.hpp>
+#include "IOStreamWriter.h"
 #include <sstream>
 
 
@@ -65,7 +66,7 @@ class StepExporter
 {
 public:
     /// Constructor for a specific scene to export
-    StepExporter(const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, const ExportProperties* pProperties);
+    StepExporter(const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, const ExportProperties* pProperties, IOStream* pOutput);
 
 protected:
     /// Starts writing the contents
@@ -73,8 +74,8 @@ protected:
 
 public:
 
-    /// Stringstream to write all output into
-    std::stringstream mOutput;
+    /// Stream to write all output into, it passes the data on to the output file
+    IOStreamWriter mOutput;
 
 protected:
 
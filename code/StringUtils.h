@@ -44,6 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 #include <stdarg.h>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
 
 ///	@fn		ai_snprintf
 ///	@brief	The portable version of the function snprintf ( C99 standard ), which works on visual studio compilers 2013 and earlier.
@@ -81,6 +83,52 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #   define ai_snprintf snprintf
 #endif
 
+///	@fn		ai_gmtime
+///	@brief	The reentrant version of gmtime(), which may be called from several exporters at once.
+///	@param	timer		The time to convert
+///	@param	result		Receives the broken-down UTC time
+///	@return	true on success.
+inline bool ai_gmtime( const std::time_t *timer, std::tm *result ) {
+#if defined(_MSC_VER)
+    return 0 == gmtime_s( result, timer );
+#elif defined(_WIN32)
+    // the CRT keeps the buffer of gmtime() per thread
+    const std::tm *p = gmtime( timer );
+    return nullptr != p && ( *result = *p, true );
+#else
+    return nullptr != gmtime_r( timer, result );
+#endif
+}
+
+///	@fn		ai_localtime
+///	@brief	The reentrant version of localtime(), see ai_gmtime().
+inline bool ai_localtime( const std::time_t *timer, std::tm *result ) {
+#if defined(_MSC_VER)
+    return 0 == localtime_s( result, timer );
+#elif defined(_WIN32)
+    const std::tm *p = localtime( timer );
+    return nullptr != p && ( *result = *p, true );
+#else
+    return nullptr != localtime_r( timer, result );
+#endif
+}
+
+///	@fn		ai_asctime
+///	@brief	The reentrant version of asctime(), see ai_gmtime().
+///	@param	time		The broken-down time
+///	@param	buffer		Receives the text, at least 26 characters long
+///	@return	buffer
+inline char *ai_asctime( const std::tm *time, char ( &buffer )[ 26 ] ) {
+#if defined(_MSC_VER)
+    asctime_s( buffer, sizeof( buffer ), time );
+#elif defined(_WIN32)
+    strcpy( buffer, asctime( time ) );
+#else
+    asctime_r( time, buffer );
+#endif
+    return buffer;
+}
+
 template <typename T>
 inline
 std::string to_string( T value ) {
@@ -63,6 +63,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "PolyTools.h"
 #include <memory>
+#include <algorithm>
 
 //#define AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
 //#define AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -72,8 +73,201 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define POLY_GRID_XPAD 20
 #define POLY_OUTPUT_FILE "assimp_polygons_debug.txt"
 
+// Polygons with at least this many vertices are triangulated with the
+// z-order accelerated ear clipping
+#define POLY_ZORDER_THRESHOLD 64
+
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Interleave the bits of two 16 bit coordinates to get their position on a z-order curve
+inline uint32_t ZOrder(uint32_t x, uint32_t y)
+{
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+
+    y = (y | (y << 8)) & 0x00FF00FF;
+    y = (y | (y << 4)) & 0x0F0F0F0F;
+    y = (y | (y << 2)) & 0x33333333;
+    y = (y | (y << 1)) & 0x55555555;
+
+    return x | (y << 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Ear clipping for large polygons.
+ *
+ *  The remaining vertices are kept in a second list sorted by their position
+ *  on a z-order curve. A vertex can only lie inside an ear candidate if its
+ *  z-order key lies between the keys of the corners of the candidate's bounding
+ *  box, so only the vertices close to the ear are tested instead of all of
+ *  them. The ear and containment tests are the same as for small polygons.
+ */
+class ZOrderEarClipper
+{
+public:
+    ZOrderEarClipper(const aiVector2D* pts, int num)
+        : pts(pts), num(num), sign(1.0)
+        , prev(num), next(num), prevZ(num), nextZ(num), z(num)
+    {
+        aiVector2D vmax = pts[0];
+        vmin = pts[0];
+        double area = 0.0;
+        for (int i = 0; i < num; ++i) {
+            prev[i] = i ? i - 1 : num - 1;
+            next[i] = i + 1 < num ? i + 1 : 0;
+
+            vmin.x = std::min(vmin.x, pts[i].x);
+            vmin.y = std::min(vmin.y, pts[i].y);
+            vmax.x = std::max(vmax.x, pts[i].x);
+            vmax.y = std::max(vmax.y, pts[i].y);
+
+            const aiVector2D& n = pts[next[i]];
+            // same orientation as GetArea2D()
+            area += (double)n.x * pts[i].y - (double)pts[i].x * n.y;
+        }
+
+        // convex corners turn the same way as the whole polygon
+        if (area < 0.0) {
+            sign = -1.0;
+        }
+
+        const ai_real extent = std::max(vmax.x - vmin.x, vmax.y - vmin.y);
+        scale = extent > 0 ? (ai_real)32767.0 / extent : (ai_real)0.0;
+
+        std::vector<int> order(num);
+        for (int i = 0; i < num; ++i) {
+            z[i] = Key(pts[i]);
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), ZLess(z));
+        for (int i = 0; i < num; ++i) {
+            prevZ[order[i]] = i ? order[i - 1] : -1;
+            nextZ[order[i]] = i + 1 < num ? order[i + 1] : -1;
+        }
+    }
+
+    // Emit the triangles (with indices relative to the polygon), returns false
+    // if no ear was found in a full loop around the remaining vertices.
+    bool Run(aiFace*& curOut)
+    {
+        int remaining = num, ear = 0, stop = 0;
+        while (remaining > 3) {
+            const int p = prev[ear], n = next[ear];
+            if (IsEar(ear)) {
+                Emit(curOut, p, ear, n);
+                Remove(ear);
+                --remaining;
+
+                // skipping the next vertex leads to fewer sliver triangles
+                ear = stop = next[n];
+                continue;
+            }
+
+            ear = n;
+            if (ear == stop) {
+                return false;
+            }
+        }
+        Emit(curOut, prev[ear], ear, next[ear]);
+        return true;
+    }
+
+private:
+
+    struct ZLess {
+        explicit ZLess(const std::vector<uint32_t>& z) : z(z) {}
+        bool operator()(int a, int b) const { return z[a] < z[b]; }
+        const std::vector<uint32_t>& z;
+    };
+
+    uint32_t Key(const aiVector2D& v) const
+    {
+        return ZOrder(static_cast<uint32_t>((v.x - vmin.x) * scale), static_cast<uint32_t>((v.y - vmin.y) * scale));
+    }
+
+    bool IsEar(int ear) const
+    {
+        const int a = prev[ear], c = next[ear];
+        const aiVector2D &p0 = pts[a], &p1 = pts[ear], &p2 = pts[c];
+
+        // Must be a convex point
+        if (GetArea2D(p0, p1, p2) * sign < 0) {
+            return false;
+        }
+
+        // and no other point may be contained in this triangle
+        aiVector2D tmin(std::min(p0.x, std::min(p1.x, p2.x)), std::min(p0.y, std::min(p1.y, p2.y)));
+        aiVector2D tmax(std::max(p0.x, std::max(p1.x, p2.x)), std::max(p0.y, std::max(p1.y, p2.y)));
+        const uint32_t minZ = Key(tmin), maxZ = Key(tmax);
+
+        for (int i = nextZ[ear]; i != -1 && z[i] <= maxZ; i = nextZ[i]) {
+            if (Blocks(i, a, ear, c, tmin, tmax)) {
+                return false;
+            }
+        }
+        for (int i = prevZ[ear]; i != -1 && z[i] >= minZ; i = prevZ[i]) {
+            if (Blocks(i, a, ear, c, tmin, tmax)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Blocks(int i, int a, int b, int c, const aiVector2D& tmin, const aiVector2D& tmax) const
+    {
+        // the z-order range also covers points outside of the bounding box
+        const aiVector2D& v = pts[i];
+        if (v.x < tmin.x || v.y < tmin.y || v.x > tmax.x || v.y > tmax.y) {
+            return false;
+        }
+
+        // compare the actual values because multiple indexes in the polygon may
+        // refer to the same position, see TriangulateMesh()
+        return i != a && i != c && v != pts[a] && v != pts[b] && v != pts[c] &&
+            PointInTriangle2D(pts[a], pts[b], pts[c], v);
+    }
+
+    void Remove(int i)
+    {
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+
+        if (prevZ[i] != -1) {
+            nextZ[prevZ[i]] = nextZ[i];
+        }
+        if (nextZ[i] != -1) {
+            prevZ[nextZ[i]] = prevZ[i];
+        }
+    }
+
+    static void Emit(aiFace*& curOut, int a, int b, int c)
+    {
+        aiFace& nface = *curOut++;
+        nface.mNumIndices = 3;
+        if (!nface.mIndices) {
+            nface.mIndices = new unsigned int[3];
+        }
+        nface.mIndices[0] = a;
+        nface.mIndices[1] = b;
+        nface.mIndices[2] = c;
+    }
+
+    const aiVector2D* pts;
+    int num;
+    double sign;
+    aiVector2D vmin;
+    ai_real scale;
+    std::vector<int> prev, next, prevZ, nextZ;
+    std::vector<uint32_t> z;
+};
+
+} // !anon namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 TriangulateProcess::TriangulateProcess()
@@ -354,6 +548,20 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
             fprintf(fout,"\ntriangulation sequence: ");
 #endif
 
+            if (max >= POLY_ZORDER_THRESHOLD) {
+                // Large polygons - floor plates or terrain outlines from CAD formats -
+                // only test the vertices close to each ear candidate.
+                ZOrderEarClipper clipper(&temp_verts[0], max);
+                if (!clipper.Run(curOut)) {
+                    DefaultLogger::get()->error("Failed to triangulate polygon (no ear found). Probably not a simple polygon?");
+
+#ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
+                    fprintf(fout,"critical error here, no ear found! ");
+#endif
+                }
+                num = 0;
+            }
+
             //
             // FIXME: currently this is the slow O(kn) variant with a worst case
             // complexity of O(n^2) (I think). Can be done in O(n).
@@ -482,30 +690,32 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
 #endif
 
-        for(aiFace* f = last_face; f != curOut; ) {
+        // compact in a single pass, shifting the remaining faces for
+        // every dropped one is quadratic for large polygons
+        aiFace* dst = last_face;
+        for(aiFace* f = last_face; f != curOut; ++f) {
             unsigned int* i = f->mIndices;
 
             //  drop dumb 0-area triangles
             if (std::fabs(GetArea2D(temp_verts[i[0]],temp_verts[i[1]],temp_verts[i[2]])) < 1e-5f) {
                 DefaultLogger::get()->debug("Dropping triangle with area 0");
-                --curOut;
 
                 delete[] f->mIndices;
                 f->mIndices = NULL;
-
-                for(aiFace* ff = f; ff != curOut; ++ff) {
-                    ff->mNumIndices = (ff+1)->mNumIndices;
-                    ff->mIndices = (ff+1)->mIndices;
-                    (ff+1)->mIndices = NULL;
-                }
                 continue;
             }
 
             i[0] = idx[i[0]];
             i[1] = idx[i[1]];
             i[2] = idx[i[2]];
-            ++f;
+            if (dst != f) {
+                dst->mNumIndices = f->mNumIndices;
+                dst->mIndices = f->mIndices;
+                f->mIndices = NULL;
+            }
+            ++dst;
         }
+        curOut = dst;
 
         delete[] face.mIndices;
         face.mIndices = NULL;
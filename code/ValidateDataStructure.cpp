@@ -554,7 +554,27 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation)
             Validate(pAnimation, pAnimation->mChannels[i]);
         }
     }
-    else ReportError("aiAnimation::mNumChannels is 0. At least one node animation channel must be there.");
+    else if (!pAnimation->mNumMorphMeshChannels) {
+        ReportError("aiAnimation::mNumChannels is 0. At least one node animation channel must be there.");
+    }
+
+    // morph animations may come without any node animation channel
+    if (pAnimation->mNumMorphMeshChannels)
+    {
+        if (!pAnimation->mMorphMeshChannels) {
+            ReportError("aiAnimation::mMorphMeshChannels is NULL (aiAnimation::mNumMorphMeshChannels is %i)",
+                pAnimation->mNumMorphMeshChannels);
+        }
+        for (unsigned int i = 0; i < pAnimation->mNumMorphMeshChannels;++i)
+        {
+            if (!pAnimation->mMorphMeshChannels[i])
+            {
+                ReportError("aiAnimation::mMorphMeshChannels[%i] is NULL (aiAnimation::mNumMorphMeshChannels is %i)",
+                    i, pAnimation->mNumMorphMeshChannels);
+            }
+            Validate(pAnimation, pAnimation->mMorphMeshChannels[i]);
+        }
+    }
 
     // Animation duration is allowed to be zero in cases where the anim contains only a single key frame.
     // if (!pAnimation->mDuration)this->ReportError("aiAnimation::mDuration is zero");
@@ -796,6 +816,47 @@ void ValidateDSProcess::Validate( const aiTexture* pTexture)
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
+     const aiMeshMorphAnim* pMorphAnim)
+{
+    Validate(&pMorphAnim->mName);
+
+    if (!pMorphAnim->mNumKeys)
+        ReportError("Empty morph mesh animation channel");
+
+    if (!pMorphAnim->mKeys)
+    {
+        ReportError("aiMeshMorphAnim::mKeys is NULL (aiMeshMorphAnim::mNumKeys is %i)",
+            pMorphAnim->mNumKeys);
+    }
+    double dLast = -10e10;
+    for (unsigned int i = 0; i < pMorphAnim->mNumKeys;++i)
+    {
+        const aiMeshMorphKey& key = pMorphAnim->mKeys[i];
+        if (key.mNumValuesAndWeights && (!key.mValues || !key.mWeights))
+        {
+            ReportError("aiMeshMorphAnim::mKeys[%i] has no values or weights "
+                "(aiMeshMorphKey::mNumValuesAndWeights is %i)",i,key.mNumValuesAndWeights);
+        }
+        if (pAnimation->mDuration > 0. && key.mTime > pAnimation->mDuration+0.001)
+        {
+            ReportError("aiMeshMorphAnim::mKeys[%i].mTime (%.5f) is larger "
+                "than aiAnimation::mDuration (which is %.5f)",i,
+                (float)key.mTime,
+                (float)pAnimation->mDuration);
+        }
+        if (i && key.mTime <= dLast)
+        {
+            ReportWarning("aiMeshMorphAnim::mKeys[%i].mTime (%.5f) is smaller "
+                "than aiMeshMorphAnim::mKeys[%i] (which is %.5f)",i,
+                (float)key.mTime,
+                i-1, (float)dLast);
+        }
+        dLast = key.mTime;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
      const aiNodeAnim* pNodeAnim)
@@ -53,6 +53,7 @@ struct aiBone;
 struct aiMesh;
 struct aiAnimation;
 struct aiNodeAnim;
+struct aiMeshMorphAnim;
 struct aiTexture;
 struct aiMaterial;
 struct aiNode;
@@ -148,6 +149,13 @@ protected:
     void Validate( const aiAnimation* pAnimation,
         const aiNodeAnim* pBoneAnim);
 
+    // -------------------------------------------------------------------
+    /** Validates a morph mesh animation channel
+     * @param pAnimation Animation channel.
+     * @param pMorphAnim Input morph animation */
+    void Validate( const aiAnimation* pAnimation,
+        const aiMeshMorphAnim* pMorphAnim);
+
     // -------------------------------------------------------------------
     /** Validates a node and all of its subnodes
      * @param Node Input node*/
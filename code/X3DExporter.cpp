@@ -11,6 +11,7 @@
 // Header files, Assimp.
 #include "Exceptional.h"
 #include "StringUtils.h"
+#include "fast_ftoa.h"
 #include <assimp/Exporter.hpp>
 #include <assimp/IOSystem.hpp>
 
@@ -46,7 +47,7 @@ void X3DExporter::IndentationStringSet(const size_t pNewLevel)
 void X3DExporter::XML_Write(const string& pData)
 {
 	if(pData.size() == 0) return;
-	if(mOutFile->Write((void*)pData.data(), pData.length(), 1) != 1) throw DeadlyExportError("Failed to write scene data!");
+	if(!mOutput->write(pData.data(), pData.length())) throw DeadlyExportError("Failed to write scene data!");
 }
 
 aiMatrix4x4 X3DExporter::Matrix_GlobalToCurrent(const aiNode& pNode) const
@@ -75,69 +76,63 @@ aiMatrix4x4 out_matr;
 
 void X3DExporter::AttrHelper_FloatToString(const float pValue, std::string& pTargetString)
 {
-	pTargetString = to_string(pValue);
-	AttrHelper_CommaToPoint(pTargetString);
+char buf[AI_FTOA_MAX_CHARS];
+
+	pTargetString.assign(buf, fast_ftoa(pValue, buf));
 }
 
-void X3DExporter::AttrHelper_Vec3DArrToString(const aiVector3D* pArray, const size_t pArray_Size, string& pTargetString)
+void X3DExporter::AttrHelper_RealArrToString(const ai_real* pArray, const size_t pArray_Size, std::string& pTargetString)
 {
-	pTargetString.clear();
-	pTargetString.reserve(pArray_Size * 6);// (Number + space) * 3.
-	for(size_t idx = 0; idx < pArray_Size; idx++)
-		pTargetString.append(to_string(pArray[idx].x) + " " + to_string(pArray[idx].y) + " " + to_string(pArray[idx].z) + " ");
+	// format in place, then cut the string to the written size.
+	pTargetString.resize(pArray_Size * AI_FTOA_MAX_CHARS);
+	char* end = fast_ftoa_n(pArray, pArray_Size, ' ', &pTargetString[0]);
+	pTargetString.resize(end - pTargetString.data());
+}
 
-	// remove last space symbol.
-	pTargetString.resize(pTargetString.length() - 1);
-	AttrHelper_CommaToPoint(pTargetString);
+void X3DExporter::AttrHelper_Vec3DArrToString(const aiVector3D* pArray, const size_t pArray_Size, string& pTargetString)
+{
+	AttrHelper_RealArrToString(&pArray->x, pArray_Size * 3, pTargetString);
 }
 
 void X3DExporter::AttrHelper_Vec2DArrToString(const aiVector2D* pArray, const size_t pArray_Size, std::string& pTargetString)
 {
-	pTargetString.clear();
-	pTargetString.reserve(pArray_Size * 4);// (Number + space) * 2.
+	pTargetString.resize(pArray_Size * 2 * AI_FTOA_MAX_CHARS);
+	char* end = &pTargetString[0];
 	for(size_t idx = 0; idx < pArray_Size; idx++)
-		pTargetString.append(to_string(pArray[idx].x) + " " + to_string(pArray[idx].y) + " ");
+	{
+		// aiVector2D is packed, its members can't be addressed as ai_real.
+		const ai_real xy[2] = { pArray[idx].x, pArray[idx].y };
 
-	// remove last space symbol.
-	pTargetString.resize(pTargetString.length() - 1);
-	AttrHelper_CommaToPoint(pTargetString);
+		if(idx > 0) *end++ = ' ';
+
+		end = fast_ftoa_n(xy, 2, ' ', end);
+	}
+
+	pTargetString.resize(end - pTargetString.data());
 }
 
 void X3DExporter::AttrHelper_Vec3DAsVec2fArrToString(const aiVector3D* pArray, const size_t pArray_Size, string& pTargetString)
 {
-	pTargetString.clear();
-	pTargetString.reserve(pArray_Size * 4);// (Number + space) * 2.
+	pTargetString.resize(pArray_Size * 2 * AI_FTOA_MAX_CHARS);
+	char* end = &pTargetString[0];
 	for(size_t idx = 0; idx < pArray_Size; idx++)
-		pTargetString.append(to_string(pArray[idx].x) + " " + to_string(pArray[idx].y) + " ");
+	{
+		if(idx > 0) *end++ = ' ';
 
-	// remove last space symbol.
-	pTargetString.resize(pTargetString.length() - 1);
-	AttrHelper_CommaToPoint(pTargetString);
+		end = fast_ftoa_n(&pArray[idx].x, 2, ' ', end);
+	}
+
+	pTargetString.resize(end - pTargetString.data());
 }
 
 void X3DExporter::AttrHelper_Col4DArrToString(const aiColor4D* pArray, const size_t pArray_Size, string& pTargetString)
 {
-	pTargetString.clear();
-	pTargetString.reserve(pArray_Size * 8);// (Number + space) * 4.
-	for(size_t idx = 0; idx < pArray_Size; idx++)
-		pTargetString.append(to_string(pArray[idx].r) + " " + to_string(pArray[idx].g) + " " + to_string(pArray[idx].b) + " " +
-								to_string(pArray[idx].a) + " ");
-
-	// remove last space symbol.
-	pTargetString.resize(pTargetString.length() - 1);
-	AttrHelper_CommaToPoint(pTargetString);
+	AttrHelper_RealArrToString(&pArray->r, pArray_Size * 4, pTargetString);
 }
 
 void X3DExporter::AttrHelper_Col3DArrToString(const aiColor3D* pArray, const size_t pArray_Size, std::string& pTargetString)
 {
-	pTargetString.clear();
-	pTargetString.reserve(pArray_Size * 6);// (Number + space) * 3.
-	for(size_t idx = 0; idx < pArray_Size; idx++)
-		pTargetString.append(to_string(pArray[idx].r) + " " + to_string(pArray[idx].g) + " " + to_string(pArray[idx].b) + " ");
-
-	// remove last space symbol.
-	pTargetString.resize(pTargetString.length() - 1);
-	AttrHelper_CommaToPoint(pTargetString);
+	AttrHelper_RealArrToString(&pArray->r, pArray_Size * 3, pTargetString);
 }
 
 void X3DExporter::AttrHelper_Color3ToAttrList(std::list<SAttribute>& pList, const std::string& pName, const aiColor3D& pValue, const aiColor3D& pDefaultValue)
@@ -215,18 +210,19 @@ list<SAttribute> attr_list;
 	{
 		auto Vector2String = [this](const aiVector3D pVector) -> string
 		{
-			string tstr = to_string(pVector.x) + " " + to_string(pVector.y) + " " + to_string(pVector.z);
+			string tstr;
 
-			AttrHelper_CommaToPoint(tstr);
+			AttrHelper_Vec3DArrToString(&pVector, 1, tstr);
 
 			return tstr;
 		};
 
 		auto Rotation2String = [this](const aiVector3D pAxis, const ai_real pAngle) -> string
 		{
-			string tstr = to_string(pAxis.x) + " " + to_string(pAxis.y) + " " + to_string(pAxis.z) + " " + to_string(pAngle);
+			const ai_real rotation[4] = { pAxis.x, pAxis.y, pAxis.z, pAngle };
+			string tstr;
 
-			AttrHelper_CommaToPoint(tstr);
+			AttrHelper_RealArrToString(rotation, 4, tstr);
 
 			return tstr;
 		};
@@ -574,18 +570,21 @@ list<SAttribute> attr_list;
 void X3DExporter::Export_MetadataDouble(const aiString& pKey, const double pValue, const size_t pTabLevel)
 {
 list<SAttribute> attr_list;
+char buf[AI_FTOA_MAX_CHARS];
 
 	attr_list.push_back({"name", pKey.C_Str()});
-	attr_list.push_back({"value", to_string(pValue)});
+	attr_list.push_back({"value", string(buf, fast_ftoa(pValue, buf))});
 	NodeHelper_OpenNode("MetadataDouble", pTabLevel, true, attr_list);
 }
 
 void X3DExporter::Export_MetadataFloat(const aiString& pKey, const float pValue, const size_t pTabLevel)
 {
 list<SAttribute> attr_list;
+string tstr;
 
+	AttrHelper_FloatToString(pValue, tstr);
 	attr_list.push_back({"name", pKey.C_Str()});
-	attr_list.push_back({"value", to_string(pValue)});
+	attr_list.push_back({"value", tstr});
 	NodeHelper_OpenNode("MetadataFloat", pTabLevel, true, attr_list);
 }
 
@@ -704,6 +703,7 @@ list<SAttribute> attr_list;
 	mOutFile = pIOSystem->Open(pFileName, "wt");
 	if(mOutFile == nullptr) throw DeadlyExportError("Could not open output .x3d file: " + string(pFileName));
 
+	mOutput.reset(new IOStreamWriter(mOutFile));
 	// Begin document
 	XML_Write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
 	XML_Write("<!DOCTYPE X3D PUBLIC \"ISO//Web3D//DTD X3D 3.3//EN\" \"http://www.web3d.org/specifications/x3d-3.3.dtd\">\n");
@@ -725,8 +725,11 @@ list<SAttribute> attr_list;
 	// Close Root node.
 	NodeHelper_CloseNode("X3D", 0);
 	// Cleanup
+	const bool failed = mOutput->flush().fail();
+	mOutput.reset();
 	pIOSystem->Close(mOutFile);
 	mOutFile = nullptr;
+	if(failed) throw DeadlyExportError("Failed to write scene data!");
 }
 
 }// namespace Assimp
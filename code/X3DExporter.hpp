@@ -12,9 +12,11 @@
 #include <assimp/Exporter.hpp>
 #include <assimp/material.h>
 #include <assimp/scene.h>
+#include "IOStreamWriter.h"
 
 // Header files, stdlib.
 #include <list>
+#include <memory>
 #include <string>
 
 namespace Assimp
@@ -68,6 +70,7 @@ class X3DExporter
 	/***********************************************/
 
 	IOStream* mOutFile;
+	std::unique_ptr<IOStreamWriter> mOutput;///< Buffered writer over \ref mOutFile, collects the small XML pieces into larger writes.
 	std::map<size_t, std::string> mDEF_Map_Mesh;
 	std::map<size_t, std::string> mDEF_Map_Material;
 
@@ -95,17 +98,19 @@ private:
 	/// \return calculated matrix.
 	aiMatrix4x4 Matrix_GlobalToCurrent(const aiNode& pNode) const;
 
-	/// \fn void AttrHelper_CommaToPoint(std::string& pStringWithComma)
-	/// Convert commas in string to points. That's needed because "std::to_string" result depends on locale (regional settings).
-	/// \param [in, out] pStringWithComma - reference to string, which must be modified.
-	void AttrHelper_CommaToPoint(std::string& pStringWithComma) { for(char& c: pStringWithComma) { if(c == ',') c = '.'; } }
-
 	/// \fn void AttrHelper_FloatToString(const float pValue, std::string& pTargetString)
 	/// Converts float to string.
 	/// \param [in] pValue - value for converting.
 	/// \param [out] pTargetString - reference to string where result will be placed. Will be cleared before using.
 	void AttrHelper_FloatToString(const float pValue, std::string& pTargetString);
 
+	/// \fn void AttrHelper_RealArrToString(const ai_real* pArray, const size_t pArray_Size, std::string& pTargetString)
+	/// Converts array of numbers to string. Numbers are separated by spaces and written independent of the locale.
+	/// \param [in] pArray - pointer to array of numbers.
+	/// \param [in] pArray_Size - count of elements in array.
+	/// \param [out] pTargetString - reference to string where result will be placed. Will be cleared before using.
+	void AttrHelper_RealArrToString(const ai_real* pArray, const size_t pArray_Size, std::string& pTargetString);
+
 	/// \fn void AttrHelper_Vec3DArrToString(const aiVector3D* pArray, const size_t pArray_Size, std::string& pTargetString)
 	/// Converts array of vectors to string.
 	/// \param [in] pArray - pointer to array of vectors.
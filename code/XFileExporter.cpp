@@ -77,21 +77,17 @@ void ExportSceneXFile(const char* pFile,IOSystem* pIOSystem, const aiScene* pSce
     // set standard properties if not set
     if (!props.HasPropertyBool(AI_CONFIG_EXPORT_XFILE_64BIT)) props.SetPropertyBool(AI_CONFIG_EXPORT_XFILE_64BIT, false);
 
-    // invoke the exporter
-    XFileExporter iDoTheExportThing( pScene, pIOSystem, path, file, &props);
-
-    if (iDoTheExportThing.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-    
-    // we're still here - export successfully completed. Write result to the given IOSYstem
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .x file: " + std::string(pFile));
     }
 
-    // XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-    outfile->Write( iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()),1);
+    // invoke the exporter
+    XFileExporter iDoTheExportThing( pScene, pIOSystem, path, file, &props, outfile.get());
+
+    if (iDoTheExportThing.mOutput.flush().fail()) {
+        throw DeadlyExportError("could not write output .x file: " + std::string(pFile));
+    }
 }
 
 } // end of namespace Assimp
@@ -99,8 +95,9 @@ void ExportSceneXFile(const char* pFile,IOSystem* pIOSystem, const aiScene* pSce
 
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
-XFileExporter::XFileExporter(const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, const ExportProperties* pProperties)
-        : mProperties(pProperties),
+XFileExporter::XFileExporter(const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, const ExportProperties* pProperties, IOStream* pOutput)
+        : mOutput(pOutput),
+        mProperties(pProperties),
         mIOSystem(pIOSystem),
         mPath(path),
         mFile(file),
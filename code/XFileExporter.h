@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/matrix4x4.h>
 #include <assimp/Exporter.hpp>
+#include "IOStreamWriter.h"
 #include <sstream>
 
 struct aiScene;
@@ -68,7 +69,7 @@ class XFileExporter
 {
 public:
     /// Constructor for a specific scene to export
-    XFileExporter(const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, const ExportProperties* pProperties);
+    XFileExporter(const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file, const ExportProperties* pProperties, IOStream* pOutput);
 
     /// Destructor
     virtual ~XFileExporter();
@@ -99,8 +100,8 @@ protected:
     }
 
 public:
-    /// Stringstream to write all output into
-    std::stringstream mOutput;
+    /// Stream to write all output into, it passes the data on to the output file
+    IOStreamWriter mOutput;
 
 protected:
 
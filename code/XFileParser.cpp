@@ -53,6 +53,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ByteSwapper.h"
 #include "StringUtils.h"
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <cstring>
 
 
 using namespace Assimp;
@@ -83,6 +85,52 @@ static void  dummy_free  (void* /*opaque*/, void* address)  {
 
 #endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
 
+// ------------------------------------------------------------------------------------------------
+// Streaming state for MSZIP compressed files
+struct XFileParser::Inflater
+{
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_X
+    z_stream mStream;
+#endif
+
+    /// next MSZIP block header in the compressed data and its end
+    const char* mIn;
+    const char* mInEnd;
+
+    /// uncompressed data not parsed yet, always zero-terminated
+    std::vector<char> mWindow;
+
+    Inflater( const char* pIn, const char* pInEnd, bool pBinary)
+        : mIn( pIn), mInEnd( pInEnd)
+    {
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_X
+        mStream.opaque = NULL;
+        mStream.zalloc = &dummy_alloc;
+        mStream.zfree  = &dummy_free;
+        mStream.data_type = (pBinary ? Z_BINARY : Z_ASCII);
+
+        // initialize the inflation algorithm
+        ::inflateInit2(&mStream, -MAX_WBITS);
+
+        mWindow.resize( 2 * MSZIP_BLOCK + 1);
+#else
+        (void) pBinary;
+        mWindow.resize( 1);
+#endif
+    }
+
+    ~Inflater()
+    {
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_X
+        ::inflateEnd(&mStream);
+#endif
+    }
+};
+
+// Text tokens are scanned without refilling the window, so at least this much
+// is made available in front of each of them
+static const size_t TextLookAhead = 1024;
+
 // ------------------------------------------------------------------------------------------------
 // Constructor. Creates a data structure out of the XFile given in the memory block.
 XFileParser::XFileParser( const std::vector<char>& pBuffer)
@@ -94,9 +142,6 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
     mLineNumber = 0;
     mScene = NULL;
 
-    // vector to store uncompressed file for INFLATE'd X files
-    std::vector<char> uncompressed;
-
     // set up memory pointers
     P = &pBuffer.front();
     End = P + pBuffer.size() - 1;
@@ -174,86 +219,15 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
          * ///////////////////////////////////////////////////////////////////////
          */
 
-        // build a zlib stream
-        z_stream stream;
-        stream.opaque = NULL;
-        stream.zalloc = &dummy_alloc;
-        stream.zfree  = &dummy_free;
-        stream.data_type = (mIsBinaryFormat ? Z_BINARY : Z_ASCII);
-
-        // initialize the inflation algorithm
-        ::inflateInit2(&stream, -MAX_WBITS);
-
         // skip unknown data (checksum, flags?)
         P += 6;
 
-        // First find out how much storage we'll need. Count sections.
-        const char* P1       = P;
-        unsigned int est_out = 0;
-
-        while (P1 + 3 < End)
-        {
-            // read next offset
-            uint16_t ofs = *((uint16_t*)P1);
-            AI_SWAP2(ofs); P1 += 2;
-
-            if (ofs >= MSZIP_BLOCK)
-                throw DeadlyImportError("X: Invalid offset to next MSZIP compressed block");
-
-            // check magic word
-            uint16_t magic = *((uint16_t*)P1);
-            AI_SWAP2(magic); P1 += 2;
-
-            if (magic != MSZIP_MAGIC)
-                throw DeadlyImportError("X: Unsupported compressed format, expected MSZIP header");
-
-            // and advance to the next offset
-            P1 += ofs;
-            est_out += MSZIP_BLOCK; // one decompressed block is 32786 in size
-        }
-
-        // Allocate storage and terminating zero and do the actual uncompressing
-        uncompressed.resize(est_out + 1);
-        char* out = &uncompressed.front();
-        while (P + 3 < End)
-        {
-            uint16_t ofs = *((uint16_t*)P);
-            AI_SWAP2(ofs);
-            P += 4;
-
-            if (P + ofs > End + 2) {
-                throw DeadlyImportError("X: Unexpected EOF in compressed chunk");
-            }
-
-            // push data to the stream
-            stream.next_in   = (Bytef*)P;
-            stream.avail_in  = ofs;
-            stream.next_out  = (Bytef*)out;
-            stream.avail_out = MSZIP_BLOCK;
-
-            // and decompress the data ....
-            int ret = ::inflate( &stream, Z_SYNC_FLUSH );
-            if (ret != Z_OK && ret != Z_STREAM_END)
-                throw DeadlyImportError("X: Failed to decompress MSZIP-compressed data");
-
-            ::inflateReset( &stream );
-            ::inflateSetDictionary( &stream, (const Bytef*)out , MSZIP_BLOCK - stream.avail_out );
-
-            // and advance to the next offset
-            out +=  MSZIP_BLOCK - stream.avail_out;
-            P   += ofs;
-        }
-
-        // terminate zlib
-        ::inflateEnd(&stream);
-
-        // ok, update pointers to point to the uncompressed file data
-        P = &uncompressed[0];
-        End = out;
+        // Blocks are inflated on demand into a small sliding window while the
+        // file is parsed, the uncompressed file is never held in memory at once.
+        mInflater.reset( new Inflater( P, End, mIsBinaryFormat));
+        P = End = &mInflater->mWindow.front();
 
-        // FIXME: we don't need the compressed data anymore, could release
-        // it already for better memory usage. Consider breaking const-co.
-        DefaultLogger::get()->info("Successfully decompressed MSZIP-compressed file");
+        DefaultLogger::get()->info("Reading MSZIP-compressed file");
 #endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
     }
     else
@@ -279,6 +253,93 @@ XFileParser::~XFileParser()
     delete mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Inflates MSZIP blocks into the sliding window until pNumBytes bytes are available at P
+bool XFileParser::InflateMore( size_t pNumBytes)
+{
+#ifdef ASSIMP_BUILD_NO_COMPRESSED_X
+    (void) pNumBytes;
+    return false;
+#else
+    if( !mInflater)
+        return false;
+
+    z_stream& stream = mInflater->mStream;
+    std::vector<char>& window = mInflater->mWindow;
+
+    // move the data not parsed yet to the front of the window
+    if( P > End)
+        P = End;
+    size_t filled = End - P;
+    if( filled && P != &window.front())
+        ::memmove( &window.front(), P, filled);
+
+    while( filled < pNumBytes && mInflater->mIn + 3 < mInflater->mInEnd)
+    {
+        const char* in = mInflater->mIn;
+
+        // read next offset
+        uint16_t ofs = *((uint16_t*)in);
+        AI_SWAP2(ofs);
+
+        if (ofs >= MSZIP_BLOCK)
+            throw DeadlyImportError("X: Invalid offset to next MSZIP compressed block");
+
+        // check magic word
+        uint16_t magic = *((uint16_t*)(in + 2));
+        AI_SWAP2(magic);
+
+        if (magic != MSZIP_MAGIC)
+            throw DeadlyImportError("X: Unsupported compressed format, expected MSZIP header");
+
+        in += 4;
+        if (in + ofs > mInflater->mInEnd + 2) {
+            throw DeadlyImportError("X: Unexpected EOF in compressed chunk");
+        }
+
+        // one decompressed block is at most 32786 in size, keep room for the terminating zero
+        if( window.size() < filled + MSZIP_BLOCK + 1)
+            window.resize( filled + MSZIP_BLOCK + 1);
+        char* out = &window[filled];
+
+        // push data to the stream
+        stream.next_in   = (Bytef*)in;
+        stream.avail_in  = ofs;
+        stream.next_out  = (Bytef*)out;
+        stream.avail_out = MSZIP_BLOCK;
+
+        // and decompress the data ....
+        int ret = ::inflate( &stream, Z_SYNC_FLUSH );
+        if (ret != Z_OK && ret != Z_STREAM_END)
+            throw DeadlyImportError("X: Failed to decompress MSZIP-compressed data");
+
+        ::inflateReset( &stream );
+        ::inflateSetDictionary( &stream, (const Bytef*)out , MSZIP_BLOCK - stream.avail_out );
+
+        // and advance to the next offset
+        filled += MSZIP_BLOCK - stream.avail_out;
+        mInflater->mIn = in + ofs;
+    }
+
+    P = &window.front();
+    End = P + filled;
+    window[filled] = 0;
+    return filled >= pNumBytes;
+#endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
+}
+
+// ------------------------------------------------------------------------------------------------
+// Skips binary data, stops at the end of the file
+void XFileParser::SkipBytes( size_t pNumBytes)
+{
+    while( pNumBytes > 0 && EnsureAvailable( 1))
+    {
+        const size_t num = std::min( pNumBytes, size_t( End - P));
+        P += num;
+        pNumBytes -= num;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void XFileParser::ParseFile()
 {
@@ -458,8 +519,7 @@ void XFileParser::ParseDataObjectMesh( Mesh* pMesh)
     pMesh->mPositions.resize( numVertices);
 
     // read vertices
-    for( unsigned int a = 0; a < numVertices; a++)
-        pMesh->mPositions[a] = ReadVector3();
+    ReadVector3s( pMesh->mPositions);
 
     // read position faces
     unsigned int numPosFaces = ReadInt();
@@ -469,9 +529,8 @@ void XFileParser::ParseDataObjectMesh( Mesh* pMesh)
         // read indices
         unsigned int numIndices = ReadInt();
         Face& face = pMesh->mPosFaces[a];
-        for (unsigned int b = 0; b < numIndices; b++) {
-            face.mIndices.push_back( ReadInt() );
-        }
+        face.mIndices.resize( numIndices);
+        ReadInts( face.mIndices.data(), numIndices);
         TestForSeparator();
     }
 
@@ -578,8 +637,7 @@ void XFileParser::ParseDataObjectMeshNormals( Mesh* pMesh)
     pMesh->mNormals.resize( numNormals);
 
     // read normal vectors
-    for( unsigned int a = 0; a < numNormals; a++)
-        pMesh->mNormals[a] = ReadVector3();
+    ReadVector3s( pMesh->mNormals);
 
     // read normal indices
     unsigned int numFaces = ReadInt();
@@ -592,8 +650,8 @@ void XFileParser::ParseDataObjectMeshNormals( Mesh* pMesh)
         pMesh->mNormFaces.push_back( Face());
         Face& face = pMesh->mNormFaces.back();
 
-        for( unsigned int b = 0; b < numIndices; b++)
-            face.mIndices.push_back( ReadInt());
+        face.mIndices.resize( numIndices);
+        ReadInts( face.mIndices.data(), numIndices);
 
         TestForSeparator();
     }
@@ -615,8 +673,7 @@ void XFileParser::ParseDataObjectMeshTextureCoords( Mesh* pMesh)
         ThrowException( "Texture coord count does not match vertex count");
 
     coords.resize( numCoords);
-    for( unsigned int a = 0; a < numCoords; a++)
-        coords[a] = ReadVector2();
+    ReadVector2s( coords);
 
     CheckForClosingBrace();
 }
@@ -670,14 +727,15 @@ void XFileParser::ParseDataObjectMeshMaterialList( Mesh* pMesh)
         ThrowException( "Per-Face material index count does not match face count.");
 
     // read per-face material indices
-    for( unsigned int a = 0; a < numMatIndices; a++)
-        pMesh->mFaceMaterials.push_back( ReadInt());
+    const size_t firstMatIndex = pMesh->mFaceMaterials.size();
+    pMesh->mFaceMaterials.resize( firstMatIndex + numMatIndices);
+    ReadInts( pMesh->mFaceMaterials.data() + firstMatIndex, numMatIndices);
 
     // in version 03.02, the face indices end with two semicolons.
     // commented out version check, as version 03.03 exported from blender also has 2 semicolons
     if( !mIsBinaryFormat) // && MajorVersion == 3 && MinorVersion <= 2)
     {
-        if(P < End && *P == ';')
+        if( EnsureAvailable( 1) && *P == ';')
             ++P;
     }
 
@@ -993,8 +1051,18 @@ void XFileParser::ParseUnknownDataObject()
 //! checks for closing curly brace
 void XFileParser::CheckForClosingBrace()
 {
-    if( GetNextToken() != "}")
+    // look at the token in place instead of building a string for it
+    if( mIsBinaryFormat)
+    {
+        if( !EnsureAvailable( 2) || ReadBinWord() != 0x0b)
+            ThrowException( "Closing brace expected.");
+        return;
+    }
+
+    FindNextNoneWhiteSpace();
+    if( P >= End || *P != '}')
         ThrowException( "Closing brace expected.");
+    ++P;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1004,8 +1072,10 @@ void XFileParser::CheckForSemicolon()
     if( mIsBinaryFormat)
         return;
 
-    if( GetNextToken() != ";")
+    FindNextNoneWhiteSpace();
+    if( P >= End || *P != ';')
         ThrowException( "Semicolon expected.");
+    ++P;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1015,9 +1085,10 @@ void XFileParser::CheckForSeparator()
     if( mIsBinaryFormat)
         return;
 
-    std::string token = GetNextToken();
-    if( token != "," && token != ";")
+    FindNextNoneWhiteSpace();
+    if( P >= End || (*P != ',' && *P != ';'))
         ThrowException( "Separator character (';' or ',') expected.");
+    ++P;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1061,7 +1132,7 @@ std::string XFileParser::GetNextToken()
         // in binary mode it will only return NAME and STRING token
         // and (correctly) skip over other tokens.
 
-        if( End - P < 2) return s;
+        if( !EnsureAvailable( 2)) return s;
         unsigned int tok = ReadBinWord();
         unsigned int len;
 
@@ -1070,37 +1141,38 @@ std::string XFileParser::GetNextToken()
         {
             case 1:
                 // name token
-                if( End - P < 4) return s;
+                if( !EnsureAvailable( 4)) return s;
                 len = ReadBinDWord();
-                if( End - P < int(len)) return s;
+                if( !EnsureAvailable( len)) return s;
                 s = std::string(P, len);
                 P += len;
                 return s;
             case 2:
                 // string token
-                if( End - P < 4) return s;
+                if( !EnsureAvailable( 4)) return s;
                 len = ReadBinDWord();
-                if( End - P < int(len)) return s;
+                if( !EnsureAvailable( len)) return s;
                 s = std::string(P, len);
-                P += (len + 2);
+                P += len;
+                SkipBytes( 2);
                 return s;
             case 3:
                 // integer token
-                P += 4;
+                SkipBytes( 4);
                 return "<integer>";
             case 5:
                 // GUID token
-                P += 16;
+                SkipBytes( 16);
                 return "<guid>";
             case 6:
-                if( End - P < 4) return s;
+                if( !EnsureAvailable( 4)) return s;
                 len = ReadBinDWord();
-                P += (len * 4);
+                SkipBytes( size_t( len) * 4);
                 return "<int_list>";
             case 7:
-                if( End - P < 4) return s;
+                if( !EnsureAvailable( 4)) return s;
                 len = ReadBinDWord();
-                P += (len * mBinaryFloatSize);
+                SkipBytes( size_t( len) * mBinaryFloatSize);
                 return "<flt_list>";
             case 0x0a:
                 return "{";
@@ -1161,16 +1233,26 @@ std::string XFileParser::GetNextToken()
         if( P >= End)
             return s;
 
-        while( (P < End) && !isspace( (unsigned char) *P))
+        // a delimiter is a token on its own
+        if( *P == ';' || *P == '}' || *P == '{' || *P == ',')
         {
-            // either keep token delimiters when already holding a token, or return if first valid char
-            if( *P == ';' || *P == '}' || *P == '{' || *P == ',')
+            s.assign( P++, 1);
+            return s;
+        }
+
+        // otherwise keep token delimiters for the next call. The token is copied out in
+        // one piece unless it runs over the end of the buffered data.
+        while( EnsureAvailable( 1))
+        {
+            const char* start = P;
+            while( P < End && !isspace( (unsigned char) *P)
+                && *P != ';' && *P != '}' && *P != '{' && *P != ',')
             {
-                if( !s.size())
-                    s.append( P++, 1);
-                break; // stop for delimiter
+                ++P;
             }
-            s.append( P++, 1);
+            s.append( start, P - start);
+            if( P < End)
+                break;
         }
     }
     return s;
@@ -1185,7 +1267,7 @@ void XFileParser::FindNextNoneWhiteSpace()
     bool running = true;
     while( running )
     {
-        while( P < End && isspace( (unsigned char) *P))
+        while( EnsureAvailable( 1) && isspace( (unsigned char) *P))
         {
             if( *P == '\n')
                 mLineNumber++;
@@ -1195,6 +1277,9 @@ void XFileParser::FindNextNoneWhiteSpace()
         if( P >= End)
             return;
 
+        // make sure the following token can be scanned in one go
+        EnsureAvailable( TextLookAhead);
+
         // check if this is a comment
         if( (P[0] == '/' && P[1] == '/') || P[0] == '#')
             ReadUntilEndOfLine();
@@ -1220,10 +1305,10 @@ void XFileParser::GetNextTokenAsString( std::string& poString)
         ThrowException( "Expected quotation mark.");
     ++P;
 
-    while( P < End && *P != '"')
+    while( EnsureAvailable( 1) && *P != '"')
         poString.append( P++, 1);
 
-    if( P >= End-1)
+    if( !EnsureAvailable( 2))
         ThrowException( "Unexpected end of file while parsing string");
 
     if( P[1] != ';' || P[0] != '"')
@@ -1237,7 +1322,7 @@ void XFileParser::ReadUntilEndOfLine()
     if( mIsBinaryFormat)
         return;
 
-    while( P < End)
+    while( EnsureAvailable( 1))
     {
         if( *P == '\n' || *P == '\r')
         {
@@ -1274,17 +1359,17 @@ unsigned int XFileParser::ReadInt()
 {
     if( mIsBinaryFormat)
     {
-        if( mBinaryNumCount == 0 && End - P >= 2)
+        if( mBinaryNumCount == 0 && EnsureAvailable( 2))
         {
             unsigned short tmp = ReadBinWord(); // 0x06 or 0x03
-            if( tmp == 0x06 && End - P >= 4) // array of ints follows
+            if( tmp == 0x06 && EnsureAvailable( 4)) // array of ints follows
                 mBinaryNumCount = ReadBinDWord();
             else // single int follows
                 mBinaryNumCount = 1;
         }
 
         --mBinaryNumCount;
-        if ( End - P >= 4) {
+        if ( EnsureAvailable( 4)) {
             return ReadBinDWord();
         } else {
             P = End;
@@ -1310,7 +1395,7 @@ unsigned int XFileParser::ReadInt()
 
         // read digits
         unsigned int number = 0;
-        while( P < End)
+        while( EnsureAvailable( 1))
         {
             if( !isdigit( *P))
                 break;
@@ -1328,10 +1413,10 @@ ai_real XFileParser::ReadFloat()
 {
     if( mIsBinaryFormat)
     {
-        if( mBinaryNumCount == 0 && End - P >= 2)
+        if( mBinaryNumCount == 0 && EnsureAvailable( 2))
         {
             unsigned short tmp = ReadBinWord(); // 0x07 or 0x42
-            if( tmp == 0x07 && End - P >= 4) // array of floats following
+            if( tmp == 0x07 && EnsureAvailable( 4)) // array of floats following
                 mBinaryNumCount = ReadBinDWord();
             else // single float following
                 mBinaryNumCount = 1;
@@ -1340,20 +1425,22 @@ ai_real XFileParser::ReadFloat()
         --mBinaryNumCount;
         if( mBinaryFloatSize == 8)
         {
-            if( End - P >= 8) {
-                ai_real result = (ai_real) (*(double*) P);
+            if( EnsureAvailable( 8)) {
+                double result;
+                ::memcpy( &result, P, 8);
                 P += 8;
-                return result;
+                return (ai_real) result;
             } else {
                 P = End;
                 return 0;
             }
         } else
         {
-            if( End - P >= 4) {
-                ai_real result = *(ai_real*) P;
+            if( EnsureAvailable( 4)) {
+                float result;
+                ::memcpy( &result, P, 4);
                 P += 4;
-                return result;
+                return (ai_real) result;
             } else {
                 P = End;
                 return 0;
@@ -1435,6 +1522,143 @@ aiColor3D XFileParser::ReadRGB()
     return color;
 }
 
+// ------------------------------------------------------------------------------------------------
+void XFileParser::ReadInts( unsigned int* pOut, size_t pCount)
+{
+    if( mIsBinaryFormat)
+    {
+        ReadBinInts( pOut, pCount);
+        return;
+    }
+
+    for( size_t a = 0; a < pCount; a++)
+        pOut[a] = ReadInt();
+}
+
+// ------------------------------------------------------------------------------------------------
+void XFileParser::ReadVector2s( std::vector<aiVector2D>& pVectors)
+{
+    static_assert(sizeof(aiVector2D) == 2 * sizeof(ai_real), "aiVector2D is not tightly packed");
+    if( mIsBinaryFormat)
+    {
+        // the vector types are packed, go through void* to copy into their components
+        void* data = pVectors.data();
+        ReadBinFloats( static_cast<ai_real*>( data), pVectors.size() * 2);
+        return;
+    }
+
+    for( size_t a = 0; a < pVectors.size(); a++)
+        pVectors[a] = ReadVector2();
+}
+
+// ------------------------------------------------------------------------------------------------
+void XFileParser::ReadVector3s( std::vector<aiVector3D>& pVectors)
+{
+    static_assert(sizeof(aiVector3D) == 3 * sizeof(ai_real), "aiVector3D is not tightly packed");
+    if( mIsBinaryFormat)
+    {
+        // the vector types are packed, go through void* to copy into their components
+        void* data = pVectors.data();
+        ReadBinFloats( static_cast<ai_real*>( data), pVectors.size() * 3);
+        return;
+    }
+
+    for( size_t a = 0; a < pVectors.size(); a++)
+        pVectors[a] = ReadVector3();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies values straight out of binary float list tokens. Whatever the current list and the
+// buffered data hold is taken in one go, single values at the boundaries go through ReadFloat().
+void XFileParser::ReadBinFloats( ai_real* pOut, size_t pCount)
+{
+    while( pCount > 0)
+    {
+        if( mBinaryNumCount == 0 && EnsureAvailable( 2))
+        {
+            unsigned short tmp = ReadBinWord(); // 0x07 or 0x42
+            if( tmp == 0x07 && EnsureAvailable( 4)) // array of floats following
+                mBinaryNumCount = ReadBinDWord();
+            else // single float following
+                mBinaryNumCount = 1;
+        }
+
+        size_t num = std::min( pCount, size_t( mBinaryNumCount));
+        num = std::min( num, size_t( End - P) / mBinaryFloatSize);
+        if( num == 0)
+        {
+            *pOut++ = ReadFloat();
+            --pCount;
+            continue;
+        }
+
+        if( mBinaryFloatSize == 8)
+        {
+            for( size_t a = 0; a < num; a++, P += 8)
+            {
+                double value;
+                ::memcpy( &value, P, 8);
+                pOut[a] = (ai_real) value;
+            }
+        } else
+        if( sizeof(ai_real) == 4)
+        {
+            ::memcpy( pOut, P, num * 4);
+            P += num * 4;
+        } else
+        {
+            for( size_t a = 0; a < num; a++, P += 4)
+            {
+                float value;
+                ::memcpy( &value, P, 4);
+                pOut[a] = (ai_real) value;
+            }
+        }
+
+        pOut += num;
+        pCount -= num;
+        mBinaryNumCount -= (unsigned int) num;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies values straight out of binary int list tokens, see ReadBinFloats()
+void XFileParser::ReadBinInts( unsigned int* pOut, size_t pCount)
+{
+    while( pCount > 0)
+    {
+        if( mBinaryNumCount == 0 && EnsureAvailable( 2))
+        {
+            unsigned short tmp = ReadBinWord(); // 0x06 or 0x03
+            if( tmp == 0x06 && EnsureAvailable( 4)) // array of ints follows
+                mBinaryNumCount = ReadBinDWord();
+            else // single int follows
+                mBinaryNumCount = 1;
+        }
+
+        size_t num = std::min( pCount, size_t( mBinaryNumCount));
+        num = std::min( num, size_t( End - P) / 4);
+        if( num == 0)
+        {
+            *pOut++ = ReadInt();
+            --pCount;
+            continue;
+        }
+
+#ifdef AI_BUILD_BIG_ENDIAN
+        for( size_t a = 0; a < num; a++)
+            pOut[a] = ReadBinDWord();
+#else
+        ::memcpy( pOut, P, num * 4);
+        P += num * 4;
+#endif
+
+        pOut += num;
+        pCount -= num;
+        mBinaryNumCount -= (unsigned int) num;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Throws an exception with a line number and the given text.
 AI_WONT_RETURN void XFileParser::ThrowException( const std::string& pText)
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_XFILEPARSER_H_INC
 #define AI_XFILEPARSER_H_INC
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -97,6 +98,18 @@ protected:
     void ParseDataObjectTextureFilename( std::string& pName);
     void ParseUnknownDataObject();
 
+    //! makes sure at least pNumBytes bytes can be read at P. For compressed files
+    //! further MSZIP blocks are inflated on demand. Returns false if the file ends before.
+    bool EnsureAvailable( size_t pNumBytes) {
+        return End - P >= (ptrdiff_t) pNumBytes || InflateMore( pNumBytes);
+    }
+
+    //! inflates MSZIP blocks into the sliding window until pNumBytes bytes are available at P
+    bool InflateMore( size_t pNumBytes);
+
+    //! skips pNumBytes bytes of binary data, stops at the end of the file
+    void SkipBytes( size_t pNumBytes);
+
     //! places pointer to next begin of a token, and ignores comments
     void FindNextNoneWhiteSpace();
 
@@ -131,6 +144,17 @@ protected:
     ai_real ReadFloat();
     aiVector2D ReadVector2();
     aiVector3D ReadVector3();
+
+    //! reads pCount integers, binary int lists are copied in bulk
+    void ReadInts( unsigned int* pOut, size_t pCount);
+    //! fills the given arrays, binary float lists are copied in bulk
+    void ReadVector2s( std::vector<aiVector2D>& pVectors);
+    void ReadVector3s( std::vector<aiVector3D>& pVectors);
+
+    //! copies pCount values straight out of binary float list tokens
+    void ReadBinFloats( ai_real* pOut, size_t pCount);
+    //! copies pCount values straight out of binary int list tokens
+    void ReadBinInts( unsigned int* pOut, size_t pCount);
     aiColor3D ReadRGB();
     aiColor4D ReadRGBA();
 
@@ -152,6 +176,10 @@ protected:
     const char* P;
     const char* End;
 
+    /// Inflation state for MSZIP compressed files, NULL for uncompressed ones
+    struct Inflater;
+    std::unique_ptr<Inflater> mInflater;
+
     /// Line number when reading in text format
     unsigned int mLineNumber;
 
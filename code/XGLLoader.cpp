@@ -218,9 +218,8 @@ void XGLImporter::InternReadFile( const std::string& pFile,
 #endif
     }
 
-    // construct the irrXML parser
-    CIrrXML_IOStreamReader st(stream.get());
-    m_reader.reset( createIrrXMLReader( ( IFileReadCallBack* ) &st ) );
+    // construct the XML parser
+    m_reader.reset( new FastXmlReader( stream.get() ) );
 
     // parse the XML file
     TempScope scope;
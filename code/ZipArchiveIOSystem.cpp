@@ -0,0 +1,391 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  ZipArchiveIOSystem.cpp
+ *  @brief Implementation of the lazily inflating zip archive IOSystem.
+ */
+#include "ZipArchiveIOSystem.h"
+
+#include <assimp/IOStream.hpp>
+#include <assimp/ai_assert.h>
+#include <contrib/unzip/unzip.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <limits.h>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Maps the file functions of unzip to an IOSystem
+voidpf IOSystem2UnzipOpen(voidpf opaque, const char* filename, int mode) {
+    IOSystem* io_system = reinterpret_cast<IOSystem*>(opaque);
+
+    const char* mode_fopen = NULL;
+    if((mode & ZLIB_FILEFUNC_MODE_READWRITEFILTER)==ZLIB_FILEFUNC_MODE_READ) {
+        mode_fopen = "rb";
+    } else {
+        if(mode & ZLIB_FILEFUNC_MODE_EXISTING) {
+            mode_fopen = "r+b";
+        } else {
+            if(mode & ZLIB_FILEFUNC_MODE_CREATE) {
+                mode_fopen = "wb";
+            }
+        }
+    }
+
+    return (voidpf) io_system->Open(filename, mode_fopen);
+}
+
+uLong IOSystem2UnzipRead(voidpf /*opaque*/, voidpf stream, void* buf, uLong size) {
+    IOStream* io_stream = (IOStream*) stream;
+
+    return static_cast<uLong>(io_stream->Read(buf, 1, size));
+}
+
+uLong IOSystem2UnzipWrite(voidpf /*opaque*/, voidpf stream, const void* buf, uLong size) {
+    IOStream* io_stream = (IOStream*) stream;
+
+    return static_cast<uLong>(io_stream->Write(buf, 1, size));
+}
+
+long IOSystem2UnzipTell(voidpf /*opaque*/, voidpf stream) {
+    IOStream* io_stream = (IOStream*) stream;
+
+    return static_cast<long>(io_stream->Tell());
+}
+
+long IOSystem2UnzipSeek(voidpf /*opaque*/, voidpf stream, uLong offset, int origin) {
+    IOStream* io_stream = (IOStream*) stream;
+
+    aiOrigin assimp_origin;
+    switch (origin) {
+        default:
+        case ZLIB_FILEFUNC_SEEK_CUR:
+            assimp_origin = aiOrigin_CUR;
+            break;
+        case ZLIB_FILEFUNC_SEEK_END:
+            assimp_origin = aiOrigin_END;
+            break;
+        case ZLIB_FILEFUNC_SEEK_SET:
+            assimp_origin = aiOrigin_SET;
+            break;
+    }
+
+    return (io_stream->Seek(offset, assimp_origin) == aiReturn_SUCCESS ? 0 : -1);
+}
+
+int IOSystem2UnzipClose(voidpf opaque, voidpf stream) {
+    IOSystem* io_system = (IOSystem*) opaque;
+    IOStream* io_stream = (IOStream*) stream;
+
+    io_system->Close(io_stream);
+
+    return 0;
+}
+
+int IOSystem2UnzipTestError(voidpf /*opaque*/, voidpf /*stream*/) {
+    return 0;
+}
+
+zlib_filefunc_def IOSystem2Unzip(IOSystem* pIOHandler) {
+    zlib_filefunc_def mapping;
+
+    mapping.zopen_file = IOSystem2UnzipOpen;
+    mapping.zread_file = IOSystem2UnzipRead;
+    mapping.zwrite_file = IOSystem2UnzipWrite;
+    mapping.ztell_file = IOSystem2UnzipTell;
+    mapping.zseek_file = IOSystem2UnzipSeek;
+    mapping.zclose_file = IOSystem2UnzipClose;
+    mapping.zerror_file = IOSystem2UnzipTestError;
+    mapping.opaque = reinterpret_cast<voidpf>(pIOHandler);
+
+    return mapping;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Stream for a single entry. It owns a handle to the archive of its own and
+// inflates the entry as it is read.
+class ZipEntryStream : public IOStream {
+public:
+    ZipEntryStream(unzFile handle, size_t size)
+    : m_Handle(handle)
+    , m_Size(size)
+    , m_Pos(0) {
+        // empty
+    }
+
+    ~ZipEntryStream() {
+        unzCloseCurrentFile(m_Handle);
+        unzClose(m_Handle);
+    }
+
+    size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+        if (0 == pSize || 0 == pCount) {
+            return 0;
+        }
+        const size_t size = std::min(pSize * pCount, m_Size - m_Pos);
+        const size_t read = Inflate(pvBuffer, size);
+        return read / pSize;
+    }
+
+    size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+        return 0;
+    }
+
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+        size_t target = pOffset;
+        if (aiOrigin_CUR == pOrigin) {
+            target = m_Pos + pOffset;
+        } else if (aiOrigin_END == pOrigin) {
+            if (pOffset > m_Size) {
+                return aiReturn_FAILURE;
+            }
+            target = m_Size - pOffset;
+        }
+        if (target > m_Size) {
+            return aiReturn_FAILURE;
+        }
+
+        // deflate streams can only be decoded forward, so restart the entry
+        // to go back
+        if (target < m_Pos) {
+            unzCloseCurrentFile(m_Handle);
+            if (unzOpenCurrentFile(m_Handle) != UNZ_OK) {
+                return aiReturn_FAILURE;
+            }
+            m_Pos = 0;
+        }
+
+        char scratch[4096];
+        while (m_Pos < target) {
+            if (!Inflate(scratch, std::min(sizeof(scratch), target - m_Pos))) {
+                return aiReturn_FAILURE;
+            }
+        }
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const {
+        return m_Pos;
+    }
+
+    size_t FileSize() const {
+        return m_Size;
+    }
+
+    void Flush() {
+        // empty
+    }
+
+private:
+    size_t Inflate(void* pvBuffer, size_t size) {
+        size_t read = 0;
+        while (read < size) {
+            const unsigned int chunk = static_cast<unsigned int>(std::min(size - read, static_cast<size_t>(INT_MAX)));
+            const int result = unzReadCurrentFile(m_Handle, static_cast<char*>(pvBuffer) + read, chunk);
+            if (result <= 0) {
+                break;
+            }
+            read += result;
+        }
+        m_Pos += read;
+        return read;
+    }
+
+    unzFile m_Handle;
+    size_t m_Size;
+    size_t m_Pos;
+};
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+class ZipArchiveIOSystem::Implement {
+public:
+    struct Entry {
+        unz_file_pos m_Pos;
+        size_t m_Size;
+    };
+
+    Implement(IOSystem* pIOHandler, const std::string& rFile)
+    : m_IOHandler(pIOHandler)
+    , m_File(rFile)
+    , m_ZipFileHandle(NULL) {
+        if (!rFile.empty()) {
+            zlib_filefunc_def mapping = IOSystem2Unzip(pIOHandler);
+            m_ZipFileHandle = unzOpen2(rFile.c_str(), &mapping);
+            if (m_ZipFileHandle != NULL) {
+                MapArchive();
+            }
+        }
+    }
+
+    ~Implement() {
+        if (m_ZipFileHandle != NULL) {
+            unzClose(m_ZipFileHandle);
+            m_ZipFileHandle = NULL;
+        }
+    }
+
+    // Index the central directory, nothing is inflated here
+    void MapArchive() {
+        if (unzGoToFirstFile(m_ZipFileHandle) != UNZ_OK) {
+            return;
+        }
+        std::string filename;
+        do {
+            unz_file_info fileInfo;
+            if (unzGetCurrentFileInfo(m_ZipFileHandle, &fileInfo, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK) {
+                continue;
+            }
+
+            // directories and empty files are skipped
+            if (0 == fileInfo.uncompressed_size || 0 == fileInfo.size_filename) {
+                continue;
+            }
+
+            filename.resize(fileInfo.size_filename + 1);
+            if (unzGetCurrentFileInfo(m_ZipFileHandle, NULL, &filename[0], static_cast<uLong>(filename.size()), NULL, 0, NULL, 0) != UNZ_OK) {
+                continue;
+            }
+            filename.resize(fileInfo.size_filename);
+
+            Entry entry;
+            entry.m_Size = fileInfo.uncompressed_size;
+            if (unzGetFilePos(m_ZipFileHandle, &entry.m_Pos) == UNZ_OK) {
+                m_Entries[filename] = entry;
+            }
+        } while (unzGoToNextFile(m_ZipFileHandle) != UNZ_END_OF_LIST_OF_FILE);
+    }
+
+    IOStream* Open(const char* pFile) {
+        std::unordered_map<std::string, Entry>::iterator it = m_Entries.find(pFile);
+        if (it == m_Entries.end()) {
+            return NULL;
+        }
+
+        // every stream gets its own handle, so several entries can be read
+        // at the same time
+        zlib_filefunc_def mapping = IOSystem2Unzip(m_IOHandler);
+        unzFile handle = unzOpen2(m_File.c_str(), &mapping);
+        if (NULL == handle) {
+            return NULL;
+        }
+        if (unzGoToFilePos(handle, &it->second.m_Pos) != UNZ_OK || unzOpenCurrentFile(handle) != UNZ_OK) {
+            unzClose(handle);
+            return NULL;
+        }
+        return new ZipEntryStream(handle, it->second.m_Size);
+    }
+
+    IOSystem* m_IOHandler;
+    std::string m_File;
+    unzFile m_ZipFileHandle;
+    std::unordered_map<std::string, Entry> m_Entries;
+};
+
+// ------------------------------------------------------------------------------------------------
+ZipArchiveIOSystem::ZipArchiveIOSystem(IOSystem* pIOHandler, const std::string& rFile)
+: mImpl(new Implement(pIOHandler, rFile)) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+ZipArchiveIOSystem::~ZipArchiveIOSystem() {
+    delete mImpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::isOpen() const {
+    return (mImpl->m_ZipFileHandle != NULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::Exists(const char* pFile) const {
+    ai_assert(pFile != NULL);
+
+    if (pFile == NULL) {
+        return false;
+    }
+    return mImpl->m_Entries.find(pFile) != mImpl->m_Entries.end();
+}
+
+// ------------------------------------------------------------------------------------------------
+char ZipArchiveIOSystem::getOsSeparator() const {
+#ifndef _WIN32
+    return '/';
+#else
+    return '\\';
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* ZipArchiveIOSystem::Open(const char* pFile, const char* /*pMode*/) {
+    ai_assert(pFile != NULL);
+
+    if (pFile == NULL) {
+        return NULL;
+    }
+    return mImpl->Open(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipArchiveIOSystem::Close(IOStream* pFile) {
+    delete pFile;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipArchiveIOSystem::getFileList(std::vector<std::string>& rFileList) const {
+    rFileList.clear();
+    rFileList.reserve(mImpl->m_Entries.size());
+    for (std::unordered_map<std::string, Implement::Entry>::const_iterator it = mImpl->m_Entries.begin();
+            it != mImpl->m_Entries.end(); ++it) {
+        rFileList.push_back(it->first);
+    }
+
+    // keep the order independent of the hash table
+    std::sort(rFileList.begin(), rFileList.end());
+}
+
+} // Namespace Assimp
@@ -0,0 +1,112 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  ZipArchiveIOSystem.h
+ *  @brief IOSystem to read the entries of a zip archive, used by the
+ *    3MF and Quake 3 BSP (pk3) importers.
+ */
+#ifndef INCLUDED_AI_ZIP_ARCHIVE_IOSYSTEM_H
+#define INCLUDED_AI_ZIP_ARCHIVE_IOSYSTEM_H
+
+#include <assimp/IOSystem.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------------
+/** @brief Read-only IOSystem for the entries of a zip archive.
+ *
+ *  Opening the archive only reads its central directory into a hashed index.
+ *  Entries are inflated incrementally while they are read from the streams
+ *  returned by Open(), so entries which are never opened - thumbnails,
+ *  unused textures - are never decompressed, and large entries are not held
+ *  in memory as a whole.
+ *
+ *  Every opened stream has its own cursor into the archive, several streams
+ *  can be open at the same time. The streams must be closed with Close().
+ */
+class ASSIMP_API ZipArchiveIOSystem : public IOSystem {
+public:
+    // -------------------------------------------------------------------
+    /** @brief Opens the archive and indexes its entries.
+     *  @param pIOHandler IOSystem to access the archive file with
+     *  @param rFile      Path of the archive
+     */
+    ZipArchiveIOSystem(IOSystem* pIOHandler, const std::string& rFile);
+    ~ZipArchiveIOSystem();
+
+    // -------------------------------------------------------------------
+    /** Returns true if the archive could be opened */
+    bool isOpen() const;
+
+    // -------------------------------------------------------------------
+    /** Returns true if the archive contains a (non-empty) file with the given name */
+    bool Exists(const char* pFile) const;
+
+    // -------------------------------------------------------------------
+    /** Returns the path separator used for the entries */
+    char getOsSeparator() const;
+
+    // -------------------------------------------------------------------
+    /** Opens an entry for reading, returns NULL if it doesn't exist */
+    IOStream* Open(const char* pFile, const char* pMode = "rb");
+
+    // -------------------------------------------------------------------
+    /** Closes a stream returned by Open() */
+    void Close(IOStream* pFile);
+
+    // -------------------------------------------------------------------
+    /** Returns the names of all (non-empty) files in the archive, sorted */
+    void getFileList(std::vector<std::string>& rFileList) const;
+
+private:
+    ZipArchiveIOSystem(const ZipArchiveIOSystem&);
+    ZipArchiveIOSystem& operator=(const ZipArchiveIOSystem&);
+
+    class Implement;
+    Implement* mImpl;
+};
+
+} // Namespace Assimp
+
+#endif // INCLUDED_AI_ZIP_ARCHIVE_IOSYSTEM_H
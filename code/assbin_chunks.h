@@ -2,7 +2,7 @@
 #define INCLUDED_ASSBIN_CHUNKS_H
 
 #define ASSBIN_VERSION_MAJOR 1
-#define ASSBIN_VERSION_MINOR 0
+#define ASSBIN_VERSION_MINOR 1
 
 /**
 @page assfile .ASS File formats
@@ -57,6 +57,7 @@ in <tt>&lt;root&gt;/tools/assimp_cmd/WriteDumb.cpp</tt> (yes, the 'b' is no typo
 
 integer is four bytes wide, stored in little-endian byte order.
 short   is two bytes wide, stored in little-endian byte order.
+int64   is eight bytes wide, stored in little-endian byte order.
 byte    is a single byte.
 string  is an integer n followed by n UTF-8 characters, not terminated by zero
 float   is an IEEE 754 single-precision floating-point value
@@ -81,10 +82,12 @@ integer     Assimp compile flags
 short       0 for normal files, 1 for shortened dumps for regression tests
                 these should have the file extension assbin.regress
 
-short       1 if the data after the header is compressed with the DEFLATE algorithm,
+short       Layout of the data after the header (ASSBIN_LAYOUT_XXX):
             0 for uncompressed files.
+            1 if the data after the header is compressed with the DEFLATE algorithm.
                    For compressed files, the first integer after the header is
                    always the uncompressed data size
+            2 for indexed files, see section 4 (since version 1.1)
 
 byte[256]   Zero-terminated source file name, UTF-8
 byte[128]   Zero-terminated command line parameters passed to assimp_cmd, UTF-8
@@ -164,6 +167,33 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 
    - mNumAllocated is omitted, for obvious reasons :-)
 
+-------------------------------------------------------------------------------
+4. Indexed layout:
+-------------------------------------------------------------------------------
+
+The scene is split into blocks which are stored independently of each other,
+so they can be written and read in parallel and a single mesh can be loaded
+without touching the rest of the file. An index table follows the header:
+
+integer     Magic chunk ID ASSBIN_CHUNK_INDEX
+integer     Number of blocks n
+
+n times     (ASSBIN_INDEX_ENTRY_LENGTH bytes each)
+   integer     Magic chunk ID of the chunk stored in the block
+   integer     Flags, ASSBIN_BLOCK_DEFLATE if the block is compressed with DEFLATE
+   int64       Offset of the block data from the beginning of the file
+   integer     Stored size of the block data, in bytes
+   integer     Size of the block data after decompression, in bytes
+
+The block data follows the index table. Each block holds exactly one chunk as
+described in section 3:
+
+   - block 0 is an ASSBIN_CHUNK_AISCENE chunk. Its subchunks are the root
+     node, the materials, the lights and the cameras, in this order.
+   - the next aiScene::mNumMeshes blocks hold one ASSBIN_CHUNK_AIMESH each,
+   - followed by aiScene::mNumAnimations ASSBIN_CHUNK_AIANIMATION blocks,
+   - followed by aiScene::mNumTextures ASSBIN_CHUNK_AITEXTURE blocks.
+
 
  @endverbatim*/
 
@@ -182,6 +212,19 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 #define ASSBIN_CHUNK_AINODE                     0x123c
 #define ASSBIN_CHUNK_AIMATERIAL                 0x123d
 #define ASSBIN_CHUNK_AIMATERIALPROPERTY         0x123e
+#define ASSBIN_CHUNK_INDEX                      0x123f
+
+// values of the layout field in the file header
+#define ASSBIN_LAYOUT_PLAIN                     0
+#define ASSBIN_LAYOUT_DEFLATE                   1
+#define ASSBIN_LAYOUT_INDEXED                   2
+
+// index table of the indexed layout
+#define ASSBIN_INDEX_ENTRY_LENGTH               24
+#define ASSBIN_BLOCK_DEFLATE                    0x1
+
+// chunk header and counts of an ASSBIN_CHUNK_AIMESH chunk, up to aiMesh::mMaterialIndex
+#define ASSBIN_MESH_HEADER_LENGTH               28
 
 #define ASSBIN_MESH_HAS_POSITIONS                   0x1
 #define ASSBIN_MESH_HAS_NORMALS                     0x2
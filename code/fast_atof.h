@@ -265,7 +265,11 @@ inline int64_t strtol10_64(const char* in, const char** out = 0, unsigned int* m
 template <typename Real>
 inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true)
 {
-    Real f = 0;
+    // The value is accumulated in double and rounded to Real once at the end. Adding the
+    // integral and the fractional part as floats rounds twice, so the shortest decimal
+    // representation of a float (as written by fast_ftoa) would not always read back as
+    // the same float.
+    double f = 0;
 
     bool inv = (*c == '-');
     if (inv || *c == '+') {
@@ -303,7 +307,7 @@ inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma
 
     if (*c != '.' && (! check_comma || c[0] != ','))
     {
-        f = static_cast<Real>( strtoul10_64 ( c, &c) );
+        f = static_cast<double>( strtoul10_64 ( c, &c) );
     }
 
     if ((*c == '.' || (check_comma && c[0] == ',')) && c[1] >= '0' && c[1] <= '9')
@@ -322,7 +326,7 @@ inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma
         double pl = static_cast<double>( strtoul10_64 ( c, &c, &diff ));
 
         pl *= fast_atof_table[diff];
-        f += static_cast<Real>( pl );
+        f += pl;
     }
     // For backwards compatibility: eat trailing dots, but not trailing commas.
     else if (*c == '.') {
@@ -339,20 +343,17 @@ inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma
             ++c;
         }
 
-        // The reason float constants are used here is that we've seen cases where compilers
-        // would perform such casts on compile-time constants at runtime, which would be
-        // bad considering how frequently fast_atoreal_move<float> is called in Assimp.
-        Real exp = static_cast<Real>( strtoul10_64(c, &c) );
+        double exp = static_cast<double>( strtoul10_64(c, &c) );
         if (einv) {
             exp = -exp;
         }
-        f *= std::pow(static_cast<Real>(10.0), exp);
+        f *= std::pow(10.0, exp);
     }
 
     if (inv) {
         f = -f;
     }
-    out = f;
+    out = static_cast<Real>(f);
     return c;
 }
 
@@ -0,0 +1,632 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file fast_ftoa.h
+ *  @brief Fast, locale independent formatting of floating point numbers for
+ *    the text exporters, the counterpart of fast_atof.h.
+ *
+ *  fast_ftoa() writes the shortest decimal representation which reads back
+ *  as the same value, computed with the Grisu2 algorithm (F. Loitsch:
+ *  "Printing Floating-Point Numbers Quickly and Accurately with Integers").
+ *  In very rare cases Grisu2 emits one digit more than necessary, the result
+ *  still reads back exactly.
+ *  Floats are formatted with their own precision, so 0.1f is written as "0.1"
+ *  instead of "0.100000001490116". fast_ftoa_fixed() writes a fixed number of
+ *  decimal places like printf's "%.*f". The output uses only digits, '-', '.'
+ *  and 'e', it is always parseable by fast_atof().
+ */
+#ifndef AI_FAST_FTOA_H_INC
+#define AI_FAST_FTOA_H_INC
+
+#include <assimp/ai_assert.h>
+#include <assimp/vector2.h>
+#include <assimp/vector3.h>
+#include <assimp/color4.h>
+#include <assimp/matrix3x3.h>
+#include <assimp/matrix4x4.h>
+#include <assimp/types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdint.h>
+#include <stddef.h>
+
+/** Maximum number of characters written for one value, no terminator. */
+#define AI_FTOA_MAX_CHARS 32
+
+/** Maximum number of decimal places supported by fast_ftoa_fixed(). */
+#define AI_FTOA_MAX_FIXED_DIGITS 9
+
+namespace Assimp {
+namespace Grisu {
+
+// ---------------------------------------------------------------------------
+/** A floating point number f * 2^e with a 64 bit significand. */
+struct DiyFp {
+    uint64_t f;
+    int e;
+
+    DiyFp(uint64_t _f, int _e) : f(_f), e(_e) {}
+
+    // Both operands must have the same exponent and x.f >= y.f.
+    static DiyFp Sub(const DiyFp& x, const DiyFp& y) {
+        return DiyFp(x.f - y.f, x.e);
+    }
+
+    // Returns the upper 64 bits of the product, rounded.
+    static DiyFp Mul(const DiyFp& x, const DiyFp& y) {
+        const uint64_t xLo = x.f & 0xFFFFFFFFu, xHi = x.f >> 32;
+        const uint64_t yLo = y.f & 0xFFFFFFFFu, yHi = y.f >> 32;
+
+        const uint64_t p0 = xLo * yLo;
+        const uint64_t p1 = xLo * yHi;
+        const uint64_t p2 = xHi * yLo;
+        const uint64_t p3 = xHi * yHi;
+
+        uint64_t q = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+        q += uint64_t(1) << 31;
+        return DiyFp(p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e + y.e + 64);
+    }
+
+    static DiyFp Normalize(DiyFp x) {
+        while ((x.f >> 63) == 0) {
+            x.f <<= 1;
+            --x.e;
+        }
+        return x;
+    }
+
+    static DiyFp NormalizeTo(const DiyFp& x, int e) {
+        return DiyFp(x.f << (x.e - e), e);
+    }
+};
+
+// ---------------------------------------------------------------------------
+/** A finite, positive value together with the boundaries of the interval of
+ *  decimals which round to it. All three share the same exponent. */
+struct Boundaries {
+    DiyFp w, minus, plus;
+};
+
+template <typename TReal, typename TBits>
+inline Boundaries ComputeBoundaries(TReal value) {
+    static_assert(sizeof(TReal) == sizeof(TBits), "bit pattern size mismatch");
+
+    const int precision = std::numeric_limits<TReal>::digits; // including the hidden bit
+    const int bias = std::numeric_limits<TReal>::max_exponent - 1 + (precision - 1);
+    const uint64_t hiddenBit = uint64_t(1) << (precision - 1);
+
+    TBits bits;
+    ::memcpy(&bits, &value, sizeof(bits));
+    const uint64_t exponent = uint64_t(bits) >> (precision - 1);
+    const uint64_t fraction = uint64_t(bits) & (hiddenBit - 1);
+
+    const DiyFp v = exponent == 0
+        ? DiyFp(fraction, 1 - bias)
+        : DiyFp(fraction + hiddenBit, int(exponent) - bias);
+
+    // the lower boundary is closer if the fraction is zero, except for the smallest normal
+    const bool lowerIsCloser = fraction == 0 && exponent > 1;
+    const DiyFp plus = DiyFp::Normalize(DiyFp(2 * v.f + 1, v.e - 1));
+    const DiyFp minus = lowerIsCloser
+        ? DiyFp(4 * v.f - 1, v.e - 2)
+        : DiyFp(2 * v.f - 1, v.e - 1);
+
+    Boundaries b = { DiyFp::Normalize(v), DiyFp::NormalizeTo(minus, plus.e), plus };
+    return b;
+}
+
+// ---------------------------------------------------------------------------
+/** Returns the cached power of ten c = f * 2^e = 10^k so that the product of c
+ *  and a normalized DiyFp with the binary exponent e has an exponent in
+ *  [-60, -32], which lets the digits be generated with 32 bit arithmetic. */
+struct CachedPower {
+    uint64_t f;
+    int e;
+    int k;
+};
+
+inline const CachedPower& GetCachedPower(int e) {
+    static const CachedPower powers[] = {
+        { 0xAB70FE17C79AC6CA, -1060, -300 },
+        { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+        { 0xBE5691EF416BD60C, -1007, -284 },
+        { 0x8DD01FAD907FFC3C,  -980, -276 },
+        { 0xD3515C2831559A83,  -954, -268 },
+        { 0x9D71AC8FADA6C9B5,  -927, -260 },
+        { 0xEA9C227723EE8BCB,  -901, -252 },
+        { 0xAECC49914078536D,  -874, -244 },
+        { 0x823C12795DB6CE57,  -847, -236 },
+        { 0xC21094364DFB5637,  -821, -228 },
+        { 0x9096EA6F3848984F,  -794, -220 },
+        { 0xD77485CB25823AC7,  -768, -212 },
+        { 0xA086CFCD97BF97F4,  -741, -204 },
+        { 0xEF340A98172AACE5,  -715, -196 },
+        { 0xB23867FB2A35B28E,  -688, -188 },
+        { 0x84C8D4DFD2C63F3B,  -661, -180 },
+        { 0xC5DD44271AD3CDBA,  -635, -172 },
+        { 0x936B9FCEBB25C996,  -608, -164 },
+        { 0xDBAC6C247D62A584,  -582, -156 },
+        { 0xA3AB66580D5FDAF6,  -555, -148 },
+        { 0xF3E2F893DEC3F126,  -529, -140 },
+        { 0xB5B5ADA8AAFF80B8,  -502, -132 },
+        { 0x87625F056C7C4A8B,  -475, -124 },
+        { 0xC9BCFF6034C13053,  -449, -116 },
+        { 0x964E858C91BA2655,  -422, -108 },
+        { 0xDFF9772470297EBD,  -396, -100 },
+        { 0xA6DFBD9FB8E5B88F,  -369,  -92 },
+        { 0xF8A95FCF88747D94,  -343,  -84 },
+        { 0xB94470938FA89BCF,  -316,  -76 },
+        { 0x8A08F0F8BF0F156B,  -289,  -68 },
+        { 0xCDB02555653131B6,  -263,  -60 },
+        { 0x993FE2C6D07B7FAC,  -236,  -52 },
+        { 0xE45C10C42A2B3B06,  -210,  -44 },
+        { 0xAA242499697392D3,  -183,  -36 },
+        { 0xFD87B5F28300CA0E,  -157,  -28 },
+        { 0xBCE5086492111AEB,  -130,  -20 },
+        { 0x8CBCCC096F5088CC,  -103,  -12 },
+        { 0xD1B71758E219652C,   -77,   -4 },
+        { 0x9C40000000000000,   -50,    4 },
+        { 0xE8D4A51000000000,   -24,   12 },
+        { 0xAD78EBC5AC620000,     3,   20 },
+        { 0x813F3978F8940984,    30,   28 },
+        { 0xC097CE7BC90715B3,    56,   36 },
+        { 0x8F7E32CE7BEA5C70,    83,   44 },
+        { 0xD5D238A4ABE98068,   109,   52 },
+        { 0x9F4F2726179A2245,   136,   60 },
+        { 0xED63A231D4C4FB27,   162,   68 },
+        { 0xB0DE65388CC8ADA8,   189,   76 },
+        { 0x83C7088E1AAB65DB,   216,   84 },
+        { 0xC45D1DF942711D9A,   242,   92 },
+        { 0x924D692CA61BE758,   269,  100 },
+        { 0xDA01EE641A708DEA,   295,  108 },
+        { 0xA26DA3999AEF774A,   322,  116 },
+        { 0xF209787BB47D6B85,   348,  124 },
+        { 0xB454E4A179DD1877,   375,  132 },
+        { 0x865B86925B9BC5C2,   402,  140 },
+        { 0xC83553C5C8965D3D,   428,  148 },
+        { 0x952AB45CFA97A0B3,   455,  156 },
+        { 0xDE469FBD99A05FE3,   481,  164 },
+        { 0xA59BC234DB398C25,   508,  172 },
+        { 0xF6C69A72A3989F5C,   534,  180 },
+        { 0xB7DCBF5354E9BECE,   561,  188 },
+        { 0x88FCF317F22241E2,   588,  196 },
+        { 0xCC20CE9BD35C78A5,   614,  204 },
+        { 0x98165AF37B2153DF,   641,  212 },
+        { 0xE2A0B5DC971F303A,   667,  220 },
+        { 0xA8D9D1535CE3B396,   694,  228 },
+        { 0xFB9B7CD9A4A7443C,   720,  236 },
+        { 0xBB764C4CA7A44410,   747,  244 },
+        { 0x8BAB8EEFB6409C1A,   774,  252 },
+        { 0xD01FEF10A657842C,   800,  260 },
+        { 0x9B10A4E5E9913129,   827,  268 },
+        { 0xE7109BFBA19C0C9D,   853,  276 },
+        { 0xAC2820D9623BF429,   880,  284 },
+        { 0x80444B5E7AA7CF85,   907,  292 },
+        { 0xBF21E44003ACDD2D,   933,  300 },
+        { 0x8E679C2F5E44FF8F,   960,  308 },
+        { 0xD433179D9C8CB841,   986,  316 },
+        { 0x9E19DB92B4E31BA9,  1013,  324 },
+    };
+
+    // k = ceil((-61 - e) * log10(2)), the table starts at 10^-300 in steps of 10^8
+    const int f = -61 - e;
+    const int k = (f * 78913) / (1 << 18) + int(f > 0);
+    const int index = (300 + k + 7) / 8;
+    ai_assert(index >= 0 && index < int(sizeof(powers) / sizeof(powers[0])));
+    return powers[index];
+}
+
+// ---------------------------------------------------------------------------
+// Returns the number of decimal digits of n and the largest power of ten <= n.
+inline int LargestPow10(uint32_t n, uint32_t& pow10) {
+    int digits = 10;
+    pow10 = 1000000000;
+    while (digits > 1 && n < pow10) {
+        pow10 /= 10;
+        --digits;
+    }
+    return digits;
+}
+
+// ---------------------------------------------------------------------------
+// Moves the last digit towards w as long as the result stays in the interval.
+inline void RoundWeed(char* buffer, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK) {
+    while (rest < dist && delta - rest >= tenK
+            && (rest + tenK < dist || dist - rest > rest + tenK - dist)) {
+        --buffer[length - 1];
+        rest += tenK;
+    }
+}
+
+// ---------------------------------------------------------------------------
+/** Generates the shortest digits of a decimal in [minus, plus] close to w.
+ *  The value is digits * 10^exponent on return. */
+inline void GenerateDigits(char* buffer, int& length, int& exponent, const DiyFp& minus, const DiyFp& w, const DiyFp& plus) {
+    uint64_t delta = DiyFp::Sub(plus, minus).f;
+    uint64_t dist = DiyFp::Sub(plus, w).f;
+
+    // split plus into an integral part p1 and a fractional part p2
+    const int shift = -plus.e;
+    const uint64_t one = uint64_t(1) << shift;
+    uint32_t p1 = static_cast<uint32_t>(plus.f >> shift);
+    uint64_t p2 = plus.f & (one - 1);
+
+    uint32_t pow10;
+    int n = LargestPow10(p1, pow10);
+    while (n > 0) {
+        buffer[length++] = static_cast<char>('0' + p1 / pow10);
+        p1 %= pow10;
+        --n;
+
+        const uint64_t rest = (uint64_t(p1) << shift) + p2;
+        if (rest <= delta) {
+            exponent += n;
+            RoundWeed(buffer, length, dist, delta, rest, uint64_t(pow10) << shift);
+            return;
+        }
+        pow10 /= 10;
+    }
+
+    int m = 0;
+    for (;;) {
+        p2 *= 10;
+        buffer[length++] = static_cast<char>('0' + (p2 >> shift));
+        p2 &= one - 1;
+        ++m;
+
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta) {
+            break;
+        }
+    }
+    exponent -= m;
+    RoundWeed(buffer, length, dist, delta, p2, one);
+}
+
+// ---------------------------------------------------------------------------
+/** Writes the shortest digits of a finite, positive value to buffer, which
+ *  must hold 17 characters. The value is digits * 10^exponent on return. */
+template <typename TReal, typename TBits>
+inline int Digits(TReal value, char* buffer, int& exponent) {
+    const Boundaries b = ComputeBoundaries<TReal, TBits>(value);
+    const CachedPower& cached = GetCachedPower(b.plus.e);
+    const DiyFp c(cached.f, cached.e);
+
+    const DiyFp w = DiyFp::Mul(b.w, c);
+    const DiyFp minus = DiyFp::Mul(b.minus, c);
+    const DiyFp plus = DiyFp::Mul(b.plus, c);
+
+    // shrink the interval by one unit to stay safe from the rounding in Mul
+    int length = 0;
+    exponent = -cached.k;
+    GenerateDigits(buffer, length, exponent, DiyFp(minus.f + 1, minus.e), w, DiyFp(plus.f - 1, plus.e));
+    return length;
+}
+
+// ---------------------------------------------------------------------------
+/** Formats the digits d * 10^exponent in place. Values with a decimal
+ *  exponent in [-5, maxDigits) are written in plain notation, others in
+ *  scientific notation with at least two exponent digits, like "%g". */
+inline char* FormatDigits(char* buffer, int length, int exponent, int maxDigits) {
+    // the position of the decimal point relative to the first digit
+    const int point = length + exponent;
+
+    if (length <= point && point <= maxDigits) {
+        // digits followed by zeros: 1234000
+        ::memset(buffer + length, '0', size_t(point - length));
+        return buffer + point;
+    }
+    if (0 < point && point <= maxDigits) {
+        // 123.45
+        ::memmove(buffer + point + 1, buffer + point, size_t(length - point));
+        buffer[point] = '.';
+        return buffer + length + 1;
+    }
+    if (-4 < point && point <= 0) {
+        // 0.0012345
+        ::memmove(buffer + 2 - point, buffer, size_t(length));
+        buffer[0] = '0';
+        buffer[1] = '.';
+        ::memset(buffer + 2, '0', size_t(-point));
+        return buffer + 2 - point + length;
+    }
+
+    // 1.2345e-07
+    if (length > 1) {
+        ::memmove(buffer + 2, buffer + 1, size_t(length - 1));
+        buffer[1] = '.';
+        buffer += length + 1;
+    } else {
+        buffer += 1;
+    }
+    *buffer++ = 'e';
+
+    int e = point - 1;
+    if (e < 0) {
+        *buffer++ = '-';
+        e = -e;
+    } else {
+        *buffer++ = '+';
+    }
+    if (e >= 100) {
+        *buffer++ = static_cast<char>('0' + e / 100);
+        e %= 100;
+    }
+    *buffer++ = static_cast<char>('0' + e / 10);
+    *buffer++ = static_cast<char>('0' + e % 10);
+    return buffer;
+}
+
+// ---------------------------------------------------------------------------
+// Writes the sign and handles zero, infinity and NaN. Returns NULL if the
+// value is finite and not zero, so its digits must still be written.
+template <typename TReal>
+inline char* FormatSpecial(TReal value, char*& out) {
+    if (std::signbit(value) && !std::isnan(value)) {
+        *out++ = '-';
+    }
+    if (std::isnan(value)) {
+        ::memcpy(out, "nan", 3);
+        return out + 3;
+    }
+    if (std::isinf(value)) {
+        ::memcpy(out, "inf", 3);
+        return out + 3;
+    }
+    if (value == TReal(0)) {
+        *out = '0';
+        return out + 1;
+    }
+    return NULL;
+}
+
+template <typename TReal, typename TBits>
+inline char* Format(TReal value, char* out) {
+    if (char* end = FormatSpecial(value, out)) {
+        return end;
+    }
+
+    int exponent;
+    const int length = Digits<TReal, TBits>(std::fabs(value), out, exponent);
+    return FormatDigits(out, length, exponent, std::numeric_limits<TReal>::max_digits10);
+}
+
+} // ! namespace Grisu
+
+// ---------------------------------------------------------------------------
+/** Writes the shortest decimal representation of a float that reads back as
+ *  the same float. No terminator is written.
+ *  @param value The value to be formatted.
+ *  @param out   Output buffer, must hold AI_FTOA_MAX_CHARS characters.
+ *  @return Pointer behind the last written character. */
+inline char* fast_ftoa(float value, char* out) {
+    return Grisu::Format<float, uint32_t>(value, out);
+}
+
+// ---------------------------------------------------------------------------
+/** Writes the shortest decimal representation of a double that reads back
+ *  as the same double. See fast_ftoa(float, char*). */
+inline char* fast_ftoa(double value, char* out) {
+    return Grisu::Format<double, uint64_t>(value, out);
+}
+
+// ---------------------------------------------------------------------------
+/** Writes a value with a fixed number of decimal places like "%.*f", ties
+ *  are rounded to even. Values too large to be written this way, i.e.
+ *  |value| * 10^digits >= 2^53, are written like fast_ftoa(double, char*).
+ *  @param value  The value to be formatted.
+ *  @param digits Number of decimal places, at most AI_FTOA_MAX_FIXED_DIGITS.
+ *  @param out    Output buffer, must hold AI_FTOA_MAX_CHARS characters.
+ *  @return Pointer behind the last written character. */
+inline char* fast_ftoa_fixed(double value, unsigned int digits, char* out) {
+    ai_assert(digits <= AI_FTOA_MAX_FIXED_DIGITS);
+
+    static const double scales[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    const double scaled = std::fabs(value) * scales[digits];
+    if (!(scaled < 9007199254740992.0)) {
+        return fast_ftoa(value, out);
+    }
+
+    // exact for floats with up to six decimal places, their product has at most 44 bits
+    uint64_t n = static_cast<uint64_t>(scaled);
+    const double rest = scaled - double(n);
+    if (rest > 0.5 || (rest == 0.5 && (n & 1) != 0)) {
+        ++n;
+    }
+
+    if (std::signbit(value)) {
+        *out++ = '-';
+    }
+
+    // write the digits backwards, at least one before the point
+    char buffer[AI_FTOA_MAX_CHARS];
+    char* p = buffer + sizeof(buffer);
+    for (unsigned int i = 0; i < digits; ++i) {
+        *--p = static_cast<char>('0' + n % 10);
+        n /= 10;
+    }
+    if (digits > 0) {
+        *--p = '.';
+    }
+    do {
+        *--p = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n > 0);
+
+    const size_t length = size_t(buffer + sizeof(buffer) - p);
+    ::memcpy(out, p, length);
+    return out + length;
+}
+
+// ---------------------------------------------------------------------------
+/** Writes a sequence of values with fast_ftoa(), separated by a character.
+ *  @param values    The values to be formatted.
+ *  @param count     Number of values.
+ *  @param separator Character written between two values.
+ *  @param out       Output buffer, must hold count * AI_FTOA_MAX_CHARS characters.
+ *  @return Pointer behind the last written character. */
+template <typename TReal>
+inline char* fast_ftoa_n(const TReal* values, size_t count, char separator, char* out) {
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            *out++ = separator;
+        }
+        out = fast_ftoa(values[i], out);
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+/** Writes a sequence of values with fast_ftoa_fixed(), separated by a
+ *  character. See fast_ftoa_n(). */
+template <typename TReal>
+inline char* fast_ftoa_fixed_n(const TReal* values, size_t count, unsigned int digits, char separator, char* out) {
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            *out++ = separator;
+        }
+        out = fast_ftoa_fixed(values[i], digits, out);
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+/** One or more values to be written to a std::ostream with fast_ftoa() or
+ *  fast_ftoa_fixed(), independent of the stream's locale and precision.
+ *  Created by ShortestReals() and FixedReals(). A sequence only references
+ *  its values, so write it in the expression which created it:
+ *  @code
+ *  out << "v " << ShortestReals(mesh->mVertices[i]) << '\n';
+ *  @endcode
+ */
+template <typename TReal>
+struct FormattedReals {
+    const TReal* mValues;
+    size_t mCount;
+    char mSeparator;
+    int mDigits; // -1 for the shortest representation
+};
+
+template <typename TReal>
+inline std::ostream& operator << (std::ostream& out, const FormattedReals<TReal>& reals) {
+    // format in blocks to keep the number of stream calls low
+    static const size_t BlockSize = 16;
+    char buffer[BlockSize * (AI_FTOA_MAX_CHARS + 1)];
+
+    for (size_t i = 0; i < reals.mCount; i += BlockSize) {
+        char* p = buffer;
+        if (i > 0) {
+            *p++ = reals.mSeparator;
+        }
+        const size_t count = std::min(BlockSize, reals.mCount - i);
+        p = reals.mDigits < 0
+            ? fast_ftoa_n(reals.mValues + i, count, reals.mSeparator, p)
+            : fast_ftoa_fixed_n(reals.mValues + i, count, static_cast<unsigned int>(reals.mDigits), reals.mSeparator, p);
+        out.write(buffer, p - buffer);
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+/** Writes values in the shortest representation, see fast_ftoa(). */
+template <typename TReal>
+inline FormattedReals<TReal> ShortestReals(const TReal* values, size_t count, char separator = ' ') {
+    FormattedReals<TReal> reals = { values, count, separator, -1 };
+    return reals;
+}
+
+template <typename TReal>
+inline FormattedReals<TReal> ShortestReals(const TReal& value) {
+    return ShortestReals(&value, 1);
+}
+
+template <typename TReal>
+inline FormattedReals<TReal> ShortestReals(const aiVector2t<TReal>& v, char separator = ' ') {
+    return ShortestReals(&v.x, 2, separator);
+}
+
+template <typename TReal>
+inline FormattedReals<TReal> ShortestReals(const aiVector3t<TReal>& v, char separator = ' ') {
+    return ShortestReals(&v.x, 3, separator);
+}
+
+template <typename TReal>
+inline FormattedReals<TReal> ShortestReals(const aiColor4t<TReal>& c, char separator = ' ') {
+    return ShortestReals(&c.r, 4, separator);
+}
+
+inline FormattedReals<ai_real> ShortestReals(const aiColor3D& c, char separator = ' ') {
+    return ShortestReals(&c.r, 3, separator);
+}
+
+// Matrices are written row by row.
+template <typename TReal>
+inline FormattedReals<TReal> ShortestReals(const aiMatrix3x3t<TReal>& m, char separator = ' ') {
+    return ShortestReals(&m.a1, 9, separator);
+}
+
+template <typename TReal>
+inline FormattedReals<TReal> ShortestReals(const aiMatrix4x4t<TReal>& m, char separator = ' ') {
+    return ShortestReals(&m.a1, 16, separator);
+}
+
+// ---------------------------------------------------------------------------
+/** Writes values with a fixed number of decimal places, see fast_ftoa_fixed(). */
+template <typename TReal>
+inline FormattedReals<TReal> FixedReals(const TReal* values, size_t count, unsigned int digits, char separator = ' ') {
+    ai_assert(digits <= AI_FTOA_MAX_FIXED_DIGITS);
+    FormattedReals<TReal> reals = { values, count, separator, static_cast<int>(digits) };
+    return reals;
+}
+
+template <typename TReal>
+inline FormattedReals<TReal> FixedReals(const TReal& value, unsigned int digits) {
+    return FixedReals(&value, 1, digits);
+}
+
+} // ! namespace Assimp
+
+#endif // AI_FAST_FTOA_H_INC
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * glTF Extensions Support:
  *   KHR_materials_pbrSpecularGlossiness full
+ *   Open3DGC-compression: full (when built with Open3DGC)
  */
 #ifndef GLTF2ASSET_H_INC
 #define GLTF2ASSET_H_INC
@@ -264,6 +265,7 @@ namespace glTF2
     //! Values for the BufferView::target field
     enum BufferViewTarget
     {
+        BufferViewTarget_NONE = 0, //!< Not vertex or index data, e.g. a compressed stream
         BufferViewTarget_ARRAY_BUFFER = 34962,
         BufferViewTarget_ELEMENT_ARRAY_BUFFER = 34963
     };
@@ -442,6 +444,8 @@ namespace glTF2
         std::vector<float> max;      //!< Maximum value of each component in this attribute.
         std::vector<float> min;      //!< Minimum value of each component in this attribute.
 
+        shared_ptr<uint8_t> decodedData; //!< Tightly packed data of a compressed primitive, used instead of the bufferView.
+
         unsigned int GetNumComponents();
         unsigned int GetBytesPerComponent();
         unsigned int GetElementSize();
@@ -562,6 +566,8 @@ namespace glTF2
 	private:
 
 		shared_ptr<uint8_t> mData; //!< Pointer to the data
+		size_t mCapacity; //!< Size of the block behind mData, at least byteLength
+		bool mIsBorrowed; //!< mData points into a caller's read-only memory block, see LoadFromStream
 		bool mIsSpecial; //!< Set to true for special cases (e.g. the body buffer)
 
 		/// \var EncodedRegion_List
@@ -577,6 +583,13 @@ namespace glTF2
 
 		void Read(Value& obj, Asset& r);
 
+        /// \fn bool LoadFromStream(IOStream& stream, size_t length, size_t baseOffset)
+        /// Read the buffer contents from a stream. If the stream is a MemoryIOStream which does not own its
+        /// memory, the buffer borrows the memory block instead of copying it.
+        /// \param [in] stream - stream to read from.
+        /// \param [in] length - number of bytes to read, 0 for the whole stream.
+        /// \param [in] baseOffset - offset of the data in the stream, in bytes.
+        /// \return true - if the data was read successfully.
         bool LoadFromStream(IOStream& stream, size_t length = 0, size_t baseOffset = 0);
 
 		/// \fn void EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
@@ -605,9 +618,13 @@ namespace glTF2
         size_t AppendData(uint8_t* data, size_t length);
         void Grow(size_t amount);
 
+        /// The data must not be written through the pointer while IsBorrowed() is true.
         uint8_t* GetPointer()
             { return mData.get(); }
 
+        bool IsBorrowed() const
+            { return mIsBorrowed; }
+
         void MarkAsSpecial()
             { mIsSpecial = true; }
 
@@ -781,12 +798,31 @@ namespace glTF2
             Ref<Accessor> indices;
 
             Ref<Material> material;
+
+            /// \struct SCompression_Open3DGC
+            /// Indices and vertex attributes of the primitive compressed with the Open3DGC algorithm
+            /// ("Open3DGC-compression" extension). The accessors of a compressed primitive have no bufferView.
+            struct SCompression_Open3DGC
+            {
+                Ref<BufferView> bufferView;///< View of the compressed stream.
+                bool Binary;///< If true then "binary" mode is used for coding, if false - "ascii" mode.
+
+                SCompression_Open3DGC() : Binary(true) {}
+            } compression;
         };
 
         std::vector<Primitive> primitives;
 
         Mesh() {}
 
+		#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+			/// \fn void Decode_O3DGC(Primitive& pPrimitive)
+			/// Decode the compressed stream of a primitive into its accessors. Primitives not sharing
+			/// accessors can be decoded concurrently.
+			/// \param [in, out] pPrimitive - primitive with "Open3DGC-compression" extension.
+			static void Decode_O3DGC(Primitive& pPrimitive);
+		#endif
+
 		/// \fn void Read(Value& pJSON_Object, Asset& pAsset_Root)
 		/// Get mesh data from JSON-object and place them to root asset.
 		/// \param [in] pJSON_Object - reference to pJSON-object from which data are read.
@@ -1056,6 +1092,7 @@ namespace glTF2
         struct Extensions
         {
             bool KHR_materials_pbrSpecularGlossiness;
+            bool Open3DGC_compression;
 
         } extensionsUsed;
 
@@ -40,10 +40,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "StringUtils.h"
+#include "Base64.h"
+#include "MemoryIOWrapper.h"
 
 // Header files, Assimp
 #include <assimp/DefaultLogger.hpp>
 
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+	// Header files, Open3DGC.
+#	include <Open3DGC/o3dgcSC3DMCDecoder.h>
+#endif
+
 using namespace Assimp;
 
 namespace glTF2 {
@@ -324,7 +331,7 @@ Ref<T> LazyDict<T>::Create(const char* id)
 
 
 inline Buffer::Buffer()
-	: byteLength(0), type(Type_arraybuffer), EncodedRegion_Current(nullptr), mIsSpecial(false)
+	: byteLength(0), type(Type_arraybuffer), EncodedRegion_Current(nullptr), mCapacity(0), mIsBorrowed(false), mIsSpecial(false)
 { }
 
 inline Buffer::~Buffer()
@@ -358,6 +365,7 @@ inline void Buffer::Read(Value& obj, Asset& r)
             uint8_t* data = 0;
             this->byteLength = Util::DecodeBase64(dataURI.data, dataURI.dataLength, data);
             this->mData.reset(data, std::default_delete<uint8_t[]>());
+            this->mCapacity = this->byteLength;
 
             if (statedLength > 0 && this->byteLength != statedLength) {
                 throw DeadlyImportError("GLTF: buffer \"" + id + "\", expected " + to_string(statedLength) +
@@ -372,6 +380,7 @@ inline void Buffer::Read(Value& obj, Asset& r)
 
             this->mData.reset(new uint8_t[dataURI.dataLength], std::default_delete<uint8_t[]>());
             memcpy( this->mData.get(), dataURI.data, dataURI.dataLength );
+            this->mCapacity = dataURI.dataLength;
         }
     }
     else { // Local file
@@ -397,11 +406,25 @@ inline bool Buffer::LoadFromStream(IOStream& stream, size_t length, size_t baseO
 {
     byteLength = length ? length : stream.FileSize();
 
+    // Data read from a user-supplied memory block (e.g. Importer::ReadFileFromMemory)
+    // is referenced in place instead of being copied, the block outlives the import.
+    // The block is const: while mIsBorrowed is set nothing writes through mData,
+    // Grow() and ReplaceData() move the data to a block of their own first.
+    MemoryIOStream* memStream = dynamic_cast<MemoryIOStream*>(&stream);
+    if (memStream && !memStream->IsOwner() && baseOffset + byteLength <= memStream->FileSize()) {
+        mData.reset(const_cast<uint8_t*>(memStream->GetBuffer()) + baseOffset, [](uint8_t*) {});
+        mCapacity = 0;
+        mIsBorrowed = true;
+        return true;
+    }
+
     if (baseOffset) {
         stream.Seek(baseOffset, aiOrigin_SET);
     }
 
     mData.reset(new uint8_t[byteLength], std::default_delete<uint8_t[]>());
+    mCapacity = byteLength;
+    mIsBorrowed = false;
 
     if (stream.Read(mData.get(), byteLength, 1) != 1) {
         return false;
@@ -478,6 +501,8 @@ uint8_t* new_data;
 	// Apply new data
 	mData.reset(new_data, std::default_delete<uint8_t[]>());
 	byteLength = new_data_size;
+	mCapacity = new_data_size;
+	mIsBorrowed = false;
 
 	return true;
 }
@@ -486,6 +511,7 @@ inline size_t Buffer::AppendData(uint8_t* data, size_t length)
 {
     size_t offset = this->byteLength;
     Grow(length);
+    ai_assert(!mIsBorrowed || length == 0);
     memcpy(mData.get() + offset, data, length);
     return offset;
 }
@@ -493,9 +519,16 @@ inline size_t Buffer::AppendData(uint8_t* data, size_t length)
 inline void Buffer::Grow(size_t amount)
 {
     if (amount <= 0) return;
-    uint8_t* b = new uint8_t[byteLength + amount];
-    if (mData) memcpy(b, mData.get(), byteLength);
-    mData.reset(b, std::default_delete<uint8_t[]>());
+    if (byteLength + amount > mCapacity) {
+        // grow geometrically, the exporters append one accessor at a time.
+        // Borrowed data has no capacity, so it always ends up in a block of its own.
+        size_t capacity = std::max(byteLength + amount, mCapacity + mCapacity / 2);
+        uint8_t* b = new uint8_t[capacity];
+        if (mData) memcpy(b, mData.get(), byteLength);
+        mData.reset(b, std::default_delete<uint8_t[]>());
+        mCapacity = capacity;
+        mIsBorrowed = false;
+    }
     byteLength += amount;
 }
 
@@ -551,6 +584,7 @@ inline unsigned int Accessor::GetElementSize()
 
 inline uint8_t* Accessor::GetPointer()
 {
+    if (decodedData) return decodedData.get();
     if (!bufferView || !bufferView->buffer) return 0;
     uint8_t* basePtr = bufferView->buffer->GetPointer();
     if (!basePtr) return 0;
@@ -601,12 +635,12 @@ bool Accessor::ExtractData(T*& outData)
     const size_t elemSize = GetElementSize();
     const size_t totalSize = elemSize * count;
 
-    const size_t stride = bufferView && bufferView->byteStride ? bufferView->byteStride : elemSize;
+    const size_t stride = bufferView && bufferView->byteStride && !decodedData ? bufferView->byteStride : elemSize;
 
     const size_t targetElemSize = sizeof(T);
     ai_assert(elemSize <= targetElemSize);
 
-    ai_assert(count*stride <= bufferView->byteLength);
+    ai_assert(decodedData || count*stride <= bufferView->byteLength);
 
     outData = new T[count];
     if (stride == elemSize && targetElemSize == elemSize) {
@@ -641,7 +675,7 @@ inline Accessor::Indexer::Indexer(Accessor& acc)
     : accessor(acc)
     , data(acc.GetPointer())
     , elemSize(acc.GetElementSize())
-    , stride(acc.bufferView && acc.bufferView->byteStride ? acc.bufferView->byteStride : elemSize)
+    , stride(acc.bufferView && acc.bufferView->byteStride && !acc.decodedData ? acc.bufferView->byteStride : elemSize)
 {
 
 }
@@ -651,7 +685,7 @@ template<class T>
 T Accessor::Indexer::GetValue(int i)
 {
     ai_assert(data);
-    ai_assert(i*stride < accessor.bufferView->byteLength);
+    ai_assert(accessor.decodedData || i*stride < accessor.bufferView->byteLength);
     T value = T();
     memcpy(&value, data + i*stride, elemSize);
     //value >>= 8 * (sizeof(T) - elemSize);
@@ -929,10 +963,97 @@ inline void Mesh::Read(Value& pJSON_Object, Asset& pAsset_Root)
             if (Value* material = FindUInt(primitive, "material")) {
 				prim.material = pAsset_Root.materials.Retrieve(material->GetUint());
             }
+
+            /************** Primitive extensions **************/
+            Value* extensions = FindObject(primitive, "extensions");
+            if (Value* o3dgc = extensions ? FindObject(*extensions, "Open3DGC-compression") : nullptr) {
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+                Value* bufferView = FindUInt(*o3dgc, "bufferView");
+                if (!bufferView) throw DeadlyImportError("GLTF: \"Open3DGC-compression\" must has \"bufferView\".");
+
+                prim.compression.bufferView = pAsset_Root.bufferViews.Retrieve(bufferView->GetUint());
+                const char* mode_str;
+                prim.compression.Binary = !ReadMember(*o3dgc, "mode", mode_str) || strcmp(mode_str, "ascii") != 0;
+#else
+                (void)o3dgc;
+                throw DeadlyImportError("GLTF: \"Open3DGC-compression\" is not supported by this build.");
+#endif
+            }
         }
     }
 }
 
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+inline void Mesh::Decode_O3DGC(Primitive& pPrimitive)
+{
+    typedef unsigned short IndicesType;///< \sa glTF2Exporter::ExportMeshes.
+
+    o3dgc::SC3DMCDecoder<IndicesType> decoder;
+    o3dgc::IndexedFaceSet<IndicesType> ifs;
+    o3dgc::BinaryStream bstream;
+
+    Ref<BufferView> view = pPrimitive.compression.bufferView;
+    if (!view->buffer || !view->buffer->GetPointer() || view->byteOffset + view->byteLength > view->buffer->byteLength) {
+        throw DeadlyImportError("GLTF: Open3DGC. Compressed data out of the buffer bounds.");
+    }
+
+    bstream.LoadFromBuffer(view->buffer->GetPointer() + view->byteOffset, static_cast<unsigned long>(view->byteLength));
+
+    // After decoding header we can get size of primitives.
+    if (decoder.DecodeHeader(ifs, bstream) != o3dgc::O3DGC_OK) throw DeadlyImportError("GLTF: can not decode Open3DGC header.");
+
+    // Every array of the stream goes to the accessor of the primitive it replaces, after checking that their sizes match.
+    auto alloc_decoded = [](Ref<Accessor>& pAccessor, size_t pCount, AttribType::Value pType, ComponentType pComponentType, const char* pName) -> uint8_t* {
+        if (!pAccessor || pAccessor->count != pCount || pAccessor->type != pType || pAccessor->componentType != pComponentType) {
+            throw DeadlyImportError(std::string("GLTF: Open3DGC. Compressed ") + pName + " do not match the accessor of the primitive.");
+        }
+
+        pAccessor->decodedData.reset(new uint8_t[pCount * pAccessor->GetElementSize()], std::default_delete<uint8_t[]>());
+        return pAccessor->decodedData.get();
+    };
+
+    Primitive::Attributes& attr = pPrimitive.attributes;
+
+    // Indices
+    ifs.SetCoordIndex(reinterpret_cast<IndicesType*>(alloc_decoded(pPrimitive.indices, ifs.GetNCoordIndex() * 3, AttribType::SCALAR, ComponentType_UNSIGNED_SHORT, "indices")));
+    // Coordinates
+    if (attr.position.empty()) throw DeadlyImportError("GLTF: Open3DGC. Compressed primitive has no positions.");
+    ifs.SetCoord(reinterpret_cast<o3dgc::Real*>(alloc_decoded(attr.position[0], ifs.GetNCoord(), AttribType::VEC3, ComponentType_FLOAT, "positions")));
+    // Normals
+    if (ifs.GetNNormal() > 0) {
+        if (attr.normal.empty()) throw DeadlyImportError("GLTF: Open3DGC. Compressed normals missing in the primitive.");
+        ifs.SetNormal(reinterpret_cast<o3dgc::Real*>(alloc_decoded(attr.normal[0], ifs.GetNNormal(), AttribType::VEC3, ComponentType_FLOAT, "normals")));
+    }
+
+    // Additional attributes, only texture coordinates are written.
+    if (ifs.GetNumFloatAttributes() != attr.texcoord.size()) {
+        throw DeadlyImportError("GLTF: Open3DGC. Compressed texture coordinates do not match the primitive.");
+    }
+
+    for (unsigned long idx = 0; idx < ifs.GetNumFloatAttributes(); idx++) {
+        if (ifs.GetFloatAttributeType(idx) != o3dgc::O3DGC_IFS_FLOAT_ATTRIBUTE_TYPE_TEXCOORD) {
+            throw DeadlyImportError("GLTF: Open3DGC. Unsupported type of float attribute: " + to_string(ifs.GetFloatAttributeType(idx)));
+        }
+
+        const AttribType::Value type = ifs.GetFloatAttributeDim(idx) == 2 ? AttribType::VEC2 : AttribType::VEC3;
+        ifs.SetFloatAttribute(idx, reinterpret_cast<o3dgc::Real*>(alloc_decoded(attr.texcoord[idx], ifs.GetNFloatAttribute(idx), type, ComponentType_FLOAT, "texture coordinates")));
+    }
+
+    for (unsigned long idx = 0; idx < ifs.GetNumIntAttributes(); idx++) {
+        if (ifs.GetNIntAttribute(idx) > 0) {
+            throw DeadlyImportError("GLTF: Open3DGC. Unsupported type of int attribute: " + to_string(ifs.GetIntAttributeType(idx)));
+        }
+    }
+
+    //
+    // Decode data
+    //
+    if (decoder.DecodePayload(ifs, bstream) != o3dgc::O3DGC_OK) {
+        throw DeadlyImportError("GLTF: can not decode Open3DGC data.");
+    }
+}
+#endif
+
 inline void Camera::Read(Value& obj, Asset& /*r*/)
 {
     type = MemberOrDefault(obj, "type", Camera::Perspective);
@@ -1215,6 +1336,8 @@ inline void Asset::ReadExtensionsUsed(Document& doc)
     CHECK_EXT(KHR_materials_pbrSpecularGlossiness);
 
     #undef CHECK_EXT
+
+    if (exts.find("Open3DGC-compression") != exts.end()) extensionsUsed.Open3DGC_compression = true;
 }
 
 inline IOStream* Asset::OpenFile(std::string path, const char* mode, bool /*absolute*/)
@@ -1326,40 +1449,11 @@ namespace Util {
         return true;
     }
 
-    template<bool B>
-    struct DATA
-    {
-        static const uint8_t tableDecodeBase64[128];
-    };
-
-    template<bool B>
-    const uint8_t DATA<B>::tableDecodeBase64[128] = {
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 62,  0,  0,  0, 63,
-        52, 53, 54, 55, 56, 57, 58, 59, 60, 61,  0,  0,  0, 64,  0,  0,
-         0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
-        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,  0,  0,  0,  0,  0,
-         0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,  0,  0,  0,  0,  0
-    };
-
     inline char EncodeCharBase64(uint8_t b)
     {
         return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/="[size_t(b)];
     }
 
-    inline uint8_t DecodeCharBase64(char c)
-    {
-        return DATA<true>::tableDecodeBase64[size_t(c)]; // TODO faster with lookup table or ifs?
-        /*if (c >= 'A' && c <= 'Z') return c - 'A';
-        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-        if (c >= '0' && c <= '9') return c - '0' + 52;
-        if (c == '+') return 62;
-        if (c == '/') return 63;
-        return 64; // '-' */
-    }
-
     inline size_t DecodeBase64(const char* in, size_t inLength, uint8_t*& out)
     {
         ai_assert(inLength % 4 == 0);
@@ -1369,38 +1463,10 @@ namespace Util {
             return 0;
         }
 
-        int nEquals = int(in[inLength - 1] == '=') +
-                      int(in[inLength - 2] == '=');
-
-        size_t outLength = (inLength * 3) / 4 - nEquals;
+        // decode straight from the (in-situ parsed) JSON string into the buffer
+        const size_t outLength = Base64::DecodedLength(in, inLength);
         out = new uint8_t[outLength];
-        memset(out, 0, outLength);
-
-        size_t i, j = 0;
-
-        for (i = 0; i + 4 < inLength; i += 4) {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
-
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            out[j++] = (uint8_t)((b2 << 6) | b3);
-        }
-
-        {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
-
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            if (b2 < 64) out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            if (b3 < 64) out[j++] = (uint8_t)((b2 << 6) | b3);
-        }
-
-        return outLength;
+        return Base64::Decode(in, inLength, out);
     }
 
 
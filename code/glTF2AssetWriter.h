@@ -64,8 +64,6 @@ class AssetWriter
 
 private:
 
-    void WriteBinaryData(IOStream* outfile, size_t sceneLength);
-
     void WriteMetadata();
     void WriteExtensionsUsed();
 
@@ -81,6 +79,7 @@ public:
     AssetWriter(Asset& asset);
 
     void WriteFile(const char* path);
+    void WriteGLBFile(const char* path);
 };
 
 }
@@ -95,8 +95,10 @@ namespace glTF2 {
 
     inline void Write(Value& obj, Accessor& a, AssetWriter& w)
     {
-        obj.AddMember("bufferView", a.bufferView->index, w.mAl);
-        obj.AddMember("byteOffset", a.byteOffset, w.mAl);
+        if (a.bufferView) { // the data of compressed primitives lives in the extension
+            obj.AddMember("bufferView", a.bufferView->index, w.mAl);
+            obj.AddMember("byteOffset", a.byteOffset, w.mAl);
+        }
 
         obj.AddMember("componentType", int(a.componentType), w.mAl);
         obj.AddMember("count", a.count, w.mAl);
@@ -156,7 +158,9 @@ namespace glTF2 {
     inline void Write(Value& obj, Buffer& b, AssetWriter& w)
     {
         obj.AddMember("byteLength", static_cast<uint64_t>(b.byteLength), w.mAl);
-        obj.AddMember("uri", Value(b.GetURI(), w.mAl).Move(), w.mAl);
+        if (!b.IsSpecial()) { // the body buffer of a .glb has no uri
+            obj.AddMember("uri", Value(b.GetURI(), w.mAl).Move(), w.mAl);
+        }
     }
 
     inline void Write(Value& obj, BufferView& bv, AssetWriter& w)
@@ -167,7 +171,9 @@ namespace glTF2 {
         if (bv.byteStride != 0) {
             obj.AddMember("byteStride", bv.byteStride, w.mAl);
         }
-        obj.AddMember("target", int(bv.target), w.mAl);
+        if (bv.target != BufferViewTarget_NONE) {
+            obj.AddMember("target", int(bv.target), w.mAl);
+        }
     }
 
     inline void Write(Value& /*obj*/, Camera& /*c*/, AssetWriter& /*w*/)
@@ -385,6 +391,18 @@ namespace glTF2 {
                     WriteAttrs(w, attrs, p.attributes.weight, "WEIGHTS", true);
                 }
                 prim.AddMember("attributes", attrs, w.mAl);
+
+                if (p.compression.bufferView) {
+                    Value o3dgc;
+                    o3dgc.SetObject();
+                    o3dgc.AddMember("bufferView", p.compression.bufferView->index, w.mAl);
+                    o3dgc.AddMember("mode", StringRef(p.compression.Binary ? "binary" : "ascii"), w.mAl);
+
+                    Value exts;
+                    exts.SetObject();
+                    exts.AddMember("Open3DGC-compression", o3dgc, w.mAl);
+                    prim.AddMember("extensions", exts, w.mAl);
+                }
             }
             primitives.PushBack(prim, w.mAl);
         }
@@ -561,6 +579,76 @@ namespace glTF2 {
         }
     }
 
+    inline void AssetWriter::WriteGLBFile(const char* path)
+    {
+        std::unique_ptr<IOStream> outfile(mAsset.OpenFile(path, "wb", true));
+
+        if (outfile == 0) {
+            throw DeadlyExportError("Could not open output file: " + std::string(path));
+        }
+
+        StringBuffer docBuffer;
+        Writer<StringBuffer> writer(docBuffer);
+        mDoc.Accept(writer);
+
+        // Both chunks are padded to 4 bytes, the JSON with spaces and the body with zeros
+        const size_t jsonLength = docBuffer.GetSize();
+        const size_t jsonPadding = ((jsonLength + 3) & ~3) - jsonLength;
+
+        Ref<Buffer> b = mAsset.GetBodyBuffer();
+        const size_t bodyLength = b ? b->byteLength : 0;
+        const size_t bodyPadding = ((bodyLength + 3) & ~3) - bodyLength;
+
+        size_t totalLength = sizeof(GLB_Header) + sizeof(GLB_Chunk) + jsonLength + jsonPadding;
+        if (bodyLength > 0) {
+            totalLength += sizeof(GLB_Chunk) + bodyLength + bodyPadding;
+        }
+        if (totalLength > 0xffffffffu) {
+            throw DeadlyExportError("GLTF: scene too large for a binary glTF file");
+        }
+
+        // All lengths are known up front, so the file is written front to back
+        // and the body goes straight from the buffer into the stream
+        GLB_Header header;
+        memcpy(header.magic, AI_GLB_MAGIC_NUMBER, sizeof(header.magic));
+        header.version = 2;
+        AI_SWAP4(header.version);
+        header.length = uint32_t(totalLength);
+        AI_SWAP4(header.length);
+
+        if (outfile->Write(&header, 1, sizeof(header)) != sizeof(header)) {
+            throw DeadlyExportError("Failed to write the header!");
+        }
+
+        GLB_Chunk jsonChunk;
+        jsonChunk.chunkLength = uint32_t(jsonLength + jsonPadding);
+        AI_SWAP4(jsonChunk.chunkLength);
+        jsonChunk.chunkType = ChunkType_JSON;
+        AI_SWAP4(jsonChunk.chunkType);
+
+        static const char spaces[] = "   ";
+        if (outfile->Write(&jsonChunk, 1, sizeof(jsonChunk)) != sizeof(jsonChunk) ||
+            outfile->Write(docBuffer.GetString(), 1, jsonLength) != jsonLength ||
+            (jsonPadding > 0 && outfile->Write(spaces, 1, jsonPadding) != jsonPadding)) {
+            throw DeadlyExportError("Failed to write scene data!");
+        }
+
+        if (bodyLength > 0) {
+            GLB_Chunk binaryChunk;
+            binaryChunk.chunkLength = uint32_t(bodyLength + bodyPadding);
+            AI_SWAP4(binaryChunk.chunkLength);
+            binaryChunk.chunkType = ChunkType_BIN;
+            AI_SWAP4(binaryChunk.chunkType);
+
+            static const uint8_t zeros[] = { 0, 0, 0 };
+            if (outfile->Write(&binaryChunk, 1, sizeof(binaryChunk)) != sizeof(binaryChunk) ||
+                outfile->Write(b->GetPointer(), 1, bodyLength) != bodyLength ||
+                (bodyPadding > 0 && outfile->Write(zeros, 1, bodyPadding) != bodyPadding)) {
+                throw DeadlyExportError("Failed to write body data!");
+            }
+        }
+    }
+
     inline void AssetWriter::WriteMetadata()
     {
         Value asset;
@@ -579,10 +667,22 @@ namespace glTF2 {
             if (this->mAsset.extensionsUsed.KHR_materials_pbrSpecularGlossiness) {
                 exts.PushBack(StringRef("KHR_materials_pbrSpecularGlossiness"), mAl);
             }
+
+            if (this->mAsset.extensionsUsed.Open3DGC_compression) {
+                exts.PushBack(StringRef("Open3DGC-compression"), mAl);
+            }
         }
 
         if (!exts.Empty())
             mDoc.AddMember("extensionsUsed", exts, mAl);
+
+        // Compressed primitives cannot be read without the extension
+        if (this->mAsset.extensionsUsed.Open3DGC_compression) {
+            Value required;
+            required.SetArray();
+            required.PushBack(StringRef("Open3DGC-compression"), mAl);
+            mDoc.AddMember("extensionsRequired", required, mAl);
+        }
     }
 
     template<class T>
@@ -612,8 +712,6 @@ namespace glTF2 {
         }
 
         for (size_t i = 0; i < d.mObjs.size(); ++i) {
-            if (d.mObjs[i]->IsSpecial()) continue;
-
             Value obj;
             obj.SetObject();
 
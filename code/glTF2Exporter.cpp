@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ByteSwapper.h"
 
 #include "SplitLargeMeshes.h"
+#include "Hash.h"
 
 #include <assimp/SceneCombiner.h>
 #include <assimp/version.h>
@@ -55,6 +56,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exporter.hpp>
 #include <assimp/material.h>
 #include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
 
 // Header files, standard library.
 #include <memory>
@@ -62,6 +64,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "glTF2AssetWriter.h"
 
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+	// Header files, Open3DGC.
+#	include <Open3DGC/o3dgcSC3DMCEncoder.h>
+#endif
+
 using namespace rapidjson;
 
 using namespace Assimp;
@@ -77,10 +84,18 @@ namespace Assimp {
         glTF2Exporter exporter(pFile, pIOSystem, pScene, pProperties, false);
     }
 
+    // ------------------------------------------------------------------------------------------------
+    // Worker function for exporting a scene to GLB. Prototyped and registered in Exporter.cpp
+    void ExportSceneGLB2(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
+    {
+        // invoke the exporter
+        glTF2Exporter exporter(pFile, pIOSystem, pScene, pProperties, true);
+    }
+
 } // end of namespace Assimp
 
 glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const aiScene* pScene,
-                           const ExportProperties* pProperties, bool /*isBinary*/)
+                           const ExportProperties* pProperties, bool isBinary)
     : mFilename(filename)
     , mIOSystem(pIOSystem)
     , mProperties(pProperties)
@@ -101,6 +116,10 @@ glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const ai
 
     mAsset.reset( new Asset( pIOSystem ) );
 
+    if (isBinary) {
+        mAsset->SetAsBinary();
+    }
+
     ExportMetadata();
 
     ExportMaterials();
@@ -118,7 +137,11 @@ glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const ai
 
     AssetWriter writer(*mAsset);
 
-    writer.WriteFile(filename);
+    if (isBinary) {
+        writer.WriteGLBFile(filename);
+    } else {
+        writer.WriteFile(filename);
+    }
 }
 
 /*
@@ -160,7 +183,7 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
 
     size_t offset = buffer->byteLength;
     // make sure offset is correctly byte-aligned, as required by spec
-    size_t padding = offset % bytesPerComp;
+    size_t padding = (bytesPerComp - offset % bytesPerComp) % bytesPerComp;
     offset += padding;
     size_t length = count * numCompsOut * bytesPerComp;
     buffer->Grow(length + padding);
@@ -216,6 +239,287 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     return acc;
 }
 
+/*
+ * A vertex or index stream stored in the buffer, found again by the hash of its bytes
+ * when another mesh carries the same data.
+ */
+struct SharedStream
+{
+    std::string layout;
+    Ref<BufferView> view;
+    std::vector< Ref<Accessor> > accessors;
+};
+
+typedef std::multimap<uint32_t, SharedStream> SharedStreams;
+
+static SharedStream* FindSharedStream(SharedStreams& streams, uint32_t hash,
+    const std::string& layout, const uint8_t* data, size_t length)
+{
+    std::pair<SharedStreams::iterator, SharedStreams::iterator> range = streams.equal_range(hash);
+    for (SharedStreams::iterator it = range.first; it != range.second; ++it) {
+        SharedStream& s = it->second;
+        if (s.layout == layout && s.view->byteLength == length &&
+            !memcmp(s.view->buffer->GetPointer() + s.view->byteOffset, data, length)) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+static void SetMinMax(Accessor& acc, const aiVector3D* data, unsigned int count, unsigned int numComps)
+{
+    acc.min.assign(numComps,  10000000000000.0f);
+    acc.max.assign(numComps, -10000000000000.0f);
+
+    for (unsigned int i = 0; i < count; ++i) {
+        for (unsigned int j = 0; j < numComps; ++j) {
+            acc.min[j] = std::min(acc.min[j], static_cast<float>(data[i][j]));
+            acc.max[j] = std::max(acc.max[j], static_cast<float>(data[i][j]));
+        }
+    }
+}
+
+/*
+ * Write positions, normals and texture coordinates of a mesh into one bufferView,
+ * one vertex after the other. The stride is a multiple of 4 as all components are floats.
+ * A mesh with the same vertex data as an earlier one reuses its accessors.
+ */
+static void ExportInterleavedVertices(Asset& a, const aiMesh* aim, std::string& meshId, Ref<Buffer>& buffer,
+    SharedStreams& shared, Mesh::Primitive& p)
+{
+    const unsigned int count = aim->mNumVertices;
+
+    std::vector<const aiVector3D*> streams;
+    std::vector<unsigned int> numComps;
+    std::vector<Mesh::AccessorList*> targets;
+
+    if (aim->mVertices) {
+        streams.push_back(aim->mVertices);
+        numComps.push_back(3);
+        targets.push_back(&p.attributes.position);
+    }
+    if (aim->mNormals) {
+        streams.push_back(aim->mNormals);
+        numComps.push_back(3);
+        targets.push_back(&p.attributes.normal);
+    }
+    for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        if (aim->mNumUVComponents[i] > 0 && aim->mTextureCoords[i]) {
+            streams.push_back(aim->mTextureCoords[i]);
+            numComps.push_back(aim->mNumUVComponents[i] == 2 ? 2 : 3);
+            targets.push_back(&p.attributes.texcoord);
+        }
+    }
+
+    if (!count || streams.empty()) return;
+
+    std::string layout;
+    size_t stride = 0;
+    for (size_t s = 0; s < streams.size(); ++s) {
+        layout += char('0' + numComps[s]);
+        stride += numComps[s] * sizeof(float);
+    }
+
+    std::vector<uint8_t> vertices(count * stride);
+    uint8_t* dst = &vertices[0];
+    for (unsigned int i = 0; i < count; ++i) {
+        for (size_t s = 0; s < streams.size(); ++s) {
+            memcpy(dst, &streams[s][i], numComps[s] * sizeof(float));
+            dst += numComps[s] * sizeof(float);
+        }
+    }
+
+    uint32_t hash = SuperFastHash(reinterpret_cast<const char*>(&vertices[0]), uint32_t(vertices.size()));
+    hash = SuperFastHash(layout.c_str(), uint32_t(layout.size()), hash);
+
+    if (SharedStream* found = FindSharedStream(shared, hash, layout, &vertices[0], vertices.size())) {
+        for (size_t s = 0; s < streams.size(); ++s) {
+            targets[s]->push_back(found->accessors[s]);
+        }
+        return;
+    }
+
+    // bufferView, aligned to 4 bytes as required for float attributes
+    size_t offset = buffer->byteLength;
+    size_t padding = ((offset + 3) & ~size_t(3)) - offset;
+    buffer->Grow(padding + vertices.size());
+    ai_assert(!buffer->IsBorrowed());
+    memset(buffer->GetPointer() + offset, 0, padding);
+    offset += padding;
+    memcpy(buffer->GetPointer() + offset, &vertices[0], vertices.size());
+
+    SharedStream stream;
+    stream.layout = layout;
+    stream.view = a.bufferViews.Create(a.FindUniqueID(meshId, "view"));
+    stream.view->buffer = buffer;
+    stream.view->byteOffset = offset;
+    stream.view->byteLength = vertices.size();
+    stream.view->byteStride = unsigned(stride);
+    stream.view->target = BufferViewTarget_ARRAY_BUFFER;
+
+    // one accessor per attribute, at its offset within the vertex
+    size_t attribOffset = 0;
+    for (size_t s = 0; s < streams.size(); ++s) {
+        Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshId, "accessor"));
+        acc->bufferView = stream.view;
+        acc->byteOffset = unsigned(attribOffset);
+        acc->componentType = ComponentType_FLOAT;
+        acc->count = count;
+        acc->type = numComps[s] == 2 ? AttribType::VEC2 : AttribType::VEC3;
+        SetMinMax(*acc, streams[s], count, numComps[s]);
+
+        targets[s]->push_back(acc);
+        stream.accessors.push_back(acc);
+        attribOffset += numComps[s] * sizeof(float);
+    }
+
+    shared.insert(std::make_pair(hash, stream));
+}
+
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+/*
+ * Encode indices, positions, normals and texture coordinates of a triangle mesh with Open3DGC.
+ * The accessors describe the data (count, type, bounds) but have no bufferView, the data is in
+ * the compressed stream referenced by the "Open3DGC-compression" extension of the primitive.
+ */
+static void ExportCompressedPrimitive(Asset& a, const aiMesh* aim, std::string& meshId, Ref<Buffer>& buffer,
+    Mesh::Primitive& p, const ExportProperties* props)
+{
+    typedef unsigned short IndicesType;///< \sa glTF2Exporter::ExportMeshes.
+
+    o3dgc::BinaryStream bs;
+    o3dgc::SC3DMCEncoder<IndicesType> encoder;
+    o3dgc::IndexedFaceSet<IndicesType> ifs;
+    o3dgc::SC3DMCEncodeParams params;
+
+    const unsigned int count = aim->mNumVertices;
+
+    auto create_accessor = [&](AttribType::Value type, ComponentType compType, unsigned int n) -> Ref<Accessor> {
+        Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshId, "accessor"));
+        acc->byteOffset = 0;
+        acc->componentType = compType;
+        acc->count = n;
+        acc->type = type;
+        return acc;
+    };
+
+    // IndexedFacesSet: "Crease angle", "solid", "convex" are set to default.
+    ifs.SetCCW(true);
+    ifs.SetIsTriangularMesh(true);
+    ifs.SetNumFloatAttributes(0);
+
+    // Coordinates
+    params.SetCoordQuantBits(props->GetPropertyInteger("extensions.Open3DGC.quantization.POSITION", 12));
+    params.SetCoordPredMode(o3dgc::O3DGC_SC3DMC_PARALLELOGRAM_PREDICTION);
+    ifs.SetNCoord(count);
+    ifs.SetCoord(reinterpret_cast<o3dgc::Real*>(aim->mVertices));
+
+    Ref<Accessor> v = create_accessor(AttribType::VEC3, ComponentType_FLOAT, count);
+    SetMinMax(*v, aim->mVertices, count, 3);
+    p.attributes.position.push_back(v);
+
+    // Normals
+    if (aim->mNormals) {
+        params.SetNormalQuantBits(props->GetPropertyInteger("extensions.Open3DGC.quantization.NORMAL", 10));
+        params.SetNormalPredMode(o3dgc::O3DGC_SC3DMC_SURF_NORMALS_PREDICTION);
+        ifs.SetNNormal(count);
+        ifs.SetNormal(reinterpret_cast<o3dgc::Real*>(aim->mNormals));
+
+        Ref<Accessor> n = create_accessor(AttribType::VEC3, ComponentType_FLOAT, count);
+        SetMinMax(*n, aim->mNormals, count, 3);
+        p.attributes.normal.push_back(n);
+    }
+
+    // Texture coordinates, packed to their number of components
+    std::vector< std::vector<float> > texcoords;
+    texcoords.reserve(AI_MAX_NUMBER_OF_TEXTURECOORDS);
+    for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        if (aim->mNumUVComponents[i] == 0 || !aim->mTextureCoords[i]) continue;
+
+        const unsigned int dim = aim->mNumUVComponents[i] == 2 ? 2 : 3;
+        texcoords.push_back(std::vector<float>(count * dim));
+        std::vector<float>& tc = texcoords.back();
+        for (unsigned int j = 0; j < count; ++j) {
+            for (unsigned int k = 0; k < dim; ++k) {
+                tc[j * dim + k] = aim->mTextureCoords[i][j][k];
+            }
+        }
+
+        const unsigned long num = ifs.GetNumFloatAttributes();
+        params.SetFloatAttributeQuantBits(num, props->GetPropertyInteger("extensions.Open3DGC.quantization.TEXCOORD", 10));
+        params.SetFloatAttributePredMode(num, o3dgc::O3DGC_SC3DMC_PARALLELOGRAM_PREDICTION);
+        ifs.SetNFloatAttribute(num, count);
+        ifs.SetFloatAttributeDim(num, dim);
+        ifs.SetFloatAttributeType(num, o3dgc::O3DGC_IFS_FLOAT_ATTRIBUTE_TYPE_TEXCOORD);
+        ifs.SetFloatAttribute(num, &tc[0]);
+        ifs.SetNumFloatAttributes(num + 1);
+
+        Ref<Accessor> t = create_accessor(dim == 2 ? AttribType::VEC2 : AttribType::VEC3, ComponentType_FLOAT, count);
+        SetMinMax(*t, aim->mTextureCoords[i], count, dim);
+        p.attributes.texcoord.push_back(t);
+    }
+
+    // Coordinates indices
+    std::vector<IndicesType> indices(aim->mNumFaces * 3);
+    for (unsigned int i = 0; i < aim->mNumFaces; ++i) {
+        for (unsigned int j = 0; j < 3; ++j) {
+            indices[i * 3 + j] = IndicesType(aim->mFaces[i].mIndices[j]);
+        }
+    }
+    ifs.SetNCoordIndex(aim->mNumFaces);
+    ifs.SetCoordIndex(&indices[0]);
+
+    p.indices = create_accessor(AttribType::SCALAR, ComponentType_UNSIGNED_SHORT, unsigned(indices.size()));
+    p.indices->min.push_back(*std::min_element(indices.begin(), indices.end()));
+    p.indices->max.push_back(*std::max_element(indices.begin(), indices.end()));
+
+    //
+    // Encoding
+    //
+    const bool binary = props->GetPropertyBool("extensions.Open3DGC.binary", true);
+    params.SetNumFloatAttributes(ifs.GetNumFloatAttributes());
+    params.SetStreamType(binary ? o3dgc::O3DGC_STREAM_TYPE_BINARY : o3dgc::O3DGC_STREAM_TYPE_ASCII);
+    ifs.ComputeMinMax(o3dgc::O3DGC_SC3DMC_MAX_ALL_DIMS);
+    encoder.Encode(params, ifs, bs);
+
+    Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshId, "view"));
+    bv->buffer = buffer;
+    bv->byteOffset = buffer->AppendData(bs.GetBuffer(), bs.GetSize());
+    bv->byteLength = bs.GetSize();
+    bv->byteStride = 0;
+    bv->target = BufferViewTarget_NONE;
+
+    p.compression.bufferView = bv;
+    p.compression.Binary = binary;
+    a.extensionsUsed.Open3DGC_compression = true;
+}
+#endif
+
+template<class T>
+static Ref<Accessor> ExportSharedIndices(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    SharedStreams& shared, std::vector<T>& indices, ComponentType compType)
+{
+    static const std::string layout = "indices";
+    const size_t length = indices.size() * sizeof(T);
+
+    uint32_t hash = SuperFastHash(reinterpret_cast<const char*>(&indices[0]), uint32_t(length));
+    hash = SuperFastHash(layout.c_str(), uint32_t(layout.size()), hash);
+
+    if (SharedStream* found = FindSharedStream(shared, hash, layout, reinterpret_cast<const uint8_t*>(&indices[0]), length)) {
+        return found->accessors[0];
+    }
+
+    Ref<Accessor> acc = ExportData(a, meshName, buffer, unsigned(indices.size()), &indices[0], AttribType::SCALAR, AttribType::SCALAR, compType, true);
+
+    SharedStream stream;
+    stream.layout = layout;
+    stream.view = acc->bufferView;
+    stream.accessors.push_back(acc);
+    shared.insert(std::make_pair(hash, stream));
+
+    return acc;
+}
+
 inline void SetSamplerWrap(SamplerWrap& wrap, aiTextureMapMode map)
 {
     switch (map) {
@@ -648,6 +952,14 @@ void glTF2Exporter::ExportMeshes()
     std::string bufferIdPrefix = fname.substr(0, fname.rfind(".gltf"));
     std::string bufferId = mAsset->FindUniqueID("", bufferIdPrefix.c_str());
 
+    const bool interleaved = mProperties && mProperties->GetPropertyBool(AI_CONFIG_EXPORT_GLTF_INTERLEAVED);
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+    const bool compress = mProperties && mProperties->GetPropertyBool("extensions.Open3DGC.use", false);
+#else
+    const bool compress = false;
+#endif
+    SharedStreams sharedStreams;
+
     Ref<Buffer> b = mAsset->GetBodyBuffer();
     if (!b) {
        b = mAsset->buffers.Create(bufferId);
@@ -687,33 +999,55 @@ void glTF2Exporter::ExportMeshes()
 
         p.material = mAsset->materials.Get(aim->mMaterialIndex);
 
-		/******************* Vertices ********************/
-        Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
-		if (v) p.attributes.position.push_back(v);
-
-		/******************** Normals ********************/
-		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
-		if (n) p.attributes.normal.push_back(n);
-
-		/************** Texture coordinates **************/
+        // Flip UV y coords
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
-            // Flip UV y coords
             if (aim -> mNumUVComponents[i] > 1) {
                 for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
                     aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
                 }
             }
+        }
+
+        // Check if compressing requested and mesh can be encoded.
+        bool compressed = false;
+        if (compress) {
+            if (aim->mPrimitiveTypes == aiPrimitiveType_TRIANGLE && aim->mNumVertices > 0 && aim->mNumFaces > 0) {
+                compressed = true;
+            } else {
+                DefaultLogger::get()->warn("GLTF: can not use Open3DGC-compression: all primitives of the mesh must be triangles.");
+            }
+        }
 
-            if (aim->mNumUVComponents[i] > 0) {
-                AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
+        if (compressed) {
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+            /********* Compressed vertices and indices *********/
+            ExportCompressedPrimitive(*mAsset, aim, meshId, b, p, mProperties);
+#endif
+        } else if (interleaved) {
+            /********* Vertices, normals, texture coordinates *********/
+            ExportInterleavedVertices(*mAsset, aim, meshId, b, sharedStreams, p);
+        } else {
+            /******************* Vertices ********************/
+            Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+            if (v) p.attributes.position.push_back(v);
 
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false);
-				if (tc) p.attributes.texcoord.push_back(tc);
-			}
-		}
+            /******************** Normals ********************/
+            Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+            if (n) p.attributes.normal.push_back(n);
+
+            /************** Texture coordinates **************/
+            for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+                if (aim->mNumUVComponents[i] > 0) {
+                    AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
+
+                    Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false);
+                    if (tc) p.attributes.texcoord.push_back(tc);
+                }
+            }
+        }
 
 		/*************** Vertices indices ****************/
-		if (aim->mNumFaces > 0) {
+		if (aim->mNumFaces > 0 && !compressed) {
 			std::vector<IndicesType> indices;
 			unsigned int nIndicesPerFace = aim->mFaces[0].mNumIndices;
             indices.resize(aim->mNumFaces * nIndicesPerFace);
@@ -723,7 +1057,11 @@ void glTF2Exporter::ExportMeshes()
                 }
             }
 
-			p.indices = ExportData(*mAsset, meshId, b, unsigned(indices.size()), &indices[0], AttribType::SCALAR, AttribType::SCALAR, ComponentType_UNSIGNED_SHORT, true);
+            if (interleaved) {
+                p.indices = ExportSharedIndices(*mAsset, meshId, b, sharedStreams, indices, ComponentType_UNSIGNED_SHORT);
+            } else {
+                p.indices = ExportData(*mAsset, meshId, b, unsigned(indices.size()), &indices[0], AttribType::SCALAR, AttribType::SCALAR, ComponentType_UNSIGNED_SHORT, true);
+            }
 		}
 
         switch (aim->mPrimitiveTypes) {
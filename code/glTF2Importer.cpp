@@ -52,8 +52,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/importerdesc.h>
 
 #include <memory>
+#include <set>
 
 #include "MakeVerboseFormat.h"
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+#   include "ParallelFor.h"
+#endif
 
 #include "glTF2Asset.h"
 // This is included here so WriteLazyDict<T>'s definition is found.
@@ -86,7 +90,8 @@ glTF2Importer::glTF2Importer()
 : BaseImporter()
 , meshOffsets()
 , embeddedTexIdxs()
-, mScene( NULL ) {
+, mScene( NULL )
+, numThreads( 0 ) {
     // empty
 }
 
@@ -99,6 +104,11 @@ const aiImporterDesc* glTF2Importer::GetInfo() const
     return &desc;
 }
 
+void glTF2Importer::SetupProperties(const Importer* pImp)
+{
+    numThreads = std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NUM_THREADS, 0));
+}
+
 bool glTF2Importer::CanRead(const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const
 {
     const std::string &extension = GetExtension(pFile);
@@ -310,10 +320,56 @@ static inline bool CheckValidFacesIndices(aiFace* faces, unsigned nFaces, unsign
 }
 #endif // ASSIMP_BUILD_DEBUG
 
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+// Decode the primitives with "Open3DGC-compression" extension. Every primitive writes only to its
+// own accessors, so they are decoded in parallel.
+static void DecodeCompressedPrimitives(glTF2::Asset& r, unsigned int numThreads)
+{
+    std::vector<Mesh::Primitive*> compressed;
+    std::set<Accessor*> accessors;
+
+    auto claim = [&accessors](Ref<Accessor>& acc) {
+        if (acc && !accessors.insert(&*acc).second) {
+            throw DeadlyImportError("GLTF: Open3DGC. Compressed primitives must not share accessors.");
+        }
+    };
+
+    for (unsigned int m = 0; m < r.meshes.Size(); ++m) {
+        Mesh& mesh = r.meshes[m];
+        for (size_t p = 0; p < mesh.primitives.size(); ++p) {
+            Mesh::Primitive& prim = mesh.primitives[p];
+            if (!prim.compression.bufferView) {
+                continue;
+            }
+
+            claim(prim.indices);
+            for (Ref<Accessor>& acc : prim.attributes.position) claim(acc);
+            for (Ref<Accessor>& acc : prim.attributes.normal) claim(acc);
+            for (Ref<Accessor>& acc : prim.attributes.texcoord) claim(acc);
+            compressed.push_back(&prim);
+        }
+    }
+
+    if (compressed.empty()) {
+        return;
+    }
+
+    DefaultLogger::get()->info("GLTF: Decompressing Open3DGC data.");
+
+    ParallelFor(compressed.size(), numThreads, [&compressed](size_t i) {
+        Mesh::Decode_O3DGC(*compressed[i]);
+    });
+}
+#endif
+
 void glTF2Importer::ImportMeshes(glTF2::Asset& r)
 {
     std::vector<aiMesh*> meshes;
 
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+    DecodeCompressedPrimitives(r, numThreads);
+#endif
+
     unsigned int k = 0;
 
     for (unsigned int m = 0; m < r.meshes.Size(); ++m) {
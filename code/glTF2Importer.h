@@ -66,6 +66,7 @@ public:
 
 protected:
     virtual const aiImporterDesc* GetInfo() const;
+    virtual void SetupProperties( const Importer* pImp );
     virtual void InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler );
 
 private:
@@ -76,6 +77,8 @@ private:
 
     aiScene* mScene;
 
+    unsigned int numThreads;
+
     void ImportEmbeddedTextures(glTF2::Asset& a);
     void ImportMaterials(glTF2::Asset& a);
     void ImportMeshes(glTF2::Asset& a);
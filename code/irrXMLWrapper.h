@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <irrXML.h>
 #include "./../include/assimp/IOStream.hpp"
 #include "BaseImporter.h"
+#include "FastXmlReader.h"
 #include <vector>
 
 namespace Assimp    {
@@ -54,6 +55,9 @@ namespace Assimp    {
 /** @brief Utility class to make IrrXML work together with our custom IO system
  *  See the IrrXML docs for more details.
  *
+ *  @note The importers use FastXmlReader instead, which implements the same
+ *  reader interface without copying the file into IrrXML's own buffer.
+ *
  *  Construct IrrXML-Reader in BaseImporter::InternReadFile():
  *  @code
  * // open the file
@@ -166,12 +166,15 @@ DataArrayList::DataArrayList()
 , m_dataList( ddl_nullptr )
 , m_next( ddl_nullptr )
 , m_refs(ddl_nullptr)
-, m_numRefs(0){
+, m_numRefs(0)
+, m_typedData( ddl_nullptr )
+, m_numArrays( 0 ) {
     // empty
 }
 
 DataArrayList::~DataArrayList() {
     delete m_dataList;
+    delete m_typedData;
     if(m_next!=ddl_nullptr)
         delete m_next;
     if(m_refs!=ddl_nullptr)
@@ -179,6 +182,10 @@ DataArrayList::~DataArrayList() {
 }
 
 size_t DataArrayList::size() {
+    if ( ddl_nullptr != m_typedData ) {
+        return m_numArrays;
+    }
+
     size_t result( 0 );
     if ( ddl_nullptr == m_next ) {
         if ( m_dataList != ddl_nullptr ) {
@@ -133,14 +133,16 @@ OpenDDLParser::OpenDDLParser()
 : m_logCallback( logMessage )
 , m_buffer()
 , m_stack()
-, m_context( ddl_nullptr ) {
+, m_context( ddl_nullptr )
+, m_typedArrayMode( false ) {
     // empty
 }
 
 OpenDDLParser::OpenDDLParser( const char *buffer, size_t len )
 : m_logCallback( &logMessage )
 , m_buffer()
-, m_context( ddl_nullptr ) {
+, m_context( ddl_nullptr )
+, m_typedArrayMode( false ) {
     if( 0 != len ) {
         setBuffer( buffer, len );
     }
@@ -164,6 +166,14 @@ OpenDDLParser::logCallback OpenDDLParser::getLogCallback() const {
     return m_logCallback;
 }
 
+void OpenDDLParser::setTypedArrayMode( bool enabled ) {
+    m_typedArrayMode = enabled;
+}
+
+bool OpenDDLParser::getTypedArrayMode() const {
+    return m_typedArrayMode;
+}
+
 void OpenDDLParser::setBuffer( const char *buffer, size_t len ) {
     clear();
     if( 0 == len ) {
@@ -400,7 +410,11 @@ char *OpenDDLParser::parseStructureBody( char *in, char *end, bool &error ) {
                 setNodeValues( top(), values );
                 setNodeReferences( top(), refs );
             } else if( arrayLen > 1 ) {
-                in = parseDataArrayList( in, end, type, &dtArrayList );
+                if( m_typedArrayMode ) {
+                    in = parseTypedDataArrayList( in, end, type, arrayLen, &dtArrayList );
+                } else {
+                    in = parseDataArrayList( in, end, type, &dtArrayList );
+                }
                 setNodeDataArrayList( top(), dtArrayList );
             } else {
                 std::cerr << "0 for array is invalid." << std::endl;
@@ -469,6 +483,7 @@ void OpenDDLParser::normalizeBuffer( std::vector<char> &buffer) {
 
     std::vector<char> newBuffer;
     const size_t len( buffer.size() );
+    newBuffer.reserve( len );
     char *end( &buffer[ len-1 ] + 1 );
     for( size_t readIdx = 0; readIdx<len; ++readIdx ) {
         char *c( &buffer[readIdx] );
@@ -1018,6 +1033,157 @@ char *OpenDDLParser::parseDataArrayList( char *in, char *end,Value::ValueType ty
     return in;
 }
 
+static bool isTypedArrayType( Value::ValueType type ) {
+    return isIntegerType( type ) || isUnsignedIntegerType( type ) ||
+            Value::ddl_float == type || Value::ddl_double == type;
+}
+
+template<class T>
+static void appendItem( std::vector<unsigned char> &items, T value ) {
+    const size_t offset( items.size() );
+    items.resize( offset + sizeof( T ) );
+    ::memcpy( &items[ offset ], &value, sizeof( T ) );
+}
+
+static char *parseTypedItem( char *in, char *end, Value::ValueType type, std::vector<unsigned char> &items ) {
+    char *next( in );
+    if( isHexLiteral( in, end ) ) {
+        // hex literals store the bit pattern of the item
+        const uint64 bits( strtoull( in, &next, 16 ) );
+        switch( type ) {
+            case Value::ddl_float:
+                appendItem( items, static_cast<uint32>( bits ) );
+                break;
+            case Value::ddl_double:
+            case Value::ddl_int64:
+            case Value::ddl_unsigned_int64:
+                appendItem( items, bits );
+                break;
+            case Value::ddl_int32:
+            case Value::ddl_unsigned_int32:
+                appendItem( items, static_cast<uint32>( bits ) );
+                break;
+            case Value::ddl_int16:
+            case Value::ddl_unsigned_int16:
+                appendItem( items, static_cast<uint16>( bits ) );
+                break;
+            default:
+                appendItem( items, static_cast<uint8>( bits ) );
+                break;
+        }
+        return next;
+    }
+
+    switch( type ) {
+        case Value::ddl_float:
+            appendItem( items, static_cast<float>( strtod( in, &next ) ) );
+            break;
+        case Value::ddl_double:
+            appendItem( items, strtod( in, &next ) );
+            break;
+        case Value::ddl_int8:
+            appendItem( items, static_cast<int8>( strtoll( in, &next, 10 ) ) );
+            break;
+        case Value::ddl_int16:
+            appendItem( items, static_cast<int16>( strtoll( in, &next, 10 ) ) );
+            break;
+        case Value::ddl_int32:
+            appendItem( items, static_cast<int32>( strtoll( in, &next, 10 ) ) );
+            break;
+        case Value::ddl_int64:
+            appendItem( items, static_cast<int64>( strtoll( in, &next, 10 ) ) );
+            break;
+        case Value::ddl_unsigned_int8:
+            appendItem( items, static_cast<uint8>( strtoull( in, &next, 10 ) ) );
+            break;
+        case Value::ddl_unsigned_int16:
+            appendItem( items, static_cast<uint16>( strtoull( in, &next, 10 ) ) );
+            break;
+        case Value::ddl_unsigned_int32:
+            appendItem( items, static_cast<uint32>( strtoull( in, &next, 10 ) ) );
+            break;
+        case Value::ddl_unsigned_int64:
+            appendItem( items, static_cast<uint64>( strtoull( in, &next, 10 ) ) );
+            break;
+        default:
+            break;
+    }
+
+    return next;
+}
+
+char *OpenDDLParser::parseTypedDataArrayList( char *in, char *end, Value::ValueType type, size_t arrayLen,
+                                              DataArrayList **dataArrayList ) {
+    if ( ddl_nullptr == dataArrayList ) {
+        return in;
+    }
+
+    if( !isTypedArrayType( type ) ) {
+        return parseDataArrayList( in, end, type, dataArrayList );
+    }
+
+    *dataArrayList = ddl_nullptr;
+    if( ddl_nullptr == in || in == end ) {
+        return in;
+    }
+
+    in = lookForNextToken( in, end );
+    if( *in != Grammar::OpenBracketToken[ 0 ] ) {
+        return in;
+    }
+    ++in;
+
+    const size_t itemSize( ValueAllocator::getPrimTypeSize( type ) );
+    std::vector<unsigned char> items;
+    size_t numArrays( 0 );
+    in = lookForNextToken( in, end );
+    while( in != end && *in == Grammar::OpenBracketToken[ 0 ] ) {
+        ++in;
+        const size_t arrayStart( items.size() );
+        const size_t arrayEnd( arrayStart + arrayLen * itemSize );
+        in = lookForNextToken( in, end );
+        while( in != end && *in != Grammar::CloseBracketToken[ 0 ] ) {
+            char *next( parseTypedItem( in, end, type, items ) );
+            if( next == in ) {
+                // not a valid literal, drop it and skip the token
+                items.resize( items.size() - itemSize );
+                next = getNextSeparator( in, end );
+                if( next == in ) {
+                    // a bracket can't be skipped, the caller reports the unexpected token
+                    return in;
+                }
+            }
+            if( items.size() > arrayEnd ) {
+                items.resize( arrayEnd );
+            }
+            in = lookForNextToken( next, end );
+        }
+
+        // missing items are zero-initialized to keep the arrays aligned
+        items.resize( arrayEnd, 0 );
+        ++numArrays;
+        if( in != end ) {
+            ++in;
+        }
+        in = lookForNextToken( in, end );
+    }
+
+    if( in != end ) {
+        ++in;
+    }
+
+    if( 0 != numArrays ) {
+        DataArrayList *dataList( new DataArrayList );
+        dataList->m_numItems = arrayLen;
+        dataList->m_numArrays = numArrays;
+        dataList->m_typedData = ValueAllocator::allocPrimArray( type, numArrays * arrayLen );
+        ::memcpy( dataList->m_typedData->m_data, &items[ 0 ], items.size() );
+        *dataArrayList = dataList;
+    }
+
+    return in;
+}
+
 const char *OpenDDLParser::getVersion() {
     return Version;
 }
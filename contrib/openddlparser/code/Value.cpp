@@ -427,6 +427,49 @@ Value *ValueAllocator::allocPrimData( Value::ValueType type, size_t len ) {
     return data;
 }
 
+Value *ValueAllocator::allocPrimArray( Value::ValueType type, size_t numItems ) {
+    const size_t itemSize( getPrimTypeSize( type ) );
+    if( 0 == itemSize ) {
+        return ddl_nullptr;
+    }
+
+    Value *data = new Value( type );
+    data->m_size = itemSize * numItems;
+    if( data->m_size ) {
+        data->m_data = new unsigned char[ data->m_size ];
+    }
+
+    return data;
+}
+
+size_t ValueAllocator::getPrimTypeSize( Value::ValueType type ) {
+    switch( type ) {
+        case Value::ddl_bool:
+            return sizeof( bool );
+        case Value::ddl_int8:
+        case Value::ddl_unsigned_int8:
+            return sizeof( int8 );
+        case Value::ddl_int16:
+        case Value::ddl_unsigned_int16:
+        case Value::ddl_half:
+            return sizeof( int16 );
+        case Value::ddl_int32:
+        case Value::ddl_unsigned_int32:
+            return sizeof( int32 );
+        case Value::ddl_int64:
+        case Value::ddl_unsigned_int64:
+            return sizeof( int64 );
+        case Value::ddl_float:
+            return sizeof( float );
+        case Value::ddl_double:
+            return sizeof( double );
+        default:
+            break;
+    }
+
+    return 0;
+}
+
 void ValueAllocator::releasePrimData( Value **data ) {
     if( !data ) {
         return;
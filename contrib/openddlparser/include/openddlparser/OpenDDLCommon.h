@@ -210,6 +210,8 @@ struct DLL_ODDLPARSER_EXPORT DataArrayList {
     DataArrayList *m_next;      ///< The next data array list ( ddl_nullptr if last ).
     Reference     *m_refs;
     size_t         m_numRefs;
+    Value         *m_typedData; ///< All items in one buffer, only set in typed array mode ( ddl_nullptr otherwise ).
+    size_t         m_numArrays; ///< The number of arrays of m_numItems items stored in m_typedData.
 
     ///	@brief  The default constructor for initialization.
     DataArrayList();
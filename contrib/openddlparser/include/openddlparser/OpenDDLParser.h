@@ -127,6 +127,17 @@ public:
     /// @return The current log callback.
     logCallback getLogCallback() const;
 
+    ///	@brief  Enables or disables the typed array mode.
+    /// @param  enabled     [in] true to store numeric data array lists in one contiguous buffer.
+    /// @remark In typed array mode a data array list like float[3] { {...}, {...} } is stored as
+    ///         one DataArrayList whose DataArrayList::m_typedData holds all items, instead of one
+    ///         DataArrayList and one Value per item.
+    void setTypedArrayMode( bool enabled );
+
+    ///	@brief  Returns true, if the typed array mode is enabled.
+    /// @return The typed array mode state.
+    bool getTypedArrayMode() const;
+
     ///	@brief  Assigns a new buffer to parse.
     ///	@param  buffer      [in] The buffer
     ///	@param  len         [in] Size of the buffer
@@ -183,6 +194,7 @@ public: // parser helpers
     static char *parseProperty( char *in, char *end, Property **prop );
     static char *parseDataList( char *in, char *end, Value::ValueType type, Value **data, size_t &numValues, Reference **refs, size_t &numRefs );
     static char *parseDataArrayList( char *in, char *end, Value::ValueType type, DataArrayList **dataList );
+    static char *parseTypedDataArrayList( char *in, char *end, Value::ValueType type, size_t arrayLen, DataArrayList **dataList );
     static const char *getVersion();
 
 private:
@@ -196,6 +208,7 @@ private:
     typedef std::vector<DDLNode*> DDLNodeStack;
     DDLNodeStack m_stack;
     Context *m_context;
+    bool m_typedArrayMode;
 };
 
 END_ODDLPARSER_NS
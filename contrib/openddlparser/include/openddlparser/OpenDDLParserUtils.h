@@ -207,7 +207,7 @@ bool isEndofLine( const T in ) {
 template<class T>
 inline
 static T *getNextSeparator( T *in, T *end ) {
-    while( !isSeparator( *in ) || in == end ) {
+    while( in != end && !isSeparator( *in ) ) {
         ++in;
     }
     return in;
@@ -262,6 +262,8 @@ private:
 ///------------------------------------------------------------------------------------------------
 struct DLL_ODDLPARSER_EXPORT ValueAllocator {
     static Value *allocPrimData( Value::ValueType type, size_t len = 1 );
+    static Value *allocPrimArray( Value::ValueType type, size_t numItems );
+    static size_t getPrimTypeSize( Value::ValueType type );
     static void releasePrimData( Value **data );
 
 private:
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "cexport.h"
 #include <map>
+#include <vector>
 
 namespace Assimp {
     
@@ -77,6 +78,33 @@ class IOSystem;
 */
 class ASSIMP_API ExportProperties;
 
+// ----------------------------------------------------------------------------------
+/** CPP-API: Receives the output of #Exporter::ExportToChunks piece by piece.
+ *
+ * Derive from this class and pass an instance to #Exporter::ExportToChunks
+ * to get the exported data without having it copied into one contiguous
+ * blob, e.g. to send it over the network right away.
+ */
+class ASSIMP_API ExportChunkHandler
+{
+public:
+    virtual ~ExportChunkHandler() {}
+
+    // -------------------------------------------------------------------
+    /** Called for each chunk of an output file, in file order.
+     *
+     * The chunks of a file are passed on when the exporter closes the file,
+     * because exporters may seek back to patch headers. The files follow
+     * each other in the order the exporter closes them.
+     * @param pName Empty for the primary output file, the file extension
+     *   for auxiliary files (see aiExportDataBlob::name).
+     * @param pData The data of the chunk, valid until the function returns.
+     * @param pSize Size of the chunk in bytes, never 0.
+     * @note An exception thrown here stops the export of further chunks,
+     *   #Exporter::ExportToChunks fails then. */
+    virtual void Write(const char* pName, const void* pData, size_t pSize) = 0;
+};
+
 class ASSIMP_API Exporter {
 public:
     /** Function pointer type of a Export worker function */
@@ -114,6 +142,32 @@ public:
         }
     };
 
+    /** One output of an export to several formats at once, see #Export */
+    struct ExportTarget
+    {
+        // ID string of the export format, see aiExportFormatDesc::id
+        const char* mFormatId;
+
+        // Full target file name
+        const char* mPath;
+
+        // Post-processing steps in addition to the ones the format enforces
+        unsigned int mPreprocessing;
+
+        // Properties for this output, may be NULL
+        const ExportProperties* mProperties;
+
+        // Constructor to fill all entries
+        ExportTarget( const char* pFormatId, const char* pPath, unsigned int pPreprocessing = 0u, const ExportProperties* pProperties = NULL)
+        : mFormatId( pFormatId )
+        , mPath( pPath )
+        , mPreprocessing( pPreprocessing )
+        , mProperties( pProperties )
+        {
+            // empty
+        }
+    };
+
 
 public:
     Exporter();
@@ -174,6 +228,24 @@ public:
     const aiExportDataBlob* ExportToBlob(const aiScene* pScene, const char* pFormatId, unsigned int pPreprocessing = 0u, const ExportProperties* = NULL);
     const aiExportDataBlob* ExportToBlob(  const aiScene* pScene, const std::string& pFormatId, unsigned int pPreprocessing = 0u, const ExportProperties* pProperties = NULL);
 
+    // -------------------------------------------------------------------
+    /** Exports the given scene to a chosen file format and passes the
+     * data to a chunk handler instead of returning a blob.
+     *
+     * The exported data is kept in chunks of up to 1 MB (the last one of
+     * a file may be larger if a single write needs it) and each chunk is
+     * released once the handler has seen it, so the data is never copied
+     * into one large buffer.
+     * @param pScene The scene to export. Stays in possession of the caller,
+     *   is not changed by the function.
+     * @param pFormatId ID string of the export format, see #ExportToBlob.
+     * @param pHandler Receives the data, see #ExportChunkHandler.
+     *   Stays in possession of the caller. Must not be NULL.
+     * @param pPreprocessing See the documentation for #Export
+     * @return AI_SUCCESS if everything was fine.
+     * @note Any IO handlers set via #SetIOHandler are ignored here. */
+    aiReturn ExportToChunks( const aiScene* pScene, const char* pFormatId, ExportChunkHandler* pHandler, unsigned int pPreprocessing = 0u, const ExportProperties* pProperties = NULL);
+
     // -------------------------------------------------------------------
     /** Convenience function to export directly to a file. Use
      *  #SetIOSystem to supply a custom IOSystem to gain fine-grained control
@@ -210,6 +282,24 @@ public:
     aiReturn Export( const aiScene* pScene, const char* pFormatId, const char* pPath, unsigned int pPreprocessing = 0u, const ExportProperties* pProperties = NULL);
     aiReturn Export( const aiScene* pScene, const std::string& pFormatId, const std::string& pPath,  unsigned int pPreprocessing = 0u, const ExportProperties* pProperties = NULL);
 
+    // -------------------------------------------------------------------
+    /** Exports a scene to several formats at once.
+     *
+     * The post-processing all targets need is worked out upfront. Targets
+     * which need the same steps share one post-processed copy of the scene,
+     * targets whose steps differ share a copy up to the first step where
+     * they differ, so each step runs once per distinct outcome. The export
+     * functions of the targets run concurrently afterwards, unless a custom
+     * IO handler is set (see #SetIOHandler), which is called from one thread.
+     * @param pScene The scene to export. Stays in possession of the caller,
+     *   is not changed by the function.
+     * @param pTargets The outputs to write, see #ExportTarget.
+     * @return AI_SUCCESS if all outputs were written. Otherwise
+     *   #GetErrorString lists the failed outputs with their errors, one per
+     *   line, and the other outputs are written nonetheless. If a format id
+     *   is unknown, nothing is written at all.*/
+    aiReturn Export( const aiScene* pScene, const std::vector<ExportTarget>& pTargets);
+
     // -------------------------------------------------------------------
     /** Returns an error description of an error that occurred in #Export
      *    or #ExportToBlob
@@ -453,9 +453,47 @@ public:
      *   cause the scene to be reset to NULL.
      *
      *  @note The method does nothing if no scene is currently bound
-     *    to the #Importer instance.  */
+     *    to the #Importer instance. It returns NULL and leaves the scene
+     *    unchanged while the importer deferred some data, see #LoadMeshData(). */
     const aiScene* ApplyPostProcessing(unsigned int pFlags);
 
+    // -------------------------------------------------------------------
+    /** Loads the data of a mesh of the current scene which the importer
+     *  deferred.
+     *
+     *  With #AI_CONFIG_IMPORT_ASSBIN_LAZY_LOADING set, the assbin importer
+     *  reads only the counts of each mesh (aiMesh::mNumVertices,
+     *  aiMesh::mNumFaces, aiMesh::mNumBones ...) and leaves the vertex,
+     *  face and bone arrays empty until the mesh is loaded with this
+     *  method. The file is opened again through the current IOSystem.
+     *  The scene has the #AI_SCENE_FLAGS_INCOMPLETE flag set until all
+     *  deferred meshes and animations are loaded. The preprocessing
+     *  #ReadFile() does on every scene (primitive types, UV components,
+     *  animation durations ...) happens for a deferred mesh or animation
+     *  when it is loaded.
+     *
+     *  @param pIndex Index of the mesh in aiScene::mMeshes.
+     *  @return true if the data of the mesh is available, which is also
+     *   the case if it was never deferred. false if there is no such mesh
+     *   or loading failed, see GetErrorString().
+     *  @note Post-processing steps can't work on deferred data. #ReadFile()
+     *    fails if post-processing flags are given and some data is deferred,
+     *    #ApplyPostProcessing() returns NULL and leaves the scene unchanged
+     *    until all data is loaded. Apply them once everything is loaded. */
+    bool LoadMeshData(unsigned int pIndex);
+
+    // -------------------------------------------------------------------
+    /** Loads the keys of an animation of the current scene which the
+     *  importer deferred.
+     *
+     *  With #AI_CONFIG_IMPORT_ASSBIN_LAZY_LOADING set, the channels of the
+     *  animations are read with their key counts, but without the keys.
+     *  See #LoadMeshData().
+     *
+     *  @param pIndex Index of the animation in aiScene::mAnimations.
+     *  @return true if the keys of the animation are available. */
+    bool LoadAnimationData(unsigned int pIndex);
+
     const aiScene* ApplyCustomizedPostProcessing( BaseProcess *rootProcess, bool requestValidation );
 
     // -------------------------------------------------------------------
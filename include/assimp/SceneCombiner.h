@@ -66,6 +66,9 @@ struct aiBone;
 struct aiMesh;
 struct aiAnimation;
 struct aiNodeAnim;
+struct aiMeshAnim;
+struct aiMeshMorphAnim;
+struct aiAnimMesh;
 
 namespace Assimp    {
 
@@ -369,6 +372,9 @@ public:
     static void Copy  (aiBone** dest, const aiBone* src);
     static void Copy  (aiLight** dest, const aiLight* src);
     static void Copy  (aiNodeAnim** dest, const aiNodeAnim* src);
+    static void Copy  (aiMeshAnim** dest, const aiMeshAnim* src);
+    static void Copy  (aiMeshMorphAnim** dest, const aiMeshMorphAnim* src);
+    static void Copy  (aiAnimMesh** dest, const aiAnimMesh* src);
     static void Copy  (aiMetadata** dest, const aiMetadata* src);
 
     // recursive, of course
@@ -0,0 +1,340 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "SceneDiffer.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+class utAssbinImportExport : public ::testing::Test {
+protected:
+    // Export the scene to assbin and read it back from memory
+    const aiScene *roundTrip( const aiScene *scene, bool indexed, bool compressed, size_t *size = nullptr ) {
+        ExportProperties props;
+        props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_INDEXED, indexed );
+        props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_COMPRESSED, compressed );
+        const aiExportDataBlob *blob = m_exporter.ExportToBlob( scene, "assbin", 0, &props );
+        EXPECT_NE( nullptr, blob );
+        if ( nullptr == blob ) {
+            return nullptr;
+        }
+        if ( nullptr != size ) {
+            *size = blob->size;
+        }
+        return m_reimporter.ReadFileFromMemory( blob->data, blob->size, 0, "assbin" );
+    }
+
+    // Compare what SceneDiffer does not look at
+    void expectSameAnimations( const aiScene *expected, const aiScene *actual ) {
+        ASSERT_EQ( expected->mNumAnimations, actual->mNumAnimations );
+        for ( unsigned int i = 0; i < expected->mNumAnimations; ++i ) {
+            const aiAnimation *a = expected->mAnimations[ i ], *b = actual->mAnimations[ i ];
+            EXPECT_EQ( a->mDuration, b->mDuration );
+            ASSERT_EQ( a->mNumChannels, b->mNumChannels );
+            for ( unsigned int c = 0; c < a->mNumChannels; ++c ) {
+                EXPECT_EQ( a->mChannels[ c ]->mNodeName, b->mChannels[ c ]->mNodeName );
+                ASSERT_EQ( a->mChannels[ c ]->mNumRotationKeys, b->mChannels[ c ]->mNumRotationKeys );
+                for ( unsigned int k = 0; k < a->mChannels[ c ]->mNumRotationKeys; ++k ) {
+                    EXPECT_EQ( a->mChannels[ c ]->mRotationKeys[ k ].mValue, b->mChannels[ c ]->mRotationKeys[ k ].mValue );
+                }
+            }
+        }
+    }
+
+    Importer m_importer;
+    Importer m_reimporter;
+    Exporter m_exporter;
+};
+
+TEST_F( utAssbinImportExport, roundTripAllLayoutsTest ) {
+    const aiScene *scene = m_importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/X/anim_test.x", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_LT( 0u, scene->mNumAnimations );
+
+    for ( int layout = 0; layout < 4; ++layout ) {
+        const aiScene *copy = roundTrip( scene, layout >= 2, 0 != ( layout & 1 ) );
+        ASSERT_NE( nullptr, copy );
+        SceneDiffer differ;
+        EXPECT_TRUE( differ.isEqual( scene, copy ) ) << "layout " << layout;
+        expectSameAnimations( scene, copy );
+    }
+}
+
+TEST_F( utAssbinImportExport, indexedBlocksAreCompressedTest ) {
+    const aiScene *scene = m_importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_LT( 1u, scene->mNumMeshes );
+
+    size_t plainSize = 0, compressedSize = 0;
+    ASSERT_NE( nullptr, roundTrip( scene, true, false, &plainSize ) );
+    const aiScene *copy = roundTrip( scene, true, true, &compressedSize );
+    ASSERT_NE( nullptr, copy );
+    EXPECT_LT( compressedSize, plainSize );
+
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( scene, copy ) );
+}
+
+TEST_F( utAssbinImportExport, truncatedIndexedFileFailsTest ) {
+    const aiScene *scene = m_importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    ExportProperties props;
+    props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_INDEXED, true );
+    props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_COMPRESSED, true );
+    const aiExportDataBlob *blob = m_exporter.ExportToBlob( scene, "assbin", 0, &props );
+    ASSERT_NE( nullptr, blob );
+    EXPECT_EQ( nullptr, m_reimporter.ReadFileFromMemory( blob->data, blob->size - 16, 0, "assbin" ) );
+}
+
+TEST_F( utAssbinImportExport, invalidCountsFailTest ) {
+    const aiScene *scene = m_importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    // the 512 byte file header is followed by the scene chunk or the index table
+    const size_t dataStart = 512;
+    const uint32_t hugeCount = 0x40000000;
+    for ( int layout = 0; layout < 3; ++layout ) {
+        ExportProperties props;
+        props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_INDEXED, layout > 0 );
+        props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_COMPRESSED, false );
+        const aiExportDataBlob *blob = m_exporter.ExportToBlob( scene, "assbin", 0, &props );
+        ASSERT_NE( nullptr, blob );
+        std::vector<char> data( static_cast<const char*>( blob->data ), static_cast<const char*>( blob->data ) + blob->size );
+
+        size_t pos = dataStart + 16; // number of materials in the scene chunk
+        if ( 1 == layout ) {
+            pos = dataStart + 4; // number of index entries
+        } else if ( 2 == layout ) {
+            uint64_t sceneOffset = 0;
+            ::memcpy( &sceneOffset, &data[ dataStart + 16 ], sizeof( sceneOffset ) );
+            pos = static_cast<size_t>( sceneOffset ) + 12; // number of meshes in block 0
+        }
+        ASSERT_LT( pos + 4, data.size() );
+        ::memcpy( &data[ pos ], &hugeCount, sizeof( hugeCount ) );
+
+        // rejected before anything is allocated for the counts
+        EXPECT_EQ( nullptr, m_reimporter.ReadFileFromMemory( &data[ 0 ], data.size(), 0, "assbin" ) ) << "layout " << layout;
+        EXPECT_NE( std::string::npos, std::string( m_reimporter.GetErrorString() ).find( "ASSBIN: " ) ) << m_reimporter.GetErrorString();
+    }
+}
+
+TEST_F( utAssbinImportExport, lazyLoadingTest ) {
+    const aiScene *scene = m_importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/X/anim_test.x", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_LT( 0u, scene->mNumMeshes );
+    ASSERT_LT( 0u, scene->mNumAnimations );
+
+    // plain, indexed and indexed + compressed
+    for ( int layout = 0; layout < 3; ++layout ) {
+        ExportProperties props;
+        props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_INDEXED, layout > 0 );
+        props.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_COMPRESSED, layout > 1 );
+        ASSERT_EQ( AI_SUCCESS, m_exporter.Export( scene, "assbin", "lazy_test.assbin", 0, &props ) );
+
+        Importer importer;
+        importer.SetPropertyBool( AI_CONFIG_IMPORT_ASSBIN_LAZY_LOADING, true );
+        const aiScene *lazyScene = importer.ReadFile( "lazy_test.assbin", 0 );
+        ASSERT_NE( nullptr, lazyScene );
+        EXPECT_NE( 0u, lazyScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE );
+
+        ASSERT_EQ( scene->mNumMeshes, lazyScene->mNumMeshes );
+        for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+            EXPECT_EQ( scene->mMeshes[ i ]->mNumVertices, lazyScene->mMeshes[ i ]->mNumVertices );
+            EXPECT_EQ( scene->mMeshes[ i ]->mNumFaces, lazyScene->mMeshes[ i ]->mNumFaces );
+            EXPECT_EQ( scene->mMeshes[ i ]->mMaterialIndex, lazyScene->mMeshes[ i ]->mMaterialIndex );
+            EXPECT_EQ( nullptr, lazyScene->mMeshes[ i ]->mVertices );
+            EXPECT_EQ( nullptr, lazyScene->mMeshes[ i ]->mFaces );
+        }
+        ASSERT_EQ( scene->mNumAnimations, lazyScene->mNumAnimations );
+        const aiNodeAnim *channel = lazyScene->mAnimations[ 0 ]->mChannels[ 0 ];
+        EXPECT_EQ( scene->mAnimations[ 0 ]->mChannels[ 0 ]->mNodeName, channel->mNodeName );
+        EXPECT_EQ( scene->mAnimations[ 0 ]->mChannels[ 0 ]->mNumRotationKeys, channel->mNumRotationKeys );
+        EXPECT_EQ( nullptr, channel->mRotationKeys );
+
+        for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+            EXPECT_TRUE( importer.LoadMeshData( i ) );
+        }
+        for ( unsigned int i = 0; i < scene->mNumAnimations; ++i ) {
+            EXPECT_TRUE( importer.LoadAnimationData( i ) );
+        }
+        EXPECT_FALSE( importer.LoadMeshData( scene->mNumMeshes ) );
+        EXPECT_EQ( scene->mFlags, lazyScene->mFlags );
+
+        SceneDiffer differ;
+        EXPECT_TRUE( differ.isEqual( scene, lazyScene ) ) << "layout " << layout;
+        expectSameAnimations( scene, lazyScene );
+    }
+    std::remove( "lazy_test.assbin" );
+}
+
+TEST_F( utAssbinImportExport, lazyLoadingRefusesPostProcessingTest ) {
+    const aiScene *scene = m_importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( AI_SUCCESS, m_exporter.Export( scene, "assbin", "lazy_pp_test.assbin" ) );
+
+    // steps which read or re-index the deferred meshes
+    const unsigned int steps = aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices;
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_ASSBIN_LAZY_LOADING, true );
+    EXPECT_EQ( nullptr, importer.ReadFile( "lazy_pp_test.assbin", steps ) );
+    EXPECT_NE( std::string::npos, std::string( importer.GetErrorString() ).find( "LoadMeshData" ) );
+
+    const aiScene *lazyScene = importer.ReadFile( "lazy_pp_test.assbin", 0 );
+    ASSERT_NE( nullptr, lazyScene );
+    EXPECT_EQ( nullptr, importer.ApplyPostProcessing( steps ) );
+    ASSERT_EQ( lazyScene, importer.GetScene() );
+    EXPECT_EQ( nullptr, lazyScene->mMeshes[ 0 ]->mVertices );
+
+    // once everything is loaded, the steps run as usual
+    for ( unsigned int i = 0; i < lazyScene->mNumMeshes; ++i ) {
+        ASSERT_TRUE( importer.LoadMeshData( i ) );
+    }
+    EXPECT_EQ( 0u, lazyScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE );
+    ASSERT_EQ( lazyScene, importer.ApplyPostProcessing( steps ) );
+    EXPECT_LT( lazyScene->mMeshes[ 0 ]->mNumVertices, scene->mMeshes[ 0 ]->mNumVertices );
+    EXPECT_TRUE( importer.LoadMeshData( 0 ) );
+
+    Importer reference;
+    const aiScene *expected = reference.ReadFile( "lazy_pp_test.assbin", steps );
+    ASSERT_NE( nullptr, expected );
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( expected, lazyScene ) );
+    std::remove( "lazy_pp_test.assbin" );
+}
+
+// A scene which relies on the preprocessing: the primitive types, the unused UV component
+// and the animation duration are left to it, and the channel lacks rotation and scaling keys.
+static aiScene *createUnprocessedScene() {
+    aiScene *scene = new aiScene;
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[ 1 ];
+    scene->mMaterials[ 0 ] = new aiMaterial;
+
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[ 1 ];
+    aiMesh *mesh = scene->mMeshes[ 0 ] = new aiMesh;
+    mesh->mNumVertices = 3;
+    mesh->mVertices = new aiVector3D[ 3 ]{ aiVector3D( 1, 0, 0 ), aiVector3D( 0, 1, 0 ), aiVector3D( 0, 0, 1 ) };
+    mesh->mTextureCoords[ 0 ] = new aiVector3D[ 3 ]{ aiVector3D( 0, 0, 1 ), aiVector3D( 1, 0, 1 ), aiVector3D( 0, 1, 1 ) };
+    mesh->mNumUVComponents[ 0 ] = 2;
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[ 1 ];
+    mesh->mFaces[ 0 ].mNumIndices = 3;
+    mesh->mFaces[ 0 ].mIndices = new unsigned int[ 3 ]{ 0, 1, 2 };
+
+    scene->mRootNode = new aiNode( "root" );
+    scene->mRootNode->mNumChildren = 1;
+    scene->mRootNode->mChildren = new aiNode*[ 1 ];
+    aiNode *node = scene->mRootNode->mChildren[ 0 ] = new aiNode( "node" );
+    node->mParent = scene->mRootNode;
+    node->mTransformation.a4 = 2.f;
+    node->mNumMeshes = 1;
+    node->mMeshes = new unsigned int[ 1 ]{ 0 };
+
+    scene->mNumAnimations = 1;
+    scene->mAnimations = new aiAnimation*[ 1 ];
+    aiAnimation *anim = scene->mAnimations[ 0 ] = new aiAnimation;
+    anim->mDuration = -1.;
+    anim->mNumChannels = 1;
+    anim->mChannels = new aiNodeAnim*[ 1 ];
+    aiNodeAnim *channel = anim->mChannels[ 0 ] = new aiNodeAnim;
+    channel->mNodeName = aiString( "node" );
+    channel->mNumPositionKeys = 2;
+    channel->mPositionKeys = new aiVectorKey[ 2 ];
+    channel->mPositionKeys[ 0 ] = aiVectorKey( 0., aiVector3D( 2, 0, 0 ) );
+    channel->mPositionKeys[ 1 ] = aiVectorKey( 4., aiVector3D( 3, 0, 0 ) );
+    return scene;
+}
+
+TEST_F( utAssbinImportExport, lazyLoadingPreprocessesLoadedDataTest ) {
+    std::unique_ptr<aiScene> scene( createUnprocessedScene() );
+    ASSERT_EQ( AI_SUCCESS, m_exporter.Export( scene.get(), "assbin", "lazy_preprocess_test.assbin" ) );
+
+    Importer reference;
+    const aiScene *expected = reference.ReadFile( "lazy_preprocess_test.assbin", 0 );
+    ASSERT_NE( nullptr, expected );
+    ASSERT_EQ( static_cast<unsigned int>( aiPrimitiveType_TRIANGLE ), expected->mMeshes[ 0 ]->mPrimitiveTypes );
+    ASSERT_EQ( 4., expected->mAnimations[ 0 ]->mDuration );
+
+    // the deferred mesh and animation are left alone until they are loaded
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_ASSBIN_LAZY_LOADING, true );
+    const aiScene *lazyScene = importer.ReadFile( "lazy_preprocess_test.assbin", 0 );
+    ASSERT_NE( nullptr, lazyScene );
+    const aiMesh *mesh = lazyScene->mMeshes[ 0 ];
+    const aiAnimation *anim = lazyScene->mAnimations[ 0 ];
+    EXPECT_EQ( 0u, mesh->mPrimitiveTypes );
+    EXPECT_EQ( -1., anim->mDuration );
+    EXPECT_EQ( 0u, anim->mChannels[ 0 ]->mNumRotationKeys );
+
+    ASSERT_TRUE( importer.LoadMeshData( 0 ) );
+    ASSERT_TRUE( importer.LoadAnimationData( 0 ) );
+    EXPECT_EQ( expected->mMeshes[ 0 ]->mPrimitiveTypes, mesh->mPrimitiveTypes );
+    EXPECT_EQ( expected->mMeshes[ 0 ]->mNumUVComponents[ 0 ], mesh->mNumUVComponents[ 0 ] );
+    for ( unsigned int i = 0; i < mesh->mNumVertices; ++i ) {
+        EXPECT_EQ( expected->mMeshes[ 0 ]->mTextureCoords[ 0 ][ i ], mesh->mTextureCoords[ 0 ][ i ] );
+    }
+    EXPECT_EQ( expected->mAnimations[ 0 ]->mDuration, anim->mDuration );
+
+    // the dummy tracks are made from the node transformation, like in the reference
+    const aiNodeAnim *channel = anim->mChannels[ 0 ], *expectedChannel = expected->mAnimations[ 0 ]->mChannels[ 0 ];
+    ASSERT_EQ( 1u, channel->mNumRotationKeys );
+    ASSERT_EQ( 1u, channel->mNumScalingKeys );
+    EXPECT_EQ( expectedChannel->mRotationKeys[ 0 ].mValue, channel->mRotationKeys[ 0 ].mValue );
+    EXPECT_EQ( expectedChannel->mScalingKeys[ 0 ].mValue, channel->mScalingKeys[ 0 ].mValue );
+
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( expected, lazyScene ) );
+    std::remove( "lazy_preprocess_test.assbin" );
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,145 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Base64.h"
+
+#include <string>
+#include <vector>
+#include <stdlib.h>
+
+using namespace Assimp;
+
+class Base64Test : public ::testing::Test {
+public:
+    static std::string Encode(const std::vector<uint8_t>& in) {
+        static const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (size_t i = 0; i < in.size(); i += 3) {
+            uint32_t v = uint32_t(in[i]) << 16;
+            if (i + 1 < in.size()) v |= uint32_t(in[i + 1]) << 8;
+            if (i + 2 < in.size()) v |= uint32_t(in[i + 2]);
+            out += chars[(v >> 18) & 63];
+            out += chars[(v >> 12) & 63];
+            out += i + 1 < in.size() ? chars[(v >> 6) & 63] : '=';
+            out += i + 2 < in.size() ? chars[v & 63] : '=';
+        }
+        return out;
+    }
+
+    // The previous per character decoder of the glTF importers
+    static std::vector<uint8_t> ReferenceDecode(const std::string& in) {
+        const uint8_t* table = Base64::DecodeTable();
+        const size_t inLength = in.size();
+        const size_t nEquals = size_t(in[inLength - 1] == '=') + size_t(in[inLength - 2] == '=');
+        std::vector<uint8_t> out((inLength * 3) / 4 - nEquals, 0);
+
+        size_t i, j = 0;
+        for (i = 0; i + 4 < inLength; i += 4) {
+            uint8_t b0 = table[uint8_t(in[i])], b1 = table[uint8_t(in[i + 1])];
+            uint8_t b2 = table[uint8_t(in[i + 2])], b3 = table[uint8_t(in[i + 3])];
+            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
+            out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
+            out[j++] = (uint8_t)((b2 << 6) | b3);
+        }
+        uint8_t b0 = table[uint8_t(in[i])], b1 = table[uint8_t(in[i + 1])];
+        uint8_t b2 = table[uint8_t(in[i + 2])], b3 = table[uint8_t(in[i + 3])];
+        out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
+        if (b2 < 64) out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
+        if (b3 < 64) out[j++] = (uint8_t)((b2 << 6) | b3);
+        return out;
+    }
+
+    static std::vector<uint8_t> Decode(const std::string& in) {
+        std::vector<uint8_t> out(Base64::DecodedLength(in.c_str(), in.size()) + 1, 0xcd);
+        const size_t length = Base64::Decode(in.c_str(), in.size(), &out[0]);
+        EXPECT_EQ(0xcd, out.back()); // no write past the end
+        out.resize(length);
+        return out;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(Base64Test, decodeShortStringsTest) {
+    EXPECT_EQ(0u, Base64::DecodedLength("", 0));
+    EXPECT_EQ(1u, Base64::DecodedLength("YQ==", 4));
+    EXPECT_EQ(2u, Base64::DecodedLength("YWI=", 4));
+    EXPECT_EQ(3u, Base64::DecodedLength("YWJj", 4));
+
+    const std::vector<uint8_t> abc = Decode("YWJj");
+    EXPECT_EQ(std::string("abc"), std::string(abc.begin(), abc.end()));
+    const std::vector<uint8_t> a = Decode("YQ==");
+    EXPECT_EQ(std::string("a"), std::string(a.begin(), a.end()));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(Base64Test, roundTripTest) {
+    srand(42);
+    for (size_t length = 1; length < 300; ++length) {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; ++i) {
+            data[i] = uint8_t(rand());
+        }
+
+        const std::string encoded = Encode(data);
+        EXPECT_EQ(data, Decode(encoded)) << "length " << length;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(Base64Test, matchesReferenceDecoderTest) {
+    srand(7);
+    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (size_t length = 4; length < 400; length += 4) {
+        std::string encoded(length, 'A');
+        for (size_t i = 0; i < length; ++i) {
+            encoded[i] = chars[rand() % chars.size()];
+        }
+
+        // sprinkle in some characters outside of the alphabet
+        if (length % 3 == 0) {
+            encoded[rand() % (length - 2)] = char(rand() % 256);
+            encoded[rand() % (length - 2)] = '-';
+        }
+        EXPECT_EQ(ReferenceDecode(encoded), Decode(encoded)) << encoded;
+    }
+}
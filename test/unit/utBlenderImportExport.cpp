@@ -41,9 +41,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 #include "AbstractImportExportBase.h"
+#include "SceneDiffer.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -59,3 +61,41 @@ public:
 TEST_F( utBlenderImporterExporter, importBlenFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utBlenderImporterExporter, importCompressedBlendTest ) {
+    Assimp::Importer plain;
+    const aiScene *expected = plain.ReadFile( ASSIMP_TEST_MODELS_DIR "/BLEND/BlenderDefault_250.blend", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, expected );
+
+    // the same file, saved with compression enabled
+    Assimp::Importer compressed;
+    const aiScene *scene = compressed.ReadFile( ASSIMP_TEST_MODELS_DIR "/BLEND/BlenderDefault_250_Compressed.blend", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( expected, scene ) );
+    differ.showReport();
+}
+
+TEST_F( utBlenderImporterExporter, importBlendMultithreadedTest ) {
+    Assimp::Importer sequential;
+    sequential.SetPropertyInteger( AI_CONFIG_IMPORT_BLEND_NUM_THREADS, 1 );
+    const aiScene *expected = sequential.ReadFile( ASSIMP_TEST_MODELS_DIR "/BLEND/4Cubes4Mats_248.blend", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, expected );
+
+    // the output, including the order of meshes and materials, must not depend
+    // on the number of threads converting the geometry
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_IMPORT_BLEND_NUM_THREADS, 4 );
+    const aiScene *scene = parallel.ReadFile( ASSIMP_TEST_MODELS_DIR "/BLEND/4Cubes4Mats_248.blend", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( expected, scene ) );
+    differ.showReport();
+
+    ASSERT_EQ( expected->mNumMeshes, scene->mNumMeshes );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        EXPECT_EQ( expected->mMeshes[ i ]->mMaterialIndex, scene->mMeshes[ i ]->mMaterialIndex );
+    }
+}
@@ -0,0 +1,158 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "BlobIOSystem.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+// Chunk handler collecting the chunks per file name, optionally failing.
+class CollectingChunkHandler : public ExportChunkHandler {
+public:
+    explicit CollectingChunkHandler( bool fail = false )
+    : m_fail( fail )
+    , m_numChunks() {
+        // empty
+    }
+
+    void Write( const char* pName, const void* pData, size_t pSize ) override {
+        if ( m_fail ) {
+            throw std::runtime_error( "chunk handler failure" );
+        }
+        EXPECT_LT( 0U, pSize );
+        const char *data = static_cast<const char*>( pData );
+        m_files[ pName ].append( data, data + pSize );
+        ++m_numChunks;
+    }
+
+    bool m_fail;
+    size_t m_numChunks;
+    std::map<std::string, std::string> m_files;
+};
+
+}
+
+class BlobIOSystemTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F( BlobIOSystemTest, writeAndSeekAcrossChunksTest ) {
+    std::string expected;
+    BlobIOSystem io;
+    {
+        std::unique_ptr<IOStream> stream( io.Open( io.GetMagicFileName(), "wb" ) );
+        ASSERT_NE( nullptr, stream.get() );
+
+        // writes of growing size, the last one larger than a chunk
+        for ( size_t size = 1; size <= 2 * AI_BLOBIO_MAX_CHUNK; size *= 3 ) {
+            const std::string data( size, static_cast<char>( 'a' + expected.size() % 26 ) );
+            EXPECT_EQ( 1U, stream->Write( data.data(), data.size(), 1 ) );
+            expected += data;
+        }
+        EXPECT_EQ( expected.size(), stream->FileSize() );
+
+        // patch a range spanning several chunks
+        const std::string patch( 20000, 'x' );
+        ASSERT_EQ( aiReturn_SUCCESS, stream->Seek( 3000, aiOrigin_SET ) );
+        EXPECT_EQ( 1U, stream->Write( patch.data(), patch.size(), 1 ) );
+        expected.replace( 3000, patch.size(), patch );
+        EXPECT_EQ( 3000 + patch.size(), stream->Tell() );
+
+        ASSERT_EQ( aiReturn_SUCCESS, stream->Seek( 0, aiOrigin_END ) );
+        EXPECT_EQ( 1U, stream->Write( "end", 3, 1 ) );
+        expected += "end";
+    }
+
+    std::unique_ptr<aiExportDataBlob> blob( io.GetBlobChain() );
+    ASSERT_NE( nullptr, blob.get() );
+    ASSERT_EQ( expected.size(), blob->size );
+    EXPECT_EQ( expected, std::string( static_cast<const char*>( blob->data ), blob->size ) );
+    EXPECT_EQ( nullptr, blob->next );
+}
+
+TEST_F( BlobIOSystemTest, exportToChunksTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    // obj writes a material file, glb seeks back to write its header
+    const char *formats[] = { "obj", "glb" };
+    for ( const char *format : formats ) {
+        Assimp::Exporter exporter;
+        CollectingChunkHandler handler;
+        ASSERT_EQ( AI_SUCCESS, exporter.ExportToChunks( scene, format, &handler ) );
+
+        const aiExportDataBlob *blob = exporter.ExportToBlob( scene, format );
+        ASSERT_NE( nullptr, blob );
+        EXPECT_LT( handler.m_files.size(), handler.m_numChunks );
+        for ( ; blob; blob = blob->next ) {
+            const std::string name( blob->name.C_Str() );
+            ASSERT_EQ( 1U, handler.m_files.count( name ) ) << format << " " << name;
+            EXPECT_EQ( std::string( static_cast<const char*>( blob->data ), blob->size ), handler.m_files[ name ] );
+            handler.m_files.erase( name );
+        }
+        EXPECT_TRUE( handler.m_files.empty() );
+    }
+}
+
+TEST_F( BlobIOSystemTest, failingChunkHandlerTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    Assimp::Exporter exporter;
+    CollectingChunkHandler handler( true );
+    EXPECT_EQ( AI_FAILURE, exporter.ExportToChunks( scene, "obj", &handler ) );
+    EXPECT_STRNE( "", exporter.GetErrorString() );
+}
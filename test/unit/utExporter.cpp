@@ -0,0 +1,181 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "ScenePrivate.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/config.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+class utExporter : public ::testing::Test {
+    // empty
+};
+
+TEST_F( utExporter, exportKeepsJoinedVerticesTest ) {
+    // the scene has all steps the exporter needs applied already, so it is exported as it is
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf",
+        aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices | aiProcess_Triangulate | aiProcess_SortByPType );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_TRUE( scene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT );
+
+    ExportProperties properties;
+    properties.SetPropertyBool( AI_CONFIG_EXPORT_REUSE_PREPARED_SCENE, true );
+
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob( scene, "glb2", 0, &properties );
+    ASSERT_NE( nullptr, blob );
+    EXPECT_EQ( nullptr, ScenePriv( scene )->mPreparedScene.get() );
+
+    // the glTF 2 importer makes the meshes verbose, so the accessors are checked instead
+    const std::string data( static_cast<const char*>( blob->data ), blob->size );
+    ASSERT_EQ( 24u, scene->mMeshes[ 0 ]->mNumVertices );
+    EXPECT_NE( std::string::npos, data.find( "\"count\":24,\"type\":\"VEC3\"" ) );
+    EXPECT_EQ( std::string::npos, data.find( "\"count\":36,\"type\":\"VEC3\"" ) );
+}
+
+TEST_F( utExporter, exportReusesPreparedSceneTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf",
+        aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices );
+    ASSERT_NE( nullptr, scene );
+    const ScenePrivateData *priv = ScenePriv( scene );
+    ASSERT_NE( nullptr, priv );
+
+    ExportProperties properties;
+    properties.SetPropertyBool( AI_CONFIG_EXPORT_REUSE_PREPARED_SCENE, true );
+
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob( scene, "glb2", 0, &properties );
+    ASSERT_NE( nullptr, blob );
+    const std::string first( static_cast<const char*>( blob->data ), blob->size );
+
+    // the post-processed copy is kept with the scene
+    const std::shared_ptr<const aiScene> prepared = priv->mPreparedScene;
+    ASSERT_NE( nullptr, prepared.get() );
+
+    // which meshes share vertices is remembered per mesh
+    ASSERT_EQ( scene->mNumMeshes, priv->mMeshFacts.size() );
+    EXPECT_TRUE( priv->mMeshFacts[ 0 ].Matches( scene->mMeshes[ 0 ] ) );
+    EXPECT_FALSE( priv->mMeshFacts[ 0 ].mVerbose );
+
+    // glb2 and gltf2 need the same steps
+    blob = exporter.ExportToBlob( scene, "gltf2", 0, &properties );
+    ASSERT_NE( nullptr, blob );
+    EXPECT_EQ( prepared, priv->mPreparedScene );
+
+    blob = exporter.ExportToBlob( scene, "glb2", 0, &properties );
+    ASSERT_NE( nullptr, blob );
+    EXPECT_EQ( first, std::string( static_cast<const char*>( blob->data ), blob->size ) );
+
+    // without the property the copy is released
+    blob = exporter.ExportToBlob( scene, "glb2" );
+    ASSERT_NE( nullptr, blob );
+    EXPECT_EQ( nullptr, priv->mPreparedScene.get() );
+    EXPECT_EQ( first, std::string( static_cast<const char*>( blob->data ), blob->size ) );
+
+    // the vertices are joined again after the steps that needed the verbose format
+    ASSERT_EQ( scene->mNumMeshes, prepared->mNumMeshes );
+    for ( unsigned int i = 0; i < prepared->mNumMeshes; ++i ) {
+        EXPECT_EQ( scene->mMeshes[ i ]->mNumVertices, prepared->mMeshes[ i ]->mNumVertices );
+    }
+    EXPECT_EQ( std::string::npos, first.find( "\"count\":36,\"type\":\"VEC3\"" ) );
+}
+
+static std::string readFile( const char *path ) {
+    std::ifstream file( path, std::ios::binary );
+    return std::string( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+}
+
+TEST_F( utExporter, exportToSeveralFormatsTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf",
+        aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices );
+    ASSERT_NE( nullptr, scene );
+
+    // every format needs other post-processing steps, assbin none at all
+    std::vector<Exporter::ExportTarget> targets;
+    targets.push_back( Exporter::ExportTarget( "glb2", "fanout_test.glb" ) );
+    targets.push_back( Exporter::ExportTarget( "glb2", "fanout_test_flipped.glb", aiProcess_FlipUVs ) );
+    targets.push_back( Exporter::ExportTarget( "objnomtl", "fanout_test.obj" ) );
+    targets.push_back( Exporter::ExportTarget( "stlb", "fanout_test.stl" ) );
+    targets.push_back( Exporter::ExportTarget( "ply", "fanout_test.ply" ) );
+    targets.push_back( Exporter::ExportTarget( "assbin", "fanout_test.assbin" ) );
+
+    Assimp::Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, targets ) );
+
+    // the outputs match the ones of single exports, assbin files differ in their file name and time stamp
+    for ( const Exporter::ExportTarget &target : targets ) {
+        const aiExportDataBlob *blob = exporter.ExportToBlob( scene, target.mFormatId, target.mPreprocessing );
+        ASSERT_NE( nullptr, blob );
+        const std::string expected( static_cast<const char*>( blob->data ), blob->size ), data( readFile( target.mPath ) );
+        if ( strcmp( target.mFormatId, "assbin" ) ) {
+            EXPECT_EQ( expected, data ) << target.mPath;
+        } else {
+            EXPECT_EQ( expected.size(), data.size() );
+        }
+        std::remove( target.mPath );
+    }
+
+    // nothing is written if a format is unknown
+    targets.push_back( Exporter::ExportTarget( "no_such_format", "fanout_test.none" ) );
+    EXPECT_EQ( AI_FAILURE, exporter.Export( scene, targets ) );
+    EXPECT_NE( std::string::npos, std::string( exporter.GetErrorString() ).find( "no_such_format" ) );
+    EXPECT_TRUE( readFile( "fanout_test.glb" ).empty() );
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,192 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "fast_ftoa.h"
+#include "fast_atof.h"
+
+#include <sstream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Assimp;
+
+class FastFtoaTest : public ::testing::Test {
+public:
+    template <typename TReal>
+    static std::string Format(TReal value) {
+        char buffer[AI_FTOA_MAX_CHARS];
+        return std::string(buffer, fast_ftoa(value, buffer));
+    }
+
+    static std::string FormatFixed(double value, unsigned int digits) {
+        char buffer[AI_FTOA_MAX_CHARS];
+        return std::string(buffer, fast_ftoa_fixed(value, digits, buffer));
+    }
+
+    // deterministic bit patterns, covering all exponents
+    static uint64_t Next(uint64_t& state) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state;
+    }
+};
+
+TEST_F(FastFtoaTest, formatFloatTest) {
+    EXPECT_EQ("0", Format(0.0f));
+    EXPECT_EQ("-0", Format(-0.0f));
+    EXPECT_EQ("1", Format(1.0f));
+    EXPECT_EQ("-2.5", Format(-2.5f));
+    EXPECT_EQ("0.1", Format(0.1f));
+    EXPECT_EQ("0.3", Format(0.3f));
+    EXPECT_EQ("100", Format(100.0f));
+    EXPECT_EQ("0.0001", Format(0.0001f));
+    EXPECT_EQ("1e-05", Format(0.00001f));
+    EXPECT_EQ("1.5e-07", Format(1.5e-7f));
+    EXPECT_EQ("123456790", Format(123456789.0f));
+    EXPECT_EQ("1e+10", Format(1e10f));
+    EXPECT_EQ("3.4028235e+38", Format(std::numeric_limits<float>::max()));
+    EXPECT_EQ("1e-45", Format(std::numeric_limits<float>::denorm_min()));
+    EXPECT_EQ("inf", Format(std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("-inf", Format(-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("nan", Format(std::numeric_limits<float>::quiet_NaN()));
+}
+
+TEST_F(FastFtoaTest, formatDoubleTest) {
+    EXPECT_EQ("0.1", Format(0.1));
+    EXPECT_EQ("0.30000000000000004", Format(0.1 + 0.2));
+    EXPECT_EQ("0.10000000149011612", Format(static_cast<double>(0.1f)));
+    EXPECT_EQ("10000000000000000", Format(1e16));
+    EXPECT_EQ("1e+17", Format(1e17));
+    EXPECT_EQ("1e+300", Format(1e300));
+    EXPECT_EQ("1.7976931348623157e+308", Format(std::numeric_limits<double>::max()));
+    EXPECT_EQ("5e-324", Format(std::numeric_limits<double>::denorm_min()));
+}
+
+TEST_F(FastFtoaTest, roundTripFloatTest) {
+    uint64_t state = 1;
+    for (unsigned int i = 0; i < 100000; ++i) {
+        const uint32_t bits = static_cast<uint32_t>(Next(state) >> 32);
+        float value;
+        ::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+
+        const std::string s = Format(value);
+        ASSERT_LE(s.size(), 15u) << s;
+        ASSERT_EQ(value, strtof(s.c_str(), NULL)) << s;
+
+        float parsed = 0.0f;
+        fast_atoreal_move<float>(s.c_str(), parsed);
+        ASSERT_EQ(value, parsed) << s;
+    }
+}
+
+TEST_F(FastFtoaTest, roundTripDoubleTest) {
+    uint64_t state = 1;
+    for (unsigned int i = 0; i < 100000; ++i) {
+        const uint64_t bits = Next(state);
+        double value;
+        ::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+
+        const std::string s = Format(value);
+        ASSERT_LE(s.size(), 24u) << s;
+        ASSERT_EQ(value, strtod(s.c_str(), NULL)) << s;
+    }
+}
+
+TEST_F(FastFtoaTest, formatFixedTest) {
+    EXPECT_EQ("0.000000", FormatFixed(0.0, 6));
+    EXPECT_EQ("-0.000000", FormatFixed(-0.0, 6));
+    EXPECT_EQ("1.500", FormatFixed(1.5, 3));
+    EXPECT_EQ("2", FormatFixed(2.5, 0));
+    EXPECT_EQ("4", FormatFixed(3.5, 0));
+    EXPECT_EQ("-0.12", FormatFixed(-0.125, 2));
+    EXPECT_EQ("1e+20", FormatFixed(1e20, 6));
+    EXPECT_EQ("nan", FormatFixed(std::numeric_limits<double>::quiet_NaN(), 6));
+
+    // same output as printf for floats
+    uint64_t state = 2;
+    char expected[64];
+    for (unsigned int i = 0; i < 10000; ++i) {
+        const float value = static_cast<float>(static_cast<int64_t>(Next(state)) >> 24) / 65536.0f;
+        ::snprintf(expected, sizeof(expected), "%.6f", value);
+        ASSERT_EQ(std::string(expected), FormatFixed(value, 6));
+    }
+}
+
+TEST_F(FastFtoaTest, formatSequenceTest) {
+    const float values[] = { 1.0f, -0.5f, 0.25f };
+    char buffer[3 * AI_FTOA_MAX_CHARS];
+    EXPECT_EQ("1,-0.5,0.25", std::string(buffer, fast_ftoa_n(values, 3, ',', buffer)));
+    EXPECT_EQ("1.0 -0.5 0.2", std::string(buffer, fast_ftoa_fixed_n(values, 3, 1, ' ', buffer)));
+    EXPECT_EQ(buffer, fast_ftoa_n(values, 0, ' ', buffer));
+}
+
+TEST_F(FastFtoaTest, streamTest) {
+    std::ostringstream out;
+    out.precision(2);
+
+    const aiVector3D v(1.0f, 2.5f, -0.1f);
+    out << ShortestReals(v) << '|' << ShortestReals(v, ',') << '|' << ShortestReals(v.z) << '|' << FixedReals(v.y, 2);
+    EXPECT_EQ("1 2.5 -0.1|1,2.5,-0.1|-0.1|2.50", out.str());
+
+    out.str("");
+    out << ShortestReals(aiMatrix4x4());
+    EXPECT_EQ("1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1", out.str());
+
+    // longer than one block
+    ai_real values[40];
+    std::string expected;
+    for (unsigned int i = 0; i < 40; ++i) {
+        values[i] = static_cast<ai_real>(i) + 0.5f;
+        expected += (i ? " " : "") + std::to_string(i) + ".5";
+    }
+    out.str("");
+    out << ShortestReals(values, 40);
+    EXPECT_EQ(expected, out.str());
+}
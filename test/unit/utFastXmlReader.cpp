@@ -0,0 +1,191 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "irrXMLWrapper.h"
+#include "FastXmlReader.h"
+#include <assimp/DefaultIOSystem.h>
+
+#include <memory>
+#include <string>
+
+using namespace Assimp;
+using namespace irr::io;
+
+class FastXmlReaderTest : public ::testing::Test {
+public:
+    // Walks both readers in lockstep and compares every reported node
+    void compareWithIrrXML(const char* file) {
+        DefaultIOSystem io;
+        std::unique_ptr<IOStream> stream1(io.Open(file, "rb"));
+        std::unique_ptr<IOStream> stream2(io.Open(file, "rb"));
+        ASSERT_TRUE(NULL != stream1.get());
+        ASSERT_TRUE(NULL != stream2.get());
+
+        CIrrXML_IOStreamReader callback(stream1.get());
+        std::unique_ptr<IrrXMLReader> reference(createIrrXMLReader(&callback));
+        std::unique_ptr<IrrXMLReader> reader(new FastXmlReader(stream2.get()));
+
+        unsigned int nodes = 0;
+        while (reader->read()) {
+            ASSERT_TRUE(reference->read());
+            ASSERT_EQ(reference->getNodeType(), reader->getNodeType()) << file << ", node " << nodes;
+            if (reader->getNodeType() != EXN_COMMENT) {
+                // IrrXML cuts the first characters of <!DOCTYPE ..> declarations
+                EXPECT_STREQ(reference->getNodeName(), reader->getNodeName());
+            }
+            EXPECT_EQ(reference->isEmptyElement(), reader->isEmptyElement());
+            ASSERT_EQ(reference->getAttributeCount(), reader->getAttributeCount());
+            for (int i = 0; i < reader->getAttributeCount(); ++i) {
+                EXPECT_STREQ(reference->getAttributeName(i), reader->getAttributeName(i));
+                EXPECT_STREQ(reference->getAttributeValue(i), reader->getAttributeValue(i));
+            }
+            ++nodes;
+        }
+        EXPECT_LT(0u, nodes);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastXmlReaderTest, readElementsAndAttributesTest) {
+    static const char xml[] = "<?xml version=\"1.0\"?>\n"
+        "<root a=\"1\" b='two' >\n"
+        "  <empty c = \"3.5\"/>\n"
+        "  <text>hello</text >\n"
+        "</root>\n";
+    FastXmlReader reader(xml, sizeof(xml) - 1);
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_UNKNOWN, reader.getNodeType());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_ELEMENT, reader.getNodeType());
+    EXPECT_STREQ("root", reader.getNodeName());
+    EXPECT_FALSE(reader.isEmptyElement());
+    ASSERT_EQ(2, reader.getAttributeCount());
+    EXPECT_STREQ("a", reader.getAttributeName(0));
+    EXPECT_EQ(1, reader.getAttributeValueAsInt("a"));
+    EXPECT_STREQ("two", reader.getAttributeValue("b"));
+    EXPECT_TRUE(NULL == reader.getAttributeValue("missing"));
+    EXPECT_STREQ("", reader.getAttributeValueSafe("missing"));
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_TEXT, reader.getNodeType());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_STREQ("empty", reader.getNodeName());
+    EXPECT_TRUE(reader.isEmptyElement());
+    EXPECT_FLOAT_EQ(3.5f, reader.getAttributeValueAsFloat(0));
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_TEXT, reader.getNodeType());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_STREQ("text", reader.getNodeName());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_TEXT, reader.getNodeType());
+    EXPECT_STREQ("hello", reader.getNodeData());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_ELEMENT_END, reader.getNodeType());
+    EXPECT_STREQ("text", reader.getNodeName());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_ELEMENT_END, reader.getNodeType());
+    EXPECT_STREQ("root", reader.getNodeName());
+    EXPECT_FALSE(reader.read());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastXmlReaderTest, decodeEntitiesTest) {
+    static const char xml[] = "<a v=\"&lt;&amp;&gt;&quot;&apos;&#65;&#x42;&unknown;\">x &amp;&amp; y</a>";
+    FastXmlReader reader(xml, sizeof(xml) - 1);
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_STREQ("<&>\"'AB&unknown;", reader.getAttributeValue("v"));
+    // decoding happens only once
+    EXPECT_STREQ("<&>\"'AB&unknown;", reader.getAttributeValue(0));
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_STREQ("x && y", reader.getNodeData());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastXmlReaderTest, readCommentAndCDATATest) {
+    static const char xml[] = "<a><!-- some <b> comment --><![CDATA[ <raw> ]]></a>";
+    FastXmlReader reader(xml, sizeof(xml) - 1);
+
+    ASSERT_TRUE(reader.read());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_COMMENT, reader.getNodeType());
+    EXPECT_STREQ(" some <b> comment ", reader.getNodeData());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_CDATA, reader.getNodeType());
+    EXPECT_STREQ(" <raw> ", reader.getNodeData());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_ELEMENT_END, reader.getNodeType());
+    EXPECT_FALSE(reader.read());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastXmlReaderTest, matchesIrrXMLTest) {
+    compareWithIrrXML(ASSIMP_TEST_MODELS_DIR "/Collada/duck.dae");
+    compareWithIrrXML(ASSIMP_TEST_MODELS_DIR "/Collada/cube_xmlspecialchars.dae");
+    compareWithIrrXML(ASSIMP_TEST_MODELS_DIR "/Collada/cube_UTF8BOM.dae");
+    compareWithIrrXML(ASSIMP_TEST_MODELS_DIR "/Collada/cube_emptyTags.dae");
+    compareWithIrrXML(ASSIMP_TEST_MODELS_DIR "/AMF/test1.amf");
+    compareWithIrrXML(ASSIMP_TEST_MODELS_DIR "/X3D/ComputerKeyboard.x3d");
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastXmlReaderTest, readUTF16Test) {
+    DefaultIOSystem io;
+    std::unique_ptr<IOStream> stream(io.Open(ASSIMP_TEST_MODELS_DIR "/IRR/box.irr", "rb"));
+    ASSERT_TRUE(NULL != stream.get());
+
+    FastXmlReader reader(stream.get());
+    EXPECT_EQ(ETF_UTF16_LE, reader.getSourceFormat());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_UNKNOWN, reader.getNodeType());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(EXN_ELEMENT, reader.getNodeType());
+    EXPECT_STREQ("irr_scene", reader.getNodeName());
+}
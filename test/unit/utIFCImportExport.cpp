@@ -41,9 +41,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 #include "AbstractImportExportBase.h"
+#include "SceneDiffer.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -61,3 +63,33 @@ public:
 TEST_F( utIFCImportExport, importIFCFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+static void compareNodes( const aiNode *expected, const aiNode *toCompare ) {
+    EXPECT_EQ( std::string( expected->mName.C_Str() ), std::string( toCompare->mName.C_Str() ) );
+    ASSERT_EQ( expected->mNumMeshes, toCompare->mNumMeshes );
+    for ( unsigned int i = 0; i < expected->mNumMeshes; ++i ) {
+        EXPECT_EQ( expected->mMeshes[ i ], toCompare->mMeshes[ i ] );
+    }
+    ASSERT_EQ( expected->mNumChildren, toCompare->mNumChildren );
+    for ( unsigned int i = 0; i < expected->mNumChildren; ++i ) {
+        compareNodes( expected->mChildren[ i ], toCompare->mChildren[ i ] );
+    }
+}
+
+TEST_F( utIFCImportExport, importIFCMultithreadedTest ) {
+    Assimp::Importer sequential;
+    sequential.SetPropertyInteger( AI_CONFIG_IMPORT_IFC_NUM_THREADS, 1 );
+    const aiScene *expected = sequential.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, expected );
+
+    // the output must not depend on the number of threads generating the geometry
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_IMPORT_IFC_NUM_THREADS, 4 );
+    const aiScene *scene = parallel.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( expected, scene ) );
+    differ.showReport();
+    compareNodes( expected->mRootNode, scene->mRootNode );
+}
@@ -0,0 +1,140 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "IOStreamWriter.h"
+
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// IOStream recording every Write call, optionally failing all of them.
+class RecordingIOStream : public IOStream {
+public:
+    explicit RecordingIOStream( bool fail = false )
+    : m_fail( fail ) {
+        // empty
+    }
+
+    size_t Read( void*, size_t, size_t ) override {
+        return 0;
+    }
+
+    size_t Write( const void* pvBuffer, size_t pSize, size_t pCount ) override {
+        if ( m_fail ) {
+            return 0;
+        }
+        const char *data = static_cast<const char*>( pvBuffer );
+        m_writes.push_back( std::string( data, data + pSize * pCount ) );
+        return pCount;
+    }
+
+    aiReturn Seek( size_t, aiOrigin ) override {
+        return aiReturn_FAILURE;
+    }
+
+    size_t Tell() const override {
+        return content().size();
+    }
+
+    size_t FileSize() const override {
+        return content().size();
+    }
+
+    void Flush() override {
+        // empty
+    }
+
+    std::string content() const {
+        std::string all;
+        for ( const std::string &w : m_writes ) {
+            all += w;
+        }
+        return all;
+    }
+
+    bool m_fail;
+    std::vector<std::string> m_writes;
+};
+
+}
+
+class IOStreamWriterTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F( IOStreamWriterTest, writeInChunksTest ) {
+    RecordingIOStream stream;
+    {
+        IOStreamWriter writer( &stream, 8 );
+        writer << "v " << 1.5 << ' ' << 42 << '\n';
+        writer << "abc";
+        EXPECT_FALSE( writer.flush().fail() );
+    }
+    EXPECT_EQ( "v 1.5 42\nabc", stream.content() );
+    for ( const std::string &w : stream.m_writes ) {
+        EXPECT_LE( w.size(), 8U );
+    }
+}
+
+TEST_F( IOStreamWriterTest, largeBlockBypassesChunkTest ) {
+    RecordingIOStream stream;
+    const std::string block( 100, 'x' );
+    {
+        IOStreamWriter writer( &stream, 16 );
+        writer << "ab";
+        writer.write( block.data(), block.size() );
+    }
+    ASSERT_EQ( 2U, stream.m_writes.size() );
+    EXPECT_EQ( "ab", stream.m_writes[ 0 ] );
+    EXPECT_EQ( block, stream.m_writes[ 1 ] );
+}
+
+TEST_F( IOStreamWriterTest, writeErrorSetsFailTest ) {
+    RecordingIOStream stream( true );
+    IOStreamWriter writer( &stream, 4 );
+    writer << "some text";
+    EXPECT_TRUE( writer.flush().fail() );
+}
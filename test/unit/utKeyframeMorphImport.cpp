@@ -0,0 +1,260 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+#include "UnitTestPCH.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/cexport.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <string.h>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+template <typename T>
+void putLE( std::string &out, T value ) {
+    uint8_t bytes[ sizeof( T ) ];
+    ::memcpy( bytes, &value, sizeof( T ) );
+    union { uint16_t u; uint8_t b[ 2 ]; } probe = { 1 };
+    for ( size_t i = 0; i < sizeof( T ); ++i ) {
+        out += static_cast<char>( bytes[ probe.b[ 0 ] ? i : sizeof( T ) - 1 - i ] );
+    }
+}
+
+void putName( std::string &out, const char *name, size_t length ) {
+    std::string padded( name );
+    padded.resize( length, '\0' );
+    out += padded;
+}
+
+// Builds an MDC file with one triangle and three frames: frame 0 and 2 use
+// base frame 0, frame 1 uses base frame 1 and frame 2 adds compressed frame 0.
+std::string buildMdc() {
+    static const uint32_t numFrames = 3, headerSize = 112, frameSize = 56, surfaceSize = 124;
+    static const uint32_t surfaceOffset = headerSize + numFrames * frameSize;
+    static const uint32_t ofsTriangles = surfaceSize, ofsShaders = ofsTriangles + 12, ofsTexCoords = ofsShaders + 68,
+        ofsBaseVerts = ofsTexCoords + 3 * 8, ofsCompVerts = ofsBaseVerts + 2 * 3 * 8,
+        ofsBaseFrames = ofsCompVerts + 3 * 4, ofsCompFrames = ofsBaseFrames + numFrames * 2,
+        surfaceEnd = ofsCompFrames + numFrames * 2;
+
+    std::string out( "IDPC" );
+    putLE<uint32_t>( out, 2 );
+    putName( out, "test", 64 );
+    const uint32_t header[] = { 0, numFrames, 0, 1, 0, headerSize, surfaceOffset, surfaceOffset, surfaceOffset, surfaceOffset + surfaceEnd };
+    for ( uint32_t v : header ) putLE( out, v );
+
+    const float origins[ numFrames ][ 3 ] = { { 0, 0, 0 }, { 1, 2, 3 }, { 10, 0, 0 } };
+    for ( unsigned int f = 0; f < numFrames; ++f ) {
+        for ( int i = 0; i < 6; ++i ) putLE( out, 0.f ); // bounding box
+        for ( float v : origins[ f ] ) putLE( out, v );
+        putLE( out, 0.f );
+        putName( out, "frame", 16 );
+    }
+
+    putLE<uint32_t>( out, 0 );
+    putName( out, "surface", 64 );
+    const uint32_t surface[] = { 0, 1, 2, 1, 3, 1, ofsTriangles, ofsShaders, ofsTexCoords, ofsBaseVerts, ofsCompVerts, ofsBaseFrames, ofsCompFrames, surfaceEnd };
+    for ( uint32_t v : surface ) putLE( out, v );
+
+    for ( uint32_t i = 0; i < 3; ++i ) putLE( out, i );
+    putName( out, "shader", 64 );
+    putLE<uint32_t>( out, 0 );
+    for ( int i = 0; i < 6; ++i ) putLE( out, i * 0.125f );
+
+    // base frame 1 is twice as large as base frame 0, 1/64 units per step
+    for ( int16_t scale = 1; scale <= 2; ++scale ) {
+        const int16_t verts[ 3 ][ 3 ] = { { 64, 0, 0 }, { 0, 128, 0 }, { 0, 0, 192 } };
+        for ( const auto &v : verts ) {
+            for ( int16_t c : v ) putLE<int16_t>( out, c * scale );
+            putLE<uint16_t>( out, 0 );
+        }
+    }
+    // +1 in x and -1 in z: 127 is zero, each step is 4/64 units
+    for ( int i = 0; i < 3; ++i ) {
+        const uint8_t delta[] = { 143, 127, 111, 0 };
+        out.append( reinterpret_cast<const char*>( delta ), 4 );
+    }
+    const int16_t baseFrames[ numFrames ] = { 0, 1, 0 }, compFrames[ numFrames ] = { -1, -1, 0 };
+    for ( int16_t v : baseFrames ) putLE( out, v );
+    for ( int16_t v : compFrames ) putLE( out, v );
+    return out;
+}
+
+} // Namespace
+
+class utKeyframeMorphImport : public ::testing::Test {
+protected:
+    // Reads the given file, or memoryFile with the given extension hint if it is set.
+    const aiScene *read( Importer &importer, const char *file ) {
+        if ( memoryFile.empty() ) {
+            return importer.ReadFile( file, aiProcess_ValidateDataStructure );
+        }
+        return importer.ReadFileFromMemory( memoryFile.data(), memoryFile.size(), aiProcess_ValidateDataStructure, file );
+    }
+
+    // Imports all frames of a file at once and checks them against
+    // separate imports of single frames.
+    void checkAllFrames( const char *file, const char *keyframeProperty ) {
+        Importer all;
+        all.SetPropertyBool( AI_CONFIG_IMPORT_ALL_KEYFRAMES, true );
+        const aiScene *scene = read( all, file );
+        ASSERT_NE( nullptr, scene );
+        ASSERT_EQ( 1u, scene->mNumAnimations );
+
+        const aiAnimation *anim = scene->mAnimations[ 0 ];
+        ASSERT_EQ( scene->mNumMeshes, anim->mNumMorphMeshChannels );
+        const unsigned int numFrames = scene->mMeshes[ 0 ]->mNumAnimMeshes;
+        ASSERT_NE( 0u, numFrames );
+        EXPECT_EQ( numFrames - 1, anim->mDuration );
+
+        for ( unsigned int m = 0; m < scene->mNumMeshes; ++m ) {
+            const aiMesh *mesh = scene->mMeshes[ m ];
+            ASSERT_EQ( numFrames, mesh->mNumAnimMeshes );
+            EXPECT_NE( 0u, mesh->mName.length );
+            EXPECT_EQ( mesh->mName, anim->mMorphMeshChannels[ m ]->mName );
+            ASSERT_EQ( numFrames, anim->mMorphMeshChannels[ m ]->mNumKeys );
+        }
+
+        // first, some frame in between and last frame
+        const unsigned int frames[] = { 0, numFrames / 2, numFrames - 1 };
+        for ( unsigned int frame : frames ) {
+            Importer single;
+            single.SetPropertyInteger( keyframeProperty, frame );
+            const aiScene *ref = read( single, file );
+            ASSERT_NE( nullptr, ref );
+            ASSERT_EQ( scene->mNumMeshes, ref->mNumMeshes );
+
+            for ( unsigned int m = 0; m < scene->mNumMeshes; ++m ) {
+                const aiAnimMesh *target = scene->mMeshes[ m ]->mAnimMeshes[ frame ];
+                const aiMesh *expected = ref->mMeshes[ m ];
+                ASSERT_EQ( expected->mNumVertices, target->mNumVertices );
+                ASSERT_TRUE( target->HasNormals() );
+                for ( unsigned int v = 0; v < target->mNumVertices; ++v ) {
+                    EXPECT_EQ( expected->mVertices[ v ], target->mVertices[ v ] );
+                    EXPECT_EQ( expected->mNormals[ v ], target->mNormals[ v ] );
+                }
+            }
+        }
+    }
+
+    std::string memoryFile;
+};
+
+TEST_F( utKeyframeMorphImport, importAllFramesMD2Test ) {
+    checkAllFrames( ASSIMP_TEST_MODELS_DIR "/MD2/sydney.md2", AI_CONFIG_IMPORT_MD2_KEYFRAME );
+}
+
+// the MD3 test models have a single frame only
+TEST_F( utKeyframeMorphImport, importAllFramesMD3Test ) {
+    checkAllFrames( ASSIMP_TEST_MODELS_DIR "/../models-nonbsd/MD3/watercan.md3", AI_CONFIG_IMPORT_MD3_KEYFRAME );
+}
+
+TEST_F( utKeyframeMorphImport, importAllFramesMDLTest ) {
+    checkAllFrames( ASSIMP_TEST_MODELS_DIR "/../models-nonbsd/MDL/IDPO (Quake1)/gijoe.mdl", AI_CONFIG_IMPORT_MDL_KEYFRAME );
+}
+
+TEST_F( utKeyframeMorphImport, importAllFramesMDCTest ) {
+    memoryFile = buildMdc();
+    checkAllFrames( "mdc", AI_CONFIG_IMPORT_MDC_KEYFRAME );
+
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_ALL_KEYFRAMES, true );
+    const aiScene *scene = read( importer, "mdc" );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( 1u, scene->mNumMeshes );
+    const aiMesh *mesh = scene->mMeshes[ 0 ];
+    EXPECT_STREQ( "surface", mesh->mName.C_Str() );
+    ASSERT_EQ( 3u, mesh->mNumVertices );
+    ASSERT_EQ( 3u, mesh->mNumAnimMeshes );
+    EXPECT_EQ( aiVector3D( 0.25f, 1.f - 0.375f, 0.f ), mesh->mTextureCoords[ 0 ][ 1 ] );
+
+    // frame 0 and 1 from the base frames, frame 2 from the compressed frame
+    const aiVector3D expected[ 3 ][ 3 ] = {
+        { aiVector3D( 1, 0, 0 ), aiVector3D( 0, 2, 0 ), aiVector3D( 0, 0, 3 ) },
+        { aiVector3D( 3, 2, 3 ), aiVector3D( 1, 6, 3 ), aiVector3D( 1, 2, 9 ) },
+        { aiVector3D( 12, 0, -1 ), aiVector3D( 11, 2, -1 ), aiVector3D( 11, 0, 2 ) }
+    };
+    for ( unsigned int f = 0; f < 3; ++f ) {
+        const aiAnimMesh *target = mesh->mAnimMeshes[ f ];
+        for ( unsigned int v = 0; v < 3; ++v ) {
+            EXPECT_EQ( expected[ f ][ v ], target->mVertices[ v ] ) << "frame " << f << ", vertex " << v;
+            EXPECT_NEAR( 1.f, target->mNormals[ v ].Length(), 1e-3f );
+        }
+    }
+    for ( unsigned int v = 0; v < 3; ++v ) {
+        EXPECT_EQ( expected[ 0 ][ v ], mesh->mVertices[ v ] );
+    }
+}
+
+TEST_F( utKeyframeMorphImport, defaultImportHasNoMorphTargetsTest ) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/MD2/sydney.md2", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_EQ( 0u, scene->mNumAnimations );
+    EXPECT_EQ( 0u, scene->mMeshes[ 0 ]->mNumAnimMeshes );
+}
+
+TEST_F( utKeyframeMorphImport, copySceneWithMorphTargetsTest ) {
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_ALL_KEYFRAMES, true );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/MD2/sydney.md2", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    // the copy must own its morph targets and channels
+    aiScene *copy = nullptr;
+    aiCopyScene( scene, &copy );
+    ASSERT_NE( nullptr, copy );
+    const aiMesh *src = scene->mMeshes[ 0 ], *dst = copy->mMeshes[ 0 ];
+    ASSERT_EQ( src->mNumAnimMeshes, dst->mNumAnimMeshes );
+    EXPECT_NE( src->mAnimMeshes, dst->mAnimMeshes );
+    EXPECT_NE( src->mAnimMeshes[ 0 ]->mVertices, dst->mAnimMeshes[ 0 ]->mVertices );
+    EXPECT_EQ( src->mAnimMeshes[ 1 ]->mVertices[ 0 ], dst->mAnimMeshes[ 1 ]->mVertices[ 0 ] );
+    ASSERT_EQ( 1u, copy->mNumAnimations );
+    EXPECT_NE( scene->mAnimations[ 0 ]->mMorphMeshChannels[ 0 ], copy->mAnimations[ 0 ]->mMorphMeshChannels[ 0 ] );
+    EXPECT_EQ( 1u, copy->mAnimations[ 0 ]->mMorphMeshChannels[ 0 ]->mKeys[ 1 ].mValues[ 0 ] );
+    aiFreeScene( copy );
+}
@@ -266,6 +266,35 @@ TEST_F( utObjImportExport, issue809_vertex_color_Test ) {
 #endif // ASSIMP_BUILD_NO_EXPORT
 }
 
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F( utObjImportExport, export_keeps_source_scene_Test ) {
+    const aiScene *scene = m_im->ReadFileFromMemory( ( void* ) ObjModel.c_str(), ObjModel.size(), 0 );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( 1u, scene->mNumMeshes );
+    const aiMesh *mesh = scene->mMeshes[ 0 ];
+    aiMaterial *const *materials = scene->mMaterials;
+    const unsigned int numMaterials = scene->mNumMaterials;
+    ASSERT_EQ( nullptr, mesh->mNormals );
+    ASSERT_EQ( 4u, mesh->mFaces[ 0 ].mNumIndices );
+
+    // the obj exporter enforces normals, triangulation works on a copy of the meshes as well
+    ::Assimp::Exporter exporter;
+    EXPECT_NE( nullptr, exporter.ExportToBlob( scene, "obj" ) );
+    EXPECT_EQ( aiReturn_SUCCESS, exporter.Export( scene, "obj", ASSIMP_TEST_MODELS_DIR "/OBJ/test.obj", aiProcess_Triangulate ) );
+    EXPECT_EQ( aiReturn_SUCCESS, exporter.Export( scene, "obj", ASSIMP_TEST_MODELS_DIR "/OBJ/test.obj", aiProcess_FlipUVs ) );
+
+    EXPECT_EQ( mesh, scene->mMeshes[ 0 ] );
+    EXPECT_EQ( materials, scene->mMaterials );
+    EXPECT_EQ( nullptr, mesh->mNormals );
+    EXPECT_EQ( 4u, mesh->mFaces[ 0 ].mNumIndices );
+    EXPECT_EQ( 6u, mesh->mNumFaces );
+    EXPECT_EQ( numMaterials, scene->mNumMaterials );
+    EXPECT_NE( nullptr, scene->mMaterials[ 0 ] );
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
+
 TEST_F( utObjImportExport, issue1453_segfault ) {
     static const std::string ObjModel =
         "v  0.0  0.0  0.0\n"
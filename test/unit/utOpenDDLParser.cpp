@@ -0,0 +1,119 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <openddlparser/OpenDDLParser.h>
+
+#include <cstring>
+
+USE_ODDLPARSER_NS
+
+class utOpenDDLParser : public ::testing::Test {
+    // empty
+};
+
+// Parses a VertexArray structure holding pData in typed array mode.
+static bool parse( OpenDDLParser &parser, const char *pData ) {
+    const std::string text( std::string( "VertexArray { " ) + pData + " }" );
+    parser.setTypedArrayMode( true );
+    parser.setBuffer( text.c_str(), text.size() );
+    return parser.parse();
+}
+
+static const DataArrayList *getDataArrayList( const OpenDDLParser &parser ) {
+    DDLNode *root( parser.getRoot() );
+    if ( nullptr == root || root->getChildNodeList().empty() ) {
+        return nullptr;
+    }
+    return root->getChildNodeList()[ 0 ]->getDataArrayList();
+}
+
+TEST_F( utOpenDDLParser, parseTypedArraysTest ) {
+    OpenDDLParser parser;
+    ASSERT_TRUE( parse( parser, "float[3] { {1, 2, 3}, {4.5, -5, 6} }" ) );
+    const DataArrayList *list( getDataArrayList( parser ) );
+    ASSERT_NE( nullptr, list );
+    ASSERT_NE( nullptr, list->m_typedData );
+    EXPECT_EQ( 3u, list->m_numItems );
+    EXPECT_EQ( 2u, list->m_numArrays );
+
+    const float expected[] = { 1.f, 2.f, 3.f, 4.5f, -5.f, 6.f };
+    EXPECT_EQ( 0, ::memcmp( expected, list->m_typedData->m_data, sizeof( expected ) ) );
+}
+
+TEST_F( utOpenDDLParser, parseHexLiteralsTest ) {
+    // hex literals give the bit pattern of the item
+    OpenDDLParser parser;
+    ASSERT_TRUE( parse( parser, "float[2] { {0x3F800000, 0xC0000000} }" ) );
+    const DataArrayList *list( getDataArrayList( parser ) );
+    ASSERT_NE( nullptr, list );
+    ASSERT_NE( nullptr, list->m_typedData );
+
+    const float expected[] = { 1.f, -2.f };
+    EXPECT_EQ( 0, ::memcmp( expected, list->m_typedData->m_data, sizeof( expected ) ) );
+}
+
+TEST_F( utOpenDDLParser, parseShortTypedArraysTest ) {
+    // missing items are zero, surplus items are dropped
+    OpenDDLParser parser;
+    ASSERT_TRUE( parse( parser, "int32[3] { {1, 2}, {3}, {4, 5, 6, 7} }" ) );
+    const DataArrayList *list( getDataArrayList( parser ) );
+    ASSERT_NE( nullptr, list );
+    ASSERT_NE( nullptr, list->m_typedData );
+    EXPECT_EQ( 3u, list->m_numArrays );
+
+    const int32 expected[] = { 1, 2, 0, 3, 0, 0, 4, 5, 6 };
+    EXPECT_EQ( 0, ::memcmp( expected, list->m_typedData->m_data, sizeof( expected ) ) );
+}
+
+TEST_F( utOpenDDLParser, rejectMalformedTypedArraysTest ) {
+    // brackets inside an array can't be skipped, parsing must stop instead of looping
+    const char *malformed[] = {
+        "float[3] { {1, 2, (3}, {4, 5, 6} }",
+        "float[3] { {1, 2, [3]} }",
+        "float[3] { {1, 2, {3}} }"
+    };
+    for ( const char *data : malformed ) {
+        OpenDDLParser parser;
+        EXPECT_FALSE( parse( parser, data ) ) << data;
+    }
+}
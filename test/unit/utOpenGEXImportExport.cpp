@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -67,3 +68,22 @@ TEST_F( utOpenGEXImportExport, Importissue1262_NoCrash ) {
     EXPECT_NE( nullptr, scene );
 
 }
+
+TEST_F( utOpenGEXImportExport, importRGBVertexColorsTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OpenGEX/animation_example.ogex", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    bool hasColors( false );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        const aiMesh *mesh = scene->mMeshes[ i ];
+        EXPECT_EQ( mesh->mNumFaces * 3, mesh->mNumVertices );
+        if ( mesh->HasVertexColors( 0 ) ) {
+            hasColors = true;
+            for ( unsigned int j = 0; j < mesh->mNumVertices; ++j ) {
+                EXPECT_EQ( aiColor4D( 1.0f, 1.0f, 1.0f, 1.0f ), mesh->mColors[ 0 ][ j ] );
+            }
+        }
+    }
+    EXPECT_TRUE( hasColors );
+}
@@ -45,8 +45,82 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include "AbstractImportExportBase.h"
 
+#include <algorithm>
+#include <sstream>
+
 using namespace ::Assimp;
 
+namespace {
+
+// Append a value to a binary PLY body in the requested byte order
+template <typename T>
+void putBinary( std::string &out, T value, bool bigEndian ) {
+    char bytes[ sizeof( T ) ];
+    ::memcpy( bytes, &value, sizeof( T ) );
+    const uint16_t probe = 1;
+    const bool hostBigEndian = ( 0 == *reinterpret_cast<const char*>( &probe ) );
+    if ( hostBigEndian != bigEndian ) {
+        std::reverse( bytes, bytes + sizeof( T ) );
+    }
+    out.append( bytes, sizeof( T ) );
+}
+
+// A grid of quads with mixed property types, in ascii, little or big endian format
+std::string buildGridPly( unsigned int size, const char *format ) {
+    const bool ascii = 0 == ::strcmp( format, "ascii" );
+    const bool bigEndian = 0 == ::strcmp( format, "binary_big_endian" );
+    const unsigned int numVertices = size * size, numFaces = ( size - 1 ) * ( size - 1 );
+
+    std::ostringstream header;
+    header << "ply\nformat " << format << " 1.0\n"
+           << "element vertex " << numVertices << "\n"
+           << "property float x\nproperty double y\nproperty short z\n"
+           << "property float nx\nproperty float ny\nproperty float nz\n"
+           << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+           << "element face " << numFaces << "\n"
+           << "property list uchar int vertex_indices\n"
+           << "end_header\n";
+
+    std::string out = header.str();
+    std::ostringstream text;
+    for ( unsigned int i = 0; i < numVertices; ++i ) {
+        const float x = static_cast<float>( i % size ) * 0.5f;
+        const double y = static_cast<double>( i / size ) * 0.25;
+        const int16_t z = static_cast<int16_t>( i % 7 ) - 3;
+        const uint8_t c = static_cast<uint8_t>( i );
+        if ( ascii ) {
+            text << x << " " << y << " " << z << " 0 0 1 " << unsigned( c ) << " 0 255\n";
+        } else {
+            putBinary( out, x, bigEndian );
+            putBinary( out, y, bigEndian );
+            putBinary( out, z, bigEndian );
+            putBinary( out, 0.f, bigEndian );
+            putBinary( out, 0.f, bigEndian );
+            putBinary( out, 1.f, bigEndian );
+            putBinary( out, c, bigEndian );
+            putBinary( out, uint8_t( 0 ), bigEndian );
+            putBinary( out, uint8_t( 255 ), bigEndian );
+        }
+    }
+    for ( unsigned int row = 0; row + 1 < size; ++row ) {
+        for ( unsigned int col = 0; col + 1 < size; ++col ) {
+            const int32_t a = row * size + col;
+            const int32_t quad[ 4 ] = { a, a + 1, a + 1 + int32_t( size ), a + int32_t( size ) };
+            if ( ascii ) {
+                text << "4 " << quad[ 0 ] << " " << quad[ 1 ] << " " << quad[ 2 ] << " " << quad[ 3 ] << "\n";
+            } else {
+                putBinary( out, uint8_t( 4 ), bigEndian );
+                for ( unsigned int k = 0; k < 4; ++k ) {
+                    putBinary( out, quad[ k ], bigEndian );
+                }
+            }
+        }
+    }
+    return out + text.str();
+}
+
+} // Namespace
+
 class utPLYImportExport : public AbstractImportExportBase {
 public:
     virtual bool importerTest() {
@@ -90,3 +164,63 @@ TEST_F( utPLYImportExport, vertexColorTest ) {
     const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PLY/float-color.ply", 0 );
     EXPECT_NE( nullptr, scene );
 }
+
+TEST_F( utPLYImportExport, binaryByteOrderTest ) {
+    static const unsigned int size = 17;
+    const char *formats[] = { "ascii", "binary_little_endian", "binary_big_endian" };
+    for ( unsigned int f = 0; f < 3; ++f ) {
+        const std::string data = buildGridPly( size, formats[ f ] );
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFileFromMemory( data.c_str(), data.size(), 0, "ply" );
+        ASSERT_NE( nullptr, scene ) << formats[ f ];
+        ASSERT_EQ( 1u, scene->mNumMeshes );
+
+        const aiMesh *mesh = scene->mMeshes[ 0 ];
+        ASSERT_EQ( size * size, mesh->mNumVertices );
+        ASSERT_EQ( ( size - 1 ) * ( size - 1 ), mesh->mNumFaces );
+        ASSERT_NE( nullptr, mesh->mNormals );
+        ASSERT_NE( nullptr, mesh->mColors[ 0 ] );
+        for ( unsigned int i = 0; i < mesh->mNumVertices; ++i ) {
+            EXPECT_FLOAT_EQ( ( i % size ) * 0.5f, mesh->mVertices[ i ].x );
+            EXPECT_FLOAT_EQ( ( i / size ) * 0.25f, mesh->mVertices[ i ].y );
+            EXPECT_FLOAT_EQ( static_cast<float>( int( i % 7 ) - 3 ), mesh->mVertices[ i ].z );
+            EXPECT_FLOAT_EQ( 1.f, mesh->mNormals[ i ].z );
+            EXPECT_FLOAT_EQ( ( i & 0xff ) / 255.f, mesh->mColors[ 0 ][ i ].r );
+            EXPECT_FLOAT_EQ( 1.f, mesh->mColors[ 0 ][ i ].b );
+        }
+        const aiFace &last = mesh->mFaces[ mesh->mNumFaces - 1 ];
+        ASSERT_EQ( 4u, last.mNumIndices );
+        EXPECT_EQ( size * size - 1, last.mIndices[ 2 ] );
+        EXPECT_EQ( size * size - 2 - size, last.mIndices[ 0 ] );
+    }
+}
+
+TEST_F( utPLYImportExport, largeBinaryMatchesAsciiTest ) {
+    // large enough for the binary decoder to run across many buffer refills
+    static const unsigned int size = 256;
+    const std::string ascii = buildGridPly( size, "ascii" );
+    Assimp::Importer asciiImporter;
+    const aiScene *expected = asciiImporter.ReadFileFromMemory( ascii.c_str(), ascii.size(), 0, "ply" );
+    ASSERT_NE( nullptr, expected );
+    const aiMesh *expectedMesh = expected->mMeshes[ 0 ];
+    ASSERT_EQ( size * size, expectedMesh->mNumVertices );
+
+    const char *formats[] = { "binary_little_endian", "binary_big_endian" };
+    for ( const char *format : formats ) {
+        const std::string data = buildGridPly( size, format );
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFileFromMemory( data.c_str(), data.size(), 0, "ply" );
+        ASSERT_NE( nullptr, scene ) << format;
+        const aiMesh *mesh = scene->mMeshes[ 0 ];
+        ASSERT_EQ( expectedMesh->mNumVertices, mesh->mNumVertices ) << format;
+        ASSERT_EQ( expectedMesh->mNumFaces, mesh->mNumFaces ) << format;
+        for ( unsigned int i = 0; i < mesh->mNumVertices; ++i ) {
+            ASSERT_EQ( expectedMesh->mVertices[ i ], mesh->mVertices[ i ] ) << format << " vertex " << i;
+            ASSERT_EQ( expectedMesh->mNormals[ i ], mesh->mNormals[ i ] ) << format << " vertex " << i;
+            ASSERT_EQ( expectedMesh->mColors[ 0 ][ i ], mesh->mColors[ 0 ][ i ] ) << format << " vertex " << i;
+        }
+        for ( unsigned int i = 0; i < mesh->mNumFaces; ++i ) {
+            ASSERT_EQ( expectedMesh->mFaces[ i ], mesh->mFaces[ i ] ) << format << " face " << i;
+        }
+    }
+}
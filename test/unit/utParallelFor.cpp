@@ -0,0 +1,104 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "ParallelFor.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Assimp;
+
+class ParallelForTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F( ParallelForTest, visitsEveryItemOnceTest ) {
+    const unsigned int threadCounts[] = { 0, 1, 2, 7 };
+    for ( unsigned int numThreads : threadCounts ) {
+        std::vector<std::atomic<int>> visits( 1000 );
+        ParallelFor( visits.size(), numThreads, [&visits]( size_t i ) {
+            ++visits[ i ];
+        } );
+        for ( size_t i = 0; i < visits.size(); ++i ) {
+            EXPECT_EQ( 1, visits[ i ] ) << numThreads << " threads, item " << i;
+        }
+    }
+    ParallelFor( 0, 0, []( size_t ) {
+        FAIL();
+    } );
+}
+
+TEST_F( ParallelForTest, oneThreadRunsInOrderTest ) {
+    std::vector<size_t> order;
+    ParallelFor( 100, 1, [&order]( size_t i ) {
+        order.push_back( i );
+    } );
+    ASSERT_EQ( 100U, order.size() );
+    for ( size_t i = 0; i < order.size(); ++i ) {
+        EXPECT_EQ( i, order[ i ] );
+    }
+}
+
+TEST_F( ParallelForTest, rethrowsLowestFailedItemTest ) {
+    const unsigned int threadCounts[] = { 0, 1, 4 };
+    for ( unsigned int numThreads : threadCounts ) {
+        try {
+            ParallelFor( 1000, numThreads, []( size_t i ) {
+                if ( i % 100 == 42 ) {
+                    throw std::runtime_error( std::to_string( i ) );
+                }
+            } );
+            FAIL() << "no exception with " << numThreads << " threads";
+        } catch ( const std::runtime_error &err ) {
+            EXPECT_STREQ( "42", err.what() );
+        }
+    }
+}
+
+TEST_F( ParallelForTest, threadCountTest ) {
+    EXPECT_EQ( 1U, GetParallelThreadCount( 1, 100 ) );
+    EXPECT_EQ( 1U, GetParallelThreadCount( 8, 0 ) );
+    EXPECT_LE( GetParallelThreadCount( 8, 3 ), 3U );
+    EXPECT_GE( GetParallelThreadCount( 0, 100 ), 1U );
+}
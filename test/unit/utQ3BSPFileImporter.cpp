@@ -0,0 +1,107 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "AbstractImportExportBase.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utQ3BSPFileImporter : public AbstractImportExportBase {
+public:
+    virtual bool importerTest() {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PK3/bezier_patch.pk3", aiProcess_ValidateDataStructure );
+        return nullptr != scene;
+    }
+};
+
+TEST_F( utQ3BSPFileImporter, importBezierPatchTest ) {
+    EXPECT_TRUE( importerTest() );
+}
+
+TEST_F( utQ3BSPFileImporter, tessellatePatchTest ) {
+    // the level holds a triangle and a single 3x3 bezier patch with the same material
+    Assimp::Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_IMPORT_Q3BSP_PATCH_TESSELLATION, 4 );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PK3/bezier_patch.pk3", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( 1u, scene->mNumMeshes );
+
+    const aiMesh *mesh = scene->mMeshes[ 0 ];
+    EXPECT_EQ( 1u + 4u * 4u * 2u, mesh->mNumFaces );
+    EXPECT_EQ( 3u + 5u * 5u, mesh->mNumVertices );
+
+    // the patch passes through its corner control points and bulges to z = 4 in its center
+    bool foundCorner = false;
+    float maxZ = 0.0f;
+    for ( unsigned int i = 0; i < mesh->mNumVertices; ++i ) {
+        foundCorner |= mesh->mVertices[ i ] == aiVector3D( 64.0f, 64.0f, 0.0f );
+        maxZ = std::max( maxZ, mesh->mVertices[ i ].z );
+    }
+    EXPECT_TRUE( foundCorner );
+    EXPECT_FLOAT_EQ( 4.0f, maxZ );
+
+    // patch triangles are wound like the other faces of the level
+    for ( unsigned int i = 0; i < mesh->mNumFaces; ++i ) {
+        const aiFace &face = mesh->mFaces[ i ];
+        ASSERT_EQ( 3u, face.mNumIndices );
+        const aiVector3D &a = mesh->mVertices[ face.mIndices[ 0 ] ];
+        const aiVector3D &b = mesh->mVertices[ face.mIndices[ 1 ] ];
+        const aiVector3D &c = mesh->mVertices[ face.mIndices[ 2 ] ];
+        EXPECT_LT( ( ( b - a ) ^ ( c - a ) ).z, 0.0f );
+    }
+}
+
+TEST_F( utQ3BSPFileImporter, skipPatchesTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_IMPORT_Q3BSP_PATCH_TESSELLATION, 0 );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PK3/bezier_patch.pk3", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( 1u, scene->mNumMeshes );
+    EXPECT_EQ( 1u, scene->mMeshes[ 0 ]->mNumFaces );
+    EXPECT_EQ( 3u, scene->mMeshes[ 0 ]->mNumVertices );
+}
@@ -46,9 +46,37 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <set>
+#include <string>
+#include <vector>
 
 using namespace Assimp;
 
+namespace {
+
+// Build a binary STL holding a unit quad as two facets sharing an edge. The
+// second facet gets a 15 bit color of r=31, g=0, b=16 in the attribute word.
+std::string buildBinaryQuad() {
+    std::string data( 80, ' ' );
+    const uint32_t numFacets = 2;
+    data.append( reinterpret_cast<const char*>( &numFacets ), sizeof( numFacets ) );
+
+    const float facets[ 2 ][ 12 ] = {
+        { 0, 0, 1,  0, 0, 0,  1, 0, 0,  1, 1, 0 },
+        { 0, 0, 1,  0, 0, 0,  1, 1, 0,  0, 1, 0 }
+    };
+    const uint16_t attributes[ 2 ] = { 0, uint16_t( ( 1 << 15 ) | ( 31 << 10 ) | 16 ) };
+    for ( unsigned int i = 0; i < 2; ++i ) {
+        data.append( reinterpret_cast<const char*>( facets[ i ] ), sizeof( facets[ i ] ) );
+        data.append( reinterpret_cast<const char*>( &attributes[ i ] ), sizeof( attributes[ i ] ) );
+    }
+    return data;
+}
+
+} // Namespace
+
 class utSTLImporterExporter : public AbstractImportExportBase {
 public:
     virtual bool importerTest() {
@@ -67,3 +95,71 @@ TEST_F( utSTLImporterExporter, test_with_two_solids ) {
     const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/STL/triangle_with_two_solids.stl", aiProcess_ValidateDataStructure );
     EXPECT_NE( nullptr, scene );
 }
+
+TEST_F( utSTLImporterExporter, binaryFacetColorTest ) {
+    const std::string data = buildBinaryQuad();
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory( data.c_str(), data.size(), aiProcess_ValidateDataStructure, "stl" );
+    ASSERT_NE( nullptr, scene );
+
+    const aiMesh *mesh = scene->mMeshes[ 0 ];
+    EXPECT_EQ( 6u, mesh->mNumVertices );
+    EXPECT_EQ( 2u, mesh->mNumFaces );
+    ASSERT_NE( nullptr, mesh->mNormals );
+    EXPECT_FLOAT_EQ( 1.f, mesh->mNormals[ 5 ].z );
+    EXPECT_FLOAT_EQ( 1.f, mesh->mVertices[ 2 ].y );
+    ASSERT_NE( nullptr, mesh->mColors[ 0 ] );
+
+    // the uncolored facet keeps the default color
+    EXPECT_FLOAT_EQ( 0.6f, mesh->mColors[ 0 ][ 0 ].r );
+    for ( unsigned int i = 3; i < 6; ++i ) {
+        EXPECT_FLOAT_EQ( 1.f, mesh->mColors[ 0 ][ i ].r );
+        EXPECT_FLOAT_EQ( 0.f, mesh->mColors[ 0 ][ i ].g );
+        EXPECT_FLOAT_EQ( 16.f / 31.f, mesh->mColors[ 0 ][ i ].b );
+    }
+}
+
+TEST_F( utSTLImporterExporter, weldVerticesTest ) {
+    const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/STL/sphereWithHole.stl",
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl"
+    };
+    for ( unsigned int f = 0; f < 2; ++f ) {
+        Assimp::Importer plainImporter, weldImporter;
+        weldImporter.SetPropertyBool( AI_CONFIG_IMPORT_STL_WELD_VERTICES, true );
+        const aiScene *plain = plainImporter.ReadFile( files[ f ], 0 );
+        const aiScene *welded = weldImporter.ReadFile( files[ f ], aiProcess_ValidateDataStructure );
+        ASSERT_NE( nullptr, plain );
+        ASSERT_NE( nullptr, welded );
+
+        // same facets, but each distinct position is stored only once
+        const aiMesh *p = plain->mMeshes[ 0 ], *w = welded->mMeshes[ 0 ];
+        ASSERT_EQ( p->mNumFaces, w->mNumFaces );
+        EXPECT_EQ( nullptr, w->mNormals );
+        std::set<std::vector<float> > unique;
+        for ( unsigned int i = 0; i < p->mNumVertices; ++i ) {
+            std::vector<float> key( 3 );
+            key[ 0 ] = p->mVertices[ i ].x;
+            key[ 1 ] = p->mVertices[ i ].y;
+            key[ 2 ] = p->mVertices[ i ].z;
+            unique.insert( key );
+        }
+        EXPECT_EQ( unique.size(), w->mNumVertices );
+        for ( unsigned int i = 0; i < w->mNumFaces; ++i ) {
+            ASSERT_EQ( 3u, w->mFaces[ i ].mNumIndices );
+            for ( unsigned int k = 0; k < 3; ++k ) {
+                EXPECT_EQ( p->mVertices[ i * 3 + k ], w->mVertices[ w->mFaces[ i ].mIndices[ k ] ] );
+            }
+        }
+    }
+
+    // colored facets only share vertices of the same color
+    Assimp::Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_STL_WELD_VERTICES, true );
+    const std::string data = buildBinaryQuad();
+    const aiScene *scene = importer.ReadFileFromMemory( data.c_str(), data.size(), aiProcess_ValidateDataStructure, "stl" );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_EQ( 6u, scene->mMeshes[ 0 ]->mNumVertices );
+    ASSERT_NE( nullptr, scene->mMeshes[ 0 ]->mColors[ 0 ] );
+    EXPECT_FLOAT_EQ( 1.f, scene->mMeshes[ 0 ]->mColors[ 0 ][ 5 ].r );
+}
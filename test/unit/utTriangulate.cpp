@@ -44,6 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <TriangulateProcess.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 
 using namespace std;
 using namespace Assimp;
@@ -137,3 +141,94 @@ TEST_F(TriangulateProcessTest, testTriangulation) {
     // we should have no valid normal vectors now necause we aren't a pure polygon mesh
     EXPECT_TRUE(pcMesh->mNormals == NULL);
 }
+
+namespace {
+
+// Build a single polygon mesh from the given outline, in a tilted plane
+aiMesh *makePolygonMesh( const std::vector<aiVector2D> &outline ) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh->mNumVertices = static_cast<unsigned int>( outline.size() );
+    mesh->mVertices = new aiVector3D[ mesh->mNumVertices ];
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[ 1 ];
+    mesh->mFaces[ 0 ].mNumIndices = mesh->mNumVertices;
+    mesh->mFaces[ 0 ].mIndices = new unsigned int[ mesh->mNumVertices ];
+    for ( unsigned int i = 0; i < mesh->mNumVertices; ++i ) {
+        mesh->mVertices[ i ] = aiVector3D( outline[ i ].x, outline[ i ].y * 0.6f, outline[ i ].y * 0.8f );
+        mesh->mFaces[ 0 ].mIndices[ i ] = i;
+    }
+    return mesh;
+}
+
+// A comb: teeth spikes of different heights along a common base
+std::vector<aiVector2D> makeComb( unsigned int teeth ) {
+    std::vector<aiVector2D> outline;
+    outline.push_back( aiVector2D( 0.f, 0.f ) );
+    outline.push_back( aiVector2D( 2.f * teeth, 0.f ) );
+    for ( unsigned int i = teeth; i > 0; --i ) {
+        outline.push_back( aiVector2D( 2.f * i - 0.5f, 5.f + ( i % 3 ) ) );
+        outline.push_back( aiVector2D( 2.f * i - 1.5f, 1.f ) );
+    }
+    return outline;
+}
+
+// A star: alternating inner and outer radius
+std::vector<aiVector2D> makeStar( unsigned int points ) {
+    std::vector<aiVector2D> outline;
+    for ( unsigned int i = 0; i < points * 2; ++i ) {
+        const float angle = i * static_cast<float>( AI_MATH_PI ) / points;
+        const float radius = ( i & 1 ) ? 10.f : 4.f;
+        outline.push_back( aiVector2D( radius * std::cos( angle ), radius * std::sin( angle ) ) );
+    }
+    return outline;
+}
+
+// Checks that the triangles exactly tile the polygon: they all have the
+// winding of the polygon and their areas sum up to the polygon's area.
+void checkTriangulation( const std::vector<aiVector2D> &outline, const aiMesh *mesh ) {
+    double polygonArea = 0.0;
+    for ( size_t i = 0; i < outline.size(); ++i ) {
+        const aiVector2D &a = outline[ i ], &b = outline[ ( i + 1 ) % outline.size() ];
+        polygonArea += 0.5 * ( (double)a.x * b.y - (double)b.x * a.y );
+    }
+
+    // zero-area triangles between collinear vertices are dropped
+    double area = 0.0;
+    EXPECT_GE( outline.size() - 2, mesh->mNumFaces );
+    EXPECT_LT( 0u, mesh->mNumFaces );
+    for ( unsigned int f = 0; f < mesh->mNumFaces; ++f ) {
+        const aiFace &face = mesh->mFaces[ f ];
+        ASSERT_EQ( 3u, face.mNumIndices );
+        for ( unsigned int k = 0; k < 3; ++k ) {
+            ASSERT_LT( face.mIndices[ k ], outline.size() );
+        }
+        const aiVector2D &a = outline[ face.mIndices[ 0 ] ], &b = outline[ face.mIndices[ 1 ] ], &c = outline[ face.mIndices[ 2 ] ];
+        const double triArea = 0.5 * ( ( (double)b.x - a.x ) * ( (double)c.y - a.y ) - ( (double)c.x - a.x ) * ( (double)b.y - a.y ) );
+        EXPECT_GT( triArea * polygonArea, 0.0 );
+        area += triArea;
+    }
+    EXPECT_NEAR( polygonArea, area, std::fabs( polygonArea ) * 1e-5 );
+}
+
+} // Namespace
+
+TEST_F(TriangulateProcessTest, testLargeConcavePolygons) {
+    // below and above the size at which the z-order ear clipping takes over
+    const unsigned int sizes[] = { 10, 31, 32, 100, 2000 };
+    for ( unsigned int s = 0; s < sizeof( sizes ) / sizeof( sizes[ 0 ] ); ++s ) {
+        std::vector<aiVector2D> shapes[ 2 ] = { makeComb( sizes[ s ] ), makeStar( sizes[ s ] ) };
+        for ( unsigned int k = 0; k < 2; ++k ) {
+            for ( unsigned int reversed = 0; reversed < 2; ++reversed ) {
+                std::vector<aiVector2D> &outline = shapes[ k ];
+                if ( reversed ) {
+                    std::reverse( outline.begin(), outline.end() );
+                }
+                aiMesh *mesh = makePolygonMesh( outline );
+                piProcess->TriangulateMesh( mesh );
+                checkTriangulation( outline, mesh );
+                delete mesh;
+            }
+        }
+    }
+}
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
 using namespace Assimp;
@@ -61,3 +62,79 @@ public:
 TEST_F( utXImporterExporter, importXFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utXImporterExporter, importBinaryAndCompressedMatchTextTest ) {
+    Assimp::Importer textImporter;
+    const aiScene *text = textImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/X/test_cube_text.x", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, text );
+    ASSERT_EQ( 1u, text->mNumMeshes );
+    const aiMesh *expected = text->mMeshes[ 0 ];
+
+    static const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/X/test_cube_binary.x",
+        ASSIMP_TEST_MODELS_DIR "/X/test_cube_compressed.x"
+    };
+    for ( const char *file : files ) {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile( file, aiProcess_ValidateDataStructure );
+        ASSERT_NE( nullptr, scene ) << file;
+        ASSERT_EQ( 1u, scene->mNumMeshes ) << file;
+
+        const aiMesh *mesh = scene->mMeshes[ 0 ];
+        ASSERT_EQ( expected->mNumVertices, mesh->mNumVertices ) << file;
+        ASSERT_EQ( expected->mNumFaces, mesh->mNumFaces ) << file;
+        ASSERT_EQ( expected->HasNormals(), mesh->HasNormals() ) << file;
+        for ( unsigned int i = 0; i < mesh->mNumVertices; ++i ) {
+            EXPECT_EQ( expected->mVertices[ i ], mesh->mVertices[ i ] ) << file;
+            if ( mesh->HasNormals() ) {
+                EXPECT_EQ( expected->mNormals[ i ], mesh->mNormals[ i ] ) << file;
+            }
+        }
+        for ( unsigned int i = 0; i < mesh->mNumFaces; ++i ) {
+            ASSERT_EQ( expected->mFaces[ i ].mNumIndices, mesh->mFaces[ i ].mNumIndices ) << file;
+            for ( unsigned int j = 0; j < mesh->mFaces[ i ].mNumIndices; ++j ) {
+                EXPECT_EQ( expected->mFaces[ i ].mIndices[ j ], mesh->mFaces[ i ].mIndices[ j ] ) << file;
+            }
+        }
+    }
+}
+
+TEST_F( utXImporterExporter, importMultiBlockCompressedMatchesTextTest ) {
+    // anim_test_compressed.x is anim_test.x in 26 MSZIP blocks, each one
+    // inflated with the previous block as dictionary
+    Assimp::Importer textImporter;
+    const aiScene *text = textImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/X/anim_test.x", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, text );
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/X/anim_test_compressed.x", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    ASSERT_EQ( text->mNumMeshes, scene->mNumMeshes );
+    for ( unsigned int m = 0; m < scene->mNumMeshes; ++m ) {
+        const aiMesh *expected = text->mMeshes[ m ], *mesh = scene->mMeshes[ m ];
+        ASSERT_EQ( expected->mNumVertices, mesh->mNumVertices );
+        ASSERT_EQ( expected->mNumFaces, mesh->mNumFaces );
+        ASSERT_EQ( expected->mNumBones, mesh->mNumBones );
+        for ( unsigned int i = 0; i < mesh->mNumVertices; ++i ) {
+            ASSERT_EQ( expected->mVertices[ i ], mesh->mVertices[ i ] ) << "vertex " << i;
+        }
+        for ( unsigned int i = 0; i < mesh->mNumFaces; ++i ) {
+            ASSERT_EQ( expected->mFaces[ i ], mesh->mFaces[ i ] ) << "face " << i;
+        }
+    }
+
+    ASSERT_EQ( text->mNumAnimations, scene->mNumAnimations );
+    for ( unsigned int a = 0; a < scene->mNumAnimations; ++a ) {
+        const aiAnimation *expected = text->mAnimations[ a ], *anim = scene->mAnimations[ a ];
+        ASSERT_EQ( expected->mNumChannels, anim->mNumChannels );
+        for ( unsigned int c = 0; c < anim->mNumChannels; ++c ) {
+            const aiNodeAnim *expectedChannel = expected->mChannels[ c ], *channel = anim->mChannels[ c ];
+            EXPECT_EQ( expectedChannel->mNodeName, channel->mNodeName );
+            ASSERT_EQ( expectedChannel->mNumRotationKeys, channel->mNumRotationKeys );
+            for ( unsigned int k = 0; k < channel->mNumRotationKeys; ++k ) {
+                EXPECT_EQ( expectedChannel->mRotationKeys[ k ].mValue, channel->mRotationKeys[ k ].mValue );
+            }
+        }
+    }
+}
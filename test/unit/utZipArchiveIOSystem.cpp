@@ -0,0 +1,201 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "ZipArchiveIOSystem.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+class ZipArchiveIOSystemTest : public ::testing::Test {
+public:
+    static std::vector<char> ReadAll(IOStream* stream) {
+        std::vector<char> data(stream->FileSize());
+        if (!data.empty()) {
+            EXPECT_EQ(data.size(), stream->Read(&data[0], 1, data.size()));
+        }
+        return data;
+    }
+
+protected:
+    DefaultIOSystem mIOSystem;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, openInvalidArchiveTest) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/3MF/does_not_exist.3mf");
+    EXPECT_FALSE(archive.isOpen());
+    EXPECT_FALSE(archive.Exists("3D/3dmodel.model"));
+    EXPECT_EQ(NULL, archive.Open("3D/3dmodel.model"));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, fileListTest) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/3MF/box.3mf");
+    ASSERT_TRUE(archive.isOpen());
+
+    // directories are not listed, the names are sorted
+    std::vector<std::string> fileList;
+    archive.getFileList(fileList);
+    ASSERT_EQ(3U, fileList.size());
+    EXPECT_EQ("3D/3dmodel.model", fileList[0]);
+    EXPECT_EQ("[Content_Types].xml", fileList[1]);
+    EXPECT_EQ("_rels/.rels", fileList[2]);
+
+    EXPECT_TRUE(archive.Exists("_rels/.rels"));
+    EXPECT_FALSE(archive.Exists("_rels/"));
+    EXPECT_FALSE(archive.Exists("3D/missing.model"));
+    EXPECT_EQ(NULL, archive.Open("3D/missing.model"));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, readEntryTest) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/3MF/box.3mf");
+    ASSERT_TRUE(archive.isOpen());
+
+    IOStream* stream = archive.Open("3D/3dmodel.model");
+    ASSERT_TRUE(NULL != stream);
+    EXPECT_EQ(1273U, stream->FileSize());
+    const std::vector<char> data = ReadAll(stream);
+    EXPECT_EQ(data.size(), stream->Tell());
+    EXPECT_EQ("<?xml", std::string(&data[0], 5));
+
+    // nothing left to read
+    char c;
+    EXPECT_EQ(0U, stream->Read(&c, 1, 1));
+    archive.Close(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, chunkedReadTest) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/../models-nonbsd/PK3/SGDTT3.pk3");
+    ASSERT_TRUE(archive.isOpen());
+
+    IOStream* stream = archive.Open("maps/SGDTT3.bsp");
+    ASSERT_TRUE(NULL != stream);
+    const std::vector<char> whole = ReadAll(stream);
+    archive.Close(stream);
+    ASSERT_EQ(852016U, whole.size());
+
+    stream = archive.Open("maps/SGDTT3.bsp");
+    ASSERT_TRUE(NULL != stream);
+    std::vector<char> chunked(whole.size());
+    size_t offset = 0;
+    while (offset < chunked.size()) {
+        const size_t count = std::min(static_cast<size_t>(1000), chunked.size() - offset);
+        ASSERT_EQ(count, stream->Read(&chunked[offset], 1, count));
+        offset += count;
+        EXPECT_EQ(offset, stream->Tell());
+    }
+    archive.Close(stream);
+    EXPECT_TRUE(whole == chunked);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, seekTest) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/../models-nonbsd/PK3/SGDTT3.pk3");
+    ASSERT_TRUE(archive.isOpen());
+
+    IOStream* stream = archive.Open("maps/SGDTT3.bsp");
+    ASSERT_TRUE(NULL != stream);
+    const std::vector<char> whole = ReadAll(stream);
+
+    char buffer[16];
+    EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(100000, aiOrigin_SET));
+    EXPECT_EQ(100000U, stream->Tell());
+    ASSERT_EQ(16U, stream->Read(buffer, 1, 16));
+    EXPECT_EQ(0, memcmp(buffer, &whole[100000], 16));
+
+    // backwards
+    EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(20, aiOrigin_SET));
+    ASSERT_EQ(16U, stream->Read(buffer, 1, 16));
+    EXPECT_EQ(0, memcmp(buffer, &whole[20], 16));
+
+    EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(64, aiOrigin_CUR));
+    EXPECT_EQ(100U, stream->Tell());
+    ASSERT_EQ(4U, stream->Read(buffer, 4, 1) * 4);
+    EXPECT_EQ(0, memcmp(buffer, &whole[100], 4));
+
+    EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(16, aiOrigin_END));
+    ASSERT_EQ(16U, stream->Read(buffer, 1, 16));
+    EXPECT_EQ(0, memcmp(buffer, &whole[whole.size() - 16], 16));
+
+    EXPECT_EQ(aiReturn_FAILURE, stream->Seek(whole.size() + 1, aiOrigin_SET));
+    archive.Close(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, concurrentStreamsTest) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/../models-nonbsd/PK3/SGDTT3.pk3");
+    ASSERT_TRUE(archive.isOpen());
+
+    IOStream* stream = archive.Open("maps/SGDTT3.aas");
+    ASSERT_TRUE(NULL != stream);
+    const std::vector<char> aas = ReadAll(stream);
+    archive.Close(stream);
+    stream = archive.Open("levelshots/SGDTT3.JPG");
+    ASSERT_TRUE(NULL != stream);
+    const std::vector<char> jpg = ReadAll(stream);
+    archive.Close(stream);
+
+    // interleaved reads must not disturb each other
+    IOStream* first = archive.Open("maps/SGDTT3.aas");
+    IOStream* second = archive.Open("levelshots/SGDTT3.JPG");
+    ASSERT_TRUE(NULL != first);
+    ASSERT_TRUE(NULL != second);
+    std::vector<char> a(aas.size()), b(jpg.size());
+    size_t offsetA = 0, offsetB = 0;
+    while (offsetA < a.size() || offsetB < b.size()) {
+        offsetA += first->Read(&a[offsetA], 1, std::min(static_cast<size_t>(4096), a.size() - offsetA));
+        offsetB += second->Read(&b[offsetB], 1, std::min(static_cast<size_t>(777), b.size() - offsetB));
+    }
+    archive.Close(first);
+    archive.Close(second);
+    EXPECT_TRUE(a == aas);
+    EXPECT_TRUE(b == jpg);
+}
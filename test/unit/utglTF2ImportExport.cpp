@@ -45,6 +45,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Importer.hpp>
 #include <assimp/Exporter.hpp>
 #include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/config.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
 
 using namespace Assimp;
 
@@ -84,8 +93,186 @@ TEST_F( utglTF2ImportExport, importBinaryglTF2FromFileTest ) {
     EXPECT_TRUE( binaryImporterTest() );
 }
 
+TEST_F( utglTF2ImportExport, importBinaryglTF2FromMemoryTest ) {
+    std::ifstream file( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF-Binary/BoxTextured.glb", std::ios::binary );
+    ASSERT_TRUE( file.good() );
+    const std::vector<char> data( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+
+    Assimp::Importer fileImporter;
+    const aiScene *reference = fileImporter.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF-Binary/BoxTextured.glb", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, reference );
+
+    // the body chunk is referenced in place instead of being copied
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory( &data[ 0 ], data.size(), aiProcess_ValidateDataStructure, "glb" );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( reference->mNumMeshes, scene->mNumMeshes );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        const aiMesh *expected = reference->mMeshes[ i ], *mesh = scene->mMeshes[ i ];
+        ASSERT_EQ( expected->mNumVertices, mesh->mNumVertices );
+        ASSERT_EQ( expected->mNumFaces, mesh->mNumFaces );
+        EXPECT_EQ( 0, memcmp( expected->mVertices, mesh->mVertices, sizeof( aiVector3D ) * mesh->mNumVertices ) );
+    }
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 TEST_F( utglTF2ImportExport, exportglTF2FromFileTest ) {
     EXPECT_TRUE( exporterTest() );
 }
 #endif // ASSIMP_BUILD_NO_EXPORT
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+TEST_F( utglTF2ImportExport, exportInterleavedglTF2Test ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    ExportProperties properties;
+    properties.SetPropertyBool( AI_CONFIG_EXPORT_GLTF_INTERLEAVED, true );
+    Assimp::Exporter exporter;
+    ASSERT_EQ( aiReturn_SUCCESS, exporter.Export( scene, "gltf2", "interleaved_test.gltf", 0, &properties ) );
+
+    Assimp::Importer reimporter;
+    const aiScene *result = reimporter.ReadFile( "interleaved_test.gltf", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, result );
+    ASSERT_EQ( scene->mNumMeshes, result->mNumMeshes );
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        const aiMesh *expected = scene->mMeshes[ i ], *mesh = result->mMeshes[ i ];
+        ASSERT_EQ( expected->mNumVertices, mesh->mNumVertices );
+        ASSERT_EQ( expected->mNumFaces, mesh->mNumFaces );
+        ASSERT_TRUE( mesh->HasNormals() );
+        ASSERT_TRUE( mesh->HasTextureCoords( 0 ) );
+        for ( unsigned int v = 0; v < mesh->mNumVertices; ++v ) {
+            EXPECT_EQ( expected->mVertices[ v ], mesh->mVertices[ v ] );
+            EXPECT_EQ( expected->mNormals[ v ], mesh->mNormals[ v ] );
+            EXPECT_EQ( expected->mTextureCoords[ 0 ][ v ].x, mesh->mTextureCoords[ 0 ][ v ].x );
+            EXPECT_EQ( expected->mTextureCoords[ 0 ][ v ].y, mesh->mTextureCoords[ 0 ][ v ].y );
+        }
+        for ( unsigned int f = 0; f < mesh->mNumFaces; ++f ) {
+            ASSERT_EQ( expected->mFaces[ f ].mNumIndices, mesh->mFaces[ f ].mNumIndices );
+            EXPECT_EQ( 0, memcmp( expected->mFaces[ f ].mIndices, mesh->mFaces[ f ].mIndices, sizeof( unsigned int ) * mesh->mFaces[ f ].mNumIndices ) );
+        }
+    }
+
+    std::remove( "interleaved_test.gltf" );
+    std::remove( "interleaved_test.bin" );
+}
+
+static aiScene *createInstancedScene() {
+    aiScene *scene = new aiScene;
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[ 1 ];
+    scene->mMaterials[ 0 ] = new aiMaterial;
+
+    scene->mNumMeshes = 2;
+    scene->mMeshes = new aiMesh*[ 2 ];
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        aiMesh *mesh = scene->mMeshes[ i ] = new aiMesh;
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = 3;
+        mesh->mVertices = new aiVector3D[ 3 ]{ aiVector3D( 1, 0, 0 ), aiVector3D( 0, 1, 0 ), aiVector3D( 0, 0, 1 ) };
+        mesh->mNormals = new aiVector3D[ 3 ]{ aiVector3D( 0, 0, 1 ), aiVector3D( 0, 0, 1 ), aiVector3D( 0, 0, 1 ) };
+        mesh->mNumFaces = 1;
+        mesh->mFaces = new aiFace[ 1 ];
+        mesh->mFaces[ 0 ].mNumIndices = 3;
+        mesh->mFaces[ 0 ].mIndices = new unsigned int[ 3 ]{ 0, 1, 2 };
+    }
+
+    scene->mRootNode = new aiNode;
+    scene->mRootNode->mNumMeshes = 2;
+    scene->mRootNode->mMeshes = new unsigned int[ 2 ]{ 0, 1 };
+    return scene;
+}
+
+TEST_F( utglTF2ImportExport, exportSharedStreamsGLBTest ) {
+    std::unique_ptr<aiScene> scene( createInstancedScene() );
+
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *plain = exporter.ExportToBlob( scene.get(), "glb2" );
+    ASSERT_NE( nullptr, plain );
+    const size_t plainSize = plain->size;
+
+    ExportProperties properties;
+    properties.SetPropertyBool( AI_CONFIG_EXPORT_GLTF_INTERLEAVED, true );
+    const aiExportDataBlob *blob = exporter.ExportToBlob( scene.get(), "glb2", 0, &properties );
+    ASSERT_NE( nullptr, blob );
+
+    // the second mesh refers to the data of the first
+    EXPECT_LT( blob->size, plainSize );
+    ASSERT_EQ( 0, memcmp( blob->data, "glTF", 4 ) );
+
+    Assimp::Importer importer;
+    const aiScene *result = importer.ReadFileFromMemory( blob->data, blob->size, aiProcess_ValidateDataStructure, "glb" );
+    ASSERT_NE( nullptr, result );
+    ASSERT_EQ( 2u, result->mNumMeshes );
+    for ( unsigned int i = 0; i < result->mNumMeshes; ++i ) {
+        const aiMesh *mesh = result->mMeshes[ i ];
+        ASSERT_EQ( 3u, mesh->mNumVertices );
+        ASSERT_EQ( 1u, mesh->mNumFaces );
+        ASSERT_TRUE( mesh->HasNormals() );
+        EXPECT_EQ( 0, memcmp( scene->mMeshes[ i ]->mVertices, mesh->mVertices, sizeof( aiVector3D ) * 3 ) );
+        EXPECT_EQ( 0, memcmp( scene->mMeshes[ i ]->mNormals, mesh->mNormals, sizeof( aiVector3D ) * 3 ) );
+    }
+}
+
+TEST_F( utglTF2ImportExport, exportCompressedGLBTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/WusonOBJ.obj", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *plain = exporter.ExportToBlob( scene, "glb2" );
+    ASSERT_NE( nullptr, plain );
+    const std::string plainData( static_cast<const char*>( plain->data ), plain->size );
+
+    ExportProperties properties;
+    properties.SetPropertyBool( "extensions.Open3DGC.use", true );
+    const aiExportDataBlob *blob = exporter.ExportToBlob( scene, "glb2", 0, &properties );
+    ASSERT_NE( nullptr, blob );
+    const std::string data( static_cast<const char*>( blob->data ), blob->size );
+
+#ifdef ASSIMP_IMPORTER_GLTF_USE_OPEN3DGC
+    EXPECT_NE( std::string::npos, data.find( "Open3DGC-compression" ) );
+    EXPECT_LT( data.size() * 2, plainData.size() );
+#else
+    // builds without Open3DGC write the meshes uncompressed
+    EXPECT_EQ( std::string::npos, data.find( "Open3DGC-compression" ) );
+#endif
+
+    Assimp::Importer plainImporter, compressedImporter;
+    const aiScene *expected = plainImporter.ReadFileFromMemory( plainData.data(), plainData.size(), aiProcess_ValidateDataStructure, "glb" );
+    ASSERT_NE( nullptr, expected );
+    const aiScene *result = compressedImporter.ReadFileFromMemory( data.data(), data.size(), aiProcess_ValidateDataStructure, "glb" );
+    ASSERT_NE( nullptr, result );
+
+    // Open3DGC reorders the triangles and quantizes the positions to 12 bits,
+    // so every triangle is looked up by its center
+    ASSERT_EQ( expected->mNumMeshes, result->mNumMeshes );
+    for ( unsigned int i = 0; i < result->mNumMeshes; ++i ) {
+        const aiMesh *reference = expected->mMeshes[ i ], *mesh = result->mMeshes[ i ];
+        ASSERT_EQ( reference->mNumVertices, mesh->mNumVertices );
+        ASSERT_EQ( reference->mNumFaces, mesh->mNumFaces );
+        ASSERT_EQ( reference->HasNormals(), mesh->HasNormals() );
+        ASSERT_EQ( reference->HasTextureCoords( 0 ), mesh->HasTextureCoords( 0 ) );
+
+        auto center = []( const aiMesh *m, unsigned int f ) {
+            const unsigned int *idx = m->mFaces[ f ].mIndices;
+            return ( m->mVertices[ idx[ 0 ] ] + m->mVertices[ idx[ 1 ] ] + m->mVertices[ idx[ 2 ] ] ) / 3.0f;
+        };
+
+        std::vector<aiVector3D> centers;
+        for ( unsigned int f = 0; f < reference->mNumFaces; ++f ) {
+            centers.push_back( center( reference, f ) );
+        }
+        for ( unsigned int f = 0; f < mesh->mNumFaces; ++f ) {
+            ASSERT_EQ( 3u, mesh->mFaces[ f ].mNumIndices );
+            const aiVector3D c = center( mesh, f );
+            float nearest = 1e10f;
+            for ( const aiVector3D &r : centers ) {
+                nearest = std::min( nearest, ( r - c ).Length() );
+            }
+            EXPECT_LT( nearest, 1e-2f );
+        }
+    }
+}
+#endif // ASSIMP_BUILD_NO_EXPORT